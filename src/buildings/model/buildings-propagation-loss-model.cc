@@ -37,28 +37,6 @@ NS_LOG_COMPONENT_DEFINE ("BuildingsPropagationLossModel");
 
 NS_OBJECT_ENSURE_REGISTERED (BuildingsPropagationLossModel);
 
-BuildingsPropagationLossModel::ShadowingLoss::ShadowingLoss ()
-{
-}
-
-BuildingsPropagationLossModel::ShadowingLoss::ShadowingLoss (double shadowingValue, Ptr<MobilityModel> receiver)
-  : m_shadowingValue (shadowingValue), m_receiver (receiver)
-{
-  NS_LOG_INFO (this << " New Shadowing value " << m_shadowingValue);
-}
-
-double
-BuildingsPropagationLossModel::ShadowingLoss::GetLoss () const
-{
-  return (m_shadowingValue);
-}
-
-Ptr<MobilityModel>
-BuildingsPropagationLossModel::ShadowingLoss::GetReceiver () const
-{
-  return m_receiver;
-}
-
 TypeId
 BuildingsPropagationLossModel::GetTypeId (void)
 {
@@ -153,33 +131,17 @@ const
     Ptr<MobilityBuildingInfo> b1 = b->GetObject <MobilityBuildingInfo> ();
     NS_ASSERT_MSG ((a1 != 0) && (b1 != 0), "BuildingsPropagationLossModel only works with MobilityBuildingInfo");
   
-  std::map<Ptr<MobilityModel>,  std::map<Ptr<MobilityModel>, ShadowingLoss> >::iterator ait = m_shadowingLossMap.find (a);
-  if (ait != m_shadowingLossMap.end ())
-    {
-      std::map<Ptr<MobilityModel>, ShadowingLoss>::iterator bit = ait->second.find (b);
-      if (bit != ait->second.end ())
-        {
-          return (bit->second.GetLoss ());
-        }
-      else
-        {
-          double sigma = EvaluateSigma (a1, b1);
-          // side effect: will create new entry          
-          // sigma is standard deviation, not variance
-          double shadowingValue = m_randVariable->GetValue (0.0, (sigma*sigma));
-          ait->second[b] = ShadowingLoss (shadowingValue, b);          
-          return (ait->second[b].GetLoss ());
-        }
-    }
-  else
+  double *shadowingLoss = m_shadowingLossCache.Find (a, b);
+  if (shadowingLoss != 0)
     {
-      double sigma = EvaluateSigma (a1, b1);
-      // side effect: will create new entries in both maps
-      // sigma is standard deviation, not variance
-      double shadowingValue = m_randVariable->GetValue (0.0, (sigma*sigma));
-      m_shadowingLossMap[a][b] = ShadowingLoss (shadowingValue, b);  
-      return (m_shadowingLossMap[a][b].GetLoss ());       
+      return (*shadowingLoss);
     }
+  double sigma = EvaluateSigma (a1, b1);
+  // side effect: will create new entry
+  // sigma is standard deviation, not variance
+  double shadowingValue = m_randVariable->GetValue (0.0, (sigma*sigma));
+  NS_LOG_INFO (this << " New Shadowing value " << shadowingValue);
+  return (*m_shadowingLossCache.Insert (a, b, shadowingValue));
 }
 
 
@@ -28,6 +28,7 @@
 #include "ns3/random-variable-stream.h"
 #include <ns3/building.h>
 #include <ns3/mobility-building-info.h>
+#include <ns3/symmetric-link-cache.h>
 
 
 
@@ -81,19 +82,8 @@ protected:
   double m_lossInternalWall; // in meters
 
   
-  class ShadowingLoss
-  {
-  public:
-    ShadowingLoss ();
-    ShadowingLoss (double shadowingValue, Ptr<MobilityModel> receiver);
-    double GetLoss () const;
-    Ptr<MobilityModel> GetReceiver (void) const;
-  protected:
-    double m_shadowingValue;
-    Ptr<MobilityModel> m_receiver;
-  };
-
-  mutable std::map<Ptr<MobilityModel>,  std::map<Ptr<MobilityModel>, ShadowingLoss> > m_shadowingLossMap;
+  /// shadowing loss (dB) of each link, the same in both directions
+  mutable SymmetricLinkCache<double> m_shadowingLossCache;
   double EvaluateSigma (Ptr<MobilityBuildingInfo> a, Ptr<MobilityBuildingInfo> b) const;
 
 
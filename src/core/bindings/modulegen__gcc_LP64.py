@@ -22,6 +22,8 @@ def register_types(module):
     
     ## log.h (module 'core'): ns3::LogLevel [enumeration]
     module.add_enum('LogLevel', ['LOG_NONE', 'LOG_ERROR', 'LOG_LEVEL_ERROR', 'LOG_WARN', 'LOG_LEVEL_WARN', 'LOG_DEBUG', 'LOG_LEVEL_DEBUG', 'LOG_INFO', 'LOG_LEVEL_INFO', 'LOG_FUNCTION', 'LOG_LEVEL_FUNCTION', 'LOG_LOGIC', 'LOG_LEVEL_LOGIC', 'LOG_ALL', 'LOG_LEVEL_ALL', 'LOG_PREFIX_FUNC', 'LOG_PREFIX_TIME', 'LOG_PREFIX_NODE', 'LOG_PREFIX_LEVEL', 'LOG_PREFIX_ALL'])
+    ## simple-ref-count.h (module 'core'): ns3::AtomicRefCount [class]
+    module.add_class('AtomicRefCount')
     ## attribute-construction-list.h (module 'core'): ns3::AttributeConstructionList [class]
     module.add_class('AttributeConstructionList')
     ## attribute-construction-list.h (module 'core'): ns3::AttributeConstructionList::Item [struct]
@@ -408,6 +410,7 @@ def register_types_ns3_internal(module):
     
 
 def register_methods(root_module):
+    register_Ns3AtomicRefCount_methods(root_module, root_module['ns3::AtomicRefCount'])
     register_Ns3AttributeConstructionList_methods(root_module, root_module['ns3::AttributeConstructionList'])
     register_Ns3AttributeConstructionListItem_methods(root_module, root_module['ns3::AttributeConstructionList::Item'])
     register_Ns3CallbackBase_methods(root_module, root_module['ns3::CallbackBase'])
@@ -533,6 +536,33 @@ def register_methods(root_module):
     register_Ns3HashFunctionMurmur3_methods(root_module, root_module['ns3::Hash::Function::Murmur3'])
     return
 
+def register_Ns3AtomicRefCount_methods(root_module, cls):
+    ## simple-ref-count.h (module 'core'): ns3::AtomicRefCount::AtomicRefCount() [constructor]
+    cls.add_constructor([])
+    ## simple-ref-count.h (module 'core'): ns3::AtomicRefCount::AtomicRefCount(ns3::AtomicRefCount const & arg0) [copy constructor]
+    cls.add_constructor([param('ns3::AtomicRefCount const &', 'arg0')])
+    ## simple-ref-count.h (module 'core'): static bool ns3::AtomicRefCount::Decrement(uint32_t & count) [member function]
+    cls.add_method('Decrement', 
+                   'bool', 
+                   [param('uint32_t &', 'count')], 
+                   is_static=True)
+    ## simple-ref-count.h (module 'core'): static void ns3::AtomicRefCount::Enable(bool enable) [member function]
+    cls.add_method('Enable', 
+                   'void', 
+                   [param('bool', 'enable')], 
+                   is_static=True)
+    ## simple-ref-count.h (module 'core'): static void ns3::AtomicRefCount::Increment(uint32_t & count) [member function]
+    cls.add_method('Increment', 
+                   'void', 
+                   [param('uint32_t &', 'count')], 
+                   is_static=True)
+    ## simple-ref-count.h (module 'core'): static bool ns3::AtomicRefCount::IsEnabled() [member function]
+    cls.add_method('IsEnabled', 
+                   'bool', 
+                   [], 
+                   is_static=True)
+    return
+
 def register_Ns3AttributeConstructionList_methods(root_module, cls):
     ## attribute-construction-list.h (module 'core'): ns3::AttributeConstructionList::AttributeConstructionList(ns3::AttributeConstructionList const & arg0) [copy constructor]
     cls.add_constructor([param('ns3::AttributeConstructionList const &', 'arg0')])
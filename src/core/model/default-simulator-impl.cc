@@ -46,6 +46,13 @@ NS_LOG_COMPONENT_DEFINE ("DefaultSimulatorImpl");
 
 NS_OBJECT_ENSURE_REGISTERED (DefaultSimulatorImpl);
 
+/**
+ * \ingroup simulator
+ * Number of events which other threads can schedule without locking
+ * between two events of the main thread.
+ */
+static const uint32_t EVENTS_WITH_CONTEXT_RING_SIZE = 4096;
+
 TypeId
 DefaultSimulatorImpl::GetTypeId (void)
 {
@@ -58,6 +65,7 @@ DefaultSimulatorImpl::GetTypeId (void)
 }
 
 DefaultSimulatorImpl::DefaultSimulatorImpl ()
+  : m_eventsWithContextRing (EVENTS_WITH_CONTEXT_RING_SIZE)
 {
   NS_LOG_FUNCTION (this);
   m_stop = false;
@@ -72,6 +80,11 @@ DefaultSimulatorImpl::DefaultSimulatorImpl ()
   m_currentContext = 0xffffffff;
   m_unscheduledEvents = 0;
   m_eventsWithContextEmpty = true;
+  m_eventsWithContextOverflow = 0;
+  m_injectionStats.injected = 0;
+  m_injectionStats.overflows = 0;
+  m_injectionStats.late = 0;
+  m_injectionStats.maxDepth = 0;
   m_main = SystemThread::Self();
 }
 
@@ -158,33 +171,63 @@ DefaultSimulatorImpl::IsFinished (void) const
   return m_events->IsEmpty () || m_stop;
 }
 
+void
+DefaultSimulatorImpl::InsertEventWithContext (const EventRing::Item &item)
+{
+  Scheduler::Event ev;
+  ev.impl = item.event;
+  ev.key.m_ts = m_currentTs + item.timestamp;
+  ev.key.m_context = item.context;
+  ev.key.m_uid = m_uid;
+  m_uid++;
+  m_unscheduledEvents++;
+  m_events->Insert (ev);
+}
+
 void
 DefaultSimulatorImpl::ProcessEventsWithContext (void)
 {
-  if (m_eventsWithContextEmpty)
+  uint32_t depth = 0;
+  EventRing::Item item;
+  while (m_eventsWithContextRing.Pop (item))
     {
-      return;
+      InsertEventWithContext (item);
+      depth++;
     }
 
-  // swap queues
-  EventsWithContext eventsWithContext;
-  {
-    CriticalSection cs (m_eventsWithContextMutex);
-    m_eventsWithContext.swap(eventsWithContext);
-    m_eventsWithContextEmpty = true;
-  }
-  while (!eventsWithContext.empty ())
+  if (!m_eventsWithContextEmpty)
     {
-       EventWithContext event = eventsWithContext.front ();
-       eventsWithContext.pop_front ();
-       Scheduler::Event ev;
-       ev.impl = event.event;
-       ev.key.m_ts = m_currentTs + event.timestamp;
-       ev.key.m_context = event.context;
-       ev.key.m_uid = m_uid;
-       m_uid++;
-       m_unscheduledEvents++;
-       m_events->Insert (ev);
+      // swap queues; the events left in the ring were scheduled before
+      // those of the list, so they are moved first
+      EventsWithContext eventsWithContext;
+      {
+        CriticalSection cs (m_eventsWithContextMutex);
+        while (m_eventsWithContextRing.Pop (item))
+          {
+            InsertEventWithContext (item);
+            depth++;
+          }
+        m_eventsWithContext.swap (eventsWithContext);
+        m_eventsWithContextEmpty = true;
+        __sync_fetch_and_and (&m_eventsWithContextOverflow, 0);
+      }
+      for (EventsWithContext::const_iterator i = eventsWithContext.begin ();
+           i != eventsWithContext.end (); ++i)
+        {
+          InsertEventWithContext (*i);
+          depth++;
+        }
+    }
+
+  if (depth > 0)
+    {
+      // the other threads update the overflows with the mutex locked
+      CriticalSection cs (m_eventsWithContextMutex);
+      m_injectionStats.injected += depth;
+      if (depth > m_injectionStats.maxDepth)
+        {
+          m_injectionStats.maxDepth = depth;
+        }
     }
 }
 
@@ -264,16 +307,20 @@ DefaultSimulatorImpl::ScheduleWithContext (uint32_t context, Time const &delay,
     }
   else
     {
-      EventWithContext ev;
+      EventRing::Item ev;
       ev.context = context;
       // Current time added in ProcessEventsWithContext()
       ev.timestamp = delay.GetTimeStep ();
       ev.event = event;
-      {
-        CriticalSection cs (m_eventsWithContextMutex);
-        m_eventsWithContext.push_back(ev);
-        m_eventsWithContextEmpty = false;
-      }
+      if (__sync_fetch_and_or (&m_eventsWithContextOverflow, 0) != 0
+          || !m_eventsWithContextRing.Push (ev))
+        {
+          CriticalSection cs (m_eventsWithContextMutex);
+          m_eventsWithContext.push_back (ev);
+          m_eventsWithContextEmpty = false;
+          __sync_fetch_and_or (&m_eventsWithContextOverflow, 1);
+          m_injectionStats.overflows++;
+        }
     }
 }
 
@@ -408,6 +455,14 @@ DefaultSimulatorImpl::GetMaximumSimulationTime (void) const
   return TimeStep (0x7fffffffffffffffLL);
 }
 
+EventRing::Stats
+DefaultSimulatorImpl::GetInjectionStats (void) const
+{
+  NS_LOG_FUNCTION (this);
+  CriticalSection cs (m_eventsWithContextMutex);
+  return m_injectionStats;
+}
+
 uint32_t
 DefaultSimulatorImpl::GetContext (void) const
 {
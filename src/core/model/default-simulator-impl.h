@@ -24,6 +24,7 @@
 #include "simulator-impl.h"
 #include "scheduler.h"
 #include "event-impl.h"
+#include "event-ring.h"
 #include "system-thread.h"
 #include "ns3/system-mutex.h"
 
@@ -78,6 +79,12 @@ public:
   virtual uint32_t GetSystemId (void) const; 
   virtual uint32_t GetContext (void) const;
 
+  /**
+   * \return The counters of the events scheduled with
+   * ScheduleWithContext by threads other than the main thread.
+   */
+  EventRing::Stats GetInjectionStats (void) const;
+
 private:
   virtual void DoDispose (void);
 
@@ -86,26 +93,44 @@ private:
   /** Move events from a different context into the main event queue. */
   void ProcessEventsWithContext (void);
  
-  /** Wrap an event with its execution context. */
-  struct EventWithContext {
-    /** The event context. */
-    uint32_t context;
-    /** Event timestamp. */
-    uint64_t timestamp;
-    /** The event implementation. */
-    EventImpl *event;
-  };
+  /**
+   * Insert an event scheduled by another thread in the main event queue.
+   *
+   * \param [in] item The event, with its delay from the current time.
+   */
+  void InsertEventWithContext (const EventRing::Item &item);
+
+  /**
+   * The events scheduled by other threads. The ring is written
+   * without locking, and read by the main thread only.
+   */
+  EventRing m_eventsWithContextRing;
   /** Container type for the events from a different context. */
-  typedef std::list<struct EventWithContext> EventsWithContext;
-  /** The container of events from a different context. */
+  typedef std::list<EventRing::Item> EventsWithContext;
+  /**
+   * The events scheduled by other threads while the ring was full.
+   */
   EventsWithContext m_eventsWithContext;
   /**
    * Flag \c true if all events with context have been moved to the
    * primary event queue.
    */
   bool m_eventsWithContextEmpty;
-  /** Mutex to control access to the list of events with context. */
-  SystemMutex m_eventsWithContextMutex;
+  /**
+   * Nonzero if the events of other threads must be added to
+   * m_eventsWithContext rather than to the ring, so that the events
+   * of a thread are kept in order once the ring got full. The other
+   * threads read it without locking the mutex, hence it is only
+   * accessed with atomic operations.
+   */
+  volatile uint32_t m_eventsWithContextOverflow;
+  /**
+   * Mutex to control access to the list of events with context and
+   * to m_injectionStats.
+   */
+  mutable SystemMutex m_eventsWithContextMutex;
+  /** The counters of the events scheduled by other threads. */
+  EventRing::Stats m_injectionStats;
 
   /** Container type for the events to run at Simulator::Destroy() */
   typedef std::list<EventId> DestroyEvents;
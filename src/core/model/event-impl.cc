@@ -20,6 +20,11 @@
 
 #include "event-impl.h"
 #include "log.h"
+#include "ns3/core-config.h"
+#include <new>
+#ifdef HAVE_PTHREAD_H
+#include <pthread.h>
+#endif /* HAVE_PTHREAD_H */
 
 /**
  * \file
@@ -31,6 +36,193 @@ namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("EventImpl");
 
+/**
+ * \ingroup events
+ * The sizes of the pooled blocks are multiples of this value.
+ */
+static const std::size_t EVENT_POOL_GRANULARITY = 16;
+/**
+ * \ingroup events
+ * Number of size classes; larger events are not pooled.
+ */
+static const std::size_t EVENT_POOL_N_CLASSES = 16;
+/**
+ * \ingroup events
+ * Maximum number of blocks kept by a pool for each size class, so
+ * that a thread which frees the events scheduled by other threads
+ * does not hold an unbounded amount of memory.
+ */
+static const uint32_t EVENT_POOL_MAX_BLOCKS = 4096;
+
+/**
+ * \ingroup events
+ * A free block of a pool, linked to the next free block of the same
+ * size class.
+ */
+struct EventPoolBlock
+{
+  EventPoolBlock *next;  //!< The next free block.
+};
+
+/**
+ * \ingroup events
+ * The event pool of a thread. This must remain a POD, as it is
+ * statically zero-initialized.
+ */
+struct EventPool
+{
+  EventPoolBlock *freeList[EVENT_POOL_N_CLASSES];  //!< Free blocks of each size class.
+  uint32_t nFree[EVENT_POOL_N_CLASSES];            //!< Length of each free list.
+  EventImpl::PoolStats stats;                      //!< Allocation statistics.
+  bool registered;                                 //!< Whether the pool is released at thread exit.
+};
+
+#if defined (__GNUC__)
+/** \ingroup events The event pool of the calling thread. */
+static __thread EventPool g_eventPool;
+
+#ifdef HAVE_PTHREAD_H
+/**
+ * \ingroup events
+ * Key whose destructor releases the event pool of an exiting thread.
+ */
+static pthread_key_t g_eventPoolKey;
+/** \ingroup events Creates g_eventPoolKey once. */
+static pthread_once_t g_eventPoolKeyOnce = PTHREAD_ONCE_INIT;
+
+/**
+ * \ingroup events
+ * Return the blocks cached by the pool of an exiting thread to the
+ * system allocator, as no other thread can reuse them.
+ *
+ * \param [in] p The event pool of the exiting thread.
+ */
+static void
+ReleaseEventPool (void *p)
+{
+  EventPool *pool = static_cast<EventPool *> (p);
+  for (std::size_t sizeClass = 0; sizeClass < EVENT_POOL_N_CLASSES; sizeClass++)
+    {
+      EventPoolBlock *block = pool->freeList[sizeClass];
+      while (block != 0)
+        {
+          EventPoolBlock *next = block->next;
+          ::operator delete (block);
+          block = next;
+        }
+      pool->stats.releases += pool->nFree[sizeClass];
+      pool->freeList[sizeClass] = 0;
+      pool->nFree[sizeClass] = 0;
+    }
+  pool->stats.cached = 0;
+  // the events freed later by the thread, e.g., by other destructors,
+  // register the pool again
+  pool->registered = false;
+}
+
+/** \ingroup events Create g_eventPoolKey. */
+static void
+CreateEventPoolKey (void)
+{
+  pthread_key_create (&g_eventPoolKey, &ReleaseEventPool);
+}
+#endif /* HAVE_PTHREAD_H */
+
+/**
+ * \ingroup events
+ * \returns The event pool of the calling thread.
+ */
+static inline EventPool *
+GetEventPool (void)
+{
+  EventPool *pool = &g_eventPool;
+#ifdef HAVE_PTHREAD_H
+  if (!pool->registered)
+    {
+      pool->registered = true;
+      pthread_once (&g_eventPoolKeyOnce, &CreateEventPoolKey);
+      pthread_setspecific (g_eventPoolKey, pool);
+    }
+#endif /* HAVE_PTHREAD_H */
+  return pool;
+}
+#else /* __GNUC__ */
+/**
+ * \ingroup events
+ * Thread-local storage is not available: events are not pooled.
+ * \returns 0
+ */
+static inline EventPool *
+GetEventPool (void)
+{
+  return 0;
+}
+#endif /* __GNUC__ */
+
+EventImpl::PoolStats
+EventImpl::GetPoolStats (void)
+{
+  EventPool *pool = GetEventPool ();
+  if (pool == 0)
+    {
+      PoolStats stats = { 0, 0, 0, 0, 0 };
+      return stats;
+    }
+  return pool->stats;
+}
+
+void *
+EventImpl::operator new (std::size_t size)
+{
+  EventPool *pool = GetEventPool ();
+  std::size_t sizeClass = (size + EVENT_POOL_GRANULARITY - 1) / EVENT_POOL_GRANULARITY;
+  if (pool == 0 || sizeClass >= EVENT_POOL_N_CLASSES)
+    {
+      return ::operator new (size);
+    }
+  pool->stats.allocations++;
+  EventPoolBlock *block = pool->freeList[sizeClass];
+  if (block != 0)
+    {
+      pool->freeList[sizeClass] = block->next;
+      pool->nFree[sizeClass]--;
+      pool->stats.poolHits++;
+      pool->stats.cached--;
+      return block;
+    }
+  // allocate the whole block, so that it can be reused by any event
+  // of the same size class
+  return ::operator new (sizeClass * EVENT_POOL_GRANULARITY);
+}
+
+void
+EventImpl::operator delete (void *p, std::size_t size)
+{
+  if (p == 0)
+    {
+      return;
+    }
+  EventPool *pool = GetEventPool ();
+  std::size_t sizeClass = (size + EVENT_POOL_GRANULARITY - 1) / EVENT_POOL_GRANULARITY;
+  if (pool == 0 || sizeClass >= EVENT_POOL_N_CLASSES)
+    {
+      ::operator delete (p);
+      return;
+    }
+  pool->stats.frees++;
+  if (pool->nFree[sizeClass] >= EVENT_POOL_MAX_BLOCKS)
+    {
+      pool->stats.releases++;
+      ::operator delete (p);
+      return;
+    }
+  EventPoolBlock *block = static_cast<EventPoolBlock *> (p);
+  block->next = pool->freeList[sizeClass];
+  pool->freeList[sizeClass] = block;
+  pool->nFree[sizeClass]++;
+  pool->stats.cached++;
+}
+
 EventImpl::~EventImpl ()
 {
   NS_LOG_FUNCTION (this);
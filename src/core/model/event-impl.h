@@ -21,6 +21,7 @@
 #define EVENT_IMPL_H
 
 #include <stdint.h>
+#include <cstddef>
 #include "simple-ref-count.h"
 
 /**
@@ -40,10 +41,50 @@ namespace ns3 {
  * when it reaches the time associated to this event. Most subclasses
  * are usually created by one of the many Simulator::Schedule
  * methods.
+ *
+ * Since the bound arguments of an event are stored within the event
+ * itself, events are allocated from per-thread pools of memory blocks
+ * of a few size classes, rather than from the system allocator. The
+ * memory of a destroyed event is kept in the pool of the thread which
+ * destroys it and reused by the next events of similar size. The
+ * blocks still cached by a thread are freed when it exits.
  */
 class EventImpl : public SimpleRefCount<EventImpl>
 {
 public:
+  /**
+   * Allocation statistics of the event pool of a thread.
+   */
+  struct PoolStats
+  {
+    uint64_t allocations;  //!< Number of events allocated.
+    uint64_t poolHits;     //!< Number of events allocated by reusing a pooled block.
+    uint64_t frees;        //!< Number of events freed.
+    uint64_t releases;     //!< Number of freed events returned to the system allocator.
+    uint64_t cached;       //!< Number of blocks currently held by the pool.
+  };
+
+  /**
+   * \returns The allocation statistics of the event pool of the
+   *          calling thread.
+   */
+  static PoolStats GetPoolStats (void);
+
+  /**
+   * Allocate memory for an event from the pool of the calling thread.
+   *
+   * \param [in] size The size of the event.
+   * \returns The allocated memory.
+   */
+  static void * operator new (std::size_t size);
+  /**
+   * Return the memory of an event to the pool of the calling thread.
+   *
+   * \param [in] p The memory of the event.
+   * \param [in] size The size of the event.
+   */
+  static void operator delete (void *p, std::size_t size);
+
   /** Default constructor. */
   EventImpl ();
   /** Destructor. */
@@ -0,0 +1,63 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "event-ring.h"
+#include "assert.h"
+#include "log.h"
+
+/**
+ * \file
+ * \ingroup simulator
+ * Implementation of class ns3::EventRing.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("EventRing");
+
+EventRing::EventRing (uint32_t capacity)
+  : m_enqueuePos (0),
+    m_dequeuePos (0)
+{
+  NS_LOG_FUNCTION (this << capacity);
+  NS_ASSERT (capacity >= 2);
+  uint32_t size = 2;
+  while (size < capacity)
+    {
+      size <<= 1;
+    }
+  m_mask = size - 1;
+  m_cells = new Cell[size];
+  for (uint32_t i = 0; i < size; i++)
+    {
+      m_cells[i].sequence = i;
+    }
+}
+
+EventRing::~EventRing ()
+{
+  NS_LOG_FUNCTION (this);
+  delete [] m_cells;
+  m_cells = 0;
+}
+
+uint32_t
+EventRing::GetCapacity (void) const
+{
+  return m_mask + 1;
+}
+
+} // namespace ns3
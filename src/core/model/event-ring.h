@@ -0,0 +1,211 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EVENT_RING_H
+#define EVENT_RING_H
+
+#include <stdint.h>
+
+/**
+ * \file
+ * \ingroup simulator
+ * Declaration of class ns3::EventRing.
+ */
+
+namespace ns3 {
+
+class EventImpl;
+
+/**
+ * \ingroup simulator
+ *
+ * \brief A bounded lock-free queue of events scheduled by other threads.
+ *
+ * The simulator implementations use this ring to let threads other
+ * than the main simulation thread (e.g., the reader threads of
+ * FdNetDevice or TapBridge) schedule events without taking a lock.
+ * Any number of threads can Push events concurrently, while a single
+ * thread at a time can Pop them.
+ *
+ * The ring is the bounded queue of Dmitry Vyukov: each slot carries a
+ * sequence number telling whether it is free for the producer of a
+ * given position or holds an item for the consumer, so that the
+ * producers only contend on an atomic increment of the enqueue
+ * position. When the ring is full, Push fails and the caller is
+ * expected to fall back to a locked queue.
+ */
+class EventRing
+{
+public:
+  /** An event scheduled by another thread. */
+  struct Item
+  {
+    uint32_t context;     //!< The event context.
+    uint64_t timestamp;   //!< The event timestamp, or delay.
+    EventImpl *event;     //!< The event implementation.
+  };
+
+  /**
+   * Counters describing the events scheduled by other threads,
+   * see DefaultSimulatorImpl::GetInjectionStats.
+   */
+  struct Stats
+  {
+    uint64_t injected;    //!< Number of events scheduled by other threads.
+    uint64_t overflows;   //!< Number of events which did not fit in the ring.
+    uint64_t late;        //!< Number of events dequeued after their timestamp.
+    uint32_t maxDepth;    //!< Largest number of events dequeued at once.
+  };
+
+  /**
+   * Constructor.
+   *
+   * \param [in] capacity The number of slots, rounded up to a power of two.
+   */
+  EventRing (uint32_t capacity);
+  /** Destructor. */
+  ~EventRing ();
+
+  /**
+   * Enqueue an item. This can be called by any thread.
+   *
+   * \param [in] item The item.
+   * \return \c false if the ring is full.
+   */
+  bool Push (const Item &item);
+  /**
+   * Dequeue the oldest item. This must not be called concurrently by
+   * several threads.
+   *
+   * \param [out] item The item.
+   * \return \c false if the ring is empty.
+   */
+  bool Pop (Item &item);
+  /**
+   * \return \c true if no item is waiting to be dequeued. This is a
+   * hint only when other threads are pushing items.
+   */
+  bool IsEmpty (void) const;
+  /** \return The number of slots. */
+  uint32_t GetCapacity (void) const;
+
+private:
+  /** A slot of the ring. */
+  struct Cell
+  {
+    /**
+     * Equal to the position of the next item to be stored in the
+     * slot when it is free, or to that position plus one when it
+     * holds an item.
+     */
+    volatile uint32_t sequence;
+    Item item;            //!< The item.
+  };
+
+  /**
+   * Copy constructor, disabled.
+   * \param [in] o The ring to copy.
+   */
+  EventRing (const EventRing &o);
+  /**
+   * Assignment operator, disabled.
+   * \param [in] o The ring to copy.
+   * \returns This ring.
+   */
+  EventRing & operator = (const EventRing &o);
+
+  Cell *m_cells;                      //!< The slots.
+  uint32_t m_mask;                    //!< Number of slots minus one.
+  /** Position of the next item to be enqueued, shared by the producers. */
+  volatile uint32_t m_enqueuePos;
+  /** Position of the next item to be dequeued, owned by the consumer. */
+  uint32_t m_dequeuePos;
+};
+
+} // namespace ns3
+
+
+/********************************************************************
+ *  Implementation of the inline methods.
+ ********************************************************************/
+
+namespace ns3 {
+
+inline bool
+EventRing::Push (const Item &item)
+{
+  uint32_t pos = m_enqueuePos;
+  Cell *cell;
+  while (true)
+    {
+      cell = &m_cells[pos & m_mask];
+      uint32_t sequence = cell->sequence;
+      __sync_synchronize ();
+      int32_t diff = (int32_t)(sequence - pos);
+      if (diff == 0)
+        {
+          // the slot is free: try to claim the position
+          if (__sync_bool_compare_and_swap (&m_enqueuePos, pos, pos + 1))
+            {
+              break;
+            }
+          pos = m_enqueuePos;
+        }
+      else if (diff < 0)
+        {
+          // the slot still holds the item of the previous lap
+          return false;
+        }
+      else
+        {
+          // another producer claimed the position
+          pos = m_enqueuePos;
+        }
+    }
+  cell->item = item;
+  __sync_synchronize ();
+  cell->sequence = pos + 1;
+  return true;
+}
+
+inline bool
+EventRing::Pop (Item &item)
+{
+  Cell *cell = &m_cells[m_dequeuePos & m_mask];
+  uint32_t sequence = cell->sequence;
+  __sync_synchronize ();
+  if ((int32_t)(sequence - (m_dequeuePos + 1)) < 0)
+    {
+      return false;
+    }
+  item = cell->item;
+  __sync_synchronize ();
+  // free the slot for the producer of the next lap
+  cell->sequence = m_dequeuePos + m_mask + 1;
+  m_dequeuePos++;
+  return true;
+}
+
+inline bool
+EventRing::IsEmpty (void) const
+{
+  const Cell *cell = &m_cells[m_dequeuePos & m_mask];
+  return cell->sequence != m_dequeuePos + 1;
+}
+
+} // namespace ns3
+
+#endif /* EVENT_RING_H */
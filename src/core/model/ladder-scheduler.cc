@@ -0,0 +1,367 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ladder-scheduler.h"
+#include "event-impl.h"
+#include <algorithm>
+#include "assert.h"
+#include "log.h"
+
+/**
+ * \file
+ * \ingroup scheduler
+ * Implementation of ns3::LadderScheduler class.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("LadderScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED (LadderScheduler);
+
+/**
+ * \ingroup scheduler
+ * A bucket holding more events than this is split into a new rung
+ * rather than being sorted into the bottom.
+ */
+static const uint32_t LADDER_BUCKET_THRESHOLD = 50;
+/** \ingroup scheduler Maximum number of rungs of the ladder. */
+static const uint32_t LADDER_MAX_RUNGS = 8;
+/** \ingroup scheduler Maximum number of buckets of a rung. */
+static const uint32_t LADDER_MAX_BUCKETS = 65536;
+
+/**
+ * \ingroup scheduler
+ * Compare (less than) two events by EventKey.
+ *
+ * \param [in] a The first event.
+ * \param [in] b The second event.
+ * \returns \c true if \c a < \c b
+ */
+static bool
+LadderEventLess (const Scheduler::Event &a, const Scheduler::Event &b)
+{
+  return a.key < b.key;
+}
+
+TypeId
+LadderScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::LadderScheduler")
+    .SetParent<Scheduler> ()
+    .SetGroupName ("Core")
+    .AddConstructor<LadderScheduler> ()
+  ;
+  return tid;
+}
+
+LadderScheduler::LadderScheduler ()
+  : m_topStart (0),
+    m_rungs (LADDER_MAX_RUNGS),
+    m_nRungs (0),
+    m_bottomHead (0),
+    m_qSize (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+LadderScheduler::~LadderScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+LadderScheduler::Bucket *
+LadderScheduler::FindBucket (const Scheduler::EventKey &key)
+{
+  if (m_nRungs == 0)
+    {
+      // all the events of the top are later than those of the bottom
+      if (m_bottomHead == m_bottom.size () || m_bottom.back ().key < key)
+        {
+          return &m_top;
+        }
+      return 0;
+    }
+  if (key.m_ts >= m_topStart)
+    {
+      return &m_top;
+    }
+  for (uint32_t i = 0; i < m_nRungs; i++)
+    {
+      Rung &rung = m_rungs[i];
+      uint64_t currentStart = rung.start + rung.current * rung.width;
+      if (key.m_ts >= currentStart)
+        {
+          uint32_t bucket = (key.m_ts - rung.start) / rung.width;
+          NS_ASSERT (bucket < rung.nBuckets);
+          return &rung.buckets[bucket];
+        }
+    }
+  return 0;
+}
+
+void
+LadderScheduler::InsertInBottom (const Scheduler::Event &ev)
+{
+  if (m_bottomHead > m_bottom.size () / 2)
+    {
+      // drop the events already dequeued, so that the bottom does not
+      // grow when events keep being inserted in it
+      m_bottom.erase (m_bottom.begin (), m_bottom.begin () + m_bottomHead);
+      m_bottomHead = 0;
+    }
+  Bucket::iterator i = std::upper_bound (m_bottom.begin () + m_bottomHead, m_bottom.end (),
+                                         ev, LadderEventLess);
+  m_bottom.insert (i, ev);
+  if (m_bottom.size () - m_bottomHead > LADDER_BUCKET_THRESHOLD
+      && m_nRungs > 0
+      && m_nRungs < LADDER_MAX_RUNGS
+      && m_bottom[m_bottomHead].key.m_ts < m_bottom.back ().key.m_ts)
+    {
+      TransferBottom ();
+    }
+}
+
+void
+LadderScheduler::TransferBottom (void)
+{
+  NS_LOG_FUNCTION (this << m_bottom.size () - m_bottomHead);
+  // the events of the bottom are earlier than the current bucket of
+  // the lowest rung, which the new rung ends at
+  const Rung &lowest = m_rungs[m_nRungs - 1];
+  uint64_t end = lowest.start + lowest.current * lowest.width;
+  uint64_t start = m_bottom[m_bottomHead].key.m_ts;
+  NS_ASSERT (m_bottom.back ().key.m_ts < end);
+  m_bottom.erase (m_bottom.begin (), m_bottom.begin () + m_bottomHead);
+  m_bottomHead = 0;
+  SpawnRung (start, end - start, m_bottom);
+  RefillBottom ();
+}
+
+void
+LadderScheduler::Insert (const Scheduler::Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.key.m_ts << ev.key.m_uid);
+  Bucket *bucket = FindBucket (ev.key);
+  if (bucket != 0)
+    {
+      bucket->push_back (ev);
+    }
+  else
+    {
+      InsertInBottom (ev);
+    }
+  m_qSize++;
+  if (m_bottomHead == m_bottom.size ())
+    {
+      RefillBottom ();
+    }
+}
+
+bool
+LadderScheduler::IsEmpty (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_qSize == 0;
+}
+
+Scheduler::Event
+LadderScheduler::PeekNext (void) const
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!IsEmpty ());
+  NS_ASSERT (m_bottomHead < m_bottom.size ());
+  return m_bottom[m_bottomHead];
+}
+
+Scheduler::Event
+LadderScheduler::RemoveNext (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!IsEmpty ());
+  NS_ASSERT (m_bottomHead < m_bottom.size ());
+  Scheduler::Event ev = m_bottom[m_bottomHead];
+  m_bottomHead++;
+  m_qSize--;
+  if (m_bottomHead == m_bottom.size ())
+    {
+      m_bottom.clear ();
+      m_bottomHead = 0;
+      if (m_qSize > 0)
+        {
+          RefillBottom ();
+        }
+    }
+  NS_LOG_LOGIC ("remove ts=" << ev.key.m_ts << ", key=" << ev.key.m_uid);
+  return ev;
+}
+
+void
+LadderScheduler::Remove (const Scheduler::Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.key.m_ts << ev.key.m_uid);
+  NS_ASSERT (!IsEmpty ());
+  Bucket *bucket = FindBucket (ev.key);
+  if (bucket != 0)
+    {
+      // buckets are unsorted: move the last event in place of the removed one
+      for (Bucket::iterator i = bucket->begin (); i != bucket->end (); ++i)
+        {
+          if (i->key.m_uid == ev.key.m_uid)
+            {
+              NS_ASSERT (ev.impl == i->impl);
+              *i = bucket->back ();
+              bucket->pop_back ();
+              m_qSize--;
+              return;
+            }
+        }
+      NS_ASSERT (false);
+    }
+
+  Bucket::iterator i = std::lower_bound (m_bottom.begin () + m_bottomHead, m_bottom.end (),
+                                         ev, LadderEventLess);
+  NS_ASSERT (i != m_bottom.end () && i->key.m_uid == ev.key.m_uid);
+  NS_ASSERT (ev.impl == i->impl);
+  m_bottom.erase (i);
+  m_qSize--;
+  if (m_bottomHead == m_bottom.size ())
+    {
+      m_bottom.clear ();
+      m_bottomHead = 0;
+      if (m_qSize > 0)
+        {
+          RefillBottom ();
+        }
+    }
+}
+
+uint32_t
+LadderScheduler::GetCapacity (void) const
+{
+  NS_LOG_FUNCTION (this);
+  uint32_t capacity = m_top.capacity () + m_bottom.capacity ();
+  for (std::vector<Rung>::const_iterator i = m_rungs.begin (); i != m_rungs.end (); ++i)
+    {
+      for (std::vector<Bucket>::const_iterator j = i->buckets.begin (); j != i->buckets.end (); ++j)
+        {
+          capacity += j->capacity ();
+        }
+    }
+  return capacity;
+}
+
+void
+LadderScheduler::RefillBottom (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (m_qSize > 0);
+  NS_ASSERT (m_bottom.empty ());
+  while (true)
+    {
+      if (m_nRungs == 0)
+        {
+          TransferTop ();
+        }
+      Rung &rung = m_rungs[m_nRungs - 1];
+      while (rung.current < rung.nBuckets && rung.buckets[rung.current].empty ())
+        {
+          rung.current++;
+        }
+      if (rung.current == rung.nBuckets)
+        {
+          // this rung is exhausted
+          m_nRungs--;
+          continue;
+        }
+      Bucket &bucket = rung.buckets[rung.current];
+      uint64_t bucketStart = rung.start + rung.current * rung.width;
+      rung.current++;
+      if (bucket.size () > LADDER_BUCKET_THRESHOLD
+          && rung.width > 1
+          && m_nRungs < LADDER_MAX_RUNGS)
+        {
+          SpawnRung (bucketStart, rung.width, bucket);
+          continue;
+        }
+      // the bucket becomes the bottom, and the old bottom storage
+      // is recycled as an empty bucket
+      m_bottom.swap (bucket);
+      m_bottomHead = 0;
+      std::sort (m_bottom.begin (), m_bottom.end (), LadderEventLess);
+      NS_LOG_LOGIC ("bottom refilled with " << m_bottom.size () << " events from rung " << m_nRungs - 1);
+      return;
+    }
+}
+
+void
+LadderScheduler::TransferTop (void)
+{
+  NS_LOG_FUNCTION (this << m_top.size ());
+  NS_ASSERT (!m_top.empty ());
+  uint64_t minTs = m_top.front ().key.m_ts;
+  uint64_t maxTs = minTs;
+  for (Bucket::const_iterator i = m_top.begin (); i != m_top.end (); ++i)
+    {
+      minTs = std::min (minTs, i->key.m_ts);
+      maxTs = std::max (maxTs, i->key.m_ts);
+    }
+  uint32_t nBuckets = std::min<uint32_t> (m_top.size (), LADDER_MAX_BUCKETS);
+  Rung &rung = m_rungs[0];
+  rung.start = minTs;
+  rung.width = (maxTs - minTs) / nBuckets + 1;
+  rung.nBuckets = nBuckets;
+  rung.current = 0;
+  m_nRungs = 1;
+  m_topStart = rung.start + nBuckets * rung.width;
+  NS_LOG_LOGIC ("new rung with " << nBuckets << " buckets of width " << rung.width);
+  Spread (rung, m_top);
+}
+
+void
+LadderScheduler::SpawnRung (uint64_t start, uint64_t width, Bucket &bucket)
+{
+  NS_LOG_FUNCTION (this << start << width << bucket.size ());
+  uint32_t nEvents = std::min<uint32_t> (bucket.size (), LADDER_MAX_BUCKETS);
+  Rung &rung = m_rungs[m_nRungs];
+  rung.start = start;
+  rung.width = (width + nEvents - 1) / nEvents;
+  rung.nBuckets = (width + rung.width - 1) / rung.width;
+  rung.current = 0;
+  m_nRungs++;
+  NS_LOG_LOGIC ("new rung " << m_nRungs - 1 << " with " << rung.nBuckets << " buckets of width " << rung.width);
+  Spread (rung, bucket);
+  // the split array is larger than the buckets usually are: release
+  // its storage, which would otherwise stay held by an emptied bucket
+  Bucket ().swap (bucket);
+}
+
+void
+LadderScheduler::Spread (Rung &rung, Bucket &events)
+{
+  if (rung.buckets.size () < rung.nBuckets)
+    {
+      rung.buckets.resize (rung.nBuckets);
+    }
+  for (Bucket::const_iterator i = events.begin (); i != events.end (); ++i)
+    {
+      uint32_t bucket = (i->key.m_ts - rung.start) / rung.width;
+      NS_ASSERT (bucket < rung.nBuckets);
+      rung.buckets[bucket].push_back (*i);
+    }
+  events.clear ();
+}
+
+} // namespace ns3
@@ -0,0 +1,169 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LADDER_SCHEDULER_H
+#define LADDER_SCHEDULER_H
+
+#include "scheduler.h"
+#include <stdint.h>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * Declaration of ns3::LadderScheduler class.
+ */
+
+namespace ns3 {
+
+class EventImpl;
+
+/**
+ * \ingroup scheduler
+ * \brief a ladder queue event scheduler
+ *
+ * This event scheduler implements the algorithm known as a ladder
+ * queue, published in 2005 in "Ladder Queue: An O(1) Priority Queue
+ * Structure for Large-Scale Discrete Event Simulation" by Wai Teng
+ * Tang, Rick Siow Mong Goh and Ian Li-Jin Thng.
+ *
+ * The events are kept in three tiers:
+ *  - the top, an unsorted array holding the events far in the future;
+ *  - the ladder, a small number of rungs, each of which is an array
+ *    of unsorted buckets covering consecutive time intervals, every
+ *    rung covering a single bucket of the rung above it;
+ *  - the bottom, a sorted array holding the earliest events.
+ *
+ * Events are inserted at the end of the array of the tier which
+ * covers their timestamp, so that only the (small) bottom is kept
+ * sorted. When the bottom holds too many events, they are moved to a
+ * new rung, as a bucket would be. When the bottom is empty, it is
+ * refilled with the first
+ * non-empty bucket of the lowest rung, which is first split into a
+ * new rung if it holds too many events. When the ladder is empty,
+ * the top is spread over a new rung whose bucket width is computed
+ * from the span of the events it holds, so that the bucket size
+ * adapts to the distribution of the events.
+ *
+ * The arrays are kept across operations and reused, except those
+ * split into a new rung, whose storage is released, and the events
+ * already dequeued are dropped from the bottom when events are
+ * inserted in it, so that the memory held by the queue is bounded by
+ * the number of events and of buckets rather than by the number of
+ * operations.
+ */
+class LadderScheduler : public Scheduler
+{
+public:
+  /**
+   *  Register this type.
+   *  \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /** Constructor. */
+  LadderScheduler ();
+  /** Destructor. */
+  virtual ~LadderScheduler ();
+
+  // Inherited
+  virtual void Insert (const Scheduler::Event &ev);
+  virtual bool IsEmpty (void) const;
+  virtual Scheduler::Event PeekNext (void) const;
+  virtual Scheduler::Event RemoveNext (void);
+  virtual void Remove (const Scheduler::Event &ev);
+
+  /**
+   * \return the number of events the arrays of the queue can hold
+   *          without allocating memory
+   */
+  uint32_t GetCapacity (void) const;
+
+private:
+  /** Bucket type: an unsorted array of Events. */
+  typedef std::vector<Scheduler::Event> Bucket;
+
+  /** A rung of the ladder. */
+  struct Rung
+  {
+    uint64_t start;                 //!< Timestamp at the start of the first bucket.
+    uint64_t width;                 //!< Duration of a bucket, in dimensionless time units.
+    uint32_t nBuckets;              //!< Number of buckets in use.
+    uint32_t current;               //!< Index of the first bucket which was not dequeued.
+    std::vector<Bucket> buckets;    //!< The buckets; only the first nBuckets are in use.
+  };
+
+  /**
+   * Get the container which holds, or should hold, an event.
+   *
+   * \param [in] key The key of the event.
+   * \returns The top or a bucket of the ladder, or 0 if the event
+   *          belongs to the bottom.
+   */
+  Bucket * FindBucket (const Scheduler::EventKey &key);
+  /**
+   * Insert an event in the bottom, keeping it sorted.
+   *
+   * \param [in] ev The event.
+   */
+  void InsertInBottom (const Scheduler::Event &ev);
+  /**
+   * Move the earliest events to the bottom. This must be called
+   * whenever the bottom is empty and the queue is not.
+   */
+  void RefillBottom (void);
+  /** Move the events of the top to a new rung. */
+  void TransferTop (void);
+  /**
+   * Move the events of the bottom to a new rung, below the lowest
+   * one, and refill the bottom from it.
+   */
+  void TransferBottom (void);
+  /**
+   * Move the events of a bucket of the lowest rung to a new rung.
+   *
+   * \param [in] start The timestamp at the start of the bucket.
+   * \param [in] width The duration of the bucket.
+   * \param [in,out] bucket The bucket, which is emptied.
+   */
+  void SpawnRung (uint64_t start, uint64_t width, Bucket &bucket);
+  /**
+   * Spread events over the buckets of a rung.
+   *
+   * \param [in,out] rung The rung.
+   * \param [in,out] events The events, which are removed from this array.
+   */
+  void Spread (Rung &rung, Bucket &events);
+
+  /** The events far in the future. */
+  Bucket m_top;
+  /** The events at or beyond this timestamp are in the top, if the ladder is not empty. */
+  uint64_t m_topStart;
+  /** The rungs; only the first m_nRungs are in use. */
+  std::vector<Rung> m_rungs;
+  /** Number of rungs in use. */
+  uint32_t m_nRungs;
+  /** The earliest events, sorted. */
+  Bucket m_bottom;
+  /** Index of the first event of the bottom which was not dequeued. */
+  uint32_t m_bottomHead;
+  /** Number of events in queue. */
+  uint32_t m_qSize;
+};
+
+} // namespace ns3
+
+#endif /* LADDER_SCHEDULER_H */
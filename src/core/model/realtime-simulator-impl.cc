@@ -51,6 +51,13 @@ NS_LOG_COMPONENT_DEFINE ("RealtimeSimulatorImpl");
 
 NS_OBJECT_ENSURE_REGISTERED (RealtimeSimulatorImpl);
 
+/**
+ * \ingroup realtime
+ * Number of events which other threads can schedule without locking
+ * between two events of the main thread.
+ */
+static const uint32_t EVENTS_WITH_CONTEXT_RING_SIZE = 4096;
+
 TypeId
 RealtimeSimulatorImpl::GetTypeId (void)
 {
@@ -75,11 +82,12 @@ RealtimeSimulatorImpl::GetTypeId (void)
 
 
 RealtimeSimulatorImpl::RealtimeSimulatorImpl ()
+  : m_eventsWithContextRing (EVENTS_WITH_CONTEXT_RING_SIZE)
 {
   NS_LOG_FUNCTION (this);
 
   m_stop = false;
-  m_running = false;
+  m_running = 0;
   // uids are allocated from 4.
   // uid 0 is "invalid" events
   // uid 1 is "now" events
@@ -90,6 +98,10 @@ RealtimeSimulatorImpl::RealtimeSimulatorImpl ()
   m_currentTs = 0;
   m_currentContext = 0xffffffff;
   m_unscheduledEvents = 0;
+  m_injectionStats.injected = 0;
+  m_injectionStats.overflows = 0;
+  m_injectionStats.late = 0;
+  m_injectionStats.maxDepth = 0;
 
   m_main = SystemThread::Self();
 
@@ -107,6 +119,10 @@ void
 RealtimeSimulatorImpl::DoDispose (void)
 {
   NS_LOG_FUNCTION (this);
+  {
+    CriticalSection cs (m_mutex);
+    ProcessEventsWithContext ();
+  }
   while (!m_events->IsEmpty ())
     {
       Scheduler::Event next = m_events->RemoveNext ();
@@ -208,6 +224,15 @@ RealtimeSimulatorImpl::ProcessOneEvent (void)
 
       { 
         CriticalSection cs (m_mutex);
+        //
+        // This resets the synchronizer so that any future event will cause it
+        // to interrupt the wait below.  It is done before looking at the events
+        // scheduled by other threads without locking, so that the Signal of
+        // an event which is not seen here is not lost.
+        //
+        m_synchronizer->SetCondition (false);
+        ProcessEventsWithContext ();
+
         //
         // Since we are in realtime mode, the time to delay has got to be the 
         // difference between the current realtime and the timestamp of the next 
@@ -248,15 +273,6 @@ RealtimeSimulatorImpl::ProcessOneEvent (void)
           {
             tsDelay = tsNext - tsNow;
           }
-
-        //
-        // We've figured out how long we need to delay in order to pace the 
-        // simulation time with the real time.  We're going to sleep, but need
-        // to work with the synchronizer to make sure we're awakened if something 
-        // external happens (like a packet is received).  This next line resets
-        // the synchronizer so that any future event will cause it to interrupt.
-        //
-        m_synchronizer->SetCondition (false);
       }
 
       //
@@ -399,7 +415,7 @@ RealtimeSimulatorImpl::IsFinished (void) const
   bool rc;
   {
     CriticalSection cs (m_mutex);
-    rc = m_events->IsEmpty () || m_stop;
+    rc = (m_events->IsEmpty () && m_eventsWithContextRing.IsEmpty ()) || m_stop;
   }
 
   return rc;
@@ -422,15 +438,18 @@ RealtimeSimulatorImpl::Run (void)
 {
   NS_LOG_FUNCTION (this);
 
-  NS_ASSERT_MSG (m_running == false, 
+  NS_ASSERT_MSG (m_running == 0, 
                  "RealtimeSimulatorImpl::Run(): Simulator already running");
 
-  // Set the current threadId as the main threadId
-  m_main = SystemThread::Self();
-
   m_stop = false;
-  m_running = true;
-  m_synchronizer->SetOrigin (m_currentTs);
+  {
+    CriticalSection cs (m_mutex);
+    // Set the current threadId as the main threadId
+    m_main = SystemThread::Self();
+    m_synchronizer->SetOrigin (m_currentTs);
+    // the other threads read the realtime clock once they see the flag
+    __sync_fetch_and_or (&m_running, 1);
+  }
 
   // Sleep until signalled
   uint64_t tsNow;
@@ -442,6 +461,7 @@ RealtimeSimulatorImpl::Run (void)
       {
         CriticalSection cs (m_mutex);
 
+        ProcessEventsWithContext ();
         if (!m_events->IsEmpty ())
           {
             process = true;
@@ -472,17 +492,18 @@ RealtimeSimulatorImpl::Run (void)
   {
     CriticalSection cs (m_mutex);
 
+    ProcessEventsWithContext ();
     NS_ASSERT_MSG (m_events->IsEmpty () == false || m_unscheduledEvents == 0,
                    "RealtimeSimulatorImpl::Run(): Empty queue and unprocessed events");
+    __sync_fetch_and_and (&m_running, 0);
   }
-
-  m_running = false;
 }
 
 bool
 RealtimeSimulatorImpl::Running (void) const
 {
-  return m_running;
+  CriticalSection cs (m_mutex);
+  return m_running != 0;
 }
 
 bool
@@ -543,6 +564,23 @@ RealtimeSimulatorImpl::ScheduleWithContext (uint32_t context, Time const &delay,
 {
   NS_LOG_FUNCTION (this << context << delay << impl);
 
+  if (!SystemThread::Equals (m_main) && __sync_fetch_and_or (&m_running, 0) != 0)
+    {
+      //
+      // The simulator is running, so we're pacing and have a meaningful realtime
+      // clock: the event can be handed over to the main thread without locking.
+      //
+      EventRing::Item item;
+      item.context = context;
+      item.timestamp = m_synchronizer->GetCurrentRealtime () + delay.GetTimeStep ();
+      item.event = impl;
+      if (m_eventsWithContextRing.Push (item))
+        {
+          m_synchronizer->Signal ();
+          return;
+        }
+    }
+
   {
     CriticalSection cs (m_mutex);
     uint64_t ts;
@@ -553,6 +591,15 @@ RealtimeSimulatorImpl::ScheduleWithContext (uint32_t context, Time const &delay,
       }
     else
       {
+        //
+        // The ring is full, or the simulator is not running.  The events
+        // already in the ring were scheduled first, so move them before.
+        //
+        if (m_running)
+          {
+            m_injectionStats.overflows++;
+          }
+        ProcessEventsWithContext ();
         //
         // If the simulator is running, we're pacing and have a meaningful 
         // realtime clock.  If we're not, then m_currentTs is where we stopped.
@@ -574,6 +621,36 @@ RealtimeSimulatorImpl::ScheduleWithContext (uint32_t context, Time const &delay,
   }
 }
 
+void
+RealtimeSimulatorImpl::ProcessEventsWithContext (void)
+{
+  uint32_t depth = 0;
+  EventRing::Item item;
+  while (m_eventsWithContextRing.Pop (item))
+    {
+      Scheduler::Event ev;
+      ev.impl = item.event;
+      ev.key.m_ts = item.timestamp;
+      if (ev.key.m_ts < m_currentTs)
+        {
+          // the main thread went past the time of the event before seeing it
+          ev.key.m_ts = m_currentTs;
+          m_injectionStats.late++;
+        }
+      ev.key.m_context = item.context;
+      ev.key.m_uid = m_uid;
+      m_uid++;
+      m_unscheduledEvents++;
+      m_events->Insert (ev);
+      depth++;
+    }
+  m_injectionStats.injected += depth;
+  if (depth > m_injectionStats.maxDepth)
+    {
+      m_injectionStats.maxDepth = depth;
+    }
+}
+
 EventId
 RealtimeSimulatorImpl::ScheduleNow (EventImpl *impl)
 {
@@ -611,6 +688,7 @@ RealtimeSimulatorImpl::ScheduleRealtimeWithContext (uint32_t context, Time const
 
   {
     CriticalSection cs (m_mutex);
+    ProcessEventsWithContext ();
 
     uint64_t ts = m_synchronizer->GetCurrentRealtime () + time.GetTimeStep ();
     NS_ASSERT_MSG (ts >= m_currentTs, "RealtimeSimulatorImpl::ScheduleRealtime(): schedule for time < m_currentTs");
@@ -638,6 +716,7 @@ RealtimeSimulatorImpl::ScheduleRealtimeNowWithContext (uint32_t context, EventIm
   NS_LOG_FUNCTION (this << context << impl);
   {
     CriticalSection cs (m_mutex);
+    ProcessEventsWithContext ();
 
     //
     // If the simulator is running, we're pacing and have a meaningful 
@@ -665,6 +744,14 @@ RealtimeSimulatorImpl::ScheduleRealtimeNow (EventImpl *impl)
   ScheduleRealtimeNowWithContext (GetContext (), impl);
 }
 
+EventRing::Stats
+RealtimeSimulatorImpl::GetInjectionStats (void) const
+{
+  NS_LOG_FUNCTION (this);
+  CriticalSection cs (m_mutex);
+  return m_injectionStats;
+}
+
 Time
 RealtimeSimulatorImpl::RealtimeNow (void) const
 {
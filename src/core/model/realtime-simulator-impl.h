@@ -25,6 +25,7 @@
 #include "scheduler.h"
 #include "synchronizer.h"
 #include "event-impl.h"
+#include "event-ring.h"
 
 #include "ptr.h"
 #include "assert.h"
@@ -154,6 +155,17 @@ public:
    */
   Time GetHardLimit (void) const;
 
+  /**
+   * Get the counters of the events scheduled with ScheduleWithContext
+   * by threads other than the main thread.  An event is counted as
+   * late if the main thread had already processed events beyond the
+   * real time at which it was scheduled; such an event is executed as
+   * soon as possible.
+   *
+   * \returns The counters.
+   */
+  EventRing::Stats GetInjectionStats (void) const;
+
 private:
   /**
    * Is the simulator running?
@@ -172,6 +184,11 @@ private:
   uint64_t NextTs (void) const;
   /** Process the next event. */
   void ProcessOneEvent (void);
+  /**
+   * Move the events scheduled by other threads into the event list.
+   * This must be called with #m_mutex locked.
+   */
+  void ProcessEventsWithContext (void);
   /** Destructor implementation. */
   virtual void DoDispose (void);
 
@@ -181,8 +198,11 @@ private:
   DestroyEvents m_destroyEvents;
   /** Has the stopping condition been reached? */
   bool m_stop;
-  /** Is the simulator currently running. */
-  bool m_running;
+  /**
+   * Nonzero if the simulator is currently running. It is written with
+   * #m_mutex locked, and read without it only with atomic operations.
+   */
+  volatile uint32_t m_running;
 
   /**
    * \name Mutex-protected variables.
@@ -202,8 +222,17 @@ private:
   uint64_t m_currentTs;
   /**< Execution context. */
   uint32_t m_currentContext;  
+  /** The counters of the events scheduled by other threads. */
+  EventRing::Stats m_injectionStats;
   /**@}*/
 
+  /**
+   * The events scheduled by other threads, with their absolute
+   * timestamp.  The ring is written without locking, and read with
+   * #m_mutex locked.
+   */
+  EventRing m_eventsWithContextRing;
+
   /** Mutex to control access to key state. */  
   mutable SystemMutex m_mutex;  
 
@@ -0,0 +1,39 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "simple-ref-count.h"
+#include "log.h"
+
+/**
+ * \file
+ * \ingroup ptr
+ * ns3::AtomicRefCount implementation.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("AtomicRefCount");
+
+bool AtomicRefCount::m_enabled = false;
+
+void
+AtomicRefCount::Enable (bool enable)
+{
+  NS_LOG_FUNCTION (enable);
+  m_enabled = enable;
+}
+
+} // namespace ns3
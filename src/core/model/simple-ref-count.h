@@ -36,6 +36,71 @@
 
 namespace ns3 {
 
+/**
+ * \ingroup ptr
+ * \brief Selects whether the reference counts are updated atomically.
+ *
+ * While it is enabled, SimpleRefCount and the copy-on-write data
+ * shared by copies of a Packet update their reference counts with
+ * atomic operations, so that objects can be referenced by several
+ * threads which process events concurrently (see
+ * ParallelSimulatorImpl). It is disabled by default, since atomic
+ * operations are slower. It must only be changed while a single
+ * thread uses reference counted objects.
+ */
+class AtomicRefCount
+{
+public:
+  /**
+   * \param enable whether the reference counts are updated atomically
+   */
+  static void Enable (bool enable);
+  /**
+   * \return true if the reference counts are updated atomically
+   */
+  static bool IsEnabled (void)
+  {
+    return m_enabled;
+  }
+  /**
+   * Increment a reference count.
+   *
+   * \param count the reference count
+   */
+  static void Increment (uint32_t &count)
+  {
+#if defined (__GNUC__)
+    if (m_enabled)
+      {
+        __sync_fetch_and_add (&count, 1);
+        return;
+      }
+#endif
+    count++;
+  }
+  /**
+   * Decrement a reference count.
+   *
+   * \param count the reference count
+   * \return true if the reference count dropped to zero
+   */
+  static bool Decrement (uint32_t &count)
+  {
+#if defined (__GNUC__)
+    if (m_enabled)
+      {
+        return __sync_sub_and_fetch (&count, 1) == 0;
+      }
+#endif
+    count--;
+    return count == 0;
+  }
+
+private:
+  /** Whether the reference counts are updated atomically. */
+  static bool m_enabled;
+};
+
 /**
  * \ingroup ptr
  * \brief A template-based reference counting class
@@ -100,7 +165,7 @@ public:
   inline void Ref (void) const
   {
     NS_ASSERT (m_count < std::numeric_limits<uint32_t>::max());
-    m_count++;
+    AtomicRefCount::Increment (m_count);
   }
   /**
    * Decrement the reference count. This method should not be called
@@ -110,8 +175,7 @@ public:
    */
   inline void Unref (void) const
   {
-    m_count--;
-    if (m_count == 0)
+    if (AtomicRefCount::Decrement (m_count))
       {
         DELETER::Delete (static_cast<T*> (const_cast<SimpleRefCount *> (this)));
       }
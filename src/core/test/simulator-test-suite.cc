@@ -19,10 +19,16 @@
  */
 #include "ns3/test.h"
 #include "ns3/simulator.h"
+#include "ns3/event-impl.h"
+#include "ns3/event-ring.h"
 #include "ns3/list-scheduler.h"
 #include "ns3/heap-scheduler.h"
 #include "ns3/map-scheduler.h"
 #include "ns3/calendar-scheduler.h"
+#include "ns3/ladder-scheduler.h"
+#include "ns3/random-variable-stream.h"
+#include <algorithm>
+#include <map>
 
 using namespace ns3;
 
@@ -459,6 +465,292 @@ SimulatorTemplateTestCase::DoRun (void)
   Simulator::Destroy ();
 }
 
+class SimulatorEventPoolTestCase : public TestCase
+{
+public:
+  SimulatorEventPoolTestCase ();
+  virtual void DoRun (void);
+  void Reschedule (uint32_t remaining);
+};
+
+SimulatorEventPoolTestCase::SimulatorEventPoolTestCase ()
+  : TestCase ("Check that the memory of the events is reused")
+{
+}
+
+void
+SimulatorEventPoolTestCase::Reschedule (uint32_t remaining)
+{
+  if (remaining > 0)
+    {
+      Simulator::Schedule (MicroSeconds (10), &SimulatorEventPoolTestCase::Reschedule, this, remaining - 1);
+    }
+}
+
+void
+SimulatorEventPoolTestCase::DoRun (void)
+{
+  EventImpl::PoolStats before = EventImpl::GetPoolStats ();
+  Simulator::Schedule (MicroSeconds (10), &SimulatorEventPoolTestCase::Reschedule, this, 99);
+  Simulator::Run ();
+  Simulator::Destroy ();
+  EventImpl::PoolStats after = EventImpl::GetPoolStats ();
+
+  uint64_t allocations = after.allocations - before.allocations;
+  uint64_t poolHits = after.poolHits - before.poolHits;
+  uint64_t frees = after.frees - before.frees;
+  NS_TEST_EXPECT_MSG_EQ (frees, allocations, "all the pooled events should have been freed");
+  // the memory of each event is available again once it has been
+  // processed, i.e., after the next one has been scheduled
+  NS_TEST_EXPECT_MSG_GT_OR_EQ (poolHits + 2, allocations, "the memory of the events was not reused");
+}
+
+class EventRingTestCase : public TestCase
+{
+public:
+  EventRingTestCase ();
+  virtual void DoRun (void);
+};
+
+EventRingTestCase::EventRingTestCase ()
+  : TestCase ("Check the queue of the events scheduled by other threads")
+{
+}
+
+void
+EventRingTestCase::DoRun (void)
+{
+  EventRing ring (6);
+  NS_TEST_ASSERT_MSG_EQ (ring.GetCapacity (), 8, "the capacity should be rounded to a power of two");
+  NS_TEST_EXPECT_MSG_EQ (ring.IsEmpty (), true, "a new ring should be empty");
+
+  EventRing::Item item;
+  item.event = 0;
+  NS_TEST_EXPECT_MSG_EQ (ring.Pop (item), false, "an empty ring should not return an item");
+
+  // go around the ring several times, filling it completely on each lap
+  uint32_t pushed = 0;
+  uint32_t popped = 0;
+  for (uint32_t lap = 0; lap < 3; lap++)
+    {
+      while (true)
+        {
+          item.context = pushed;
+          item.timestamp = 1000 + pushed;
+          if (!ring.Push (item))
+            {
+              break;
+            }
+          pushed++;
+        }
+      NS_TEST_EXPECT_MSG_EQ (pushed - popped, 8, "the ring should hold as many items as its capacity");
+      NS_TEST_EXPECT_MSG_EQ (ring.IsEmpty (), false, "the ring should not be empty");
+      // leave some items in the ring on all but the last lap
+      uint32_t toPop = (lap < 2) ? 5 : 8;
+      for (uint32_t i = 0; i < toPop; i++)
+        {
+          NS_TEST_EXPECT_MSG_EQ (ring.Pop (item), true, "the ring should return an item");
+          NS_TEST_EXPECT_MSG_EQ (item.context, popped, "the items should be returned in order");
+          NS_TEST_EXPECT_MSG_EQ (item.timestamp, 1000 + popped, "the items should not be altered");
+          popped++;
+        }
+    }
+  NS_TEST_EXPECT_MSG_EQ (ring.IsEmpty (), true, "the ring should be empty");
+  NS_TEST_EXPECT_MSG_EQ (ring.Pop (item), false, "an empty ring should not return an item");
+}
+
+/**
+ * Drives a LadderScheduler and a MapScheduler with the same random
+ * sequence of insertions, cancellations and removals, and checks that
+ * both return the same events in the same order. The bursts of events
+ * within a short interval make the ladder split its buckets into new
+ * rungs.
+ */
+class LadderSchedulerStressTestCase : public TestCase
+{
+public:
+  LadderSchedulerStressTestCase ();
+  virtual void DoRun (void);
+private:
+  void Insert (uint64_t ts);
+  Ptr<Scheduler> m_ladder;
+  Ptr<Scheduler> m_map;
+  std::map<uint32_t, Scheduler::Event> m_pending;
+  uint32_t m_uid;
+};
+
+LadderSchedulerStressTestCase::LadderSchedulerStressTestCase ()
+  : TestCase ("Check the LadderScheduler against the MapScheduler with random events")
+{
+}
+
+void
+LadderSchedulerStressTestCase::Insert (uint64_t ts)
+{
+  Scheduler::Event ev;
+  ev.impl = 0;
+  ev.key.m_ts = ts;
+  ev.key.m_uid = m_uid++;
+  ev.key.m_context = 0;
+  m_ladder->Insert (ev);
+  m_map->Insert (ev);
+  m_pending[ev.key.m_uid] = ev;
+}
+
+void
+LadderSchedulerStressTestCase::DoRun (void)
+{
+  m_ladder = CreateObject<LadderScheduler> ();
+  m_map = CreateObject<MapScheduler> ();
+  m_uid = 0;
+  Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable> ();
+  rng->SetStream (1);
+
+  // the timestamps of the inserted events are never earlier than the
+  // timestamp of the last removed one, as in a simulation
+  uint64_t now = 0;
+  uint32_t removed = 0;
+  for (uint32_t op = 0; op < 20000; op++)
+    {
+      uint32_t choice = rng->GetInteger (0, 99);
+      if (choice < 50)
+        {
+          switch (rng->GetInteger (0, 3))
+            {
+            case 0:
+              Insert (now);
+              break;
+            case 1:
+              Insert (now + rng->GetInteger (0, 10));
+              break;
+            case 2:
+              Insert (now + rng->GetInteger (0, 1000000));
+              break;
+            default:
+              // same timestamp as an event already scheduled
+              if (!m_pending.empty ())
+                {
+                  std::map<uint32_t, Scheduler::Event>::const_iterator i = m_pending.lower_bound (rng->GetInteger (0, m_uid));
+                  Insert (i != m_pending.end () ? i->second.key.m_ts : m_pending.begin ()->second.key.m_ts);
+                }
+              break;
+            }
+        }
+      else if (choice < 52)
+        {
+          uint64_t start = now + rng->GetInteger (0, 1000000);
+          for (uint32_t i = 0; i < 100; i++)
+            {
+              Insert (start + rng->GetInteger (0, 100) * rng->GetInteger (0, 1));
+            }
+        }
+      else if (choice < 70)
+        {
+          if (!m_pending.empty ())
+            {
+              std::map<uint32_t, Scheduler::Event>::iterator i = m_pending.lower_bound (rng->GetInteger (0, m_uid));
+              if (i == m_pending.end ())
+                {
+                  i = m_pending.begin ();
+                }
+              m_ladder->Remove (i->second);
+              m_map->Remove (i->second);
+              m_pending.erase (i);
+            }
+        }
+      else if (!m_pending.empty ())
+        {
+          NS_TEST_ASSERT_MSG_EQ (m_ladder->PeekNext ().key.m_uid, m_map->PeekNext ().key.m_uid, "the schedulers disagree on the next event");
+          Scheduler::Event ladderEv = m_ladder->RemoveNext ();
+          Scheduler::Event mapEv = m_map->RemoveNext ();
+          NS_TEST_ASSERT_MSG_EQ (ladderEv.key.m_uid, mapEv.key.m_uid, "the schedulers removed different events");
+          NS_TEST_ASSERT_MSG_EQ (ladderEv.key.m_ts, mapEv.key.m_ts, "the schedulers removed events with different timestamps");
+          now = mapEv.key.m_ts;
+          m_pending.erase (mapEv.key.m_uid);
+          removed++;
+        }
+      NS_TEST_ASSERT_MSG_EQ (m_ladder->IsEmpty (), m_pending.empty (), "wrong emptiness of the ladder");
+    }
+
+  while (!m_map->IsEmpty ())
+    {
+      NS_TEST_ASSERT_MSG_EQ (m_ladder->IsEmpty (), false, "the ladder lost events");
+      Scheduler::Event ladderEv = m_ladder->RemoveNext ();
+      Scheduler::Event mapEv = m_map->RemoveNext ();
+      NS_TEST_ASSERT_MSG_EQ (ladderEv.key.m_uid, mapEv.key.m_uid, "the schedulers removed different events");
+      removed++;
+    }
+  NS_TEST_EXPECT_MSG_EQ (m_ladder->IsEmpty (), true, "the ladder holds extra events");
+  NS_TEST_EXPECT_MSG_GT (removed, 10000, "too few events removed");
+  m_ladder = 0;
+  m_map = 0;
+}
+
+/**
+ * Runs a hold model, in which every removal of the earliest event is
+ * followed by the insertion of an event in the near future, on a
+ * LadderScheduler for a long time, and checks that the memory held by
+ * the queue stays bounded, i.e., that the events inserted in the
+ * bottom are moved to a new rung and that the bottom is compacted.
+ */
+class LadderSchedulerHoldTestCase : public TestCase
+{
+public:
+  LadderSchedulerHoldTestCase ();
+  virtual void DoRun (void);
+};
+
+LadderSchedulerHoldTestCase::LadderSchedulerHoldTestCase ()
+  : TestCase ("Check that the LadderScheduler memory is bounded in a hold model")
+{
+}
+
+void
+LadderSchedulerHoldTestCase::DoRun (void)
+{
+  Ptr<LadderScheduler> ladder = CreateObject<LadderScheduler> ();
+  Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable> ();
+  rng->SetStream (1);
+  const uint32_t nPending = 1000;
+  // the events are scheduled within 1 ms, in nanoseconds
+  const uint32_t maxDelay = 1000000;
+
+  uint32_t uid = 0;
+  Scheduler::Event ev;
+  ev.impl = 0;
+  ev.key.m_context = 0;
+  for (uint32_t i = 0; i < nPending; i++)
+    {
+      ev.key.m_ts = rng->GetInteger (0, maxDelay);
+      ev.key.m_uid = uid++;
+      ladder->Insert (ev);
+    }
+  // an event far in the future, as scheduled by Simulator::Stop, makes
+  // the first rung much wider than the span of the other events
+  ev.key.m_ts = 1000000000000000ULL;
+  ev.key.m_uid = uid++;
+  ladder->Insert (ev);
+
+  uint64_t now = 0;
+  uint32_t maxCapacity = 0;
+  for (uint32_t op = 0; op < 2000000; op++)
+    {
+      Scheduler::Event next = ladder->RemoveNext ();
+      NS_TEST_ASSERT_MSG_GT_OR_EQ (next.key.m_ts, now, "events removed out of order");
+      now = next.key.m_ts;
+      ev.key.m_ts = now + rng->GetInteger (0, maxDelay);
+      ev.key.m_uid = uid++;
+      ladder->Insert (ev);
+      if (op % 1000 == 0)
+        {
+          maxCapacity = std::max (maxCapacity, ladder->GetCapacity ());
+        }
+    }
+  // the arrays of the top, of the bottom and of the buckets of the
+  // rungs may each hold a few times the pending events
+  NS_TEST_EXPECT_MSG_LT (maxCapacity, 64 * nPending, "the memory of the ladder grows with the number of operations");
+}
+
 class SimulatorTestSuite : public TestSuite
 {
 public:
@@ -475,5 +767,11 @@ public:
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
     factory.SetTypeId (CalendarScheduler::GetTypeId ());
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (LadderScheduler::GetTypeId ());
+    AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+    AddTestCase (new LadderSchedulerStressTestCase, TestCase::QUICK);
+    AddTestCase (new LadderSchedulerHoldTestCase, TestCase::QUICK);
+    AddTestCase (new SimulatorEventPoolTestCase, TestCase::QUICK);
+    AddTestCase (new EventRingTestCase, TestCase::QUICK);
   }
 } g_simulatorTestSuite;
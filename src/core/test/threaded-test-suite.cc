@@ -26,10 +26,12 @@
 #include "ns3/config.h"
 #include "ns3/string.h"
 #include "ns3/system-thread.h"
+#include "ns3/default-simulator-impl.h"
 
 #include <ctime>
 #include <list>
 #include <utility>
+#include <vector>
 
 using namespace ns3;
 
@@ -225,6 +227,123 @@ ThreadedSimulatorEventsTestCase::DoRun (void)
   NS_TEST_EXPECT_MSG_EQ (m_a, m_d, "Bad scheduling");
 }
 
+/**
+ * Several threads schedule many events at once with
+ * Simulator::ScheduleWithContext, enough to fill the ring of the events
+ * of other threads. Checks that no event is lost and that the events of
+ * each thread are executed in the order they were scheduled.
+ */
+class ThreadedProducersTestCase : public TestCase
+{
+public:
+  ThreadedProducersTestCase (const std::string &simulatorType);
+private:
+  virtual void DoSetup (void);
+  virtual void DoRun (void);
+  virtual void DoTeardown (void);
+  static void Produce (std::pair<ThreadedProducersTestCase *, uint32_t> context);
+  void Consume (uint32_t producer, uint32_t seq);
+  void Poll (void);
+
+  static const uint32_t PRODUCERS = 4;
+  static const uint32_t EVENTS_PER_PRODUCER = 20000;
+  std::string m_simulatorType;
+  std::vector<uint32_t> m_next;
+  uint32_t m_received;
+  std::time_t m_deadline;
+  std::string m_error;
+};
+
+ThreadedProducersTestCase::ThreadedProducersTestCase (const std::string &simulatorType)
+  : TestCase ("Check that the events of concurrent threads are neither lost nor reordered in " + simulatorType),
+    m_simulatorType (simulatorType)
+{
+}
+
+void
+ThreadedProducersTestCase::Produce (std::pair<ThreadedProducersTestCase *, uint32_t> context)
+{
+  for (uint32_t seq = 0; seq < EVENTS_PER_PRODUCER; ++seq)
+    {
+      Simulator::ScheduleWithContext (context.second, Time (0),
+                                      &ThreadedProducersTestCase::Consume, context.first, context.second, seq);
+    }
+}
+
+void
+ThreadedProducersTestCase::Consume (uint32_t producer, uint32_t seq)
+{
+  if (seq != m_next[producer] && m_error.empty ())
+    {
+      m_error = "Events of a thread reordered";
+    }
+  m_next[producer] = seq + 1;
+  m_received++;
+}
+
+void
+ThreadedProducersTestCase::Poll (void)
+{
+  if (m_received == PRODUCERS * EVENTS_PER_PRODUCER)
+    {
+      Simulator::Stop ();
+      return;
+    }
+  if (std::time (0) > m_deadline)
+    {
+      m_error = "Events of other threads lost";
+      Simulator::Stop ();
+      return;
+    }
+  Simulator::Schedule (MilliSeconds (1), &ThreadedProducersTestCase::Poll, this);
+}
+
+void
+ThreadedProducersTestCase::DoSetup (void)
+{
+  Config::SetGlobal ("SimulatorImplementationType", StringValue (m_simulatorType));
+}
+
+void
+ThreadedProducersTestCase::DoTeardown (void)
+{
+  Config::SetGlobal ("SimulatorImplementationType", StringValue ("ns3::DefaultSimulatorImpl"));
+}
+
+void
+ThreadedProducersTestCase::DoRun (void)
+{
+  m_next.assign (PRODUCERS, 0);
+  m_received = 0;
+  m_error = "";
+  m_deadline = std::time (0) + 60;
+  // create the simulator in this thread, which becomes its main thread
+  Simulator::Schedule (MilliSeconds (1), &ThreadedProducersTestCase::Poll, this);
+
+  std::list<Ptr<SystemThread> > threads;
+  for (uint32_t i = 0; i < PRODUCERS; ++i)
+    {
+      threads.push_back (Create<SystemThread> (MakeBoundCallback (&ThreadedProducersTestCase::Produce,
+                                                                  std::pair<ThreadedProducersTestCase *, uint32_t> (this, i))));
+      threads.back ()->Start ();
+    }
+  Simulator::Run ();
+  for (std::list<Ptr<SystemThread> >::iterator it = threads.begin (); it != threads.end (); ++it)
+    {
+      (*it)->Join ();
+    }
+
+  NS_TEST_EXPECT_MSG_EQ (m_error.empty (), true, m_error);
+  NS_TEST_EXPECT_MSG_EQ (m_received, PRODUCERS * EVENTS_PER_PRODUCER, "Wrong number of events executed");
+  Ptr<DefaultSimulatorImpl> impl = DynamicCast<DefaultSimulatorImpl> (Simulator::GetImplementation ());
+  if (impl != 0)
+    {
+      NS_TEST_EXPECT_MSG_EQ (impl->GetInjectionStats ().injected, PRODUCERS * EVENTS_PER_PRODUCER,
+                             "Wrong number of events of other threads counted");
+    }
+  Simulator::Destroy ();
+}
+
 class ThreadedSimulatorTestSuite : public TestSuite
 {
 public:
@@ -241,7 +360,8 @@ public:
       "ns3::ListScheduler",
       "ns3::HeapScheduler",
       "ns3::MapScheduler",
-      "ns3::CalendarScheduler"
+      "ns3::CalendarScheduler",
+      "ns3::LadderScheduler"
     };
     unsigned int threadcounts[] = {
       0,
@@ -261,6 +381,7 @@ public:
                 AddTestCase (new ThreadedSimulatorEventsTestCase (factory, simulatorTypes[i], threadcounts[j]), TestCase::QUICK);
               }
           }
+        AddTestCase (new ThreadedProducersTestCase (simulatorTypes[i]), TestCase::QUICK);
       }
   }
 } g_threadedSimulatorTestSuite;
@@ -0,0 +1,60 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2015 University of Washington
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+//
+// Converts a binary trace log kept by a scenario run with
+// --logBinaryOnly=1 (e.g. default_phy_log.bin) to the text logfile the
+// run writes by default.  The node filters of the text logfiles
+// (e.g. --logPhyNodeId=3) apply to the conversion.
+//
+// ./waf --run "laa-trace-log-convert --input=default_phy_log.bin"
+//
+
+#include <ns3/core-module.h>
+#include <ns3/scenario-helper.h>
+
+using namespace ns3;
+
+int
+main (int argc, char *argv[])
+{
+  std::string input;
+  std::string output;
+
+  CommandLine cmd;
+  cmd.AddValue ("input", "binary trace log to convert", input);
+  cmd.AddValue ("output", "text logfile to append to (default: input without .bin)", output);
+  cmd.Parse (argc, argv);
+
+  if (input.empty ())
+    {
+      std::cerr << "No --input binary trace log given" << std::endl;
+      return 1;
+    }
+  if (output.empty ())
+    {
+      std::string::size_type pos = input.rfind (".bin");
+      output = (pos == std::string::npos) ? input + ".txt" : input.substr (0, pos);
+    }
+  if (!ConvertTraceLog (input, output))
+    {
+      std::cerr << "Cannot convert " << input << std::endl;
+      return 1;
+    }
+  return 0;
+}
@@ -152,12 +152,13 @@ static ns3::GlobalValue g_cwFactor ("cwFactor",
         ns3::MakeUintegerChecker<uint32_t> (0,16));
 
 static ns3::GlobalValue g_channelSenseMode ("ChannelSenseMode",
-        "Ene, Enects, Pre, or Prects",
+        "Ene, Enects, Pre, Prects, or Ed",
         ns3::EnumValue (LbtAccessManager::ENE),
         ns3::MakeEnumChecker (ns3::LbtAccessManager::ENE, "Ene",
             ns3::LbtAccessManager::ENECTS, "Enects",
             ns3::LbtAccessManager::PRE, "Pre",
-            ns3::LbtAccessManager::PRECTS, "Prects"));
+            ns3::LbtAccessManager::PRECTS, "Prects",
+            ns3::LbtAccessManager::ED, "Ed"));
 static ns3::GlobalValue g_location ("location",
         "Client location xaxis (meters)",
         ns3::DoubleValue (1),
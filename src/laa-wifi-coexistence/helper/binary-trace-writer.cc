@@ -0,0 +1,253 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2015 University of Washington
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/log.h>
+#include <ns3/callback.h>
+
+#include "binary-trace-writer.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("BinaryTraceWriter");
+
+/// The magic string at the start of a binary trace file.
+static const char BINARY_TRACE_MAGIC[8] = { 'N', 'S', '3', 'T', 'R', 'A', 'C', 'E' };
+
+#ifdef HAVE_PTHREAD_H
+/**
+ * The number of full chunks which may wait for the writer thread before
+ * the simulation waits for it to catch up.
+ */
+static const uint32_t MAX_PENDING_CHUNKS = 16;
+#endif /* HAVE_PTHREAD_H */
+
+BinaryTraceWriter::BinaryTraceWriter (std::string filename, uint32_t type, uint32_t recordSize,
+                                      uint32_t chunkRecords)
+  : m_recordSize (recordSize),
+    m_chunkSize (recordSize * chunkRecords),
+    m_chunk (0),
+    m_used (0),
+    m_nRecords (0),
+    m_closed (false)
+{
+  NS_LOG_FUNCTION (this << filename << type << recordSize << chunkRecords);
+#ifdef HAVE_PTHREAD_H
+  m_stop = false;
+  pthread_mutex_init (&m_mutex, 0);
+  pthread_cond_init (&m_wakeUp, 0);
+  pthread_cond_init (&m_drained, 0);
+#endif /* HAVE_PTHREAD_H */
+  NS_ASSERT (recordSize > 0 && chunkRecords > 0);
+  m_file.open (filename.c_str (), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!m_file.is_open ())
+    {
+      NS_LOG_ERROR ("Can't open file " << filename);
+      m_closed = true;
+      return;
+    }
+  m_file.write (BINARY_TRACE_MAGIC, sizeof (BINARY_TRACE_MAGIC));
+  m_file.write (reinterpret_cast<const char *> (&type), sizeof (type));
+  m_file.write (reinterpret_cast<const char *> (&recordSize), sizeof (recordSize));
+  m_chunk = GetFreeChunk ();
+#ifdef HAVE_PTHREAD_H
+  m_thread = Create<SystemThread> (MakeCallback (&BinaryTraceWriter::Run, this));
+  m_thread->Start ();
+#endif /* HAVE_PTHREAD_H */
+}
+
+BinaryTraceWriter::~BinaryTraceWriter ()
+{
+  NS_LOG_FUNCTION (this);
+  Close ();
+#ifdef HAVE_PTHREAD_H
+  pthread_cond_destroy (&m_drained);
+  pthread_cond_destroy (&m_wakeUp);
+  pthread_mutex_destroy (&m_mutex);
+#endif /* HAVE_PTHREAD_H */
+}
+
+bool
+BinaryTraceWriter::IsOpen (void) const
+{
+  return m_file.is_open ();
+}
+
+uint64_t
+BinaryTraceWriter::GetNRecords (void) const
+{
+  return m_nRecords;
+}
+
+void
+BinaryTraceWriter::Close (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_closed)
+    {
+      return;
+    }
+  m_closed = true;
+#ifdef HAVE_PTHREAD_H
+  pthread_mutex_lock (&m_mutex);
+  m_stop = true;
+  pthread_cond_signal (&m_wakeUp);
+  pthread_mutex_unlock (&m_mutex);
+  m_thread->Join ();
+  m_thread = 0;
+#endif /* HAVE_PTHREAD_H */
+  NS_ASSERT (m_pendingChunks.empty ());
+  WriteChunk (m_chunk, m_used);
+  m_file.close ();
+  delete [] m_chunk;
+  m_chunk = 0;
+  m_used = 0;
+  for (std::vector<uint8_t *>::iterator i = m_freeChunks.begin (); i != m_freeChunks.end (); i++)
+    {
+      delete [] *i;
+    }
+  m_freeChunks.clear ();
+}
+
+void
+BinaryTraceWriter::WriteChunk (const uint8_t *chunk, uint32_t size)
+{
+  m_file.write (reinterpret_cast<const char *> (chunk), size);
+}
+
+uint8_t *
+BinaryTraceWriter::GetFreeChunk (void)
+{
+  uint8_t *chunk = 0;
+#ifdef HAVE_PTHREAD_H
+  pthread_mutex_lock (&m_mutex);
+#endif /* HAVE_PTHREAD_H */
+  if (!m_freeChunks.empty ())
+    {
+      chunk = m_freeChunks.back ();
+      m_freeChunks.pop_back ();
+    }
+#ifdef HAVE_PTHREAD_H
+  pthread_mutex_unlock (&m_mutex);
+#endif /* HAVE_PTHREAD_H */
+  if (chunk == 0)
+    {
+      chunk = new uint8_t[m_chunkSize];
+    }
+  return chunk;
+}
+
+void
+BinaryTraceWriter::NextChunk (void)
+{
+  NS_LOG_FUNCTION (this);
+#ifdef HAVE_PTHREAD_H
+  PendingChunk pending;
+  pending.data = m_chunk;
+  pending.size = m_used;
+  pthread_mutex_lock (&m_mutex);
+  // bound the memory used when the disk is slower than the simulation
+  while (m_pendingChunks.size () >= MAX_PENDING_CHUNKS)
+    {
+      pthread_cond_wait (&m_drained, &m_mutex);
+    }
+  m_pendingChunks.push_back (pending);
+  pthread_cond_signal (&m_wakeUp);
+  pthread_mutex_unlock (&m_mutex);
+  m_chunk = GetFreeChunk ();
+#else
+  WriteChunk (m_chunk, m_used);
+#endif /* HAVE_PTHREAD_H */
+  m_used = 0;
+}
+
+#ifdef HAVE_PTHREAD_H
+void
+BinaryTraceWriter::Run (void)
+{
+  // no logging here, this does not run in the simulation thread
+  pthread_mutex_lock (&m_mutex);
+  while (true)
+    {
+      // chunks are queued and m_stop is set with the mutex held, so
+      // the wake up cannot be lost between the check and the wait
+      while (m_pendingChunks.empty () && !m_stop)
+        {
+          pthread_cond_wait (&m_wakeUp, &m_mutex);
+        }
+      if (m_pendingChunks.empty ())
+        {
+          break;
+        }
+      PendingChunk pending = m_pendingChunks.front ();
+      m_pendingChunks.pop_front ();
+      pthread_mutex_unlock (&m_mutex);
+
+      WriteChunk (pending.data, pending.size);
+
+      pthread_mutex_lock (&m_mutex);
+      m_freeChunks.push_back (pending.data);
+      pthread_cond_signal (&m_drained);
+    }
+  pthread_mutex_unlock (&m_mutex);
+}
+#endif /* HAVE_PTHREAD_H */
+
+BinaryTraceReader::BinaryTraceReader (std::string filename)
+  : m_valid (false),
+    m_type (0),
+    m_recordSize (0)
+{
+  NS_LOG_FUNCTION (this << filename);
+  m_file.open (filename.c_str (), std::ios::in | std::ios::binary);
+  if (!m_file.is_open ())
+    {
+      NS_LOG_ERROR ("Can't open file " << filename);
+      return;
+    }
+  char magic[sizeof (BINARY_TRACE_MAGIC)];
+  m_file.read (magic, sizeof (magic));
+  m_file.read (reinterpret_cast<char *> (&m_type), sizeof (m_type));
+  m_file.read (reinterpret_cast<char *> (&m_recordSize), sizeof (m_recordSize));
+  m_valid = m_file.good ()
+    && std::memcmp (magic, BINARY_TRACE_MAGIC, sizeof (magic)) == 0
+    && m_recordSize > 0;
+  if (!m_valid)
+    {
+      NS_LOG_ERROR ("File " << filename << " is not a binary trace file");
+    }
+}
+
+bool
+BinaryTraceReader::IsOpen (void) const
+{
+  return m_valid;
+}
+
+uint32_t
+BinaryTraceReader::GetType (void) const
+{
+  return m_type;
+}
+
+uint32_t
+BinaryTraceReader::GetRecordSize (void) const
+{
+  return m_recordSize;
+}
+
+} // namespace ns3
@@ -0,0 +1,222 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2015 University of Washington
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef BINARY_TRACE_WRITER_H
+#define BINARY_TRACE_WRITER_H
+
+#include <ns3/core-config.h>
+#include <ns3/simple-ref-count.h>
+#include <ns3/assert.h>
+#include <stdint.h>
+#include <cstring>
+#include <string>
+#include <fstream>
+#include <vector>
+#include <deque>
+#ifdef HAVE_PTHREAD_H
+#include <ns3/ptr.h>
+#include <ns3/system-thread.h>
+#include <pthread.h>
+#endif /* HAVE_PTHREAD_H */
+
+namespace ns3 {
+
+/**
+ * \ingroup laa-wifi-coexistence
+ *
+ * Streams fixed-size trace records to a binary file while the simulation
+ * runs.
+ *
+ * Records are copied into preallocated chunks; a full chunk is handed to
+ * a background writer thread (when threading is available, otherwise it
+ * is written in place) and replaced by a recycled one, so the memory used
+ * by a trace stays bounded however long the run is. The file starts with
+ * a header holding a record type tag and the record size, followed by the
+ * records in the order they were written, and can be read back with a
+ * BinaryTraceReader.
+ *
+ * The records must be plain old data: they are copied and stored
+ * byte for byte.
+ */
+class BinaryTraceWriter : public SimpleRefCount<BinaryTraceWriter>
+{
+public:
+  /**
+   * Open the file and, if threading is available, start the writer
+   * thread.
+   *
+   * \param filename the name of the file to (re)create
+   * \param type a tag identifying the record type, stored in the header
+   * \param recordSize the size of a record (bytes)
+   * \param chunkRecords the number of records per chunk
+   */
+  BinaryTraceWriter (std::string filename, uint32_t type, uint32_t recordSize,
+                     uint32_t chunkRecords = 4096);
+  /**
+   * Close the file, see Close ().
+   */
+  ~BinaryTraceWriter ();
+
+  /**
+   * \return true if the file could be opened for writing
+   */
+  bool IsOpen (void) const;
+
+  /**
+   * Append a record.
+   *
+   * \param record the record, whose size must be the record size
+   */
+  template <typename T>
+  void Write (const T &record);
+
+  /**
+   * Write the pending records, stop the writer thread and close the
+   * file. Further writes are ignored.
+   */
+  void Close (void);
+
+  /**
+   * \return the number of records written so far
+   */
+  uint64_t GetNRecords (void) const;
+
+private:
+  /// Hand the current chunk over for writing and start a new one.
+  void NextChunk (void);
+  /**
+   * Write a chunk to the file.
+   *
+   * \param chunk the chunk
+   * \param size the number of bytes to write
+   */
+  void WriteChunk (const uint8_t *chunk, uint32_t size);
+  /**
+   * Get a chunk to fill, recycled if possible.
+   *
+   * \return the chunk
+   */
+  uint8_t *GetFreeChunk (void);
+
+  /// A full chunk waiting to be written.
+  struct PendingChunk
+  {
+    uint8_t *data;      //!< The chunk.
+    uint32_t size;      //!< The number of bytes used.
+  };
+
+  std::ofstream m_file;           //!< The output file.
+  uint32_t m_recordSize;          //!< The record size (bytes).
+  uint32_t m_chunkSize;           //!< The chunk size (bytes).
+  uint8_t *m_chunk;               //!< The chunk being filled.
+  uint32_t m_used;                //!< The number of bytes used in m_chunk.
+  uint64_t m_nRecords;            //!< The number of records written.
+  bool m_closed;                  //!< Whether Close () was called.
+  std::vector<uint8_t *> m_freeChunks;     //!< Chunks ready for reuse.
+  std::deque<PendingChunk> m_pendingChunks; //!< Chunks waiting to be written.
+
+#ifdef HAVE_PTHREAD_H
+  /// The writer thread body.
+  void Run (void);
+
+  Ptr<SystemThread> m_thread;     //!< The writer thread.
+  pthread_mutex_t m_mutex;        //!< Protects the chunk lists and m_stop.
+  pthread_cond_t m_wakeUp;        //!< Signals that a chunk was queued or m_stop set.
+  pthread_cond_t m_drained;       //!< Signals that a chunk was written.
+  bool m_stop;                    //!< Whether the writer thread must stop.
+#endif /* HAVE_PTHREAD_H */
+};
+
+/**
+ * \ingroup laa-wifi-coexistence
+ *
+ * Reads back the records of a file written by a BinaryTraceWriter.
+ */
+class BinaryTraceReader
+{
+public:
+  /**
+   * Open the file and read its header.
+   *
+   * \param filename the name of the file
+   */
+  BinaryTraceReader (std::string filename);
+
+  /**
+   * \return true if the file could be opened and has a valid header
+   */
+  bool IsOpen (void) const;
+  /**
+   * \return the record type tag of the file
+   */
+  uint32_t GetType (void) const;
+  /**
+   * \return the record size of the file (bytes)
+   */
+  uint32_t GetRecordSize (void) const;
+
+  /**
+   * Read the next record.
+   *
+   * \param record the record read
+   * \return false at the end of the file, or if the size of the record
+   * is not the record size of the file
+   */
+  template <typename T>
+  bool Read (T &record);
+
+private:
+  std::ifstream m_file;   //!< The input file.
+  bool m_valid;           //!< Whether the header is valid.
+  uint32_t m_type;        //!< The record type tag.
+  uint32_t m_recordSize;  //!< The record size (bytes).
+};
+
+template <typename T>
+void
+BinaryTraceWriter::Write (const T &record)
+{
+  NS_ASSERT (sizeof (T) == m_recordSize);
+  if (m_closed)
+    {
+      return;
+    }
+  if (m_used == m_chunkSize)
+    {
+      NextChunk ();
+    }
+  std::memcpy (m_chunk + m_used, &record, sizeof (T));
+  m_used += sizeof (T);
+  m_nRecords++;
+}
+
+template <typename T>
+bool
+BinaryTraceReader::Read (T &record)
+{
+  if (!m_valid || sizeof (T) != m_recordSize)
+    {
+      return false;
+    }
+  m_file.read (reinterpret_cast<char *> (&record), sizeof (T));
+  return m_file.gcount () == static_cast<std::streamsize> (sizeof (T));
+}
+
+} // namespace ns3
+
+#endif /* BINARY_TRACE_WRITER_H */
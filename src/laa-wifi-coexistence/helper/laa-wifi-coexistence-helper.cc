@@ -38,6 +38,7 @@
 #include <ns3/lbt-access-manager.h>
 #include <ns3/basic-lbt-access-manager.h>
 #include <ns3/duty-cycle-access-manager.h>
+#include <ns3/energy-detection-spectrum-phy.h>
 
 namespace ns3 {
 
@@ -110,6 +111,37 @@ LaaWifiCoexistenceHelper::ConfigureEnbDevicesForLbt (NetDeviceContainer enbDevic
       // we need a spectrum channel in order to install wifi device on the same instance of spectrum channel
       Ptr<LteEnbNetDevice> lteEnbNetDevice = (*i)->GetObject<LteEnbNetDevice> ();
       Ptr<SpectrumChannel> downlinkSpectrumChannel = lteEnbNetDevice->GetPhy ()->GetDownlinkSpectrumPhy ()->GetChannel ();
+      //uint32_t channelNumber = 36 + 4 * (i%4);
+      uint32_t channelNumber = 36;
+
+      Ptr<LteEnbPhy> ltePhy = (*i)->GetObject<LteEnbNetDevice> ()->GetPhy ();
+      Ptr<LteEnbMac> lteMac = (*i)->GetObject<LteEnbNetDevice> ()->GetMac ();
+
+      Ptr<LbtAccessManager> lbtAccessManager;
+      if (m_channelAccessManagerFactory.GetTypeId ().GetName () == "ns3::LbtAccessManager")
+        {
+          lbtAccessManager = m_channelAccessManagerFactory.Create<LbtAccessManager> ();
+          EnumValue channelSenseMode;
+          lbtAccessManager->GetAttribute ("ChannelSenseMode", channelSenseMode);
+          if (channelSenseMode.Get () == LbtAccessManager::ED)
+            {
+              // energy detection only: a receive-only PHY on the same
+              // channel replaces the monitoring wifi device
+              Ptr<EnergyDetectionSpectrumPhy> edPhy = CreateObject<EnergyDetectionSpectrumPhy> ();
+              edPhy->SetChannelNumber (channelNumber);
+              edPhy->SetAttribute ("RxGain", DoubleValue (phyParams.m_ueRxGain));
+              edPhy->SetDevice (*i);
+              edPhy->SetMobility (node->GetObject<MobilityModel> ());
+              edPhy->SetChannel (downlinkSpectrumChannel);
+              downlinkSpectrumChannel->AddRx (edPhy);
+              lbtAccessManager->SetLteEnbMac (lteMac);
+              lbtAccessManager->SetLteEnbPhy (ltePhy);
+              lbtAccessManager->SetEnergyDetectionPhy (edPhy);
+              ltePhy->SetChannelAccessManager (lbtAccessManager);
+              continue;
+            }
+        }
+
       SpectrumWifiPhyHelper spectrumPhy = SpectrumWifiPhyHelper::Default ();
       spectrumPhy.SetChannel (downlinkSpectrumChannel);
 
@@ -130,8 +162,6 @@ LaaWifiCoexistenceHelper::ConfigureEnbDevicesForLbt (NetDeviceContainer enbDevic
       //which implements a Wi-Fi MAC that does not perform any kind of beacon generation, probing, or association
       mac.SetType ("ns3::AdhocWifiMac");
 
-      //uint32_t channelNumber = 36 + 4 * (i%4);
-      uint32_t channelNumber = 36;
       spectrumPhy.SetChannelNumber (channelNumber);
 
       // wifi device that is doing monitoring
@@ -147,9 +177,6 @@ LaaWifiCoexistenceHelper::ConfigureEnbDevicesForLbt (NetDeviceContainer enbDevic
       // MacRxMiddle *m_rxMiddle;
       // m_rxMiddle = new MacRxMiddle ();
       
-      Ptr<LteEnbPhy> ltePhy = (*i)->GetObject<LteEnbNetDevice> ()->GetPhy ();
-      Ptr<LteEnbMac> lteMac = (*i)->GetObject<LteEnbNetDevice> ()->GetMac ();
-
       if (m_channelAccessManagerFactory.GetTypeId ().GetName () == "ns3::BasicLbtAccessManager")
         {
           Ptr<BasicLbtAccessManager> basicLbtAccessManager = m_channelAccessManagerFactory.Create<BasicLbtAccessManager> ();
@@ -157,9 +184,8 @@ LaaWifiCoexistenceHelper::ConfigureEnbDevicesForLbt (NetDeviceContainer enbDevic
           // set channel access manager to lteEnbPhy
           ltePhy->SetChannelAccessManager (basicLbtAccessManager);
         }
-      else if (m_channelAccessManagerFactory.GetTypeId ().GetName () == "ns3::LbtAccessManager")
+      else if (lbtAccessManager != 0)
         {
-          Ptr<LbtAccessManager> lbtAccessManager = m_channelAccessManagerFactory.Create<LbtAccessManager> ();
           lbtAccessManager->SetLteEnbMac(lteMac);
           lbtAccessManager->SetLteEnbPhy(ltePhy);
           lbtAccessManager->SetWifiPhy (spectrumWifiPhy);
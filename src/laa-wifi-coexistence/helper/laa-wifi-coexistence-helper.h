@@ -32,6 +32,13 @@
 #include <ns3/node-container.h>
 #include <ns3/scenario-helper.h>
 
+/**
+ * \defgroup laa-wifi-coexistence LAA Wi-Fi Coexistence
+ *
+ * Models and helpers for the coexistence of LTE License Assisted Access
+ * and Wi-Fi in the unlicensed spectrum.
+ */
+
 namespace ns3 {
 
 enum Config_ChannelAccessManager
@@ -44,7 +51,7 @@ enum Config_ChannelAccessManager
 };
 
 /**
- * \ingroup lte
+ * \ingroup laa-wifi-coexistence
  *
  * This class gathers methods necessary for configuring the LAA/Wi-Fi 
  * coexistance mode on a set of LTE eNodeB devices.
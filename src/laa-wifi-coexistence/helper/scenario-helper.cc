@@ -25,6 +25,7 @@
 #include <sstream>
 #include <iostream>
 #include <iomanip>
+#include <cstdio>
 #include <ns3/core-module.h>
 #include <ns3/network-module.h>
 #include <ns3/internet-module.h>
@@ -42,7 +43,10 @@
 #include <ns3/mobility-module.h>
 #include <ns3/laa-wifi-coexistence-helper.h>
 #include <ns3/lbt-access-manager.h>
+#include <ns3/energy-detection-spectrum-phy.h>
 #include <ns3/ff-mac-common.h>
+#include <ns3/binary-trace-writer.h>
+#include <ns3/link-gain-matrix-propagation-loss-model.h>
 
 #ifndef UINT32_MAX
 #define UINT32_MAX 4294967295U
@@ -91,6 +95,21 @@ static ns3::GlobalValue g_remDir ("remDir",
         ns3::StringValue ("./"),
         ns3::MakeStringChecker ());
 
+static ns3::GlobalValue g_linkGainMatrix ("linkGainMatrix",
+        "Whether to compute the gains of the links between the nodes with constant positions once before the run, instead of evaluating the propagation loss model for every transmission",
+        ns3::BooleanValue (false),
+        ns3::MakeBooleanChecker ());
+
+static ns3::GlobalValue g_linkGainMatrixFile ("linkGainMatrixFile",
+        "If not empty and linkGainMatrix is set, the link gains are loaded from <linkGainMatrixFile>_dl.bin and <linkGainMatrixFile>_ul.bin when they match the topology, or else computed and saved there",
+        ns3::StringValue (""),
+        ns3::MakeStringChecker ());
+
+static ns3::GlobalValue g_linkGainMatrixThreads ("linkGainMatrixThreads",
+        "Number of threads computing the link gains, 0 for one thread per processor",
+        ns3::UintegerValue (0),
+        ns3::MakeUintegerChecker<uint32_t> ());
+
 static ns3::GlobalValue g_lbtChannelAccessManagerInstallTime ("lbtChannelAccessManagerInstallTime",
         "LTE channel access manager install time (seconds)",
         ns3::DoubleValue (2),
@@ -181,6 +200,11 @@ static ns3::GlobalValue g_logHarqFeedbacks ("logHarqFeedback",
         ns3::BooleanValue (false),
         ns3::MakeBooleanChecker ());
 
+static ns3::GlobalValue g_logBinaryOnly ("logBinaryOnly",
+        "Whether to keep the logfiles in the binary format they are written in during the run (<logfile>.bin) instead of converting them to text at the end of the run",
+        ns3::BooleanValue (false),
+        ns3::MakeBooleanChecker ());
+
 // 75 Mb/s will saturate LAA and WiFi SISO 20 MHz
 static const uint64_t UDP_SATURATION_RATE = 75000000;
 
@@ -268,19 +292,6 @@ ContextToNodeId (std::string context)
     return atoi (sub.substr (0,pos).c_str ());
 }
 
-// Generate a 'fake' context id that can be parsed by ContextToNodeId ()
-// For use in direct calls to "TraceConnect()" for LAA code, so that
-// uniform ContextToNodeId() can be used in Wifi and LAA callbacks
-    std::string
-NodeIdToContext (uint32_t nodeId)
-{
-    std::stringstream ss;
-    ss << "/NodeList/";
-    ss << nodeId;
-    ss << "/DeviceList/";
-    return ss.str ();
-}
-
 // Parse context strings of the form "/NodeList/3/DeviceList/1/Mac/Assoc"
 // to extract the DeviceId
     uint32_t
@@ -491,47 +502,66 @@ DeassociationLogging (std::string context, Mac48Address address)
     g_associations.push_back (a);
 }
 
+// Record type tags of the binary trace logs
+enum TraceLog_e
+{
+    TXPHY_LOG = 1,
+    PHY_LOG,
+    TXOP_LOG,
+    DATA_TX_LOG,
+    BEACON_LOG,
+    CW_LOG,
+    BACKOFF_LOG,
+    HARQ_FEEDBACK_LOG,
+    FAIL_RETRIES_LOG,
+    RETRIES_LOG,
+    VOICE_LOG
+};
+
+// The trace log records are written as they are to the binary trace
+// logs, so they are plain old data; times are Time::GetTimeStep () values
+
 struct SignalTransmission
 {
-    Time m_time;
+    int64_t m_time;
     uint32_t m_nodeId;
     uint32_t m_rate;
 };
 
 struct SignalArrival
 {
-    Time m_time;
-    Time m_duration;
-    bool m_wifi;
+    int64_t m_time;
+    int64_t m_duration;
+    double m_power;
     uint32_t m_nodeId;
     uint32_t m_senderNodeId;
-    double m_power;
+    uint32_t m_wifi;
 };
 
 struct TxopLog
 {
-    Time m_time;
-    Time m_duration;
+    int64_t m_time;
+    int64_t m_duration;
     uint32_t m_nodeId;
 };
 
 struct DataTx
 {
-    Time m_time;
+    int64_t m_time;
     uint32_t m_nodeId;
     uint32_t m_size;
 };
 
 struct BeaconArrival
 {
-    Time m_time;
-    Time m_interval;
+    int64_t m_time;
+    int64_t m_interval;
     uint32_t m_nodeId;
 };
 
 struct CwChange
 {
-    Time m_time;
+    int64_t m_time;
     uint32_t m_nodeId;
     uint32_t m_oldCw;
     uint32_t m_newCw;
@@ -539,7 +569,7 @@ struct CwChange
 
 struct BackoffChange
 {
-    Time m_time;
+    int64_t m_time;
     uint32_t m_nodeId;
     uint32_t m_oldBackoff;
     uint32_t m_newBackoff;
@@ -547,45 +577,52 @@ struct BackoffChange
 
 struct HarqFeedbackLog
 {
-    Time m_time;
+    int64_t m_time;
     uint32_t m_nodeId;
     uint32_t m_nackCount;
     uint32_t m_ackCount;
-    std::vector<uint32_t> m_ueId;
 };
 
 struct WifiRetriesLog
 {
-    Time m_time;
+    int64_t m_time;
     uint32_t m_nodeId;
-    Mac48Address m_dest;
+    uint8_t m_dest[6];
 };
 
 struct VoiceRxLog
 {
-    Time m_time;
+    int64_t m_time;
+    double m_latency;
     uint32_t m_nodeId;
     uint32_t m_seqno;
-    double m_latency;
 };
 
-std::vector<SignalArrival> g_arrivals;
-std::vector<SignalTransmission> g_transmissions;
-std::vector<TxopLog> g_txopLogs;
-std::vector<BeaconArrival> g_beaconArrivals;
-std::vector<CwChange> g_cwChanges;
-std::vector<BackoffChange> g_backoffChanges;
-std::vector<HarqFeedbackLog> g_harqFeedbacks;
-std::vector<WifiRetriesLog> g_wifiFailRetries;
-std::vector<WifiRetriesLog> g_wifiRetries;
-std::vector<VoiceRxLog> g_voiceRxLog;
-std::vector<DataTx> g_dataTxLogs;
+Ptr<BinaryTraceWriter> g_arrivals;
+Ptr<BinaryTraceWriter> g_transmissions;
+Ptr<BinaryTraceWriter> g_txopLogs;
+Ptr<BinaryTraceWriter> g_beaconArrivals;
+Ptr<BinaryTraceWriter> g_cwChanges;
+Ptr<BinaryTraceWriter> g_backoffChanges;
+Ptr<BinaryTraceWriter> g_harqFeedbacks;
+Ptr<BinaryTraceWriter> g_wifiFailRetries;
+Ptr<BinaryTraceWriter> g_wifiRetries;
+Ptr<BinaryTraceWriter> g_voiceRxLog;
+Ptr<BinaryTraceWriter> g_dataTxLogs;
 
 double g_txopDurationCounter = 0;
 double g_arrivalsDurationCounter = 0;
 
+// Values of the logPhyNodeId and logTxopNodeId global values, read when
+// the corresponding traces are connected rather than for every event
+uint32_t g_phyLogNodeId = UINT32_MAX;
+uint32_t g_txopLogNodeId = UINT32_MAX;
+
+// The trace sinks below are connected without context, with the id of
+// the node of the trace source bound as their first argument
+
     void
-VoiceRxCb (std::string context, Ptr<const Packet> packet)
+VoiceRxCb (uint32_t nodeId, Ptr<const Packet> packet)
 {
     SeqTsHeader seqTs;
     packet->PeekHeader (seqTs);
@@ -593,166 +630,212 @@ VoiceRxCb (std::string context, Ptr<const Packet> packet)
     Time sendTime = seqTs.GetTs ();
     double latencySample = Simulator::Now ().GetSeconds () - sendTime.GetSeconds ();
     VoiceRxLog entry;
-    entry.m_time = Simulator::Now ();
-    entry.m_nodeId = ContextToNodeId (context);
+    entry.m_time = Simulator::Now ().GetTimeStep ();
+    entry.m_nodeId = nodeId;
     entry.m_seqno = currentSequenceNumber.GetValue ();
     entry.m_latency = latencySample;
-    g_voiceRxLog.push_back (entry);
+    g_voiceRxLog->Write (entry);
 }
 
     void
-WifiFailRetriesCb (std::string context, Mac48Address dest)
+WifiFailRetriesCb (uint32_t nodeId, Mac48Address dest)
 {
     WifiRetriesLog entry;
-    entry.m_time = Simulator::Now ();
-    entry.m_nodeId = ContextToNodeId (context);
-    entry.m_dest = dest;
-    g_wifiFailRetries.push_back (entry);
+    entry.m_time = Simulator::Now ().GetTimeStep ();
+    entry.m_nodeId = nodeId;
+    dest.CopyTo (entry.m_dest);
+    g_wifiFailRetries->Write (entry);
 }
 
     void
-WifiRetriesCb (std::string context, Mac48Address dest)
+WifiRetriesCb (uint32_t nodeId, Mac48Address dest)
 {
     WifiRetriesLog entry;
-    entry.m_time = Simulator::Now ();
-    entry.m_nodeId = ContextToNodeId (context);
-    entry.m_dest = dest;
-    g_wifiRetries.push_back (entry);
+    entry.m_time = Simulator::Now ().GetTimeStep ();
+    entry.m_nodeId = nodeId;
+    dest.CopyTo (entry.m_dest);
+    g_wifiRetries->Write (entry);
 }
 
     void
-CwChangeCb (std::string context, uint32_t oldVal, uint32_t newVal)
+CwChangeCb (uint32_t nodeId, uint32_t oldVal, uint32_t newVal)
 {
     CwChange cwchange;
-    cwchange.m_time = Simulator::Now ();
-    cwchange.m_nodeId = ContextToNodeId (context);
+    cwchange.m_time = Simulator::Now ().GetTimeStep ();
+    cwchange.m_nodeId = nodeId;
     cwchange.m_oldCw = oldVal;
     cwchange.m_newCw = newVal;
-    g_cwChanges.push_back (cwchange);
+    g_cwChanges->Write (cwchange);
 }
 
     void
-BackoffChangeCb (std::string context, uint32_t oldVal, uint32_t newVal)
+BackoffChangeCb (uint32_t nodeId, uint32_t oldVal, uint32_t newVal)
 {
     BackoffChange bc;
-    bc.m_time = Simulator::Now ();
-    bc.m_nodeId = ContextToNodeId (context);
+    bc.m_time = Simulator::Now ().GetTimeStep ();
+    bc.m_nodeId = nodeId;
     bc.m_oldBackoff = oldVal;
     bc.m_newBackoff = newVal;
-    g_backoffChanges.push_back (bc);
+    g_backoffChanges->Write (bc);
 }
 
     void
-BeaconArrivalCb (std::string context, Time oldVal, Time newVal)
+BeaconArrivalCb (uint32_t nodeId, Time oldVal, Time newVal)
 {
     BeaconArrival ba;
-    ba.m_time = newVal;
-    ba.m_interval = newVal - oldVal;
-    ba.m_nodeId = ContextToNodeId (context);
-    g_beaconArrivals.push_back (ba);
+    ba.m_time = newVal.GetTimeStep ();
+    ba.m_interval = (newVal - oldVal).GetTimeStep ();
+    ba.m_nodeId = nodeId;
+    g_beaconArrivals->Write (ba);
 }
 
     void
-SignalTx (std::string context, uint32_t rate)
+SignalTx (uint32_t nodeId, uint32_t rate)
 {
     SignalTransmission tra;
-    tra.m_time = Simulator::Now();
-    tra.m_nodeId = ContextToNodeId (context);
+    tra.m_time = Simulator::Now ().GetTimeStep ();
+    tra.m_nodeId = nodeId;
     tra.m_rate = rate;
-    g_transmissions.push_back (tra);
+    g_transmissions->Write (tra);
 
 }
 
     void
-SignalCb (std::string context, bool wifi, uint32_t senderNodeId, double rxPowerDbm, Time rxDuration)
+SignalCb (uint32_t nodeId, bool wifi, uint32_t senderNodeId, double rxPowerDbm, Time rxDuration)
 {
     SignalArrival arr;
-    arr.m_time = Simulator::Now();
-    arr.m_duration = rxDuration;
-    arr.m_nodeId = ContextToNodeId (context);
+    arr.m_time = Simulator::Now ().GetTimeStep ();
+    arr.m_duration = rxDuration.GetTimeStep ();
+    arr.m_nodeId = nodeId;
     arr.m_senderNodeId = senderNodeId;
     arr.m_wifi = wifi;
     arr.m_power = rxPowerDbm;
-    g_arrivals.push_back (arr);
+    g_arrivals->Write (arr);
 
-    UintegerValue uintegerValue;
-    GlobalValue::GetValueByName ("logPhyNodeId", uintegerValue);
-    if ((uintegerValue.Get () == UINT32_MAX || uintegerValue.Get () == arr.m_nodeId) && !wifi)
+    if ((g_phyLogNodeId == UINT32_MAX || g_phyLogNodeId == nodeId) && !wifi)
     {
-        UintegerValue uintegerValue;
-        GlobalValue::GetValueByName ("logTxopNodeId", uintegerValue);
-        if  (uintegerValue.Get () == arr.m_senderNodeId)
+        if  (g_txopLogNodeId == senderNodeId)
         {
             g_arrivalsDurationCounter += rxDuration.GetSeconds();
         }
     }
 
-    NS_LOG_DEBUG (context << " " << wifi << " " << senderNodeId << " " << rxPowerDbm << " " << rxDuration.GetSeconds ()/1000.0);
+    NS_LOG_DEBUG (nodeId << " " << wifi << " " << senderNodeId << " " << rxPowerDbm << " " << rxDuration.GetSeconds ()/1000.0);
 }
 
     void
-TxopReceived (std::string context, Time startTime, Time duration, Time nextSubframeStarts)
+TxopReceived (uint32_t nodeId, Time startTime, Time duration, Time nextSubframeStarts)
 {
     TxopLog txopLog;
-    txopLog.m_time = Simulator::Now();
-    txopLog.m_duration = duration;
-    txopLog.m_nodeId = ContextToNodeId (context);
-    g_txopLogs.push_back (txopLog);
+    txopLog.m_time = Simulator::Now ().GetTimeStep ();
+    txopLog.m_duration = duration.GetTimeStep ();
+    txopLog.m_nodeId = nodeId;
+    g_txopLogs->Write (txopLog);
 
-    UintegerValue uintegerValue;
-    GlobalValue::GetValueByName ("logTxopNodeId", uintegerValue);
-    if  (uintegerValue.Get () == txopLog.m_nodeId)
+    if  (g_txopLogNodeId == nodeId)
     {
         g_txopDurationCounter += duration.GetSeconds();
     }
-    NS_LOG_DEBUG (context <<" " << txopLog.m_nodeId << " " << txopLog.m_time << " " << txopLog.m_duration.GetSeconds());
+    NS_LOG_DEBUG (nodeId << " " << Simulator::Now () << " " << duration.GetSeconds());
 }
 
     void
-LteDataTxCallback (std::string context, uint32_t bytes)
+LteDataTxCallback (uint32_t nodeId, uint32_t bytes)
 {
     DataTx dataTxLog;
-    dataTxLog.m_time = Simulator::Now();
-    dataTxLog.m_nodeId = ContextToNodeId (context);
+    dataTxLog.m_time = Simulator::Now ().GetTimeStep ();
+    dataTxLog.m_nodeId = nodeId;
     dataTxLog.m_size = bytes;
-    g_dataTxLogs.push_back(dataTxLog);
+    g_dataTxLogs->Write (dataTxLog);
 }
 
 
     void
-HarqFeedbackReceived (std::string context, std::vector<DlInfoListElement_s> m_dlInfoListReceived)
+HarqFeedbackReceived (uint32_t nodeId, std::vector<DlInfoListElement_s> m_dlInfoListReceived)
 {
     HarqFeedbackLog harq;
-    harq.m_time = Simulator::Now();
-    harq.m_nodeId = ContextToNodeId(context);
+    harq.m_time = Simulator::Now ().GetTimeStep ();
+    harq.m_nodeId = nodeId;
 
+    uint32_t ackCounter = 0;
     uint32_t nackCounter = 0;
-    std::vector<uint8_t> harqFeedback;
     for (uint16_t i = 0; i < m_dlInfoListReceived.size(); i++)
     {
         for (uint8_t layer = 0; layer < m_dlInfoListReceived.at(i).m_harqStatus.size (); layer++)
         {
             if (m_dlInfoListReceived.at(i).m_harqStatus.at(layer) == DlInfoListElement_s::ACK)
             {
-                harqFeedback.push_back(0);
-                harq.m_ueId.push_back(m_dlInfoListReceived.at(i).m_rnti);
+                ackCounter++;
             }
             else if (m_dlInfoListReceived.at(i).m_harqStatus.at(layer) == DlInfoListElement_s::NACK)
             {
-                harqFeedback.push_back(1);
                 nackCounter++;
-                harq.m_ueId.push_back(m_dlInfoListReceived.at(i).m_rnti);
             }
         }
     }
 
-    if (harqFeedback.size())
-        harq.m_ackCount = harqFeedback.size() - nackCounter;
-    else
-        harq.m_ackCount = 0;
+    harq.m_ackCount = ackCounter;
     harq.m_nackCount = nackCounter;
-    g_harqFeedbacks.push_back(harq);
-    NS_LOG_DEBUG (context << " " << harq.m_nodeId << " " << nackCounter << " " << harqFeedback.size() - nackCounter);
+    g_harqFeedbacks->Write (harq);
+    NS_LOG_DEBUG (nodeId << " " << nackCounter << " " << ackCounter);
+}
+
+// Connect (or disconnect) a sink to the trace source named by the last
+// element of a Config path, on every object matching the rest of the
+// path, binding the id of the node of each object to the first sink
+// argument; the node id is parsed from the matched path only once here
+// instead of from the context string of every trace event
+template <typename SINK>
+    void
+ConnectWithNodeId (std::string path, SINK sink, bool connect)
+{
+    std::string::size_type pos = path.rfind ('/');
+    std::string traceSource = path.substr (pos + 1);
+    Config::MatchContainer matches = Config::LookupMatches (path.substr (0, pos));
+    for (uint32_t i = 0; i < matches.GetN (); i++)
+    {
+        uint32_t nodeId = ContextToNodeId (matches.GetMatchedPath (i));
+        if (connect)
+        {
+            matches.Get (i)->TraceConnectWithoutContext (traceSource, MakeBoundCallback (sink, nodeId));
+        }
+        else
+        {
+            matches.Get (i)->TraceDisconnectWithoutContext (traceSource, MakeBoundCallback (sink, nodeId));
+        }
+    }
+}
+
+// Connect (or disconnect) the signal arrival log to the energy detection
+// PHYs which replace the monitoring SpectrumWifiPhy of the eNBs sensing
+// the channel in the ED mode, and which no Config path reaches
+    void
+EnergyDetectionSignalConnect (bool connect)
+{
+    for (NodeList::Iterator n = NodeList::Begin (); n != NodeList::End (); ++n)
+    {
+        for (uint32_t i = 0; i < (*n)->GetNDevices (); i++)
+        {
+            Ptr<LteEnbNetDevice> lteEnbNetDevice = DynamicCast<LteEnbNetDevice> ((*n)->GetDevice (i));
+            if (lteEnbNetDevice == 0)
+            {
+                continue;
+            }
+            Ptr<LbtAccessManager> lbtAccessManager = DynamicCast<LbtAccessManager> (lteEnbNetDevice->GetPhy ()->GetChannelAccessManager ());
+            if (lbtAccessManager == 0 || lbtAccessManager->GetEnergyDetectionPhy () == 0)
+            {
+                continue;
+            }
+            if (connect)
+            {
+                lbtAccessManager->GetEnergyDetectionPhy ()->TraceConnectWithoutContext ("SignalArrival", MakeBoundCallback (&SignalCb, (*n)->GetId ()));
+            }
+            else
+            {
+                lbtAccessManager->GetEnergyDetectionPhy ()->TraceDisconnectWithoutContext ("SignalArrival", MakeBoundCallback (&SignalCb, (*n)->GetId ()));
+            }
+        }
+    }
 }
 
     void
@@ -760,8 +843,8 @@ CwChangeConnect (Ptr<NetDevice> lteEnbNetDevice)
 {
     Ptr<LbtAccessManager> lbtAccessManager = DynamicCast<LbtAccessManager>(lteEnbNetDevice->GetObject<LteEnbNetDevice>()->GetPhy()->GetChannelAccessManager());
     NS_ASSERT_MSG(lbtAccessManager!=0, "LbtAccessManager does not exist");
-    std::string context = NodeIdToContext (lteEnbNetDevice->GetNode ()->GetId ());
-    bool success = lbtAccessManager->TraceConnect("Cw", context, MakeCallback(&CwChangeCb));
+    uint32_t nodeId = lteEnbNetDevice->GetNode ()->GetId ();
+    bool success = lbtAccessManager->TraceConnectWithoutContext("Cw", MakeBoundCallback(&CwChangeCb, nodeId));
     NS_ASSERT (success);
 }
 
@@ -770,8 +853,8 @@ CwChangeDisconnect (Ptr<NetDevice> lteEnbNetDevice)
 {
     Ptr<LbtAccessManager> lbtAccessManager = DynamicCast<LbtAccessManager>(lteEnbNetDevice->GetObject<LteEnbNetDevice>()->GetPhy()->GetChannelAccessManager());
     NS_ASSERT_MSG(lbtAccessManager!=0, "LbtAccessManager does not exist");
-    std::string context = NodeIdToContext (lteEnbNetDevice->GetNode ()->GetId ());
-    bool success = lbtAccessManager->TraceDisconnect("Cw", context, MakeCallback(&CwChangeCb));
+    uint32_t nodeId = lteEnbNetDevice->GetNode ()->GetId ();
+    bool success = lbtAccessManager->TraceDisconnectWithoutContext("Cw", MakeBoundCallback(&CwChangeCb, nodeId));
     NS_ASSERT (success);
 }
 
@@ -780,8 +863,8 @@ BackoffChangeConnect (Ptr<NetDevice> lteEnbNetDevice)
 {
     Ptr<LbtAccessManager> lbtAccessManager = DynamicCast<LbtAccessManager>(lteEnbNetDevice->GetObject<LteEnbNetDevice>()->GetPhy()->GetChannelAccessManager());
     NS_ASSERT_MSG(lbtAccessManager!=0, "LbtAccessManager does not exist");
-    std::string context = NodeIdToContext (lteEnbNetDevice->GetNode ()->GetId ());
-    bool success = lbtAccessManager->TraceConnect("Backoff", context, MakeCallback(&BackoffChangeCb));
+    uint32_t nodeId = lteEnbNetDevice->GetNode ()->GetId ();
+    bool success = lbtAccessManager->TraceConnectWithoutContext("Backoff", MakeBoundCallback(&BackoffChangeCb, nodeId));
     NS_ASSERT (success);
 }
 
@@ -790,8 +873,8 @@ BackoffChangeDisconnect (Ptr<NetDevice> lteEnbNetDevice)
 {
     Ptr<LbtAccessManager> lbtAccessManager = DynamicCast<LbtAccessManager>(lteEnbNetDevice->GetObject<LteEnbNetDevice>()->GetPhy()->GetChannelAccessManager());
     NS_ASSERT_MSG(lbtAccessManager!=0, "LbtAccessManager does not exist");
-    std::string context = NodeIdToContext (lteEnbNetDevice->GetNode ()->GetId ());
-    bool success = lbtAccessManager->TraceDisconnect("Backoff", context, MakeCallback(&BackoffChangeCb));
+    uint32_t nodeId = lteEnbNetDevice->GetNode ()->GetId ();
+    bool success = lbtAccessManager->TraceDisconnectWithoutContext("Backoff", MakeBoundCallback(&BackoffChangeCb, nodeId));
     NS_ASSERT (success);
 }
 
@@ -800,8 +883,8 @@ HarqFeedbackConnect (Ptr<NetDevice> lteEnbNetDevice)
 {
     Ptr<LteEnbMac> lteEnbMac = lteEnbNetDevice->GetObject<LteEnbNetDevice>()->GetMac();
     NS_ASSERT_MSG(lteEnbMac!=0, "lteEnbMac does not exist");
-    std::string context = NodeIdToContext (lteEnbNetDevice->GetNode ()->GetId ());
-    bool success = lteEnbMac->TraceConnect("DlHarqFeedback", context, MakeCallback(&HarqFeedbackReceived));
+    uint32_t nodeId = lteEnbNetDevice->GetNode ()->GetId ();
+    bool success = lteEnbMac->TraceConnectWithoutContext("DlHarqFeedback", MakeBoundCallback(&HarqFeedbackReceived, nodeId));
     NS_ASSERT (success);
 }
 
@@ -810,126 +893,136 @@ HarqFeedbackDisconnect (Ptr<NetDevice> lteEnbNetDevice)
 {
     Ptr<LteEnbMac> lteEnbMac = lteEnbNetDevice->GetObject<LteEnbNetDevice>()->GetMac();
     NS_ASSERT_MSG(lteEnbMac!=0, "lteEnbMac does not exist");
-    std::string context = NodeIdToContext (lteEnbNetDevice->GetNode ()->GetId ());
-    bool success = lteEnbMac->TraceDisconnect("DlHarqFeedback", context, MakeCallback(&HarqFeedbackReceived));
+    uint32_t nodeId = lteEnbNetDevice->GetNode ()->GetId ();
+    bool success = lteEnbMac->TraceDisconnectWithoutContext("DlHarqFeedback", MakeBoundCallback(&HarqFeedbackReceived, nodeId));
     NS_ASSERT (success);
 }
 
     void
 ScheduleWifiBackoffLogConnect (void)
 {
-    Config::Connect ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Mac/$ns3::ApWifiMac/BE_EdcaTxopN/$ns3::EdcaTxopN/BackoffTrace", MakeCallback (&BackoffChangeCb));
-    Config::Connect ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Mac/$ns3::StaWifiMac/BE_EdcaTxopN/$ns3::EdcaTxopN/BackoffTrace", MakeCallback (&BackoffChangeCb));
+    ConnectWithNodeId ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Mac/$ns3::ApWifiMac/BE_EdcaTxopN/$ns3::EdcaTxopN/BackoffTrace", &BackoffChangeCb, true);
+    ConnectWithNodeId ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Mac/$ns3::StaWifiMac/BE_EdcaTxopN/$ns3::EdcaTxopN/BackoffTrace", &BackoffChangeCb, true);
 }
 
     void
 ScheduleWifiBackoffLogDisconnect (void)
 {
-    Config::Disconnect ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Mac/$ns3::ApWifiMac/BE_EdcaTxopN/$ns3::EdcaTxopN/BackoffTrace", MakeCallback (&BackoffChangeCb));
-    Config::Disconnect ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Mac/$ns3::StaWifiMac/BE_EdcaTxopN/$ns3::EdcaTxopN/BackoffTrace", MakeCallback (&BackoffChangeCb));
+    ConnectWithNodeId ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Mac/$ns3::ApWifiMac/BE_EdcaTxopN/$ns3::EdcaTxopN/BackoffTrace", &BackoffChangeCb, false);
+    ConnectWithNodeId ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Mac/$ns3::StaWifiMac/BE_EdcaTxopN/$ns3::EdcaTxopN/BackoffTrace", &BackoffChangeCb, false);
 }
 
     void
 ScheduleCwChangesLogConnect (void)
 {
-    Config::Connect ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Mac/$ns3::AdhocWifiMac/BE_EdcaTxopN/$ns3::EdcaTxopN/CwTrace", MakeCallback (&CwChangeCb));
-    Config::Connect ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Mac/$ns3::ApWifiMac/BE_EdcaTxopN/$ns3::EdcaTxopN/CwTrace", MakeCallback (&CwChangeCb));
-    Config::Connect ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Mac/$ns3::StaWifiMac/BE_EdcaTxopN/$ns3::EdcaTxopN/CwTrace", MakeCallback (&CwChangeCb));
+    ConnectWithNodeId ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Mac/$ns3::AdhocWifiMac/BE_EdcaTxopN/$ns3::EdcaTxopN/CwTrace", &CwChangeCb, true);
+    ConnectWithNodeId ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Mac/$ns3::ApWifiMac/BE_EdcaTxopN/$ns3::EdcaTxopN/CwTrace", &CwChangeCb, true);
+    ConnectWithNodeId ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Mac/$ns3::StaWifiMac/BE_EdcaTxopN/$ns3::EdcaTxopN/CwTrace", &CwChangeCb, true);
 }
 
     void
 ScheduleCwChangesLogDisconnect (void)
 {
-    Config::Disconnect ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Mac/$ns3::AdhocWifiMac/BE_EdcaTxopN/$ns3::EdcaTxopN/CwTrace", MakeCallback (&CwChangeCb));
-    Config::Disconnect ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Mac/$ns3::ApWifiMac/BE_EdcaTxopN/$ns3::EdcaTxopN/CwTrace", MakeCallback (&CwChangeCb));
-    Config::Disconnect ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Mac/$ns3::StaWifiMac/BE_EdcaTxopN/$ns3::EdcaTxopN/CwTrace", MakeCallback (&CwChangeCb));
+    ConnectWithNodeId ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Mac/$ns3::AdhocWifiMac/BE_EdcaTxopN/$ns3::EdcaTxopN/CwTrace", &CwChangeCb, false);
+    ConnectWithNodeId ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Mac/$ns3::ApWifiMac/BE_EdcaTxopN/$ns3::EdcaTxopN/CwTrace", &CwChangeCb, false);
+    ConnectWithNodeId ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Mac/$ns3::StaWifiMac/BE_EdcaTxopN/$ns3::EdcaTxopN/CwTrace", &CwChangeCb, false);
 }
 
     void
 ScheduleWifiFailRetriesLogConnect (void)
 {
-    Config::Connect ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/RemoteStationManager/MacTxFinalDataFailed", MakeCallback (&WifiFailRetriesCb));
+    ConnectWithNodeId ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/RemoteStationManager/MacTxFinalDataFailed", &WifiFailRetriesCb, true);
 }
 
     void
 ScheduleWifiFailRetriesLogDisconnect (void)
 {
-    Config::Disconnect ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/RemoteStationManager/MacTxFinalDataFailed", MakeCallback (&WifiFailRetriesCb));
+    ConnectWithNodeId ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/RemoteStationManager/MacTxFinalDataFailed", &WifiFailRetriesCb, false);
 }
 
     void
 ScheduleWifiRetriesLogConnect (void)
 {
-    Config::Connect ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/RemoteStationManager/MacTxDataFailed", MakeCallback (&WifiRetriesCb));
+    ConnectWithNodeId ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/RemoteStationManager/MacTxDataFailed", &WifiRetriesCb, true);
 }
 
     void
 ScheduleWifiRetriesLogDisconnect (void)
 {
-    Config::Disconnect ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/RemoteStationManager/MacTxDataFailed", MakeCallback (&WifiRetriesCb));
+    ConnectWithNodeId ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/RemoteStationManager/MacTxDataFailed", &WifiRetriesCb, false);
 }
 
     void
 ScheduleTxPhyLogConnect (void)
 {
-    Config::Connect ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Phy/$ns3::SpectrumWifiPhy/SignalTransmission", MakeCallback (&SignalTx));
-    Config::Connect ("/NodeList/*/DeviceList/*/$ns3::LteNetDevice/$ns3::LteEnbNetDevice/LteEnbPhy/SignalTransmission", MakeCallback (&SignalTx));
+    ConnectWithNodeId ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Phy/$ns3::SpectrumWifiPhy/SignalTransmission", &SignalTx, true);
+    ConnectWithNodeId ("/NodeList/*/DeviceList/*/$ns3::LteNetDevice/$ns3::LteEnbNetDevice/LteEnbPhy/SignalTransmission", &SignalTx, true);
 }
 
     void
 ScheduleTxPhyLogDisconnect (void)
 {
-    Config::Disconnect ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Phy/$ns3::SpectrumWifiPhy/SignalTransmission", MakeCallback (&SignalTx));
-    Config::Disconnect ("/NodeList/*/DeviceList/*/$ns3::LteNetDevice/$ns3::LteEnbNetDevice/LteEnbPhy/SignalTransmission", MakeCallback (&SignalTx));
+    ConnectWithNodeId ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Phy/$ns3::SpectrumWifiPhy/SignalTransmission", &SignalTx, false);
+    ConnectWithNodeId ("/NodeList/*/DeviceList/*/$ns3::LteNetDevice/$ns3::LteEnbNetDevice/LteEnbPhy/SignalTransmission", &SignalTx, false);
 }
 
 
     void
 SchedulePhyLogConnect (void)
 {
-    Config::Connect ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Phy/$ns3::SpectrumWifiPhy/SignalArrival", MakeCallback (&SignalCb));
+    UintegerValue uintegerValue;
+    GlobalValue::GetValueByName ("logPhyNodeId", uintegerValue);
+    g_phyLogNodeId = uintegerValue.Get ();
+    GlobalValue::GetValueByName ("logTxopNodeId", uintegerValue);
+    g_txopLogNodeId = uintegerValue.Get ();
+    ConnectWithNodeId ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Phy/$ns3::SpectrumWifiPhy/SignalArrival", &SignalCb, true);
+    EnergyDetectionSignalConnect (true);
 }
 
     void
 SchedulePhyLogDisconnect (void)
 {
-    Config::Disconnect ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Phy/$ns3::SpectrumWifiPhy/SignalArrival", MakeCallback (&SignalCb));
+    ConnectWithNodeId ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Phy/$ns3::SpectrumWifiPhy/SignalArrival", &SignalCb, false);
+    EnergyDetectionSignalConnect (false);
 }
 
     void
 ScheduleTxopLogConnect (void)
 {
-    Config::Connect ("/NodeList/*/DeviceList/*/$ns3::LteNetDevice/$ns3::LteEnbNetDevice/LteEnbPhy/Txop", MakeCallback (&TxopReceived));
+    UintegerValue uintegerValue;
+    GlobalValue::GetValueByName ("logTxopNodeId", uintegerValue);
+    g_txopLogNodeId = uintegerValue.Get ();
+    ConnectWithNodeId ("/NodeList/*/DeviceList/*/$ns3::LteNetDevice/$ns3::LteEnbNetDevice/LteEnbPhy/Txop", &TxopReceived, true);
 }
 
     void
 ScheduleTxopLogDisconnect (void)
 {
-    Config::Disconnect ("/NodeList/*/DeviceList/*/$ns3::LteNetDevice/$ns3::LteEnbNetDevice/LteEnbPhy/Txop", MakeCallback (&TxopReceived));
+    ConnectWithNodeId ("/NodeList/*/DeviceList/*/$ns3::LteNetDevice/$ns3::LteEnbNetDevice/LteEnbPhy/Txop", &TxopReceived, false);
 }
 
     void
 ScheduleDataTxConnect (void)
 {
-    Config::Connect ("/NodeList/*/DeviceList/*/LteEnbPhy/DataSent", MakeCallback (&LteDataTxCallback));
+    ConnectWithNodeId ("/NodeList/*/DeviceList/*/LteEnbPhy/DataSent", &LteDataTxCallback, true);
 }
 
     void
 ScheduleDataTxDisconnect (void)
 {
-    Config::Disconnect ("/NodeList/*/DeviceList/*/LteEnbPhy/DataSent", MakeCallback (&LteDataTxCallback));
+    ConnectWithNodeId ("/NodeList/*/DeviceList/*/LteEnbPhy/DataSent", &LteDataTxCallback, false);
 }
 
     void
 ScheduleBeaconLogConnect (void)
 {
-    Config::Connect ("/NodeList/*/DeviceList/*/Mac/$ns3::StaWifiMac/BeaconArrival", MakeCallback (&BeaconArrivalCb));
+    ConnectWithNodeId ("/NodeList/*/DeviceList/*/Mac/$ns3::StaWifiMac/BeaconArrival", &BeaconArrivalCb, true);
 }
 
     void
 ScheduleBeaconLogDisconnect (void)
 {
-    Config::Disconnect ("/NodeList/*/DeviceList/*/Mac/$ns3::StaWifiMac/BeaconArrival", MakeCallback (&BeaconArrivalCb));
+    ConnectWithNodeId ("/NodeList/*/DeviceList/*/Mac/$ns3::StaWifiMac/BeaconArrival", &BeaconArrivalCb, false);
 }
 
     void
@@ -1054,7 +1147,7 @@ struct FlowRecord
 
 
     void
-SaveSpectrumTxPhyStats (std::string filename, const std::vector<SignalTransmission> &transmissions)
+SaveSpectrumTxPhyStats (std::string filename, BinaryTraceReader &reader)
 {
     std::ofstream outFile;
     outFile.open (filename.c_str (), std::ofstream::out | std::ofstream::app);
@@ -1068,20 +1161,21 @@ SaveSpectrumTxPhyStats (std::string filename, const std::vector<SignalTransmissi
         return;
     }
     outFile << "#time(s) nodeId rate(Kbps)" << std::endl;
-    for (std::vector<SignalTransmission>::size_type i = 0; i != transmissions.size (); i++)
+    SignalTransmission entry;
+    while (reader.Read (entry))
     {
-        if (uintegerValue.Get () == UINT32_MAX || uintegerValue.Get () == transmissions[i].m_nodeId)
+        if (uintegerValue.Get () == UINT32_MAX || uintegerValue.Get () == entry.m_nodeId)
         {
-            outFile << std::setprecision (9) << std::fixed << transmissions[i].m_time.GetSeconds () <<  " ";
-            outFile << transmissions[i].m_nodeId << " ";
-            outFile << transmissions[i].m_rate << std::endl;
+            outFile << std::setprecision (9) << std::fixed << TimeStep (entry.m_time).GetSeconds () <<  " ";
+            outFile << entry.m_nodeId << " ";
+            outFile << entry.m_rate << std::endl;
         }
     }
     outFile.close ();
 }
 
     void
-SaveSpectrumPhyStats (std::string filename, const std::vector<SignalArrival> &arrivals)
+SaveSpectrumPhyStats (std::string filename, BinaryTraceReader &reader)
 {
     std::ofstream outFile;
     outFile.open (filename.c_str (), std::ofstream::out | std::ofstream::app);
@@ -1095,23 +1189,24 @@ SaveSpectrumPhyStats (std::string filename, const std::vector<SignalArrival> &ar
         return;
     }
     outFile << "#time(s) nodeId type sender endTime(s) duration(ms)     powerDbm" << std::endl;
-    for (std::vector<SignalArrival>::size_type i = 0; i != arrivals.size (); i++)
+    SignalArrival entry;
+    while (reader.Read (entry))
     {
-        if (uintegerValue.Get () == UINT32_MAX || uintegerValue.Get () == arrivals[i].m_nodeId)
+        if (uintegerValue.Get () == UINT32_MAX || uintegerValue.Get () == entry.m_nodeId)
         {
-            outFile << std::setprecision (9) << std::fixed << arrivals[i].m_time.GetSeconds () <<  " ";
-            outFile << arrivals[i].m_nodeId << " ";
-            outFile << ((arrivals[i].m_wifi == true) ? "wifi " : " lte ");
-            outFile << arrivals[i].m_senderNodeId << " ";
-            outFile <<  arrivals[i].m_time.GetSeconds () + arrivals[i].m_duration.GetSeconds () << " ";
-            outFile << arrivals[i].m_duration.GetSeconds () * 1000.0 << " " << arrivals[i].m_power << std::endl;
+            outFile << std::setprecision (9) << std::fixed << TimeStep (entry.m_time).GetSeconds () <<  " ";
+            outFile << entry.m_nodeId << " ";
+            outFile << ((entry.m_wifi != 0) ? "wifi " : " lte ");
+            outFile << entry.m_senderNodeId << " ";
+            outFile <<  TimeStep (entry.m_time).GetSeconds () + TimeStep (entry.m_duration).GetSeconds () << " ";
+            outFile << TimeStep (entry.m_duration).GetSeconds () * 1000.0 << " " << entry.m_power << std::endl;
         }
     }
     outFile.close ();
 }
 
     void
-SaveTxopStats (std::string filename, const std::vector<TxopLog> &txopLogs)
+SaveTxopStats (std::string filename, BinaryTraceReader &reader)
 {
     std::ofstream outFile;
     outFile.open (filename.c_str (), std::ofstream::out | std::ofstream::app);
@@ -1125,21 +1220,22 @@ SaveTxopStats (std::string filename, const std::vector<TxopLog> &txopLogs)
         return;
     }
     outFile << "#time(s) nodeId endTime(s) duration(ms)" << std::endl;
-    for (std::vector<TxopLog>::size_type i = 0; i != txopLogs.size (); i++)
+    TxopLog entry;
+    while (reader.Read (entry))
     {
-        if (uintegerValue.Get () == UINT32_MAX || uintegerValue.Get () == txopLogs[i].m_nodeId)
+        if (uintegerValue.Get () == UINT32_MAX || uintegerValue.Get () == entry.m_nodeId)
         {
-            outFile << std::setprecision (9) << std::fixed << txopLogs[i].m_time.GetSeconds () <<  " ";
-            outFile << txopLogs[i].m_nodeId << " ";
-            outFile << txopLogs[i].m_time.GetSeconds () + txopLogs[i].m_duration.GetSeconds () << " ";
-            outFile << txopLogs[i].m_duration.GetSeconds () * 1000.0 << " " << std::endl;
+            outFile << std::setprecision (9) << std::fixed << TimeStep (entry.m_time).GetSeconds () <<  " ";
+            outFile << entry.m_nodeId << " ";
+            outFile << TimeStep (entry.m_time).GetSeconds () + TimeStep (entry.m_duration).GetSeconds () << " ";
+            outFile << TimeStep (entry.m_duration).GetSeconds () * 1000.0 << " " << std::endl;
         }
     }
     outFile.close ();
 }
 
     void
-SaveDataTxStats (std::string filename, const std::vector<DataTx> &dataTxLogs)
+SaveDataTxStats (std::string filename, BinaryTraceReader &reader)
 {
     std::ofstream outFile;
     outFile.open (filename.c_str (), std::ofstream::out | std::ofstream::app);
@@ -1153,20 +1249,21 @@ SaveDataTxStats (std::string filename, const std::vector<DataTx> &dataTxLogs)
         return;
     }
     outFile << "#time(s) nodeId endTime(s) duration(ms)" << std::endl;
-    for (std::vector<DataTx>::size_type i = 0; i != dataTxLogs.size (); i++)
+    DataTx entry;
+    while (reader.Read (entry))
     {
-        if (uintegerValue.Get () == UINT32_MAX || uintegerValue.Get () == dataTxLogs[i].m_nodeId)
+        if (uintegerValue.Get () == UINT32_MAX || uintegerValue.Get () == entry.m_nodeId)
         {
-            outFile << std::setprecision (9) << std::fixed << dataTxLogs[i].m_time.GetSeconds () <<  " ";
-            outFile << dataTxLogs[i].m_nodeId << " ";
-            outFile << dataTxLogs[i].m_size << " " << std::endl;
+            outFile << std::setprecision (9) << std::fixed << TimeStep (entry.m_time).GetSeconds () <<  " ";
+            outFile << entry.m_nodeId << " ";
+            outFile << entry.m_size << " " << std::endl;
         }
     }
     outFile.close ();
 }
 
     void
-SaveCwStats (std::string filename, const std::vector<CwChange> &changes)
+SaveCwStats (std::string filename, BinaryTraceReader &reader)
 {
     std::ofstream outFile;
     outFile.open (filename.c_str (), std::ofstream::out | std::ofstream::app);
@@ -1179,20 +1276,21 @@ SaveCwStats (std::string filename, const std::vector<CwChange> &changes)
     }
     outFile.setf (std::ios_base::fixed);
     outFile << "#time(s) nodeId oldCw newCw" << std::endl;
-    for (std::vector<CwChange>::size_type i = 0; i != changes.size (); i++)
+    CwChange entry;
+    while (reader.Read (entry))
     {
-        if (uintegerValue.Get () == UINT32_MAX || uintegerValue.Get () == changes[i].m_nodeId)
+        if (uintegerValue.Get () == UINT32_MAX || uintegerValue.Get () == entry.m_nodeId)
         {
-            outFile << std::setprecision (9) << std::fixed << changes[i].m_time.GetSeconds () <<  " ";
-            outFile << changes[i].m_nodeId << " ";
-            outFile << changes[i].m_oldCw << " ";
-            outFile << changes[i].m_newCw << std::endl;
+            outFile << std::setprecision (9) << std::fixed << TimeStep (entry.m_time).GetSeconds () <<  " ";
+            outFile << entry.m_nodeId << " ";
+            outFile << entry.m_oldCw << " ";
+            outFile << entry.m_newCw << std::endl;
         }
     }
 }
 
     void
-SaveFailRetriesStats (std::string filename, const std::vector<WifiRetriesLog> &entries)
+SaveFailRetriesStats (std::string filename, BinaryTraceReader &reader)
 {
     std::ofstream outFile;
     outFile.open (filename.c_str (), std::ofstream::out | std::ofstream::app);
@@ -1205,19 +1303,22 @@ SaveFailRetriesStats (std::string filename, const std::vector<WifiRetriesLog> &e
     }
     outFile.setf (std::ios_base::fixed);
     outFile << "#time(s) nodeId dest" << std::endl;
-    for (std::vector<WifiRetriesLog>::size_type i = 0; i != entries.size (); i++)
+    WifiRetriesLog entry;
+    while (reader.Read (entry))
     {
-        //if (uintegerValue.Get () == UINT32_MAX || uintegerValue.Get () == entries[i].m_nodeId)
+        //if (uintegerValue.Get () == UINT32_MAX || uintegerValue.Get () == entry.m_nodeId)
         {
-            outFile << std::setprecision (9) << std::fixed << entries[i].m_time.GetSeconds () <<  " ";
-            outFile << entries[i].m_nodeId << " ";
-            outFile << entries[i].m_dest << std::endl;
+            outFile << std::setprecision (9) << std::fixed << TimeStep (entry.m_time).GetSeconds () <<  " ";
+            Mac48Address dest;
+            dest.CopyFrom (entry.m_dest);
+            outFile << entry.m_nodeId << " ";
+            outFile << dest << std::endl;
         }
     }
 }
 
     void
-SaveRetriesStats (std::string filename, const std::vector<WifiRetriesLog> &entries)
+SaveRetriesStats (std::string filename, BinaryTraceReader &reader)
 {
     std::ofstream outFile;
     outFile.open (filename.c_str (), std::ofstream::out | std::ofstream::app);
@@ -1230,19 +1331,22 @@ SaveRetriesStats (std::string filename, const std::vector<WifiRetriesLog> &entri
     }
     outFile.setf (std::ios_base::fixed);
     outFile << "#time(s) nodeId dest" << std::endl;
-    for (std::vector<WifiRetriesLog>::size_type i = 0; i != entries.size (); i++)
+    WifiRetriesLog entry;
+    while (reader.Read (entry))
     {
-        //if (uintegerValue.Get () == UINT32_MAX || uintegerValue.Get () == entries[i].m_nodeId)
+        //if (uintegerValue.Get () == UINT32_MAX || uintegerValue.Get () == entry.m_nodeId)
         {
-            outFile << std::setprecision (9) << std::fixed << entries[i].m_time.GetSeconds () <<  " ";
-            outFile << entries[i].m_nodeId << " ";
-            outFile << entries[i].m_dest << std::endl;
+            outFile << std::setprecision (9) << std::fixed << TimeStep (entry.m_time).GetSeconds () <<  " ";
+            Mac48Address dest;
+            dest.CopyFrom (entry.m_dest);
+            outFile << entry.m_nodeId << " ";
+            outFile << dest << std::endl;
         }
     }
 }
 
     void
-SaveVoiceStats (std::string filename, NodeContainer nodes, const std::vector<VoiceRxLog> &entries)
+SaveVoiceStats (std::string filename, BinaryTraceReader &reader)
 {
     std::ofstream outFile;
     outFile.open (filename.c_str (), std::ofstream::out | std::ofstream::app);
@@ -1253,16 +1357,14 @@ SaveVoiceStats (std::string filename, NodeContainer nodes, const std::vector<Voi
     }
     outFile.setf (std::ios_base::fixed);
     outFile << "#time(s) nodeId seqno dest" << std::endl;
-    for (std::vector<VoiceRxLog>::size_type i = 0; i != entries.size (); i++)
+    VoiceRxLog entry;
+    while (reader.Read (entry))
     {
-        if (nodes.Contains (entries[i].m_nodeId))
-        {
-            outFile << std::setprecision (9) << std::fixed << entries[i].m_time.GetSeconds () <<  " ";
-            outFile << entries[i].m_nodeId << " ";
-            outFile << entries[i].m_seqno << " ";
-            // milliseconds
-            outFile << (1000 * entries[i].m_latency) << std::endl;
-        }
+        outFile << std::setprecision (9) << std::fixed << TimeStep (entry.m_time).GetSeconds () <<  " ";
+        outFile << entry.m_nodeId << " ";
+        outFile << entry.m_seqno << " ";
+        // milliseconds
+        outFile << (1000 * entry.m_latency) << std::endl;
     }
 }
 
@@ -1327,7 +1429,7 @@ SaveVoiceSummaryStats (std::string filename, NodeContainer nodes)
 }
 
     void
-SaveBackoffStats (std::string filename, const std::vector<BackoffChange> &changes)
+SaveBackoffStats (std::string filename, BinaryTraceReader &reader)
 {
     std::ofstream outFile;
     outFile.open (filename.c_str (), std::ofstream::out | std::ofstream::app);
@@ -1340,20 +1442,21 @@ SaveBackoffStats (std::string filename, const std::vector<BackoffChange> &change
     }
     outFile.setf (std::ios_base::fixed);
     outFile << "#time(s) nodeId oldBackoff newBackoff" << std::endl;
-    for (std::vector<BackoffChange>::size_type i = 0; i != changes.size (); i++)
+    BackoffChange entry;
+    while (reader.Read (entry))
     {
-        if (uintegerValue.Get () == UINT32_MAX || uintegerValue.Get () == changes[i].m_nodeId)
+        if (uintegerValue.Get () == UINT32_MAX || uintegerValue.Get () == entry.m_nodeId)
         {
-            outFile << std::setprecision (9) << std::fixed << changes[i].m_time.GetSeconds () <<  " ";
-            outFile << changes[i].m_nodeId << " ";
-            outFile << changes[i].m_oldBackoff << " ";
-            outFile << changes[i].m_newBackoff << std::endl;
+            outFile << std::setprecision (9) << std::fixed << TimeStep (entry.m_time).GetSeconds () <<  " ";
+            outFile << entry.m_nodeId << " ";
+            outFile << entry.m_oldBackoff << " ";
+            outFile << entry.m_newBackoff << std::endl;
         }
     }
 }
 
     void
-SaveHarqFeedbacksStats (std::string filename, const std::vector<HarqFeedbackLog> &harqs)
+SaveHarqFeedbacksStats (std::string filename, BinaryTraceReader &reader)
 {
     std::ofstream outFile;
     outFile.open (filename.c_str (), std::ofstream::out | std::ofstream::app);
@@ -1366,37 +1469,34 @@ SaveHarqFeedbacksStats (std::string filename, const std::vector<HarqFeedbackLog>
     }
     outFile.setf (std::ios_base::fixed);
     outFile << "#time(s) nodeId acks nacks" << std::endl;
-    for (std::vector<HarqFeedbackLog>::size_type i = 0; i != harqs.size (); i++)
+    HarqFeedbackLog entry;
+    while (reader.Read (entry))
     {
-        if (uintegerValue.Get () == UINT32_MAX || uintegerValue.Get () == harqs[i].m_nodeId)
+        if (uintegerValue.Get () == UINT32_MAX || uintegerValue.Get () == entry.m_nodeId)
         {
-            outFile << std::setprecision (9) << std::fixed << harqs[i].m_time.GetSeconds () <<  " ";
-            outFile << harqs[i].m_nodeId << " ";
-            outFile << harqs[i].m_ackCount << " ";
-            outFile << harqs[i].m_nackCount << " ";
+            outFile << std::setprecision (9) << std::fixed << TimeStep (entry.m_time).GetSeconds () <<  " ";
+            outFile << entry.m_nodeId << " ";
+            outFile << entry.m_ackCount << " ";
+            outFile << entry.m_nackCount << " ";
 
-            if ((harqs[i].m_ackCount + harqs[i].m_nackCount)>0)
+            if ((entry.m_ackCount + entry.m_nackCount)>0)
             {
-                outFile <<std::setprecision(2)<<((double)harqs[i].m_nackCount/(double)(harqs[i].m_ackCount + harqs[i].m_nackCount))*100 <<"%";
+                outFile <<std::setprecision(2)<<((double)entry.m_nackCount/(double)(entry.m_ackCount + entry.m_nackCount))*100 <<"%";
             }
             else
             {
                 outFile <<"0";
             }
         }
-        /* It is possible to print RNTI of UEs that have reported harq feedback by enabling this code.
-         * Currently is disabled because it is easier to parse files when all rows have the same number of columns.
-         for(std::vector<uint32_t>::size_type j=0; j != harqs[i].m_ueId.size(); j++)
-         {
-         outFile<<" "<<harqs[i].m_ueId[j]<<" ";
-         }
-         */
+        // The RNTIs of the UEs that have reported harq feedback are not
+        // logged, it is easier to parse files when all rows have the same
+        // number of columns.
         outFile<<std::endl;
     }
 }
 
     void
-SaveBeaconStats (std::string filename, const std::vector<BeaconArrival> &arrivals)
+SaveBeaconStats (std::string filename, BinaryTraceReader &reader)
 {
     std::ofstream outFile;
     outFile.open (filename.c_str (), std::ofstream::out | std::ofstream::app);
@@ -1410,15 +1510,116 @@ SaveBeaconStats (std::string filename, const std::vector<BeaconArrival> &arrival
         return;
     }
     outFile << "#time(s)   interval(s) nodeId" << std::endl;
-    for (std::vector<BeaconArrival>::size_type i = 0; i != arrivals.size (); i++)
+    BeaconArrival entry;
+    while (reader.Read (entry))
+    {
+        if (uintegerValue.Get () == UINT32_MAX || uintegerValue.Get () == entry.m_nodeId)
+        {
+            outFile << std::setprecision (9) << std::fixed << TimeStep (entry.m_time).GetSeconds () <<  " ";
+            outFile << TimeStep (entry.m_interval).GetSeconds () <<  " ";
+            outFile << entry.m_nodeId << std::endl;
+        }
+    }
+}
+
+    bool
+ConvertTraceLog (std::string binFilename, std::string filename)
+{
+    BinaryTraceReader reader (binFilename);
+    if (!reader.IsOpen ())
+    {
+        NS_LOG_ERROR ("Can't read trace log " << binFilename);
+        return false;
+    }
+    switch (reader.GetType ())
+    {
+    case TXPHY_LOG:
+        SaveSpectrumTxPhyStats (filename, reader);
+        break;
+    case PHY_LOG:
+        SaveSpectrumPhyStats (filename, reader);
+        break;
+    case TXOP_LOG:
+        SaveTxopStats (filename, reader);
+        break;
+    case DATA_TX_LOG:
+        SaveDataTxStats (filename, reader);
+        break;
+    case BEACON_LOG:
+        SaveBeaconStats (filename, reader);
+        break;
+    case CW_LOG:
+        SaveCwStats (filename, reader);
+        break;
+    case BACKOFF_LOG:
+        SaveBackoffStats (filename, reader);
+        break;
+    case HARQ_FEEDBACK_LOG:
+        SaveHarqFeedbacksStats (filename, reader);
+        break;
+    case FAIL_RETRIES_LOG:
+        SaveFailRetriesStats (filename, reader);
+        break;
+    case RETRIES_LOG:
+        SaveRetriesStats (filename, reader);
+        break;
+    case VOICE_LOG:
+        SaveVoiceStats (filename, reader);
+        break;
+    default:
+        NS_LOG_ERROR ("Unknown type " << reader.GetType () << " of trace log " << binFilename);
+        return false;
+    }
+    return true;
+}
+
+// Replace the propagation loss model of a channel by a matrix of the
+// gains between the static nodes computed from it, loaded from and saved
+// to filename if not empty
+    void
+InstallLinkGainMatrix (Ptr<SpectrumChannel> channel, std::string filename)
+{
+    Ptr<MultiModelSpectrumChannel> multiModelChannel = DynamicCast<MultiModelSpectrumChannel> (channel);
+    if (multiModelChannel == 0 || multiModelChannel->GetPropagationLossModel () == 0)
     {
-        if (uintegerValue.Get () == UINT32_MAX || uintegerValue.Get () == arrivals[i].m_nodeId)
+        NS_LOG_WARN ("channel " << channel << " has no propagation loss model to compute a link gain matrix from");
+        return;
+    }
+    UintegerValue uintegerValue;
+    GlobalValue::GetValueByName ("linkGainMatrixThreads", uintegerValue);
+    Ptr<LinkGainMatrixPropagationLossModel> matrix = CreateObject<LinkGainMatrixPropagationLossModel> ();
+    matrix->SetAttribute ("ThreadCount", uintegerValue);
+    matrix->SetFallbackModel (multiModelChannel->GetPropagationLossModel ());
+    if (filename.empty () || !matrix->Load (filename, NodeContainer::GetGlobal ()))
+    {
+        matrix->Compute (NodeContainer::GetGlobal ());
+        if (!filename.empty () && !matrix->Save (filename))
         {
-            outFile << std::setprecision (9) << std::fixed << arrivals[i].m_time.GetSeconds () <<  " ";
-            outFile << arrivals[i].m_interval.GetSeconds () <<  " ";
-            outFile << arrivals[i].m_nodeId << std::endl;
+            NS_FATAL_ERROR ("Can't write file " << filename);
         }
     }
+    multiModelChannel->SetPropagationLossModel (matrix);
+}
+
+// Close a binary trace log and, unless logBinaryOnly is set, convert it
+// to its text format and remove it
+    void
+FinishTraceLog (Ptr<BinaryTraceWriter> &log, std::string filename)
+{
+    if (log == 0)
+    {
+        return;
+    }
+    log->Close ();
+    log = 0;
+    BooleanValue booleanValue;
+    GlobalValue::GetValueByName ("logBinaryOnly", booleanValue);
+    if (booleanValue.Get () == false)
+    {
+        std::string binFilename = filename + ".bin";
+        ConvertTraceLog (binFilename, filename);
+        std::remove (binFilename.c_str ());
+    }
 }
 
     void
@@ -2881,9 +3082,10 @@ ConfigureAndRunScenario (Config_e cellConfigA,
             Ipv4Address remoteIp0;
             Ipv4Address remoteIp1;
             Ipv4Address remoteIp2;
-            std::string context;
             bool success;
 
+            g_voiceRxLog = Create<BinaryTraceWriter> (outFileName + "_operatorB_voice_log.bin", VOICE_LOG, sizeof (VoiceRxLog));
+
             // Network B
             voiceSender = clientNodesB.Get (0);
             voiceReceiver0 = ueNodesB.Get (0);
@@ -2902,8 +3104,7 @@ ConfigureAndRunScenario (Config_e cellConfigA,
             // send in downlink direction only 
             voiceAppReceiver0->SetAttribute ("SendEnabled", BooleanValue (false));
             voiceReceiver0->AddApplication (voiceAppReceiver0);
-            context = NodeIdToContext (voiceReceiver0->GetId ());
-            success = voiceAppReceiver0->TraceConnect("Rx", context, MakeCallback(&VoiceRxCb));
+            success = voiceAppReceiver0->TraceConnectWithoutContext("Rx", MakeBoundCallback(&VoiceRxCb, voiceReceiver0->GetId ()));
             NS_ASSERT (success);
 
             if (ueNodesB.GetN () > 1)
@@ -2918,8 +3119,7 @@ ConfigureAndRunScenario (Config_e cellConfigA,
                 // send in downlink direction only 
                 voiceAppReceiver1->SetAttribute ("SendEnabled", BooleanValue (false));
                 voiceReceiver1->AddApplication (voiceAppReceiver1);
-                context = NodeIdToContext (voiceReceiver1->GetId ());
-                success = voiceAppReceiver1->TraceConnect("Rx", context, MakeCallback(&VoiceRxCb));
+                success = voiceAppReceiver1->TraceConnectWithoutContext("Rx", MakeBoundCallback(&VoiceRxCb, voiceReceiver1->GetId ()));
                 NS_ASSERT (success);
             }
             else
@@ -2993,6 +3193,16 @@ ConfigureAndRunScenario (Config_e cellConfigA,
     // these slow down simulations, only enable them if you need them
     //lteHelper->EnableTraces();
 
+    GlobalValue::GetValueByName ("linkGainMatrix", booleanValue);
+    if (booleanValue.Get () == true)
+    {
+        StringValue stringValue;
+        GlobalValue::GetValueByName ("linkGainMatrixFile", stringValue);
+        std::string matrixFile = stringValue.Get ();
+        InstallLinkGainMatrix (dlSpectrumChannel, matrixFile.empty () ? "" : matrixFile + "_dl.bin");
+        InstallLinkGainMatrix (ulSpectrumChannel, matrixFile.empty () ? "" : matrixFile + "_ul.bin");
+    }
+
     Ptr<RadioEnvironmentMapHelper> remHelper;
     if (generateRem)
     {
@@ -3025,6 +3235,7 @@ ConfigureAndRunScenario (Config_e cellConfigA,
     GlobalValue::GetValueByName ("logWifiFailRetries", booleanValue);
     if (booleanValue.Get () == true)
     {
+        g_wifiFailRetries = Create<BinaryTraceWriter> (outFileName + "_fail_retries_log.bin", FAIL_RETRIES_LOG, sizeof (WifiRetriesLog));
         Simulator::Schedule (clientStartTime, &ScheduleWifiFailRetriesLogConnect);
         Simulator::Schedule (clientStopTime, &ScheduleWifiFailRetriesLogDisconnect);
     }
@@ -3032,6 +3243,7 @@ ConfigureAndRunScenario (Config_e cellConfigA,
     GlobalValue::GetValueByName ("logWifiRetries", booleanValue);
     if (booleanValue.Get () == true)
     {
+        g_wifiRetries = Create<BinaryTraceWriter> (outFileName + "_retries_log.bin", RETRIES_LOG, sizeof (WifiRetriesLog));
         Simulator::Schedule (clientStartTime, &ScheduleWifiRetriesLogConnect);
         Simulator::Schedule (clientStopTime, &ScheduleWifiRetriesLogDisconnect);
     }
@@ -3039,6 +3251,7 @@ ConfigureAndRunScenario (Config_e cellConfigA,
     GlobalValue::GetValueByName ("logPhyArrivals", booleanValue);
     if (booleanValue.Get () == true)
     {
+        g_arrivals = Create<BinaryTraceWriter> (outFileName + "_phy_log.bin", PHY_LOG, sizeof (SignalArrival));
         Simulator::Schedule (clientStartTime, &SchedulePhyLogConnect);
         Simulator::Schedule (clientStopTime, &SchedulePhyLogDisconnect);
     }
@@ -3046,6 +3259,7 @@ ConfigureAndRunScenario (Config_e cellConfigA,
     GlobalValue::GetValueByName ("logTxPhyArrivals", booleanValue);
     if (booleanValue.Get () == true)
     {
+        g_transmissions = Create<BinaryTraceWriter> (outFileName + "_txphy_log.bin", TXPHY_LOG, sizeof (SignalTransmission));
         Simulator::Schedule (clientStartTime, &ScheduleTxPhyLogConnect);
         Simulator::Schedule (clientStopTime, &ScheduleTxPhyLogDisconnect);
     }
@@ -3053,6 +3267,7 @@ ConfigureAndRunScenario (Config_e cellConfigA,
     GlobalValue::GetValueByName ("logTxops", booleanValue);
     if (booleanValue.Get () == true)
     {
+        g_txopLogs = Create<BinaryTraceWriter> (outFileName + "_txop_log.bin", TXOP_LOG, sizeof (TxopLog));
         Simulator::Schedule (clientStartTime, &ScheduleTxopLogConnect);
         //Simulator::Schedule (clientStopTime, &ScheduleTxopLogDisconnect);
     }
@@ -3060,6 +3275,7 @@ ConfigureAndRunScenario (Config_e cellConfigA,
     GlobalValue::GetValueByName ("logDataTx", booleanValue);
     if (booleanValue.Get () == true)
     {
+        g_dataTxLogs = Create<BinaryTraceWriter> (outFileName + "_dataTx_log.bin", DATA_TX_LOG, sizeof (DataTx));
         Simulator::Schedule (clientStartTime, &ScheduleDataTxConnect);
         // Simulator::Schedule (clientStopTime, &ScheduleDataTxDisconnect);
     }
@@ -3067,18 +3283,27 @@ ConfigureAndRunScenario (Config_e cellConfigA,
     GlobalValue::GetValueByName ("logBeaconArrivals", booleanValue);
     if (booleanValue.Get () == true)
     {
+        g_beaconArrivals = Create<BinaryTraceWriter> (outFileName + "_beacon_log.bin", BEACON_LOG, sizeof (BeaconArrival));
         Simulator::Schedule (clientStartTime, &ScheduleBeaconLogConnect);
         Simulator::Schedule (clientStopTime, &ScheduleBeaconLogDisconnect);
     }
     GlobalValue::GetValueByName ("logBackoffChanges", booleanValue);
     if (booleanValue.Get () == true) 
     {
+        g_backoffChanges = Create<BinaryTraceWriter> (outFileName + "_backoff_log.bin", BACKOFF_LOG, sizeof (BackoffChange));
         Simulator::Schedule (clientStartTime, &ScheduleWifiBackoffLogConnect);
         Simulator::Schedule (clientStopTime, &ScheduleWifiBackoffLogDisconnect);
     }
+    GlobalValue::GetValueByName ("logHarqFeedback", booleanValue);
+    if (booleanValue.Get () == true)
+    {
+        // connected per eNB device in the LAA configuration above
+        g_harqFeedbacks = Create<BinaryTraceWriter> (outFileName + "_harq_feedback_log.bin", HARQ_FEEDBACK_LOG, sizeof (HarqFeedbackLog));
+    }
     GlobalValue::GetValueByName ("logCwChanges", booleanValue);
     if (booleanValue.Get () == true) 
     {
+        g_cwChanges = Create<BinaryTraceWriter> (outFileName + "_cw_log.bin", CW_LOG, sizeof (CwChange));
         Simulator::Schedule (clientStartTime, &ScheduleCwChangesLogConnect);
         Simulator::Schedule (clientStopTime, &ScheduleCwChangesLogDisconnect);
     }
@@ -3130,60 +3355,60 @@ ConfigureAndRunScenario (Config_e cellConfigA,
     GlobalValue::GetValueByName ("logTxPhyArrivals", booleanValue);
     if (booleanValue.Get () == true)
     {
-        SaveSpectrumTxPhyStats (outFileName + "_txphy_log", g_transmissions);
+        FinishTraceLog (g_transmissions, outFileName + "_txphy_log");
     }
     GlobalValue::GetValueByName ("logPhyArrivals", booleanValue);
     if (booleanValue.Get () == true)
     {
-        SaveSpectrumPhyStats (outFileName + "_phy_log", g_arrivals);
+        FinishTraceLog (g_arrivals, outFileName + "_phy_log");
     }
     GlobalValue::GetValueByName ("logTxops", booleanValue);
     if (booleanValue.Get () == true)
     {
-        SaveTxopStats (outFileName + "_txop_log", g_txopLogs);
+        FinishTraceLog (g_txopLogs, outFileName + "_txop_log");
     }
 
     GlobalValue::GetValueByName ("logDataTx", booleanValue);
     if (booleanValue.Get () == true)
     {
-        SaveDataTxStats (outFileName + "_dataTx_log", g_dataTxLogs);
+        FinishTraceLog (g_dataTxLogs, outFileName + "_dataTx_log");
     }
 
     GlobalValue::GetValueByName ("logBeaconArrivals", booleanValue);
     if (booleanValue.Get () == true)
     {
-        SaveBeaconStats (outFileName + "_beacon_log", g_beaconArrivals);
+        FinishTraceLog (g_beaconArrivals, outFileName + "_beacon_log");
     }
     GlobalValue::GetValueByName ("logCwChanges", booleanValue);
     if (booleanValue.Get () == true)
     {
-        SaveCwStats (outFileName + "_cw_log", g_cwChanges);
+        FinishTraceLog (g_cwChanges, outFileName + "_cw_log");
     }
     GlobalValue::GetValueByName ("logBackoffChanges", booleanValue);
     if (booleanValue.Get () == true)
     {
-        SaveBackoffStats (outFileName + "_backoff_log", g_backoffChanges);
+        FinishTraceLog (g_backoffChanges, outFileName + "_backoff_log");
     }
     GlobalValue::GetValueByName ("logHarqFeedback", booleanValue);
     if (booleanValue.Get () == true)
     {
-        SaveHarqFeedbacksStats (outFileName + "_harq_feedback_log", g_harqFeedbacks);
+        FinishTraceLog (g_harqFeedbacks, outFileName + "_harq_feedback_log");
     }
     GlobalValue::GetValueByName ("logWifiFailRetries", booleanValue);
     if (booleanValue.Get () == true)
     {
-        SaveFailRetriesStats (outFileName + "_fail_retries_log", g_wifiFailRetries);
+        FinishTraceLog (g_wifiFailRetries, outFileName + "_fail_retries_log");
     }
     GlobalValue::GetValueByName ("logWifiRetries", booleanValue);
     if (booleanValue.Get () == true)
     {
-        SaveRetriesStats (outFileName + "_retries_log", g_wifiRetries);
+        FinishTraceLog (g_wifiRetries, outFileName + "_retries_log");
     }
     GlobalValue::GetValueByNameFailSafe ("voiceEnabled", booleanValue);
     if (booleanValue.Get () == true)
     {
         SaveVoiceSummaryStats (outFileName + "_operatorB_voice_summary_log", endpointNodesB);
-        SaveVoiceStats (outFileName + "_operatorB_voice_log", endpointNodesB, g_voiceRxLog);
+        FinishTraceLog (g_voiceRxLog, outFileName + "_operatorB_voice_log");
     }
     Simulator::Destroy ();
 
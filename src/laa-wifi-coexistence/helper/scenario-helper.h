@@ -95,6 +95,18 @@ ConfigureTcpClients (NodeContainer client, Ipv4InterfaceContainer servers, Time
 void
 StartFileTransfer (Ptr<ExponentialRandomVariable> ftpArrivals, ApplicationContainer clients, uint32_t nextClient, Time stopTime);
 
+/**
+ * Convert a binary trace log written by ConfigureAndRunScenario (a
+ * <logfile>.bin file, kept when the logBinaryOnly global value is true)
+ * to the text format of the logfile.
+ *
+ * \param binFilename the name of the binary trace log
+ * \param filename the name of the text logfile to append to
+ * \return false if the binary trace log could not be read
+ */
+bool
+ConvertTraceLog (std::string binFilename, std::string filename);
+
 void
 ConfigureAndRunScenario (Config_e cellConfigA,
                          Config_e cellConfigB,
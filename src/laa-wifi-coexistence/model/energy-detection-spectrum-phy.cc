@@ -0,0 +1,267 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2015 University of Washington
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/log.h>
+#include <ns3/double.h>
+#include <ns3/uinteger.h>
+#include <ns3/simulator.h>
+#include <ns3/node.h>
+#include <ns3/trace-source-accessor.h>
+#include <ns3/antenna-model.h>
+#include <ns3/wifi-phy.h>
+#include <ns3/wifi-spectrum-helper.h>
+#include <ns3/wifi-spectrum-signal-parameters.h>
+
+#include "energy-detection-spectrum-phy.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("EnergyDetectionSpectrumPhy");
+
+NS_OBJECT_ENSURE_REGISTERED (EnergyDetectionSpectrumPhy);
+
+EnergyDetectionSpectrumPhy::EnergyDetectionSpectrumPhy ()
+  : m_mobility (0),
+    m_netDevice (0),
+    m_channel (0),
+    m_channelNumber (0),
+    m_edThresholdW (0.0),
+    m_rxGainDb (0.0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+EnergyDetectionSpectrumPhy::~EnergyDetectionSpectrumPhy ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+EnergyDetectionSpectrumPhy::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+  m_mobility = 0;
+  m_antenna = 0;
+  m_netDevice = 0;
+  m_channel = 0;
+  m_rfFilter = 0;
+  m_signals.clear ();
+  m_ccaBusyCallback = MakeNullCallback<void, Time> ();
+  SpectrumPhy::DoDispose ();
+}
+
+TypeId
+EnergyDetectionSpectrumPhy::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::EnergyDetectionSpectrumPhy")
+    .SetParent<SpectrumPhy> ()
+    .SetGroupName ("laa-wifi-coexistence")
+    .AddConstructor<EnergyDetectionSpectrumPhy> ()
+    .AddAttribute ("ChannelNumber",
+                   "The IEEE 802.11 channel whose energy is sensed.",
+                   UintegerValue (36),
+                   MakeUintegerAccessor (&EnergyDetectionSpectrumPhy::SetChannelNumber,
+                                         &EnergyDetectionSpectrumPhy::GetChannelNumber),
+                   MakeUintegerChecker<uint16_t> ())
+    .AddAttribute ("EnergyDetectionThreshold",
+                   "The received power (dBm) at or above which the channel "
+                   "is sensed busy.",
+                   DoubleValue (-62.0),
+                   MakeDoubleAccessor (&EnergyDetectionSpectrumPhy::SetEdThreshold,
+                                       &EnergyDetectionSpectrumPhy::GetEdThreshold),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("RxGain",
+                   "Reception gain (dB).",
+                   DoubleValue (0.0),
+                   MakeDoubleAccessor (&EnergyDetectionSpectrumPhy::m_rxGainDb),
+                   MakeDoubleChecker<double> ())
+    .AddTraceSource ("SignalArrival",
+                     "Signal arrival",
+                     MakeTraceSourceAccessor (&EnergyDetectionSpectrumPhy::m_signalCb),
+                     "ns3::EnergyDetectionSpectrumPhy::SignalArrivalCallback")
+  ;
+  return tid;
+}
+
+Ptr<NetDevice>
+EnergyDetectionSpectrumPhy::GetDevice () const
+{
+  return m_netDevice;
+}
+
+Ptr<MobilityModel>
+EnergyDetectionSpectrumPhy::GetMobility ()
+{
+  return m_mobility;
+}
+
+Ptr<const SpectrumModel>
+EnergyDetectionSpectrumPhy::GetRxSpectrumModel () const
+{
+  return m_rfFilter != 0 ? m_rfFilter->GetSpectrumModel () : 0;
+}
+
+Ptr<AntennaModel>
+EnergyDetectionSpectrumPhy::GetRxAntenna ()
+{
+  return m_antenna;
+}
+
+void
+EnergyDetectionSpectrumPhy::SetDevice (Ptr<NetDevice> d)
+{
+  NS_LOG_FUNCTION (this << d);
+  m_netDevice = d;
+}
+
+void
+EnergyDetectionSpectrumPhy::SetMobility (Ptr<MobilityModel> m)
+{
+  NS_LOG_FUNCTION (this << m);
+  m_mobility = m;
+}
+
+void
+EnergyDetectionSpectrumPhy::SetChannel (Ptr<SpectrumChannel> c)
+{
+  NS_LOG_FUNCTION (this << c);
+  m_channel = c;
+}
+
+void
+EnergyDetectionSpectrumPhy::SetAntenna (Ptr<AntennaModel> a)
+{
+  NS_LOG_FUNCTION (this << a);
+  m_antenna = a;
+}
+
+void
+EnergyDetectionSpectrumPhy::SetChannelNumber (uint16_t channelNumber)
+{
+  NS_LOG_FUNCTION (this << channelNumber);
+  m_channelNumber = channelNumber;
+  m_rfFilter = WifiSpectrumHelper::GetRfFilter (channelNumber);
+}
+
+uint16_t
+EnergyDetectionSpectrumPhy::GetChannelNumber (void) const
+{
+  return m_channelNumber;
+}
+
+void
+EnergyDetectionSpectrumPhy::SetEdThreshold (double threshold)
+{
+  NS_LOG_FUNCTION (this << threshold);
+  m_edThresholdW = WifiPhy::DbmToW (threshold);
+}
+
+double
+EnergyDetectionSpectrumPhy::GetEdThreshold (void) const
+{
+  return WifiPhy::WToDbm (m_edThresholdW);
+}
+
+void
+EnergyDetectionSpectrumPhy::SetCcaBusyCallback (CcaBusyCallback c)
+{
+  NS_LOG_FUNCTION (this);
+  m_ccaBusyCallback = c;
+}
+
+double
+EnergyDetectionSpectrumPhy::UpdateSignals (void)
+{
+  Time now = Simulator::Now ();
+  std::vector<Signal>::iterator first = m_signals.begin ();
+  while (first != m_signals.end () && first->end <= now)
+    {
+      first++;
+    }
+  m_signals.erase (m_signals.begin (), first);
+  double powerW = 0.0;
+  for (std::vector<Signal>::const_iterator i = m_signals.begin (); i != m_signals.end (); i++)
+    {
+      powerW += i->powerW;
+    }
+  return powerW;
+}
+
+Time
+EnergyDetectionSpectrumPhy::GetDelayUntilIdle (void)
+{
+  if (UpdateSignals () < m_edThresholdW)
+    {
+      return Seconds (0);
+    }
+  // the channel becomes idle at the end of the last signal without
+  // which the signals ending later stay below the threshold
+  double tailW = 0.0;
+  std::vector<Signal>::reverse_iterator i;
+  for (i = m_signals.rbegin (); i != m_signals.rend (); i++)
+    {
+      if (tailW + i->powerW >= m_edThresholdW)
+        {
+          break;
+        }
+      tailW += i->powerW;
+    }
+  NS_ASSERT (i != m_signals.rend ());
+  return i->end - Simulator::Now ();
+}
+
+void
+EnergyDetectionSpectrumPhy::StartRx (Ptr<SpectrumSignalParameters> params)
+{
+  NS_LOG_FUNCTION (this << params);
+  NS_ASSERT_MSG (m_rfFilter, "channel number not set");
+  // the PSD is not materialized, since only its filtered integral is
+  // needed, which scales linearly with psdGain
+  double rxPowerW = FilteredIntegral (*params->GetUnscaledPsd (), *m_rfFilter)
+    * params->psdGain * WifiPhy::DbToRatio (m_rxGainDb);
+  uint32_t senderNodeId = 0;
+  if (params->txPhy != 0 && params->txPhy->GetDevice () != 0)
+    {
+      senderNodeId = params->txPhy->GetDevice ()->GetNode ()->GetId ();
+    }
+  bool isWifi = DynamicCast<WifiSpectrumSignalParameters> (params) != 0;
+  m_signalCb (isWifi, senderNodeId, WifiPhy::WToDbm (rxPowerW), params->duration);
+  NS_LOG_DEBUG ("Signal from node " << senderNodeId << " with power " << WifiPhy::WToDbm (rxPowerW) << " dBm");
+
+  Signal signal;
+  signal.end = Simulator::Now () + params->duration;
+  signal.powerW = rxPowerW;
+  std::vector<Signal>::iterator i = m_signals.end ();
+  while (i != m_signals.begin () && (i - 1)->end > signal.end)
+    {
+      i--;
+    }
+  m_signals.insert (i, signal);
+
+  Time delayUntilIdle = GetDelayUntilIdle ();
+  if (!delayUntilIdle.IsZero ())
+    {
+      NS_LOG_DEBUG ("Channel busy for " << delayUntilIdle);
+      if (!m_ccaBusyCallback.IsNull ())
+        {
+          m_ccaBusyCallback (delayUntilIdle);
+        }
+    }
+}
+
+} // namespace ns3
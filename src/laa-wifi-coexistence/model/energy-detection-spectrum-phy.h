@@ -0,0 +1,166 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2015 University of Washington
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef ENERGY_DETECTION_SPECTRUM_PHY_H
+#define ENERGY_DETECTION_SPECTRUM_PHY_H
+
+#include <ns3/spectrum-phy.h>
+#include <ns3/spectrum-value.h>
+#include <ns3/spectrum-channel.h>
+#include <ns3/mobility-model.h>
+#include <ns3/net-device.h>
+#include <ns3/nstime.h>
+#include <ns3/callback.h>
+#include <ns3/traced-callback.h>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup laa-wifi-coexistence
+ *
+ * Receive-only SpectrumPhy that senses a Wi-Fi channel by energy
+ * detection only.
+ *
+ * Every incoming signal, Wi-Fi or not, is filtered with the RF filter
+ * of the configured Wi-Fi channel and its power is added to the power of
+ * the signals still on the air. Whenever the total power reaches the
+ * energy detection threshold, the CCA busy callback is invoked with the
+ * time left until the power falls below the threshold again, in the same
+ * way as a SpectrumWifiPhy with Wi-Fi reception disabled notifies its
+ * listeners of a CCA busy period. No preamble detection, interference
+ * bookkeeping for error rates or packet processing is done, which makes
+ * this PHY much cheaper than a full Wi-Fi device for an LbtAccessManager
+ * that only needs the busy/idle state of the channel.
+ */
+class EnergyDetectionSpectrumPhy : public SpectrumPhy
+{
+public:
+  /**
+   * Callback invoked when the channel is sensed busy, with the time
+   * left until the received power falls below the threshold.
+   */
+  typedef Callback<void, Time> CcaBusyCallback;
+
+  EnergyDetectionSpectrumPhy ();
+  virtual ~EnergyDetectionSpectrumPhy ();
+
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  // inherited from SpectrumPhy
+  void SetChannel (Ptr<SpectrumChannel> c);
+  void SetMobility (Ptr<MobilityModel> m);
+  void SetDevice (Ptr<NetDevice> d);
+  Ptr<MobilityModel> GetMobility ();
+  Ptr<NetDevice> GetDevice () const;
+  Ptr<const SpectrumModel> GetRxSpectrumModel () const;
+  Ptr<AntennaModel> GetRxAntenna ();
+  void StartRx (Ptr<SpectrumSignalParameters> params);
+
+  /**
+   * Set the AntennaModel to be used
+   *
+   * \param a the Antenna Model
+   */
+  void SetAntenna (Ptr<AntennaModel> a);
+
+  /**
+   * Set the Wi-Fi channel to sense. This must be done before the PHY
+   * is added to a SpectrumChannel.
+   *
+   * \param channelNumber the IEEE 802.11 channel number
+   */
+  void SetChannelNumber (uint16_t channelNumber);
+  /**
+   * \return the sensed IEEE 802.11 channel number
+   */
+  uint16_t GetChannelNumber (void) const;
+
+  /**
+   * \param threshold the energy detection threshold (dBm)
+   */
+  void SetEdThreshold (double threshold);
+  /**
+   * \return the energy detection threshold (dBm)
+   */
+  double GetEdThreshold (void) const;
+
+  /**
+   * \param c the callback invoked when the channel is sensed busy
+   */
+  void SetCcaBusyCallback (CcaBusyCallback c);
+
+  /**
+   * \return the time left until the received power falls below the
+   * energy detection threshold, zero if the channel is idle
+   */
+  Time GetDelayUntilIdle (void);
+
+  /**
+   * TracedCallback signature for signal arrival events, same as
+   * SpectrumWifiPhy::SignalArrivalCallback.
+   *
+   * \param [in] signalType Whether the signal is a Wi-Fi signal.
+   * \param [in] senderNodeId The id of the sending node.
+   * \param [in] rxPower The received power (dBm).
+   * \param [in] duration The signal duration.
+   */
+  typedef void (* SignalArrivalCallback) (bool signalType, uint32_t senderNodeId, double rxPower, Time duration);
+
+protected:
+  void DoDispose ();
+
+private:
+  /** A signal still on the air. */
+  struct Signal
+  {
+    Time end;           //!< The end of the signal.
+    double powerW;      //!< The received power (W).
+  };
+
+  /**
+   * Drop the signals which ended and sum the power of the others.
+   *
+   * \return the total received power (W)
+   */
+  double UpdateSignals (void);
+
+  Ptr<MobilityModel> m_mobility;    //!< Pointer to the mobility model
+  Ptr<AntennaModel> m_antenna;      //!< Pointer to the Antenna model
+  Ptr<NetDevice> m_netDevice;       //!< Pointer to the NetDevice using this object
+  Ptr<SpectrumChannel> m_channel;   //!< Pointer to the sensed channel
+
+  uint16_t m_channelNumber;                   //!< Sensed IEEE 802.11 channel
+  Ptr<const SpectrumValue> m_rfFilter;        //!< RF filter of the sensed channel
+  double m_edThresholdW;                      //!< Energy detection threshold (W)
+  double m_rxGainDb;                          //!< Reception gain (dB)
+  /// The signals on the air, sorted by end time.
+  std::vector<Signal> m_signals;
+  CcaBusyCallback m_ccaBusyCallback;          //!< CCA busy callback
+
+  /// Trace fired for each incoming signal, like SpectrumWifiPhy::SignalArrival
+  TracedCallback<bool, uint32_t, double, Time> m_signalCb;
+};
+
+} // namespace ns3
+
+#endif /* ENERGY_DETECTION_SPECTRUM_PHY_H */
@@ -25,6 +25,7 @@
 #include "ns3/assert.h"
 #include "ns3/log.h"
 #include "ns3/spectrum-wifi-phy.h"
+#include "energy-detection-spectrum-phy.h"
 
 namespace ns3 {
 
@@ -209,7 +210,8 @@ namespace ns3 {
                         MakeEnumChecker (LbtAccessManager::ENE, "ENE",
                             LbtAccessManager::ENECTS, "ENECTS",
                             LbtAccessManager::PRE, "PRE",
-                            LbtAccessManager::PRECTS, "PRECTS"))
+                            LbtAccessManager::PRECTS, "PRECTS",
+                            LbtAccessManager::ED, "ED"))
                 .AddConstructor<LbtAccessManager> ()
                 ;
             return tid;
@@ -241,6 +243,10 @@ namespace ns3 {
         delete m_lbtMacLowListener;
         m_lbtPhyListener = 0;
         m_lbtMacLowListener = 0;
+        if (m_edPhy != 0)
+        {
+            m_edPhy->SetCcaBusyCallback (MakeNullCallback<void, Time> ());
+        }
         if (m_waitForDeferEventId.IsRunning ())
         {
             m_waitForDeferEventId.Cancel ();
@@ -311,7 +317,7 @@ namespace ns3 {
             m_wifiPhy = phy;
             // Configure the WifiPhy to treat each incoming signal as a foreign signal
             // (energy detection only)
-            if (m_channelSenseMode == ENE || m_channelSenseMode == ENECTS)
+            if (m_channelSenseMode == ENE || m_channelSenseMode == ENECTS || m_channelSenseMode == ED)
             {
                 m_wifiPhy->SetAttribute ("DisableWifiReception", BooleanValue (true));
             }
@@ -321,6 +327,28 @@ namespace ns3 {
             m_cw = m_cwMin;
         }
 
+    void
+        LbtAccessManager::SetEnergyDetectionPhy (Ptr<EnergyDetectionSpectrumPhy> phy)
+        {
+            NS_LOG_FUNCTION (this << phy);
+            NS_ASSERT_MSG (m_channelSenseMode != ENECTS && m_channelSenseMode != PRECTS,
+                    "CTS-to-self channel sense modes need a Wi-Fi device");
+            m_edPhy = phy;
+            // The PHY reports the same busy periods as a SpectrumWifiPhy
+            // with Wi-Fi reception disabled reports to its listeners
+            m_edPhy->SetCcaBusyCallback (MakeCallback (&LbtAccessManager::NotifyMaybeCcaBusyStartNow, this));
+            m_edPhy->SetEdThreshold (m_edThreshold);
+
+            // Initialization of post-attribute-construction variables can be done here
+            m_cw = m_cwMin;
+        }
+
+    Ptr<EnergyDetectionSpectrumPhy>
+        LbtAccessManager::GetEnergyDetectionPhy (void) const
+        {
+            return m_edPhy;
+        }
+
     void
         LbtAccessManager::SetLteEnbMac (Ptr<LteEnbMac> lteEnbMac)
         {
@@ -356,7 +384,7 @@ namespace ns3 {
         LbtAccessManager::DoRequestAccess ()
         {
             NS_LOG_FUNCTION (this);
-            NS_ASSERT_MSG (m_wifiPhy, "LbtAccessManager not connected to a WifiPhy");
+            NS_ASSERT_MSG (m_wifiPhy || m_edPhy, "LbtAccessManager not connected to a WifiPhy or an EnergyDetectionSpectrumPhy");
 
             if (m_grantRequested == true)
             {
@@ -45,6 +45,7 @@
 namespace ns3 {
 
 class SpectrumWifiPhy;
+class EnergyDetectionSpectrumPhy;
 class WifiMac;
 class MacLow;
 class LbtPhyListener;
@@ -62,12 +63,20 @@ public:
     TXOP_GRANTED
   };
 
+  /**
+   * How the channel is sensed. ENE and PRE use a SpectrumWifiPhy, with
+   * Wi-Fi reception disabled for ENE, and the CTS variants additionally
+   * send a CTS-to-self through MacLow before each TXOP. ED only detects
+   * energy, through an EnergyDetectionSpectrumPhy set with
+   * SetEnergyDetectionPhy, and needs no Wi-Fi device at all.
+   */
   enum ChannelSenseMode_t
   {
     ENE,
     ENECTS,
     PRE,
     PRECTS,
+    ED,
   };
 
   enum CWUpdateRule_t
@@ -94,6 +103,17 @@ public:
   void SetupPhyListener (Ptr<SpectrumWifiPhy> phy);
   void SetupLowListener (Ptr<MacLow> low);
   void SetWifiPhy (Ptr<SpectrumWifiPhy> phy);
+  /**
+   * Sense the channel with the given energy detection PHY instead of a
+   * SpectrumWifiPhy. This is meant for the ED channel sense mode.
+   *
+   * \param phy the energy detection PHY
+   */
+  void SetEnergyDetectionPhy (Ptr<EnergyDetectionSpectrumPhy> phy);
+  /**
+   * \return the energy detection PHY set with SetEnergyDetectionPhy, or 0
+   */
+  Ptr<EnergyDetectionSpectrumPhy> GetEnergyDetectionPhy (void) const;
   void SetLteEnbMac (Ptr<LteEnbMac> lteEnbMac);
   void SetLteEnbPhy (Ptr<LteEnbPhy> lteEnbPhy);
   void NotifyRxStartNow (Time duration);
@@ -135,6 +155,7 @@ private:
   Ptr<LteEnbMac> m_lteEnbMac;
   Ptr<LteEnbPhy> m_lteEnbPhy;
   Ptr<SpectrumWifiPhy> m_wifiPhy;
+  Ptr<EnergyDetectionSpectrumPhy> m_edPhy;
   Ptr<MacLow> m_wifiMacLow;
   LbtPhyListener* m_lbtPhyListener;
   LbtMacLowListener* m_lbtMacLowListener;
@@ -0,0 +1,460 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2015 University of Washington
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "link-gain-matrix-propagation-loss-model.h"
+
+#include <ns3/log.h>
+#include <ns3/assert.h>
+#include <ns3/uinteger.h>
+#include <ns3/object-factory.h>
+#include <ns3/rng-seed-manager.h>
+#include <ns3/node.h>
+#include <ns3/constant-position-mobility-model.h>
+#include <ns3/mobility-building-info.h>
+#include <ns3/core-config.h>
+
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#ifdef HAVE_PTHREAD_H
+#include <ns3/system-thread.h>
+#include <unistd.h>
+#endif /* HAVE_PTHREAD_H */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("LinkGainMatrixPropagationLossModel");
+
+NS_OBJECT_ENSURE_REGISTERED (LinkGainMatrixPropagationLossModel);
+
+/// Tag at the start of the matrix files.
+static const uint32_t LINK_GAIN_MATRIX_MAGIC = 0x4c474d31;
+
+TypeId
+LinkGainMatrixPropagationLossModel::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::LinkGainMatrixPropagationLossModel")
+    .SetParent<PropagationLossModel> ()
+    .SetGroupName ("LaaWifiCoexistence")
+    .AddConstructor<LinkGainMatrixPropagationLossModel> ()
+    .AddAttribute ("ThreadCount",
+                   "The number of threads computing the matrix, "
+                   "0 for one thread per processor.",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&LinkGainMatrixPropagationLossModel::m_threadCount),
+                   MakeUintegerChecker<uint32_t> ())
+  ;
+  return tid;
+}
+
+LinkGainMatrixPropagationLossModel::LinkGainMatrixPropagationLossModel ()
+  : m_threadCount (0),
+    m_stream (-1)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+LinkGainMatrixPropagationLossModel::~LinkGainMatrixPropagationLossModel ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+LinkGainMatrixPropagationLossModel::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_fallback = 0;
+  SetMobilities (std::vector<Ptr<MobilityModel> > ());
+  m_gainDb.clear ();
+  PropagationLossModel::DoDispose ();
+}
+
+void
+LinkGainMatrixPropagationLossModel::SetFallbackModel (Ptr<PropagationLossModel> model)
+{
+  NS_LOG_FUNCTION (this << model);
+  m_fallback = model;
+}
+
+Ptr<PropagationLossModel>
+LinkGainMatrixPropagationLossModel::GetFallbackModel (void) const
+{
+  return m_fallback;
+}
+
+uint32_t
+LinkGainMatrixPropagationLossModel::GetN (void) const
+{
+  return m_mobilities.size ();
+}
+
+std::vector<Ptr<MobilityModel> >
+LinkGainMatrixPropagationLossModel::GetStaticMobilities (NodeContainer nodes)
+{
+  std::vector<Ptr<MobilityModel> > mobilities;
+  for (NodeContainer::Iterator it = nodes.Begin (); it != nodes.End (); ++it)
+    {
+      Ptr<MobilityModel> mobility = (*it)->GetObject<MobilityModel> ();
+      if (DynamicCast<ConstantPositionMobilityModel> (mobility) != 0)
+        {
+          mobilities.push_back (mobility);
+        }
+    }
+  return mobilities;
+}
+
+std::string
+LinkGainMatrixPropagationLossModel::GetFallbackSignature (void) const
+{
+  NS_ASSERT (m_fallback != 0);
+  TypeId tid = m_fallback->GetInstanceTypeId ();
+  std::ostringstream oss;
+  oss << tid.GetName ();
+  for (TypeId t = tid; t != Object::GetTypeId (); t = t.GetParent ())
+    {
+      for (uint32_t i = 0; i < t.GetAttributeN (); ++i)
+        {
+          struct TypeId::AttributeInformation info = t.GetAttribute (i);
+          if (!(info.flags & TypeId::ATTR_GET))
+            {
+              continue;
+            }
+          Ptr<AttributeValue> value = info.checker->Create ();
+          m_fallback->GetAttribute (info.name, *value);
+          oss << " " << info.name << "=" << value->SerializeToString (info.checker);
+        }
+    }
+  // the random realizations of the model depend on the run
+  oss << " RngSeed=" << RngSeedManager::GetSeed ()
+      << " RngRun=" << RngSeedManager::GetRun ()
+      << " Stream=" << m_stream;
+  return oss.str ();
+}
+
+bool
+LinkGainMatrixPropagationLossModel::CanComputeInParallel (const std::vector<Ptr<MobilityModel> > &mobilities) const
+{
+  if (m_fallback->GetNext () != 0)
+    {
+      NS_LOG_LOGIC ("the fallback model is chained to another model");
+      return false;
+    }
+  TypeId tid = m_fallback->GetInstanceTypeId ();
+  for (TypeId t = tid; t != Object::GetTypeId (); t = t.GetParent ())
+    {
+      for (uint32_t i = 0; i < t.GetAttributeN (); ++i)
+        {
+          // the copies would share the objects pointed to
+          std::string valueType = t.GetAttribute (i).checker->GetValueTypeName ();
+          if (valueType == "ns3::PointerValue" || valueType == "ns3::ObjectPtrContainerValue")
+            {
+              NS_LOG_LOGIC ("the fallback model has a pointer attribute " << t.GetAttribute (i).name);
+              return false;
+            }
+        }
+    }
+  for (std::vector<Ptr<MobilityModel> >::const_iterator it = mobilities.begin (); it != mobilities.end (); ++it)
+    {
+      // the copies of the mobility models would share the buildings
+      if ((*it)->GetObject<MobilityBuildingInfo> () != 0)
+        {
+          NS_LOG_LOGIC ("the nodes have a MobilityBuildingInfo");
+          return false;
+        }
+    }
+  return true;
+}
+
+Ptr<PropagationLossModel>
+LinkGainMatrixPropagationLossModel::CopyFallbackModel (void) const
+{
+  TypeId tid = m_fallback->GetInstanceTypeId ();
+  ObjectFactory factory;
+  factory.SetTypeId (tid);
+  for (TypeId t = tid; t != Object::GetTypeId (); t = t.GetParent ())
+    {
+      for (uint32_t i = 0; i < t.GetAttributeN (); ++i)
+        {
+          struct TypeId::AttributeInformation info = t.GetAttribute (i);
+          if (!(info.flags & TypeId::ATTR_GET) || !(info.flags & (TypeId::ATTR_SET | TypeId::ATTR_CONSTRUCT)))
+            {
+              continue;
+            }
+          Ptr<AttributeValue> value = info.checker->Create ();
+          m_fallback->GetAttribute (info.name, *value);
+          factory.Set (info.name, *value);
+        }
+    }
+  return factory.Create<PropagationLossModel> ();
+}
+
+void
+LinkGainMatrixPropagationLossModel::ComputeTask::Run (void)
+{
+  for (uint32_t i = first; i < n; i += step)
+    {
+      const Ptr<PropagationLossModel> &model = (*models)[i];
+      for (uint32_t j = i; j < n; ++j)
+        {
+          gainDb[i * n + j] = model->CalcRxPower (0.0, mobilities[i], mobilities[j]);
+          gainDb[j * n + i] = model->CalcRxPower (0.0, mobilities[j], mobilities[i]);
+        }
+    }
+}
+
+void
+LinkGainMatrixPropagationLossModel::Compute (NodeContainer nodes)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT_MSG (m_fallback != 0, "no fallback model to compute the matrix from");
+  std::vector<Ptr<MobilityModel> > mobilities = GetStaticMobilities (nodes);
+  uint32_t n = mobilities.size ();
+  std::vector<double> gainDb (n * n);
+
+  uint32_t nThreads = 1;
+#ifdef HAVE_PTHREAD_H
+  nThreads = m_threadCount;
+  if (nThreads == 0)
+    {
+      long nProcessors = sysconf (_SC_NPROCESSORS_ONLN);
+      nThreads = (nProcessors > 0) ? nProcessors : 1;
+    }
+#endif /* HAVE_PTHREAD_H */
+  nThreads = std::max (std::min (nThreads, n), (uint32_t) 1);
+
+  std::vector<Ptr<PropagationLossModel> > models;
+  if (n > 0 && CanComputeInParallel (mobilities))
+    {
+      for (uint32_t i = 0; i < n; ++i)
+        {
+          models.push_back (CopyFallbackModel ());
+        }
+    }
+  else
+    {
+      nThreads = 1;
+      models.assign (n, m_fallback);
+    }
+  NS_LOG_LOGIC ("computing the gains between " << n << " nodes with " << nThreads << " threads");
+
+  std::vector<ComputeTask> tasks (nThreads);
+  for (uint32_t t = 0; t < nThreads; ++t)
+    {
+      tasks[t].models = &models;
+      tasks[t].gainDb = n > 0 ? &gainDb[0] : 0;
+      tasks[t].n = n;
+      tasks[t].first = t;
+      tasks[t].step = nThreads;
+      if (nThreads == 1)
+        {
+          tasks[t].mobilities = mobilities;
+          continue;
+        }
+      // a Ptr must not be copied by two threads at once, hence each
+      // thread has its own copy of the mobility models
+      for (uint32_t i = 0; i < n; ++i)
+        {
+          Ptr<MobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+          mobility->SetPosition (mobilities[i]->GetPosition ());
+          tasks[t].mobilities.push_back (mobility);
+        }
+    }
+
+#ifdef HAVE_PTHREAD_H
+  std::vector<Ptr<SystemThread> > threads;
+  for (uint32_t t = 1; t < nThreads; ++t)
+    {
+      Ptr<SystemThread> thread = Create<SystemThread> (MakeCallback (&ComputeTask::Run, &tasks[t]));
+      thread->Start ();
+      threads.push_back (thread);
+    }
+  tasks[0].Run ();
+  for (std::vector<Ptr<SystemThread> >::iterator it = threads.begin (); it != threads.end (); ++it)
+    {
+      (*it)->Join ();
+    }
+#else
+  tasks[0].Run ();
+#endif /* HAVE_PTHREAD_H */
+
+  m_gainDb.swap (gainDb);
+  m_signature = GetFallbackSignature ();
+  SetMobilities (mobilities);
+}
+
+void
+LinkGainMatrixPropagationLossModel::SetMobilities (const std::vector<Ptr<MobilityModel> > &mobilities)
+{
+  NS_LOG_FUNCTION (this);
+  for (std::vector<Ptr<MobilityModel> >::iterator it = m_mobilities.begin (); it != m_mobilities.end (); ++it)
+    {
+      (*it)->TraceDisconnectWithoutContext ("CourseChange", MakeCallback (&LinkGainMatrixPropagationLossModel::CourseChanged, this));
+    }
+  m_mobilities = mobilities;
+  m_nodeIds.clear ();
+  m_index.clear ();
+  for (uint32_t i = 0; i < m_mobilities.size (); ++i)
+    {
+      Ptr<Node> node = m_mobilities[i]->GetObject<Node> ();
+      m_nodeIds.push_back (node != 0 ? node->GetId () : i);
+      m_index.insert (std::make_pair (PeekPointer (m_mobilities[i]), i));
+      m_mobilities[i]->TraceConnectWithoutContext ("CourseChange", MakeCallback (&LinkGainMatrixPropagationLossModel::CourseChanged, this));
+    }
+}
+
+void
+LinkGainMatrixPropagationLossModel::CourseChanged (Ptr<const MobilityModel> mobility)
+{
+  NS_LOG_FUNCTION (this << mobility);
+  m_index.erase (PeekPointer (mobility));
+}
+
+bool
+LinkGainMatrixPropagationLossModel::Save (std::string filename) const
+{
+  NS_LOG_FUNCTION (this << filename);
+  std::ofstream file (filename.c_str (), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!file.is_open ())
+    {
+      NS_LOG_WARN ("cannot open " << filename);
+      return false;
+    }
+  uint32_t header[3];
+  header[0] = LINK_GAIN_MATRIX_MAGIC;
+  header[1] = m_signature.size ();
+  header[2] = m_mobilities.size ();
+  file.write (reinterpret_cast<const char *> (header), sizeof (header));
+  file.write (m_signature.data (), m_signature.size ());
+  for (uint32_t i = 0; i < m_mobilities.size (); ++i)
+    {
+      Vector position = m_mobilities[i]->GetPosition ();
+      double coordinates[3] = { position.x, position.y, position.z };
+      file.write (reinterpret_cast<const char *> (&m_nodeIds[i]), sizeof (uint32_t));
+      file.write (reinterpret_cast<const char *> (coordinates), sizeof (coordinates));
+    }
+  if (!m_gainDb.empty ())
+    {
+      file.write (reinterpret_cast<const char *> (&m_gainDb[0]), m_gainDb.size () * sizeof (double));
+    }
+  return file.good ();
+}
+
+bool
+LinkGainMatrixPropagationLossModel::Load (std::string filename, NodeContainer nodes)
+{
+  NS_LOG_FUNCTION (this << filename);
+  NS_ASSERT_MSG (m_fallback != 0, "no fallback model to check the matrix against");
+  std::ifstream file (filename.c_str (), std::ios::in | std::ios::binary);
+  if (!file.is_open ())
+    {
+      NS_LOG_LOGIC ("cannot open " << filename);
+      return false;
+    }
+  uint32_t header[3];
+  file.read (reinterpret_cast<char *> (header), sizeof (header));
+  if (!file.good () || header[0] != LINK_GAIN_MATRIX_MAGIC)
+    {
+      NS_LOG_WARN (filename << " is not a link gain matrix file");
+      return false;
+    }
+  std::string signature (header[1], ' ');
+  if (header[1] > 0)
+    {
+      file.read (&signature[0], header[1]);
+    }
+  if (!file.good () || signature != GetFallbackSignature ())
+    {
+      NS_LOG_LOGIC (filename << " was computed by another model");
+      return false;
+    }
+
+  std::vector<Ptr<MobilityModel> > mobilities = GetStaticMobilities (nodes);
+  uint32_t n = mobilities.size ();
+  if (header[2] != n)
+    {
+      NS_LOG_LOGIC (filename << " has " << header[2] << " nodes instead of " << n);
+      return false;
+    }
+  for (uint32_t i = 0; i < n; ++i)
+    {
+      uint32_t nodeId;
+      double coordinates[3];
+      file.read (reinterpret_cast<char *> (&nodeId), sizeof (nodeId));
+      file.read (reinterpret_cast<char *> (coordinates), sizeof (coordinates));
+      Ptr<Node> node = mobilities[i]->GetObject<Node> ();
+      Vector position = mobilities[i]->GetPosition ();
+      if (!file.good () || nodeId != (node != 0 ? node->GetId () : i)
+          || coordinates[0] != position.x || coordinates[1] != position.y || coordinates[2] != position.z)
+        {
+          NS_LOG_LOGIC (filename << " has different nodes or positions");
+          return false;
+        }
+    }
+  std::vector<double> gainDb (n * n);
+  if (n > 0)
+    {
+      file.read (reinterpret_cast<char *> (&gainDb[0]), gainDb.size () * sizeof (double));
+      if (!file.good ())
+        {
+          NS_LOG_WARN (filename << " is truncated");
+          return false;
+        }
+    }
+
+  m_gainDb.swap (gainDb);
+  m_signature = signature;
+  SetMobilities (mobilities);
+  return true;
+}
+
+double
+LinkGainMatrixPropagationLossModel::DoCalcRxPower (double txPowerDbm,
+                                                   Ptr<MobilityModel> a,
+                                                   Ptr<MobilityModel> b) const
+{
+  std::map<const MobilityModel *, uint32_t>::const_iterator aIt = m_index.find (PeekPointer (a));
+  if (aIt != m_index.end ())
+    {
+      std::map<const MobilityModel *, uint32_t>::const_iterator bIt = m_index.find (PeekPointer (b));
+      if (bIt != m_index.end ())
+        {
+          return txPowerDbm + m_gainDb[aIt->second * m_mobilities.size () + bIt->second];
+        }
+    }
+  NS_ASSERT_MSG (m_fallback != 0, "link not in the matrix and no fallback model");
+  return m_fallback->CalcRxPower (txPowerDbm, a, b);
+}
+
+int64_t
+LinkGainMatrixPropagationLossModel::DoAssignStreams (int64_t stream)
+{
+  if (m_fallback == 0)
+    {
+      return 0;
+    }
+  m_stream = stream;
+  return m_fallback->AssignStreams (stream);
+}
+
+bool
+LinkGainMatrixPropagationLossModel::DoIsCacheable (void) const
+{
+  return m_fallback == 0 || m_fallback->IsCacheable ();
+}
+
+} // namespace ns3
@@ -0,0 +1,194 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2015 University of Washington
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LINK_GAIN_MATRIX_PROPAGATION_LOSS_MODEL_H
+#define LINK_GAIN_MATRIX_PROPAGATION_LOSS_MODEL_H
+
+#include <ns3/propagation-loss-model.h>
+#include <ns3/mobility-model.h>
+#include <ns3/node-container.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <map>
+
+namespace ns3 {
+
+/**
+ * \ingroup laa-wifi-coexistence
+ *
+ * Propagation loss model looking up the gain of each link in a matrix
+ * computed once, before the simulation, from another model.
+ *
+ * Compute () evaluates the fallback model for every ordered couple of
+ * the given nodes that have a ConstantPositionMobilityModel, and stores
+ * the gain in dB in a dense N x N matrix. The rows are spread over
+ * several threads (see the ThreadCount attribute): each row is computed
+ * by its own copy of the fallback model, created with the same attribute
+ * values, so that the random variables of the copies (e.g., shadowing,
+ * LOS/NLOS state) are never shared between threads. A row computes both
+ * directions of its links, hence a symmetric model gives a symmetric
+ * matrix. The random realizations differ from the ones the fallback
+ * model would have drawn itself: the copies draw from automatically
+ * assigned streams, not from the streams given to AssignStreams (), so
+ * they depend on the seed, the run and the number of random variables
+ * created before Compute (). If the fallback model cannot be copied
+ * (it is chained to another model or has pointer attributes), or if the
+ * nodes have a MobilityBuildingInfo, the matrix is computed by the
+ * fallback model itself in a single thread.
+ *
+ * The model assumes that the received power is the transmitted power
+ * minus a loss which does not depend on it, which is the case of all the
+ * path loss models but not of, e.g., FixedRssLossModel.
+ *
+ * The links whose ends are not both in the matrix, or whose position
+ * changed after the matrix was computed, are handed over to the
+ * fallback model.
+ *
+ * Save () and Load () write and read the matrix to a binary file, in
+ * the byte order of the host, so that several runs on the same topology
+ * compute it only once. A file is loaded only if it holds the same
+ * nodes, at the same positions, and was computed by a model of the same
+ * type with the same attribute values as the fallback model, in a run
+ * with the same RngSeed and RngRun and the same stream assigned.
+ */
+class LinkGainMatrixPropagationLossModel : public PropagationLossModel
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  LinkGainMatrixPropagationLossModel ();
+  virtual ~LinkGainMatrixPropagationLossModel ();
+
+  /**
+   * \param model the model the matrix is computed from, and which gives
+   * the loss of the links not in the matrix
+   */
+  void SetFallbackModel (Ptr<PropagationLossModel> model);
+  /**
+   * \return the fallback model
+   */
+  Ptr<PropagationLossModel> GetFallbackModel (void) const;
+
+  /**
+   * Compute the gains of the links between the nodes with a
+   * ConstantPositionMobilityModel.
+   *
+   * \param nodes the nodes
+   */
+  void Compute (NodeContainer nodes);
+
+  /**
+   * Read a matrix written by Save ().
+   *
+   * \param filename the name of the file
+   * \param nodes the nodes, as they would be passed to Compute ()
+   * \return true if the file matches the nodes and the fallback model
+   * and was loaded, false if the matrix is unchanged
+   */
+  bool Load (std::string filename, NodeContainer nodes);
+
+  /**
+   * Write the matrix to a file.
+   *
+   * \param filename the name of the file
+   * \return true if the file could be written
+   */
+  bool Save (std::string filename) const;
+
+  /**
+   * \return the number of nodes in the matrix
+   */
+  uint32_t GetN (void) const;
+
+protected:
+  virtual void DoDispose (void);
+
+private:
+  // inherited from PropagationLossModel
+  virtual double DoCalcRxPower (double txPowerDbm,
+                                Ptr<MobilityModel> a,
+                                Ptr<MobilityModel> b) const;
+  virtual int64_t DoAssignStreams (int64_t stream);
+  virtual bool DoIsCacheable (void) const;
+
+  /// The rows of the matrix computed by a thread.
+  struct ComputeTask
+  {
+    /// Compute the rows.
+    void Run (void);
+
+    const std::vector<Ptr<PropagationLossModel> > *models;  //!< The model of each row.
+    std::vector<Ptr<MobilityModel> > mobilities;  //!< The ends of the links, owned by the thread.
+    double *gainDb;     //!< The matrix.
+    uint32_t n;         //!< The number of rows.
+    uint32_t first;     //!< The first row.
+    uint32_t step;      //!< The distance between two rows.
+  };
+
+  /**
+   * \param nodes the nodes
+   * \return the mobility models of the nodes to be put in the matrix
+   */
+  static std::vector<Ptr<MobilityModel> > GetStaticMobilities (NodeContainer nodes);
+  /**
+   * \return a description of the type and attribute values of the
+   * fallback model, and of the run of its random variables
+   */
+  std::string GetFallbackSignature (void) const;
+  /**
+   * \param mobilities the mobility models of the nodes
+   * \return true if the rows can be computed by copies of the fallback
+   * model in parallel threads
+   */
+  bool CanComputeInParallel (const std::vector<Ptr<MobilityModel> > &mobilities) const;
+  /**
+   * \return a new model with the type and attribute values of the
+   * fallback model
+   */
+  Ptr<PropagationLossModel> CopyFallbackModel (void) const;
+  /**
+   * Make the given nodes the rows of the matrix.
+   *
+   * \param mobilities the mobility models of the nodes
+   */
+  void SetMobilities (const std::vector<Ptr<MobilityModel> > &mobilities);
+  /**
+   * Remove a node whose position changed from the matrix.
+   *
+   * \param mobility the mobility model of the node
+   */
+  void CourseChanged (Ptr<const MobilityModel> mobility);
+
+  Ptr<PropagationLossModel> m_fallback;                //!< The fallback model.
+  uint32_t m_threadCount;                              //!< The ThreadCount attribute.
+  std::vector<Ptr<MobilityModel> > m_mobilities;       //!< The mobility model of each row.
+  std::vector<uint32_t> m_nodeIds;                     //!< The node of each row.
+  std::map<const MobilityModel *, uint32_t> m_index;   //!< The row of each mobility model.
+  std::vector<double> m_gainDb;                        //!< The gains (dB), by row of the transmitter.
+  std::string m_signature;                             //!< The signature of the model the matrix was computed from.
+  int64_t m_stream;                                    //!< The first stream assigned, or -1.
+};
+
+} // namespace ns3
+
+#endif /* LINK_GAIN_MATRIX_PROPAGATION_LOSS_MODEL_H */
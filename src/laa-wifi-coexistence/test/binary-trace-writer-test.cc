@@ -0,0 +1,116 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2015 University of Washington
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cstdio>
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/binary-trace-writer.h"
+
+using namespace ns3;
+
+// Logs are enabled when running a debug build through 'test-runner'
+NS_LOG_COMPONENT_DEFINE ("BinaryTraceWriterTest");
+
+/**
+ * Writes records spanning several chunks and checks that they are read
+ * back unchanged and in order.
+ */
+class BinaryTraceWriterRoundTripTest : public TestCase
+{
+public:
+  BinaryTraceWriterRoundTripTest ();
+  virtual ~BinaryTraceWriterRoundTripTest ();
+
+private:
+  virtual void DoRun (void);
+
+  /// A test record.
+  struct Record
+  {
+    int64_t m_time;
+    double m_value;
+    uint32_t m_id;
+  };
+};
+
+BinaryTraceWriterRoundTripTest::BinaryTraceWriterRoundTripTest ()
+  : TestCase ("Records written by a BinaryTraceWriter are read back in order")
+{
+}
+
+BinaryTraceWriterRoundTripTest::~BinaryTraceWriterRoundTripTest ()
+{
+}
+
+void
+BinaryTraceWriterRoundTripTest::DoRun (void)
+{
+  const uint32_t type = 7;
+  const uint32_t chunkRecords = 16;
+  const uint32_t nRecords = 40 * chunkRecords + 5;
+  std::string filename = CreateTempDirFilename ("binary-trace-writer-test.bin");
+
+  Ptr<BinaryTraceWriter> writer = Create<BinaryTraceWriter> (filename, type, sizeof (Record), chunkRecords);
+  NS_TEST_ASSERT_MSG_EQ (writer->IsOpen (), true, "cannot open " << filename);
+  for (uint32_t i = 0; i < nRecords; i++)
+    {
+      Record record;
+      record.m_time = 1000 * i;
+      record.m_value = 0.5 * i;
+      record.m_id = i;
+      writer->Write (record);
+    }
+  NS_TEST_ASSERT_MSG_EQ (writer->GetNRecords (), nRecords, "wrong number of records written");
+  writer->Close ();
+
+  BinaryTraceReader reader (filename);
+  NS_TEST_ASSERT_MSG_EQ (reader.IsOpen (), true, "cannot read " << filename);
+  NS_TEST_ASSERT_MSG_EQ (reader.GetType (), type, "wrong record type");
+  NS_TEST_ASSERT_MSG_EQ (reader.GetRecordSize (), sizeof (Record), "wrong record size");
+  Record record;
+  uint32_t n = 0;
+  while (reader.Read (record))
+    {
+      NS_TEST_ASSERT_MSG_EQ (record.m_id, n, "record out of order");
+      NS_TEST_ASSERT_MSG_EQ (record.m_time, 1000 * n, "wrong record time");
+      NS_TEST_ASSERT_MSG_EQ (record.m_value, 0.5 * n, "wrong record value");
+      n++;
+    }
+  NS_TEST_ASSERT_MSG_EQ (n, nRecords, "wrong number of records read");
+
+  // a record of the wrong size is not read
+  BinaryTraceReader otherReader (filename);
+  uint32_t wrongSize;
+  NS_TEST_ASSERT_MSG_EQ (otherReader.Read (wrongSize), false, "record of the wrong size read");
+
+  std::remove (filename.c_str ());
+}
+
+class BinaryTraceWriterTestSuite : public TestSuite
+{
+public:
+  BinaryTraceWriterTestSuite ();
+};
+
+BinaryTraceWriterTestSuite::BinaryTraceWriterTestSuite ()
+  : TestSuite ("binary-trace-writer", UNIT)
+{
+  AddTestCase (new BinaryTraceWriterRoundTripTest, TestCase::QUICK);
+}
+
+static BinaryTraceWriterTestSuite binaryTraceWriterTestSuite;
@@ -34,6 +34,8 @@
 #include "ns3/wifi-phy-standard.h"
 #include "ns3/wifi-spectrum-signal-parameters.h"
 #include "ns3/lbt-access-manager.h"
+#include "ns3/energy-detection-spectrum-phy.h"
+#include "ns3/enum.h"
 
 using namespace ns3;
 
@@ -233,6 +235,120 @@ LbtAccessManagerEdThresholdTest::DoRun (void)
   Simulator::Destroy ();
 }
 
+// Same ED threshold checks, with the channel sensed by an
+// EnergyDetectionSpectrumPhy instead of a SpectrumWifiPhy
+class LbtAccessManagerEdPhyThresholdTest : public TestCase
+{
+public:
+  LbtAccessManagerEdPhyThresholdTest ();
+  virtual ~LbtAccessManagerEdPhyThresholdTest ();
+protected:
+  virtual void DoSetup (void);
+  Ptr<EnergyDetectionSpectrumPhy> m_phy;
+  Ptr<LbtAccessManager> m_lbt;
+  void SendSignal (double txPowerWatts, Time duration);
+private:
+  virtual void DoRun (void);
+  void ReceiveAccessGranted (Time duration);
+  void SetEdThreshold (double edThreshold);
+  void CheckState (LbtAccessManager::LbtState state);
+};
+
+LbtAccessManagerEdPhyThresholdTest::LbtAccessManagerEdPhyThresholdTest ()
+  : TestCase ("LbtAccessManager testing of ED threshold with an EnergyDetectionSpectrumPhy")
+{
+}
+
+LbtAccessManagerEdPhyThresholdTest::~LbtAccessManagerEdPhyThresholdTest ()
+{
+}
+
+// Make a non Wi-Fi signal with a Wi-Fi PSD and inject it directly to the StartRx() method
+void
+LbtAccessManagerEdPhyThresholdTest::SendSignal (double txPowerWatts, Time duration)
+{
+  Ptr<SpectrumSignalParameters> txParams = Create<SpectrumSignalParameters> ();
+  txParams->psd = WifiSpectrumHelper::CreateTxPowerSpectralDensity (txPowerWatts, WifiPhy::GetHtMcs0 (), CHANNEL_NUMBER);
+  txParams->txPhy = 0;
+  txParams->duration = duration;
+  m_phy->StartRx (txParams);
+}
+
+void
+LbtAccessManagerEdPhyThresholdTest::SetEdThreshold (double edThreshold)
+{
+  bool ok = m_lbt->SetAttributeFailSafe ("EnergyDetectionThreshold", DoubleValue (edThreshold));
+  NS_TEST_ASSERT_MSG_EQ (ok, true, "Could not set attribute");
+  // change the underlying EnergyDetectionSpectrumPhy threshold via the LbtAccessManager
+  m_lbt->SetEnergyDetectionPhy (m_phy);
+}
+
+void
+LbtAccessManagerEdPhyThresholdTest::ReceiveAccessGranted (Time duration)
+{
+  NS_FATAL_ERROR ("Should be unreachable; LTE not yet part of this test");
+}
+
+void
+LbtAccessManagerEdPhyThresholdTest::DoSetup (void)
+{
+  m_phy = CreateObject<EnergyDetectionSpectrumPhy> ();
+  m_phy->SetChannelNumber (CHANNEL_NUMBER);
+  m_phy->SetAttribute ("RxGain", DoubleValue (0.0));
+
+  m_lbt = CreateObject<LbtAccessManager> ();
+  m_lbt->SetAttribute ("ChannelSenseMode", EnumValue (LbtAccessManager::ED));
+  m_lbt->SetAttribute ("EnergyDetectionThreshold", DoubleValue (-62.0));
+  m_lbt->SetEnergyDetectionPhy (m_phy);
+  m_lbt->SetAccessGrantedCallback (MakeCallback (&LbtAccessManagerEdPhyThresholdTest::ReceiveAccessGranted, this));
+}
+
+void
+LbtAccessManagerEdPhyThresholdTest::CheckState (LbtAccessManager::LbtState state)
+{
+  NS_TEST_ASSERT_MSG_EQ (state, m_lbt->GetLbtState (), "Failed at time " << Simulator::Now());
+}
+
+void
+LbtAccessManagerEdPhyThresholdTest::DoRun (void)
+{
+  Time duration = MicroSeconds (1292);
+  double txPowerWatts = 1e-9;  // -60 dBm
+  Simulator::Schedule (Seconds (0.5), &LbtAccessManagerEdPhyThresholdTest::CheckState, this, LbtAccessManager::IDLE);
+
+  // Above threshold: BUSY just for the duration of the signal
+  Simulator::Schedule (Seconds (1), &LbtAccessManagerEdPhyThresholdTest::SendSignal, this, txPowerWatts, duration);
+  Simulator::Schedule (MicroSeconds (1001291), &LbtAccessManagerEdPhyThresholdTest::CheckState, this, LbtAccessManager::BUSY);
+  Simulator::Schedule (MicroSeconds (1001293), &LbtAccessManagerEdPhyThresholdTest::CheckState, this, LbtAccessManager::IDLE);
+
+  // Below threshold
+  txPowerWatts = 5e-10;  // -63 dBm
+  Simulator::Schedule (Seconds (2), &LbtAccessManagerEdPhyThresholdTest::SendSignal, this, txPowerWatts, duration);
+  Simulator::Schedule (MicroSeconds (2001000), &LbtAccessManagerEdPhyThresholdTest::CheckState, this, LbtAccessManager::IDLE);
+
+  // Two signals below threshold sent 700 us apart add up above it until
+  // the first one ends
+  Simulator::Schedule (MicroSeconds (5000000), &LbtAccessManagerEdPhyThresholdTest::SendSignal, this, txPowerWatts, duration);
+  Simulator::Schedule (MicroSeconds (5000700), &LbtAccessManagerEdPhyThresholdTest::SendSignal, this, txPowerWatts, duration);
+  Simulator::Schedule (MicroSeconds (5000699), &LbtAccessManagerEdPhyThresholdTest::CheckState, this, LbtAccessManager::IDLE);
+  Simulator::Schedule (MicroSeconds (5000701), &LbtAccessManagerEdPhyThresholdTest::CheckState, this, LbtAccessManager::BUSY);
+  Simulator::Schedule (MicroSeconds (5001291), &LbtAccessManagerEdPhyThresholdTest::CheckState, this, LbtAccessManager::BUSY);
+  Simulator::Schedule (MicroSeconds (5001293), &LbtAccessManagerEdPhyThresholdTest::CheckState, this, LbtAccessManager::IDLE);
+
+  // Lower the LBT ED threshold to -72 dBm
+  Simulator::Schedule (MicroSeconds (6000000), &LbtAccessManagerEdPhyThresholdTest::SetEdThreshold, this, -72.0);
+  txPowerWatts = 1.58e-10;  // -68 dBm
+  Simulator::Schedule (MicroSeconds (6001000), &LbtAccessManagerEdPhyThresholdTest::SendSignal, this, txPowerWatts, duration);
+  Simulator::Schedule (MicroSeconds (6001050), &LbtAccessManagerEdPhyThresholdTest::CheckState, this, LbtAccessManager::BUSY);
+  txPowerWatts = 5e-11;  // -73 dBm
+  Simulator::Schedule (MicroSeconds (7001000), &LbtAccessManagerEdPhyThresholdTest::SendSignal, this, txPowerWatts, duration);
+  Simulator::Schedule (MicroSeconds (7001050), &LbtAccessManagerEdPhyThresholdTest::CheckState, this, LbtAccessManager::IDLE);
+
+  Simulator::Stop (Seconds (10));
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
 class TestPhyListener : public ns3::WifiPhyListener
 {
 public:
@@ -295,6 +411,7 @@ LbtAccessManagerEdThresholdTestSuite::LbtAccessManagerEdThresholdTestSuite ()
   : TestSuite ("lbt-access-manager-ed-threshold", UNIT)
 {
   AddTestCase (new LbtAccessManagerEdThresholdTest, TestCase::QUICK);
+  AddTestCase (new LbtAccessManagerEdPhyThresholdTest, TestCase::QUICK);
 }
 
 static LbtAccessManagerEdThresholdTestSuite lbtAccessManagerTestSuite;
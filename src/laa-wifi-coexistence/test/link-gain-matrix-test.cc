@@ -0,0 +1,229 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2015 University of Washington
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cstdio>
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/double.h"
+#include "ns3/uinteger.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/node-container.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/propagation-loss-model.h"
+#include "ns3/itu-umi-propagation-loss-model.h"
+#include "ns3/link-gain-matrix-propagation-loss-model.h"
+
+using namespace ns3;
+
+// Logs are enabled when running a debug build through 'test-runner'
+NS_LOG_COMPONENT_DEFINE ("LinkGainMatrixTest");
+
+/**
+ * Place nodes with constant positions on a line.
+ *
+ * \param nodes the nodes
+ */
+static void
+InstallConstantPositions (NodeContainer nodes)
+{
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  for (uint32_t i = 0; i < nodes.GetN (); i++)
+    {
+      positionAlloc->Add (Vector (17.0 * i, 3.0 * i * i, 1.5));
+    }
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.Install (nodes);
+}
+
+/**
+ * Checks that the matrix holds the gains of the fallback model for the
+ * static nodes, and that the other links are handed over to it.
+ */
+class LinkGainMatrixFallbackTest : public TestCase
+{
+public:
+  LinkGainMatrixFallbackTest ();
+  virtual ~LinkGainMatrixFallbackTest ();
+
+private:
+  virtual void DoRun (void);
+};
+
+LinkGainMatrixFallbackTest::LinkGainMatrixFallbackTest ()
+  : TestCase ("The link gain matrix holds the gains of the fallback model")
+{
+}
+
+LinkGainMatrixFallbackTest::~LinkGainMatrixFallbackTest ()
+{
+}
+
+void
+LinkGainMatrixFallbackTest::DoRun (void)
+{
+  NodeContainer nodes;
+  nodes.Create (6);
+  InstallConstantPositions (nodes);
+  NodeContainer mobileNode;
+  mobileNode.Create (1);
+  Ptr<ConstantVelocityMobilityModel> mobile = CreateObject<ConstantVelocityMobilityModel> ();
+  mobile->SetPosition (Vector (40.0, 10.0, 1.5));
+  mobileNode.Get (0)->AggregateObject (mobile);
+  nodes.Add (mobileNode);
+
+  Ptr<PropagationLossModel> friis = CreateObject<FriisPropagationLossModel> ();
+  Ptr<LinkGainMatrixPropagationLossModel> matrix = CreateObject<LinkGainMatrixPropagationLossModel> ();
+  matrix->SetAttribute ("ThreadCount", UintegerValue (3));
+  matrix->SetFallbackModel (friis);
+  matrix->Compute (nodes);
+  NS_TEST_ASSERT_MSG_EQ (matrix->GetN (), 6, "only the nodes with a constant position are in the matrix");
+
+  for (uint32_t i = 0; i < nodes.GetN (); i++)
+    {
+      Ptr<MobilityModel> a = nodes.Get (i)->GetObject<MobilityModel> ();
+      for (uint32_t j = 0; j < nodes.GetN (); j++)
+        {
+          Ptr<MobilityModel> b = nodes.Get (j)->GetObject<MobilityModel> ();
+          NS_TEST_ASSERT_MSG_EQ_TOL (matrix->CalcRxPower (20.0, a, b), friis->CalcRxPower (20.0, a, b), 1e-9,
+                                     "wrong gain from node " << i << " to node " << j);
+        }
+    }
+
+  // a node which moves after the matrix is computed is handed over to the fallback model
+  Ptr<MobilityModel> a = nodes.Get (0)->GetObject<MobilityModel> ();
+  Ptr<MobilityModel> b = nodes.Get (1)->GetObject<MobilityModel> ();
+  double before = matrix->CalcRxPower (20.0, a, b);
+  b->SetPosition (Vector (500.0, 0.0, 1.5));
+  NS_TEST_ASSERT_MSG_EQ_TOL (matrix->CalcRxPower (20.0, a, b), friis->CalcRxPower (20.0, a, b), 1e-9,
+                             "the gain of a moved node comes from the fallback model");
+  NS_TEST_ASSERT_MSG_NE (matrix->CalcRxPower (20.0, a, b), before, "the gain of a moved node is not updated");
+}
+
+/**
+ * Checks that a matrix computed in parallel from a random model is
+ * symmetric, and that it is saved and loaded back only for the same
+ * topology and model.
+ */
+class LinkGainMatrixSaveLoadTest : public TestCase
+{
+public:
+  LinkGainMatrixSaveLoadTest ();
+  virtual ~LinkGainMatrixSaveLoadTest ();
+
+private:
+  virtual void DoRun (void);
+};
+
+LinkGainMatrixSaveLoadTest::LinkGainMatrixSaveLoadTest ()
+  : TestCase ("A link gain matrix is symmetric and is loaded back for the same topology only")
+{
+}
+
+LinkGainMatrixSaveLoadTest::~LinkGainMatrixSaveLoadTest ()
+{
+}
+
+void
+LinkGainMatrixSaveLoadTest::DoRun (void)
+{
+  NodeContainer nodes;
+  nodes.Create (9);
+  InstallConstantPositions (nodes);
+
+  Ptr<PropagationLossModel> ituUmi = CreateObject<ItuUmiPropagationLossModel> ();
+  ituUmi->SetAttribute ("Frequency", DoubleValue (5.18e9));
+  Ptr<LinkGainMatrixPropagationLossModel> matrix = CreateObject<LinkGainMatrixPropagationLossModel> ();
+  matrix->SetAttribute ("ThreadCount", UintegerValue (4));
+  matrix->SetFallbackModel (ituUmi);
+  matrix->Compute (nodes);
+  NS_TEST_ASSERT_MSG_EQ (matrix->GetN (), nodes.GetN (), "wrong number of nodes in the matrix");
+  for (uint32_t i = 0; i < nodes.GetN (); i++)
+    {
+      Ptr<MobilityModel> a = nodes.Get (i)->GetObject<MobilityModel> ();
+      for (uint32_t j = i + 1; j < nodes.GetN (); j++)
+        {
+          Ptr<MobilityModel> b = nodes.Get (j)->GetObject<MobilityModel> ();
+          NS_TEST_ASSERT_MSG_EQ (matrix->CalcRxPower (0.0, a, b), matrix->CalcRxPower (0.0, b, a),
+                                 "asymmetric gain between nodes " << i << " and " << j);
+        }
+    }
+
+  std::string filename = CreateTempDirFilename ("link-gain-matrix-test.bin");
+  NS_TEST_ASSERT_MSG_EQ (matrix->Save (filename), true, "cannot write " << filename);
+
+  Ptr<PropagationLossModel> otherItuUmi = CreateObject<ItuUmiPropagationLossModel> ();
+  otherItuUmi->SetAttribute ("Frequency", DoubleValue (5.18e9));
+  Ptr<LinkGainMatrixPropagationLossModel> loaded = CreateObject<LinkGainMatrixPropagationLossModel> ();
+  loaded->SetFallbackModel (otherItuUmi);
+  NS_TEST_ASSERT_MSG_EQ (loaded->Load (filename, nodes), true, "cannot load " << filename);
+  NS_TEST_ASSERT_MSG_EQ (loaded->GetN (), nodes.GetN (), "wrong number of nodes loaded");
+  for (uint32_t i = 0; i < nodes.GetN (); i++)
+    {
+      Ptr<MobilityModel> a = nodes.Get (i)->GetObject<MobilityModel> ();
+      for (uint32_t j = 0; j < nodes.GetN (); j++)
+        {
+          Ptr<MobilityModel> b = nodes.Get (j)->GetObject<MobilityModel> ();
+          NS_TEST_ASSERT_MSG_EQ (loaded->CalcRxPower (0.0, a, b), matrix->CalcRxPower (0.0, a, b),
+                                 "wrong gain loaded from node " << i << " to node " << j);
+        }
+    }
+
+  // another model configuration
+  Ptr<PropagationLossModel> otherFrequency = CreateObject<ItuUmiPropagationLossModel> ();
+  otherFrequency->SetAttribute ("Frequency", DoubleValue (5.5e9));
+  Ptr<LinkGainMatrixPropagationLossModel> rejected = CreateObject<LinkGainMatrixPropagationLossModel> ();
+  rejected->SetFallbackModel (otherFrequency);
+  NS_TEST_ASSERT_MSG_EQ (rejected->Load (filename, nodes), false, "matrix of another model loaded");
+  NS_TEST_ASSERT_MSG_EQ (rejected->GetN (), 0, "matrix changed by a rejected file");
+
+  // another topology
+  rejected->SetFallbackModel (otherItuUmi);
+  NodeContainer fewerNodes;
+  for (uint32_t i = 0; i < nodes.GetN () - 1; i++)
+    {
+      fewerNodes.Add (nodes.Get (i));
+    }
+  NS_TEST_ASSERT_MSG_EQ (rejected->Load (filename, fewerNodes), false, "matrix of other nodes loaded");
+  // another run
+  uint64_t run = RngSeedManager::GetRun ();
+  RngSeedManager::SetRun (run + 1);
+  NS_TEST_EXPECT_MSG_EQ (rejected->Load (filename, nodes), false, "matrix of another run loaded");
+  RngSeedManager::SetRun (run);
+  nodes.Get (4)->GetObject<MobilityModel> ()->SetPosition (Vector (-10.0, 0.0, 1.5));
+  NS_TEST_ASSERT_MSG_EQ (rejected->Load (filename, nodes), false, "matrix of other positions loaded");
+
+  std::remove (filename.c_str ());
+}
+
+class LinkGainMatrixTestSuite : public TestSuite
+{
+public:
+  LinkGainMatrixTestSuite ();
+};
+
+LinkGainMatrixTestSuite::LinkGainMatrixTestSuite ()
+  : TestSuite ("link-gain-matrix", UNIT)
+{
+  AddTestCase (new LinkGainMatrixFallbackTest, TestCase::QUICK);
+  AddTestCase (new LinkGainMatrixSaveLoadTest, TestCase::QUICK);
+}
+
+static LinkGainMatrixTestSuite linkGainMatrixTestSuite;
@@ -292,7 +292,7 @@ LrWpanPhy::StartRx (Ptr<SpectrumSignalParameters> spectrumRxParams)
   if (lrWpanRxParams == 0)
     {
       CheckInterference ();
-      m_signal->AddSignal (spectrumRxParams->psd);
+      m_signal->AddSignal (spectrumRxParams->GetPsd ());
 
       // Update peak power if CCA is in progress.
       if (!m_ccaRequest.IsExpired ())
@@ -330,8 +330,9 @@ LrWpanPhy::StartRx (Ptr<SpectrumSignalParameters> spectrumRxParams)
 
       // Add any incoming packet to the current interference before checking the
       // SINR.
-      NS_LOG_DEBUG (this << " receiving packet with power: " << 10 * log10(LrWpanSpectrumValueHelper::TotalAvgPower (lrWpanRxParams->psd, m_phyPIBAttributes.phyCurrentChannel)) + 30 << "dBm");
-      m_signal->AddSignal (lrWpanRxParams->psd);
+      Ptr<SpectrumValue> rxPsd = lrWpanRxParams->GetPsd ();
+      NS_LOG_DEBUG (this << " receiving packet with power: " << 10 * log10(LrWpanSpectrumValueHelper::TotalAvgPower (rxPsd, m_phyPIBAttributes.phyCurrentChannel)) + 30 << "dBm");
+      m_signal->AddSignal (rxPsd);
       Ptr<SpectrumValue> interferenceAndNoise = m_signal->GetSignalPsd ();
       *interferenceAndNoise -= *lrWpanRxParams->psd;
       *interferenceAndNoise += *m_noise;
@@ -365,7 +366,7 @@ LrWpanPhy::StartRx (Ptr<SpectrumSignalParameters> spectrumRxParams)
       // Add the incoming packet to the current interference after we have
       // checked for successfull reception of the current packet for the time
       // before the additional interference.
-      m_signal->AddSignal (lrWpanRxParams->psd);
+      m_signal->AddSignal (lrWpanRxParams->GetPsd ());
     }
   else
     {
@@ -374,7 +375,7 @@ LrWpanPhy::StartRx (Ptr<SpectrumSignalParameters> spectrumRxParams)
       m_phyRxDropTrace (p);
 
       // Add the signal power to the interference, anyway.
-      m_signal->AddSignal (lrWpanRxParams->psd);
+      m_signal->AddSignal (lrWpanRxParams->GetPsd ());
     }
 
   // Update peak power if CCA is in progress.
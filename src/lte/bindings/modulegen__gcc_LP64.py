@@ -290,6 +290,8 @@ def register_types(module):
     module.add_class('SchedDlConfigIndParameters', outer_class=root_module['ns3::FfMacSchedSapUser'])
     ## ff-mac-sched-sap.h (module 'lte'): ns3::FfMacSchedSapUser::SchedUlConfigIndParameters [struct]
     module.add_class('SchedUlConfigIndParameters', outer_class=root_module['ns3::FfMacSchedSapUser'])
+    ## ff-mac-scheduler-ue-table.h (module 'lte'): ns3::FfMacSchedulerUeTable [class]
+    module.add_class('FfMacSchedulerUeTable')
     ## eps-bearer.h (module 'lte'): ns3::GbrQosInformation [struct]
     module.add_class('GbrQosInformation')
     ## lte-harq-phy.h (module 'lte'): ns3::HarqProcessInfoElement_t [struct]
@@ -1056,6 +1058,8 @@ def register_types(module):
     module.add_enum('AmcModel', ['PiroEW2010', 'MiErrorModel'], outer_class=root_module['ns3::LteAmc'])
     ## lte-anr.h (module 'lte'): ns3::LteAnr [class]
     module.add_class('LteAnr', parent=root_module['ns3::Object'])
+    ## lte-chunk-processor.h (module 'lte'): ns3::LteChunkArena [class]
+    module.add_class('LteChunkArena')
     ## lte-chunk-processor.h (module 'lte'): ns3::LteChunkProcessor [class]
     module.add_class('LteChunkProcessor', parent=root_module['ns3::SimpleRefCount< ns3::LteChunkProcessor, ns3::empty, ns3::DefaultDeleter<ns3::LteChunkProcessor> >'])
     ## lte-control-messages.h (module 'lte'): ns3::LteControlMessage [class]
@@ -1100,8 +1104,6 @@ def register_types(module):
     module.add_class('LteInterference', parent=root_module['ns3::Object'])
     ## lte-chunk-processor.h (module 'lte'): ns3::LteListChunkProcessor [class]
     module.add_class('LteListChunkProcessor', parent=root_module['ns3::LteChunkProcessor'])
-    ## lte-chunk-processor.h (module 'lte'): ns3::LteListChunkProcessor::Chunk [struct]
-    module.add_class('Chunk', outer_class=root_module['ns3::LteListChunkProcessor'])
     ## lte-pdcp.h (module 'lte'): ns3::LtePdcp [class]
     module.add_class('LtePdcp', parent=root_module['ns3::Object'])
     ## lte-pdcp.h (module 'lte'): ns3::LtePdcp::Status [struct]
@@ -1364,7 +1366,8 @@ def register_types(module):
     module.add_container('std::map< std::string, ns3::LogComponent * >', ('std::string', 'ns3::LogComponent *'), container_type=u'map')
     module.add_container('std::map< unsigned short, std::vector< double > >', ('short unsigned int', 'std::vector< double >'), container_type=u'map')
     module.add_container('std::vector< int >', 'int', container_type=u'vector')
-    module.add_container('std::list< ns3::LteListChunkProcessor::Chunk >', 'ns3::LteListChunkProcessor::Chunk', container_type=u'list')
+    module.add_container('std::list< ns3::EpcTft::PacketFilter >', 'ns3::EpcTft::PacketFilter', container_type=u'list')
+    module.add_container('std::vector< unsigned long >', 'long unsigned int', container_type=u'vector')
     module.add_container('ns3::HarqProcessInfoList_t', 'ns3::HarqProcessInfoElement_t', container_type=u'vector')
     module.add_container('std::list< ns3::LteRrcSap::SrbToAddMod >', 'ns3::LteRrcSap::SrbToAddMod', container_type=u'list')
     module.add_container('std::list< ns3::LteRrcSap::DrbToAddMod >', 'ns3::LteRrcSap::DrbToAddMod', container_type=u'list')
@@ -1685,6 +1688,7 @@ def register_methods(root_module):
     register_Ns3FfMacSchedSapUser_methods(root_module, root_module['ns3::FfMacSchedSapUser'])
     register_Ns3FfMacSchedSapUserSchedDlConfigIndParameters_methods(root_module, root_module['ns3::FfMacSchedSapUser::SchedDlConfigIndParameters'])
     register_Ns3FfMacSchedSapUserSchedUlConfigIndParameters_methods(root_module, root_module['ns3::FfMacSchedSapUser::SchedUlConfigIndParameters'])
+    register_Ns3FfMacSchedulerUeTable_methods(root_module, root_module['ns3::FfMacSchedulerUeTable'])
     register_Ns3GbrQosInformation_methods(root_module, root_module['ns3::GbrQosInformation'])
     register_Ns3HarqProcessInfoElement_t_methods(root_module, root_module['ns3::HarqProcessInfoElement_t'])
     register_Ns3Hasher_methods(root_module, root_module['ns3::Hasher'])
@@ -2011,6 +2015,7 @@ def register_methods(root_module):
     register_Ns3LogNormalRandomVariable_methods(root_module, root_module['ns3::LogNormalRandomVariable'])
     register_Ns3LteAmc_methods(root_module, root_module['ns3::LteAmc'])
     register_Ns3LteAnr_methods(root_module, root_module['ns3::LteAnr'])
+    register_Ns3LteChunkArena_methods(root_module, root_module['ns3::LteChunkArena'])
     register_Ns3LteChunkProcessor_methods(root_module, root_module['ns3::LteChunkProcessor'])
     register_Ns3LteControlMessage_methods(root_module, root_module['ns3::LteControlMessage'])
     register_Ns3LteEnbMac_methods(root_module, root_module['ns3::LteEnbMac'])
@@ -2031,7 +2036,6 @@ def register_methods(root_module):
     register_Ns3LteHexGridEnbTopologyHelper_methods(root_module, root_module['ns3::LteHexGridEnbTopologyHelper'])
     register_Ns3LteInterference_methods(root_module, root_module['ns3::LteInterference'])
     register_Ns3LteListChunkProcessor_methods(root_module, root_module['ns3::LteListChunkProcessor'])
-    register_Ns3LteListChunkProcessorChunk_methods(root_module, root_module['ns3::LteListChunkProcessor::Chunk'])
     register_Ns3LtePdcp_methods(root_module, root_module['ns3::LtePdcp'])
     register_Ns3LtePdcpStatus_methods(root_module, root_module['ns3::LtePdcp::Status'])
     register_Ns3LtePhy_methods(root_module, root_module['ns3::LtePhy'])
@@ -4522,6 +4526,127 @@ def register_Ns3FfMacSchedSapUserSchedUlConfigIndParameters_methods(root_module,
     cls.add_instance_attribute('m_vendorSpecificList', 'std::vector< ns3::VendorSpecificListElement_s >', is_const=False)
     return
 
+def register_Ns3FfMacSchedulerUeTable_methods(root_module, cls):
+    ## ff-mac-scheduler-ue-table.h (module 'lte'): ns3::FfMacSchedulerUeTable::FfMacSchedulerUeTable(ns3::FfMacSchedulerUeTable const & arg0) [copy constructor]
+    cls.add_constructor([param('ns3::FfMacSchedulerUeTable const &', 'arg0')])
+    ## ff-mac-scheduler-ue-table.h (module 'lte'): ns3::FfMacSchedulerUeTable::FfMacSchedulerUeTable() [constructor]
+    cls.add_constructor([])
+    ## ff-mac-scheduler-ue-table.h (module 'lte'): uint32_t ns3::FfMacSchedulerUeTable::AddUe(uint16_t rnti) [member function]
+    cls.add_method('AddUe', 
+                   'uint32_t', 
+                   [param('uint16_t', 'rnti')])
+    ## ff-mac-scheduler-ue-table.h (module 'lte'): void ns3::FfMacSchedulerUeTable::Clear() [member function]
+    cls.add_method('Clear', 
+                   'void', 
+                   [])
+    ## ff-mac-scheduler-ue-table.h (module 'lte'): uint8_t ns3::FfMacSchedulerUeTable::GetDlHarqCurrentProcessId(uint32_t slot) const [member function]
+    cls.add_method('GetDlHarqCurrentProcessId', 
+                   'uint8_t', 
+                   [param('uint32_t', 'slot')], 
+                   is_const=True)
+    ## ff-mac-scheduler-ue-table.h (module 'lte'): uint8_t * ns3::FfMacSchedulerUeTable::GetDlHarqProcessesStatus(uint32_t slot) [member function]
+    cls.add_method('GetDlHarqProcessesStatus', 
+                   'uint8_t *', 
+                   [param('uint32_t', 'slot')])
+    ## ff-mac-scheduler-ue-table.h (module 'lte'): uint8_t * ns3::FfMacSchedulerUeTable::GetDlHarqProcessesTimer(uint32_t slot) [member function]
+    cls.add_method('GetDlHarqProcessesTimer', 
+                   'uint8_t *', 
+                   [param('uint32_t', 'slot')])
+    ## ff-mac-scheduler-ue-table.h (module 'lte'): uint8_t ns3::FfMacSchedulerUeTable::GetDlLayers(uint32_t slot) const [member function]
+    cls.add_method('GetDlLayers', 
+                   'uint8_t', 
+                   [param('uint32_t', 'slot')], 
+                   is_const=True)
+    ## ff-mac-scheduler-ue-table.h (module 'lte'): uint32_t ns3::FfMacSchedulerUeTable::GetDlRbgNum() const [member function]
+    cls.add_method('GetDlRbgNum', 
+                   'uint32_t', 
+                   [], 
+                   is_const=True)
+    ## ff-mac-scheduler-ue-table.h (module 'lte'): uint8_t ns3::FfMacSchedulerUeTable::GetDlSbCqi(uint32_t slot, uint8_t layer, uint32_t rbg) const [member function]
+    cls.add_method('GetDlSbCqi', 
+                   'uint8_t', 
+                   [param('uint32_t', 'slot'), param('uint8_t', 'layer'), param('uint32_t', 'rbg')], 
+                   is_const=True)
+    ## ff-mac-scheduler-ue-table.h (module 'lte'): uint8_t const * ns3::FfMacSchedulerUeTable::GetDlSbCqiRow(uint8_t layer, uint32_t rbg) const [member function]
+    cls.add_method('GetDlSbCqiRow', 
+                   'uint8_t const *', 
+                   [param('uint8_t', 'layer'), param('uint32_t', 'rbg')], 
+                   is_const=True)
+    ## ff-mac-scheduler-ue-table.h (module 'lte'): uint32_t ns3::FfMacSchedulerUeTable::GetNSlots() const [member function]
+    cls.add_method('GetNSlots', 
+                   'uint32_t', 
+                   [], 
+                   is_const=True)
+    ## ff-mac-scheduler-ue-table.h (module 'lte'): uint32_t ns3::FfMacSchedulerUeTable::GetNUes() const [member function]
+    cls.add_method('GetNUes', 
+                   'uint32_t', 
+                   [], 
+                   is_const=True)
+    ## ff-mac-scheduler-ue-table.h (module 'lte'): uint16_t ns3::FfMacSchedulerUeTable::GetRnti(uint32_t slot) const [member function]
+    cls.add_method('GetRnti', 
+                   'uint16_t', 
+                   [param('uint32_t', 'slot')], 
+                   is_const=True)
+    ## ff-mac-scheduler-ue-table.h (module 'lte'): uint32_t ns3::FfMacSchedulerUeTable::GetSlot(uint16_t rnti) const [member function]
+    cls.add_method('GetSlot', 
+                   'uint32_t', 
+                   [param('uint16_t', 'rnti')], 
+                   is_const=True)
+    ## ff-mac-scheduler-ue-table.h (module 'lte'): uint8_t ns3::FfMacSchedulerUeTable::GetTxMode(uint32_t slot) const [member function]
+    cls.add_method('GetTxMode', 
+                   'uint8_t', 
+                   [param('uint32_t', 'slot')], 
+                   is_const=True)
+    ## ff-mac-scheduler-ue-table.h (module 'lte'): bool ns3::FfMacSchedulerUeTable::HasDlSbCqi(uint32_t slot) const [member function]
+    cls.add_method('HasDlSbCqi', 
+                   'bool', 
+                   [param('uint32_t', 'slot')], 
+                   is_const=True)
+    ## ff-mac-scheduler-ue-table.h (module 'lte'): bool ns3::FfMacSchedulerUeTable::IsDlHarqProcessAvailable(uint32_t slot) const [member function]
+    cls.add_method('IsDlHarqProcessAvailable', 
+                   'bool', 
+                   [param('uint32_t', 'slot')], 
+                   is_const=True)
+    ## ff-mac-scheduler-ue-table.h (module 'lte'): void ns3::FfMacSchedulerUeTable::RefreshDlHarqProcesses() [member function]
+    cls.add_method('RefreshDlHarqProcesses', 
+                   'void', 
+                   [])
+    ## ff-mac-scheduler-ue-table.h (module 'lte'): void ns3::FfMacSchedulerUeTable::RefreshDlSbCqi() [member function]
+    cls.add_method('RefreshDlSbCqi', 
+                   'void', 
+                   [])
+    ## ff-mac-scheduler-ue-table.h (module 'lte'): void ns3::FfMacSchedulerUeTable::RemoveUe(uint16_t rnti) [member function]
+    cls.add_method('RemoveUe', 
+                   'void', 
+                   [param('uint16_t', 'rnti')])
+    ## ff-mac-scheduler-ue-table.h (module 'lte'): void ns3::FfMacSchedulerUeTable::ResetDlSbCqi(uint32_t slot) [member function]
+    cls.add_method('ResetDlSbCqi', 
+                   'void', 
+                   [param('uint32_t', 'slot')])
+    ## ff-mac-scheduler-ue-table.h (module 'lte'): void ns3::FfMacSchedulerUeTable::SetDlRbgNum(uint32_t rbgNum) [member function]
+    cls.add_method('SetDlRbgNum', 
+                   'void', 
+                   [param('uint32_t', 'rbgNum')])
+    ## ff-mac-scheduler-ue-table.h (module 'lte'): void ns3::FfMacSchedulerUeTable::SetDlSbCqi(uint32_t slot, ns3::SbMeasResult_s const & sbMeasResult, uint32_t validity) [member function]
+    cls.add_method('SetDlSbCqi', 
+                   'void', 
+                   [param('uint32_t', 'slot'), param('ns3::SbMeasResult_s const &', 'sbMeasResult'), param('uint32_t', 'validity')])
+    ## ff-mac-scheduler-ue-table.h (module 'lte'): void ns3::FfMacSchedulerUeTable::SetTxMode(uint32_t slot, uint8_t txMode) [member function]
+    cls.add_method('SetTxMode', 
+                   'void', 
+                   [param('uint32_t', 'slot'), param('uint8_t', 'txMode')])
+    ## ff-mac-scheduler-ue-table.h (module 'lte'): uint8_t ns3::FfMacSchedulerUeTable::UpdateDlHarqProcessId(uint32_t slot) [member function]
+    cls.add_method('UpdateDlHarqProcessId', 
+                   'uint8_t', 
+                   [param('uint32_t', 'slot')])
+    ## ff-mac-scheduler-ue-table.h (module 'lte'): ns3::FfMacSchedulerUeTable::MAX_LAYERS [variable]
+    cls.add_static_attribute('MAX_LAYERS', 'uint8_t const', is_const=True)
+    ## ff-mac-scheduler-ue-table.h (module 'lte'): ns3::FfMacSchedulerUeTable::NO_CQI [variable]
+    cls.add_static_attribute('NO_CQI', 'uint8_t const', is_const=True)
+    ## ff-mac-scheduler-ue-table.h (module 'lte'): ns3::FfMacSchedulerUeTable::NO_SLOT [variable]
+    cls.add_static_attribute('NO_SLOT', 'uint32_t const', is_const=True)
+    return
+
 def register_Ns3GbrQosInformation_methods(root_module, cls):
     ## eps-bearer.h (module 'lte'): ns3::GbrQosInformation::GbrQosInformation(ns3::GbrQosInformation const & arg0) [copy constructor]
     cls.add_constructor([param('ns3::GbrQosInformation const &', 'arg0')])
@@ -6007,15 +6132,20 @@ def register_Ns3LteMiErrorModel_methods(root_module, cls):
     cls.add_constructor([])
     ## lte-mi-error-model.h (module 'lte'): ns3::LteMiErrorModel::LteMiErrorModel(ns3::LteMiErrorModel const & arg0) [copy constructor]
     cls.add_constructor([param('ns3::LteMiErrorModel const &', 'arg0')])
-    ## lte-mi-error-model.h (module 'lte'): static double ns3::LteMiErrorModel::GetPcfichPdcchError(std::list<ns3::LteListChunkProcessor::Chunk, std::allocator<ns3::LteListChunkProcessor::Chunk> > sinr) [member function]
+    ## lte-mi-error-model.h (module 'lte'): static void ns3::LteMiErrorModel::GetBlerCurveParameters(uint8_t ecrId, uint16_t cbSize, double & b, double & c) [member function]
+    cls.add_method('GetBlerCurveParameters', 
+                   'void', 
+                   [param('uint8_t', 'ecrId'), param('uint16_t', 'cbSize'), param('double &', 'b'), param('double &', 'c')], 
+                   is_static=True)
+    ## lte-mi-error-model.h (module 'lte'): static double ns3::LteMiErrorModel::GetPcfichPdcchError(ns3::LteChunkArena const & sinr) [member function]
     cls.add_method('GetPcfichPdcchError', 
                    'double', 
-                   [param('std::list< ns3::LteListChunkProcessor::Chunk >', 'sinr')], 
+                   [param('ns3::LteChunkArena const &', 'sinr')], 
                    is_static=True)
-    ## lte-mi-error-model.h (module 'lte'): static ns3::TbStats_t ns3::LteMiErrorModel::GetTbDecodificationStats(std::list<ns3::LteListChunkProcessor::Chunk, std::allocator<ns3::LteListChunkProcessor::Chunk> > sinr, std::vector<int, std::allocator<int> > const & map, uint16_t size, uint8_t mcs, ns3::HarqProcessInfoList_t miHistory) [member function]
+    ## lte-mi-error-model.h (module 'lte'): static ns3::TbStats_t ns3::LteMiErrorModel::GetTbDecodificationStats(ns3::LteChunkArena const & sinr, std::vector<int, std::allocator<int> > const & map, uint16_t size, uint8_t mcs, ns3::HarqProcessInfoList_t const & miHistory) [member function]
     cls.add_method('GetTbDecodificationStats', 
                    'ns3::TbStats_t', 
-                   [param('std::list< ns3::LteListChunkProcessor::Chunk >', 'sinr'), param('std::vector< int > const &', 'map'), param('uint16_t', 'size'), param('uint8_t', 'mcs'), param('ns3::HarqProcessInfoList_t', 'miHistory')], 
+                   [param('ns3::LteChunkArena const &', 'sinr'), param('std::vector< int > const &', 'map'), param('uint16_t', 'size'), param('uint8_t', 'mcs'), param('ns3::HarqProcessInfoList_t const &', 'miHistory')], 
                    is_static=True)
     ## lte-mi-error-model.h (module 'lte'): static double ns3::LteMiErrorModel::MappingMiBler(double mib, uint8_t ecrId, uint16_t cbSize) [member function]
     cls.add_method('MappingMiBler', 
@@ -13177,6 +13307,11 @@ def register_Ns3EpcTft_methods(root_module, cls):
                    'ns3::Ptr< ns3::EpcTft >', 
                    [], 
                    is_static=True)
+    ## epc-tft.h (module 'lte'): std::list<ns3::EpcTft::PacketFilter, std::allocator<ns3::EpcTft::PacketFilter> > ns3::EpcTft::GetPacketFilters() const [member function]
+    cls.add_method('GetPacketFilters', 
+                   'std::list< ns3::EpcTft::PacketFilter >', 
+                   [], 
+                   is_const=True)
     ## epc-tft.h (module 'lte'): bool ns3::EpcTft::Matches(ns3::EpcTft::Direction direction, ns3::Ipv4Address remoteAddress, ns3::Ipv4Address localAddress, uint16_t remotePort, uint16_t localPort, uint8_t typeOfService) [member function]
     cls.add_method('Matches', 
                    'bool', 
@@ -13235,6 +13370,16 @@ def register_Ns3EpcTftClassifier_methods(root_module, cls):
     cls.add_method('Delete', 
                    'void', 
                    [param('uint32_t', 'id')])
+    ## epc-tft-classifier.h (module 'lte'): uint64_t ns3::EpcTftClassifier::GetNoMatchCount() const [member function]
+    cls.add_method('GetNoMatchCount', 
+                   'uint64_t', 
+                   [], 
+                   is_const=True)
+    ## epc-tft-classifier.h (module 'lte'): std::vector<unsigned long, std::allocator<unsigned long> > ns3::EpcTftClassifier::GetPacketFilterHits(uint32_t id) const [member function]
+    cls.add_method('GetPacketFilterHits', 
+                   'std::vector< unsigned long >', 
+                   [param('uint32_t', 'id')], 
+                   is_const=True)
     return
 
 def register_Ns3EpcUeNas_methods(root_module, cls):
@@ -14883,6 +15028,45 @@ def register_Ns3LteAnr_methods(root_module, cls):
                    visibility='protected', is_virtual=True)
     return
 
+def register_Ns3LteChunkArena_methods(root_module, cls):
+    ## lte-chunk-processor.h (module 'lte'): ns3::LteChunkArena::LteChunkArena(ns3::LteChunkArena const & arg0) [copy constructor]
+    cls.add_constructor([param('ns3::LteChunkArena const &', 'arg0')])
+    ## lte-chunk-processor.h (module 'lte'): ns3::LteChunkArena::LteChunkArena() [constructor]
+    cls.add_constructor([])
+    ## lte-chunk-processor.h (module 'lte'): void ns3::LteChunkArena::Add(ns3::SpectrumValue const & value, ns3::Time duration) [member function]
+    cls.add_method('Add', 
+                   'void', 
+                   [param('ns3::SpectrumValue const &', 'value'), param('ns3::Time', 'duration')])
+    ## lte-chunk-processor.h (module 'lte'): void ns3::LteChunkArena::Clear() [member function]
+    cls.add_method('Clear', 
+                   'void', 
+                   [])
+    ## lte-chunk-processor.h (module 'lte'): ns3::Time ns3::LteChunkArena::GetDuration(uint32_t chunk) const [member function]
+    cls.add_method('GetDuration', 
+                   'ns3::Time', 
+                   [param('uint32_t', 'chunk')], 
+                   is_const=True)
+    ## lte-chunk-processor.h (module 'lte'): uint32_t ns3::LteChunkArena::GetNChunks() const [member function]
+    cls.add_method('GetNChunks', 
+                   'uint32_t', 
+                   [], 
+                   is_const=True)
+    ## lte-chunk-processor.h (module 'lte'): uint32_t ns3::LteChunkArena::GetNRbs() const [member function]
+    cls.add_method('GetNRbs', 
+                   'uint32_t', 
+                   [], 
+                   is_const=True)
+    ## lte-chunk-processor.h (module 'lte'): double const * ns3::LteChunkArena::GetValues(uint32_t chunk) const [member function]
+    cls.add_method('GetValues', 
+                   'double const *', 
+                   [param('uint32_t', 'chunk')], 
+                   is_const=True)
+    ## lte-chunk-processor.h (module 'lte'): void ns3::LteChunkArena::Scale(double factor) [member function]
+    cls.add_method('Scale', 
+                   'void', 
+                   [param('double', 'factor')])
+    return
+
 def register_Ns3LteChunkProcessor_methods(root_module, cls):
     ## lte-chunk-processor.h (module 'lte'): ns3::LteChunkProcessor::LteChunkProcessor(ns3::LteChunkProcessor const & arg0) [copy constructor]
     cls.add_constructor([param('ns3::LteChunkProcessor const &', 'arg0')])
@@ -16496,10 +16680,10 @@ def register_Ns3LteListChunkProcessor_methods(root_module, cls):
     cls.add_constructor([])
     ## lte-chunk-processor.h (module 'lte'): ns3::LteListChunkProcessor::LteListChunkProcessor(ns3::LteListChunkProcessor const & arg0) [copy constructor]
     cls.add_constructor([param('ns3::LteListChunkProcessor const &', 'arg0')])
-    ## lte-chunk-processor.h (module 'lte'): void ns3::LteListChunkProcessor::AddCallback(ns3::Callback<void,std::list<ns3::LteListChunkProcessor::Chunk, std::allocator<ns3::LteListChunkProcessor::Chunk> >,ns3::empty,ns3::empty,ns3::empty,ns3::empty,ns3::empty,ns3::empty,ns3::empty,ns3::empty> c) [member function]
+    ## lte-chunk-processor.h (module 'lte'): void ns3::LteListChunkProcessor::AddCallback(ns3::Callback<void,const ns3::LteChunkArena&,ns3::empty,ns3::empty,ns3::empty,ns3::empty,ns3::empty,ns3::empty,ns3::empty,ns3::empty> c) [member function]
     cls.add_method('AddCallback', 
                    'void', 
-                   [param('ns3::Callback< void, std::list< ns3::LteListChunkProcessor::Chunk >, ns3::empty, ns3::empty, ns3::empty, ns3::empty, ns3::empty, ns3::empty, ns3::empty, ns3::empty >', 'c')], 
+                   [param('ns3::Callback< void, ns3::LteChunkArena const &, ns3::empty, ns3::empty, ns3::empty, ns3::empty, ns3::empty, ns3::empty, ns3::empty, ns3::empty >', 'c')], 
                    is_virtual=True)
     ## lte-chunk-processor.h (module 'lte'): void ns3::LteListChunkProcessor::End() [member function]
     cls.add_method('End', 
@@ -16518,19 +16702,6 @@ def register_Ns3LteListChunkProcessor_methods(root_module, cls):
                    is_virtual=True)
     return
 
-def register_Ns3LteListChunkProcessorChunk_methods(root_module, cls):
-    ## lte-chunk-processor.h (module 'lte'): ns3::LteListChunkProcessor::Chunk::Chunk(ns3::LteListChunkProcessor::Chunk const & arg0) [copy constructor]
-    cls.add_constructor([param('ns3::LteListChunkProcessor::Chunk const &', 'arg0')])
-    ## lte-chunk-processor.h (module 'lte'): ns3::LteListChunkProcessor::Chunk::Chunk(ns3::Ptr<ns3::SpectrumValue> spectrumValue, ns3::Time duration) [constructor]
-    cls.add_constructor([param('ns3::Ptr< ns3::SpectrumValue >', 'spectrumValue'), param('ns3::Time', 'duration')])
-    ## lte-chunk-processor.h (module 'lte'): ns3::LteListChunkProcessor::Chunk::Chunk() [constructor]
-    cls.add_constructor([])
-    ## lte-chunk-processor.h (module 'lte'): ns3::LteListChunkProcessor::Chunk::m_duration [variable]
-    cls.add_instance_attribute('m_duration', 'ns3::Time', is_const=False)
-    ## lte-chunk-processor.h (module 'lte'): ns3::LteListChunkProcessor::Chunk::m_spectrumValue [variable]
-    cls.add_instance_attribute('m_spectrumValue', 'ns3::Ptr< ns3::SpectrumValue >', is_const=False)
-    return
-
 def register_Ns3LtePdcp_methods(root_module, cls):
     ## lte-pdcp.h (module 'lte'): ns3::LtePdcp::LtePdcp(ns3::LtePdcp const & arg0) [copy constructor]
     cls.add_constructor([param('ns3::LtePdcp const &', 'arg0')])
@@ -17131,10 +17302,10 @@ def register_Ns3LteSpectrumPhy_methods(root_module, cls):
     cls.add_method('AddExpectedTb', 
                    'void', 
                    [param('uint16_t', 'rnti'), param('uint8_t', 'ndi'), param('uint16_t', 'size'), param('uint8_t', 'mcs'), param('std::vector< int >', 'map'), param('uint8_t', 'layer'), param('uint8_t', 'harqId'), param('uint8_t', 'rv'), param('bool', 'downlink')])
-    ## lte-spectrum-phy.h (module 'lte'): void ns3::LteSpectrumPhy::UpdateSinrPerceived(std::list<ns3::LteListChunkProcessor::Chunk, std::allocator<ns3::LteListChunkProcessor::Chunk> > sinr) [member function]
+    ## lte-spectrum-phy.h (module 'lte'): void ns3::LteSpectrumPhy::UpdateSinrPerceived(ns3::LteChunkArena const & sinr) [member function]
     cls.add_method('UpdateSinrPerceived', 
                    'void', 
-                   [param('std::list< ns3::LteListChunkProcessor::Chunk >', 'sinr')])
+                   [param('ns3::LteChunkArena const &', 'sinr')])
     ## lte-spectrum-phy.h (module 'lte'): void ns3::LteSpectrumPhy::SetTransmissionMode(uint8_t txMode) [member function]
     cls.add_method('SetTransmissionMode', 
                    'void', 
@@ -37,9 +37,28 @@
 #include <ns3/node.h>
 #include <ns3/buildings-helper.h>
 #include <ns3/lte-spectrum-value-helper.h>
+#include <ns3/node-list.h>
+#include <ns3/lte-enb-net-device.h>
+#include <ns3/lte-enb-phy.h>
+#include <ns3/lte-spectrum-phy.h>
+#include <ns3/multi-model-spectrum-channel.h>
+#include <ns3/spectrum-converter.h>
+#include <ns3/propagation-loss-model.h>
+#include <ns3/spectrum-propagation-loss-model.h>
+#include <ns3/antenna-model.h>
+#include <ns3/angles.h>
+#include <ns3/core-config.h>
 
 #include <fstream>
+#include <sstream>
 #include <limits>
+#include <cmath>
+#include <algorithm>
+#ifdef HAVE_PTHREAD_H
+#include <ns3/system-thread.h>
+#include <pthread.h>
+#include <unistd.h>
+#endif /* HAVE_PTHREAD_H */
 
 namespace ns3 {
 
@@ -144,6 +163,21 @@ RadioEnvironmentMapHelper::GetTypeId (void)
                    IntegerValue (-1),
                    MakeIntegerAccessor (&RadioEnvironmentMapHelper::m_rbId),
                    MakeIntegerChecker<int32_t> ())
+    .AddAttribute ("Offline",
+                   "If true, the map is computed directly from the eNBs attached "
+                   "to the channel and from the propagation and antenna models "
+                   "of the channel, instead of through simulated transmissions. "
+                   "Only the control channel of a MultiModelSpectrumChannel is "
+                   "supported, otherwise simulated transmissions are used.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&RadioEnvironmentMapHelper::m_offline),
+                   MakeBooleanChecker ())
+    .AddAttribute ("ThreadCount",
+                   "The number of threads computing the SINR of the offline map. "
+                   "Zero means one per online processor.",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&RadioEnvironmentMapHelper::m_threadCount),
+                   MakeUintegerChecker<uint32_t> ())
   ;
   return tid;
 }
@@ -208,14 +242,23 @@ RadioEnvironmentMapHelper::Install ()
       startDelay = 0.5001;
     }
 
-  Simulator::Schedule (Seconds (startDelay),
-                       &RadioEnvironmentMapHelper::DelayedInstall,
-                       this);
+  if (m_offline)
+    {
+      Simulator::Schedule (Seconds (startDelay),
+                           &RadioEnvironmentMapHelper::OfflineInstall,
+                           this);
+    }
+  else
+    {
+      Simulator::Schedule (Seconds (startDelay),
+                           &RadioEnvironmentMapHelper::DelayedInstall,
+                           this);
+    }
 }
 
 
-void 
-RadioEnvironmentMapHelper::DelayedInstall ()
+void
+RadioEnvironmentMapHelper::SetupGrid ()
 {
   NS_LOG_FUNCTION (this);
   m_xStep = (m_xMax - m_xMin)/(m_xRes-1);
@@ -226,8 +269,6 @@ RadioEnvironmentMapHelper::DelayedInstall ()
       m_maxPointsPerIteration = m_xRes * m_yRes;
     }
 
-  Ptr<SpectrumModel> sm = LteSpectrumValueHelper::GetSpectrumModel (m_earfcn, m_bandwidth);
-
   double noisePowerSpectralDensity = LteSpectrumValueHelper::GetNoisePowerSpectralDensity (m_noiseFigureDb);
 
   if (m_rbId >= 0)
@@ -238,8 +279,17 @@ RadioEnvironmentMapHelper::DelayedInstall ()
     {
       m_noisePowerW = noisePowerSpectralDensity * 180000 * m_bandwidth;
     }
-  
-  
+}
+
+
+void 
+RadioEnvironmentMapHelper::DelayedInstall ()
+{
+  NS_LOG_FUNCTION (this);
+  SetupGrid ();
+
+  Ptr<SpectrumModel> sm = LteSpectrumValueHelper::GetSpectrumModel (m_earfcn, m_bandwidth);
+
   for (uint32_t i = 0; i < m_maxPointsPerIteration; ++i)
     {
       RemPoint p;
@@ -354,6 +404,335 @@ RadioEnvironmentMapHelper::PrintAndReset ()
     }
 }
 
+#ifdef HAVE_PTHREAD_H
+/**
+ * The threads computing the tiles of the offline map. They are started
+ * once for the whole map, and take the tiles of each batch in turn.
+ */
+struct RadioEnvironmentMapHelper::OfflinePool
+{
+  /**
+   * Start the threads.
+   *
+   * \param nThreads the number of threads
+   */
+  OfflinePool (uint32_t nThreads);
+  /// Stop the threads.
+  ~OfflinePool ();
+  /**
+   * Hand the tiles of a batch to the threads.
+   *
+   * \param batchTiles the tiles, which must be kept until Wait () returns
+   */
+  void Start (std::vector<OfflineTile> &batchTiles);
+  /// Wait until the tiles of the batch are computed.
+  void Wait (void);
+  /// The body of the threads.
+  void Run (void);
+
+  pthread_mutex_t mutex;              ///< Protects the other fields.
+  pthread_cond_t tilesReady;          ///< Signals new tiles, or stop.
+  pthread_cond_t batchDone;           ///< Signals that the batch is computed.
+  std::vector<OfflineTile> *tiles;    ///< The tiles of the batch, if any.
+  uint32_t nextTile;                  ///< The next tile to compute.
+  uint32_t nPending;                  ///< The tiles not computed yet.
+  bool stop;                          ///< Whether the threads must stop.
+  std::vector<Ptr<SystemThread> > threads;  ///< The threads.
+};
+
+RadioEnvironmentMapHelper::OfflinePool::OfflinePool (uint32_t nThreads)
+  : tiles (0),
+    nextTile (0),
+    nPending (0),
+    stop (false)
+{
+  pthread_mutex_init (&mutex, 0);
+  pthread_cond_init (&tilesReady, 0);
+  pthread_cond_init (&batchDone, 0);
+  for (uint32_t i = 0; i < nThreads; ++i)
+    {
+      Ptr<SystemThread> thread = Create<SystemThread> (MakeCallback (&OfflinePool::Run, this));
+      thread->Start ();
+      threads.push_back (thread);
+    }
+}
+
+RadioEnvironmentMapHelper::OfflinePool::~OfflinePool ()
+{
+  pthread_mutex_lock (&mutex);
+  stop = true;
+  pthread_cond_broadcast (&tilesReady);
+  pthread_mutex_unlock (&mutex);
+  for (std::vector<Ptr<SystemThread> >::iterator i = threads.begin (); i != threads.end (); ++i)
+    {
+      (*i)->Join ();
+    }
+  pthread_cond_destroy (&batchDone);
+  pthread_cond_destroy (&tilesReady);
+  pthread_mutex_destroy (&mutex);
+}
+
+void
+RadioEnvironmentMapHelper::OfflinePool::Start (std::vector<OfflineTile> &batchTiles)
+{
+  pthread_mutex_lock (&mutex);
+  tiles = &batchTiles;
+  nextTile = 0;
+  nPending = batchTiles.size ();
+  pthread_cond_broadcast (&tilesReady);
+  pthread_mutex_unlock (&mutex);
+}
+
+void
+RadioEnvironmentMapHelper::OfflinePool::Wait (void)
+{
+  pthread_mutex_lock (&mutex);
+  while (nPending > 0)
+    {
+      pthread_cond_wait (&batchDone, &mutex);
+    }
+  tiles = 0;
+  pthread_mutex_unlock (&mutex);
+}
+
+void
+RadioEnvironmentMapHelper::OfflinePool::Run (void)
+{
+  // no logging here, this does not run in the simulation thread
+  pthread_mutex_lock (&mutex);
+  while (true)
+    {
+      while (!stop && (tiles == 0 || nextTile == tiles->size ()))
+        {
+          pthread_cond_wait (&tilesReady, &mutex);
+        }
+      if (stop)
+        {
+          break;
+        }
+      OfflineTile &tile = (*tiles)[nextTile++];
+      pthread_mutex_unlock (&mutex);
+      tile.Run ();
+      pthread_mutex_lock (&mutex);
+      if (--nPending == 0)
+        {
+          pthread_cond_signal (&batchDone);
+        }
+    }
+  pthread_mutex_unlock (&mutex);
+}
+#endif /* HAVE_PTHREAD_H */
+
+void
+RadioEnvironmentMapHelper::OfflineInstall ()
+{
+  NS_LOG_FUNCTION (this);
+  Ptr<MultiModelSpectrumChannel> channel = DynamicCast<MultiModelSpectrumChannel> (m_channel);
+  if (m_useDataChannel || channel == 0)
+    {
+      NS_LOG_WARN ("offline REM supports only the control channel of a MultiModelSpectrumChannel, simulating it instead");
+      DelayedInstall ();
+      return;
+    }
+  SetupGrid ();
+
+  // all the eNBs are assumed to transmit the control channel with their
+  // whole downlink PSD, as they do in every subframe
+  Ptr<SpectrumModel> sm = LteSpectrumValueHelper::GetSpectrumModel (m_earfcn, m_bandwidth);
+  std::vector<OfflineTx> transmitters;
+  for (NodeList::Iterator nodeIt = NodeList::Begin (); nodeIt != NodeList::End (); ++nodeIt)
+    {
+      for (uint32_t i = 0; i < (*nodeIt)->GetNDevices (); ++i)
+        {
+          Ptr<LteEnbNetDevice> enbDev = DynamicCast<LteEnbNetDevice> ((*nodeIt)->GetDevice (i));
+          if (enbDev == 0)
+            {
+              continue;
+            }
+          Ptr<LteEnbPhy> enbPhy = enbDev->GetPhy ();
+          Ptr<LteSpectrumPhy> dlPhy = enbPhy->GetDownlinkSpectrumPhy ();
+          if (dlPhy->GetChannel () != m_channel)
+            {
+              continue;
+            }
+          OfflineTx tx;
+          tx.mobility = dlPhy->GetMobility ();
+          tx.antenna = dlPhy->GetRxAntenna ();
+          tx.psd = enbPhy->CreateTxPowerSpectralDensity ();
+          if (tx.psd->GetSpectrumModelUid () != sm->GetUid ())
+            {
+              SpectrumConverter converter (tx.psd->GetSpectrumModel (), sm);
+              tx.psd = converter.Convert (tx.psd);
+            }
+          if (m_rbId >= 0)
+            {
+              tx.powerW = (*tx.psd)[m_rbId] * 180000;
+            }
+          else
+            {
+              tx.powerW = Integral (*tx.psd);
+            }
+          NS_LOG_LOGIC ("eNB " << enbDev->GetCellId () << " power " << tx.powerW << " W");
+          transmitters.push_back (tx);
+        }
+    }
+
+  // like the RemSpectrumPhys, each point of a batch has its own mobility
+  // model, which keeps any per-link state of the propagation loss model
+  std::vector<Ptr<MobilityModel> > probes;
+  for (uint32_t i = 0; i < m_maxPointsPerIteration; ++i)
+    {
+      Ptr<MobilityModel> probe = CreateObject<ConstantPositionMobilityModel> ();
+      probe->AggregateObject (CreateObject<MobilityBuildingInfo> ());
+      probes.push_back (probe);
+    }
+
+  uint32_t nThreads = 1;
+#ifdef HAVE_PTHREAD_H
+  nThreads = m_threadCount;
+  if (nThreads == 0)
+    {
+      long nProcessors = sysconf (_SC_NPROCESSORS_ONLN);
+      nThreads = (nProcessors > 0) ? nProcessors : 1;
+    }
+#endif /* HAVE_PTHREAD_H */
+  NS_LOG_LOGIC ("using " << nThreads << " threads for " << transmitters.size () << " eNBs");
+
+  double x = m_xMin;
+  double y = m_yMin;
+  OfflineBatch current;
+  OfflineBatch next;
+#ifdef HAVE_PTHREAD_H
+  OfflinePool pool (nThreads);
+#endif /* HAVE_PTHREAD_H */
+  FillOfflineBatch (transmitters, probes, x, y, current);
+  while (!current.points.empty ())
+    {
+      uint32_t nPoints = current.points.size ();
+      uint32_t nTiles = std::min (nThreads, nPoints);
+      std::vector<OfflineTile> tiles (nTiles);
+      for (uint32_t i = 0; i < nTiles; ++i)
+        {
+          tiles[i].batch = &current;
+          tiles[i].begin = (uint64_t) nPoints * i / nTiles;
+          tiles[i].end = (uint64_t) nPoints * (i + 1) / nTiles;
+          tiles[i].nTx = transmitters.size ();
+          tiles[i].noisePowerW = m_noisePowerW;
+        }
+#ifdef HAVE_PTHREAD_H
+      pool.Start (tiles);
+      FillOfflineBatch (transmitters, probes, x, y, next);
+      pool.Wait ();
+#else
+      for (uint32_t i = 0; i < nTiles; ++i)
+        {
+          tiles[i].Run ();
+        }
+      FillOfflineBatch (transmitters, probes, x, y, next);
+#endif /* HAVE_PTHREAD_H */
+      for (uint32_t i = 0; i < nTiles; ++i)
+        {
+          m_outFile << tiles[i].text;
+        }
+      std::swap (current, next);
+    }
+  m_outFile.flush ();
+  Finalize ();
+}
+
+void
+RadioEnvironmentMapHelper::FillOfflineBatch (const std::vector<OfflineTx> &transmitters,
+                                             const std::vector<Ptr<MobilityModel> > &probes,
+                                             double &x, double &y, OfflineBatch &batch)
+{
+  NS_LOG_FUNCTION (this << x << y);
+  Ptr<MultiModelSpectrumChannel> channel = DynamicCast<MultiModelSpectrumChannel> (m_channel);
+  Ptr<PropagationLossModel> propagationLoss = channel->GetPropagationLossModel ();
+  Ptr<SpectrumPropagationLossModel> spectrumPropagationLoss = channel->GetSpectrumPropagationLossModel ();
+  DoubleValue maxLossDb;
+  channel->GetAttribute ("MaxLossDb", maxLossDb);
+
+  batch.points.clear ();
+  batch.rxPowerW.clear ();
+  // same order of the points as DelayedInstall ()
+  while (batch.points.size () < m_maxPointsPerIteration && x < m_xMax + 0.5*m_xStep)
+    {
+      Ptr<MobilityModel> probe = probes[batch.points.size ()];
+      probe->SetPosition (Vector (x, y, m_z));
+      BuildingsHelper::MakeConsistent (probe);
+      batch.points.push_back (probe->GetPosition ());
+
+      // same computation as MultiModelSpectrumChannel::StartTx ()
+      for (std::vector<OfflineTx>::const_iterator tx = transmitters.begin (); tx != transmitters.end (); ++tx)
+        {
+          double pathLossDb = 0;
+          if (tx->antenna != 0)
+            {
+              Angles txAngles (probe->GetPosition (), tx->mobility->GetPosition ());
+              pathLossDb -= tx->antenna->GetGainDb (txAngles);
+            }
+          if (propagationLoss != 0)
+            {
+              pathLossDb -= propagationLoss->CalcRxPower (0, tx->mobility, probe);
+            }
+          if (pathLossDb > maxLossDb.Get ())
+            {
+              // beyond range
+              batch.rxPowerW.push_back (0.0);
+              continue;
+            }
+          double pathGainLinear = std::pow (10.0, (-pathLossDb) / 10.0);
+          if (spectrumPropagationLoss != 0)
+            {
+              Ptr<SpectrumValue> rxPsd = tx->psd->Copy ();
+              *rxPsd *= pathGainLinear;
+              rxPsd = spectrumPropagationLoss->CalcRxPowerSpectralDensity (rxPsd, tx->mobility, probe);
+              batch.rxPowerW.push_back ((m_rbId >= 0) ? (*rxPsd)[m_rbId] * 180000 : Integral (*rxPsd));
+            }
+          else
+            {
+              batch.rxPowerW.push_back (tx->powerW * pathGainLinear);
+            }
+        }
+
+      y += m_yStep;
+      if (!(y < m_yMax + 0.5*m_yStep))
+        {
+          y = m_yMin;
+          x += m_xStep;
+        }
+    }
+}
+
+void
+RadioEnvironmentMapHelper::OfflineTile::Run (void)
+{
+  // no logging here, this does not run in the simulation thread
+  std::ostringstream os;
+  for (uint32_t i = begin; i < end; ++i)
+    {
+      // same as RemSpectrumPhy::GetSinr ()
+      double sumPower = 0;
+      double referenceSignalPower = 0;
+      for (uint32_t t = 0; t < nTx; ++t)
+        {
+          double power = batch->rxPowerW[i * nTx + t];
+          sumPower += power;
+          if (power > referenceSignalPower)
+            {
+              referenceSignalPower = power;
+            }
+        }
+      const Vector &pos = batch->points[i];
+      os << pos.x << "\t"
+         << pos.y << "\t"
+         << pos.z << "\t"
+         << referenceSignalPower / (sumPower - referenceSignalPower + noisePowerW)
+         << "\n";
+    }
+  text = os.str ();
+}
+
 void 
 RadioEnvironmentMapHelper::Finalize ()
 {
@@ -24,7 +24,10 @@
 
 
 #include <ns3/object.h>
+#include <ns3/vector.h>
 #include <fstream>
+#include <string>
+#include <vector>
 
 
 namespace ns3 {
@@ -35,6 +38,8 @@ class NetDevice;
 class SpectrumChannel;
 //class BuildingsMobilityModel;
 class MobilityModel;
+class AntennaModel;
+class SpectrumValue;
 
 /** 
  * \ingroup lte
@@ -77,6 +82,9 @@ public:
 
 private:
 
+  /// Compute the distance between the listening points and the noise power.
+  void SetupGrid ();
+
   /**
    * Scheduled by Install() to perform the actual generation of map.
    *
@@ -108,6 +116,73 @@ private:
   /// Called when the map generation procedure has been completed.
   void Finalize ();
 
+  /**
+   * Scheduled by Install() instead of DelayedInstall() when the `Offline`
+   * attribute is true, to generate the whole map at once.
+   *
+   * The power received from every eNB attached to the channel is computed
+   * directly from the propagation and antenna models of the channel, in
+   * batches of at most `MaxPointsPerIteration` points. The SINR of a batch
+   * is computed and formatted by a pool of threads, started once for the
+   * whole map, to which the tiles of the batch are handed. Meanwhile the
+   * received powers of the next batch are computed (the models are not
+   * thread safe, so this is done by the calling thread only). The tiles
+   * are then written to the output file in order, in the same format as
+   * PrintAndReset().
+   *
+   * Only the control channel on a MultiModelSpectrumChannel is supported;
+   * otherwise this falls back to DelayedInstall().
+   */
+  void OfflineInstall ();
+
+  /// A transmitter whose power is included in the offline map.
+  struct OfflineTx
+  {
+    Ptr<MobilityModel> mobility;     ///< Position of the transmitter.
+    Ptr<AntennaModel> antenna;       ///< Transmit antenna, if any.
+    Ptr<SpectrumValue> psd;          ///< Transmit PSD, in the REM spectrum model.
+    double powerW;                   ///< Transmit power over the REM band (W).
+  };
+
+  /// A batch of listening points of the offline map.
+  struct OfflineBatch
+  {
+    /// Position of the listening points.
+    std::vector<Vector> points;
+    /// Power received from each transmitter at each point (W), point-major.
+    std::vector<double> rxPowerW;
+  };
+
+  /// A contiguous part of a batch, whose output is prepared by a thread.
+  struct OfflineTile
+  {
+    const OfflineBatch *batch;  ///< The batch.
+    uint32_t begin;             ///< Index of the first point of the tile.
+    uint32_t end;               ///< Index after the last point of the tile.
+    uint32_t nTx;               ///< Number of transmitters.
+    double noisePowerW;         ///< Noise power (W).
+    std::string text;           ///< The output lines of the tile.
+    /// Compute the SINR of the points of the tile and format them.
+    void Run (void);
+  };
+
+  /// The threads computing the tiles of the offline map.
+  struct OfflinePool;
+
+  /**
+   * Compute the powers received at the next points of the grid.
+   *
+   * \param transmitters the transmitters
+   * \param probes the mobility models placed at the points, one per
+   * point of a full batch
+   * \param x X coordinate of the next point, updated
+   * \param y Y coordinate of the next point, updated
+   * \param batch the batch to fill, empty at the end of the grid
+   */
+  void FillOfflineBatch (const std::vector<OfflineTx> &transmitters,
+                         const std::vector<Ptr<MobilityModel> > &probes,
+                         double &x, double &y, OfflineBatch &batch);
+
   /// A complete Radio Environment Map is composed of many of this structure.
   struct RemPoint 
   {
@@ -154,6 +229,9 @@ private:
 
   double m_noisePowerW; ///< The noise power value used internally for the SINR calculations
 
+  bool m_offline;          ///< The `Offline` attribute.
+  uint32_t m_threadCount;  ///< The `ThreadCount` attribute.
+
 }; // end of `class RadioEnvironmentMapHelper`
 
 
@@ -34,13 +34,12 @@
 #include <ns3/nstime.h>
 #include <ns3/lte-amc.h>
 #include <ns3/lte-ffr-sap.h>
+#include <ns3/ff-mac-scheduler-ue-table.h>
 
 // value for SINR outside the range defined by FF-API, used to indicate that there
 // is no CQI for this element
 
 #define NO_SINR -5000
-#define HARQ_PROC_NUM 8
-#define HARQ_DL_TIMEOUT 11
 
 namespace ns3 {
 
@@ -54,7 +54,12 @@ void
 EpcSgwPgwApplication::UeInfo::RemoveBearer (uint8_t bearerId)
 {
   NS_LOG_FUNCTION (this << bearerId);
-  m_teidByBearerIdMap.erase (bearerId);
+  std::map<uint8_t, uint32_t>::iterator it = m_teidByBearerIdMap.find (bearerId);
+  if (it != m_teidByBearerIdMap.end ())
+    {
+      m_tftClassifier.Delete (it->second);
+      m_teidByBearerIdMap.erase (it);
+    }
 }
 
 uint32_t
@@ -141,14 +146,13 @@ EpcSgwPgwApplication::RecvFromTunDevice (Ptr<Packet> packet, const Address& sour
   NS_LOG_FUNCTION (this << source << dest << packet << packet->GetSize ());
 
   // get IP address of UE
-  Ptr<Packet> pCopy = packet->Copy ();
   Ipv4Header ipv4Header;
-  pCopy->RemoveHeader (ipv4Header);
+  packet->PeekHeader (ipv4Header);
   Ipv4Address ueAddr =  ipv4Header.GetDestination ();
   NS_LOG_LOGIC ("packet addressed to UE " << ueAddr);
 
   // find corresponding UeInfo address
-  std::map<Ipv4Address, Ptr<UeInfo> >::iterator it = m_ueInfoByAddrMap.find (ueAddr);
+  UeInfoByAddrMap::iterator it = m_ueInfoByAddrMap.find (ueAddr);
   if (it == m_ueInfoByAddrMap.end ())
     {        
       NS_LOG_WARN ("unknown UE address " << ueAddr);
@@ -31,16 +31,27 @@
 #include "ns3/log.h"
 #include "ns3/packet.h"
 #include "ns3/ipv4-header.h"
-#include "ns3/udp-header.h"
-#include "ns3/tcp-header.h"
 #include "ns3/udp-l4-protocol.h"
 #include "ns3/tcp-l4-protocol.h"
 
+#include <algorithm>
+
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("EpcTftClassifier");
 
+size_t
+EpcTftClassifier::FlowKeyHash::operator() (const FlowKey &k) const
+{
+  uint32_t h = k.remoteAddress;
+  h = h * 31 + k.localAddress;
+  h = h * 31 + ((uint32_t) k.remotePort << 16 | k.localPort);
+  return h;
+}
+
 EpcTftClassifier::EpcTftClassifier ()
+  : m_rangeTableDirty (true),
+    m_noMatchCount (0)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -50,10 +61,56 @@ EpcTftClassifier::Add (Ptr<EpcTft> tft, uint32_t id)
 {
   NS_LOG_FUNCTION (this << tft);
   
+  if (m_tftMap.find (id) != m_tftMap.end ())
+    {
+      Delete (id);
+    }
   m_tftMap[id] = tft;  
   
   // simple sanity check: there shouldn't be more than 16 bearers (hence TFTs) per UE
   NS_ASSERT (m_tftMap.size () <= 16);
+
+  std::list<EpcTft::PacketFilter> packetFilters = tft->GetPacketFilters ();
+  std::vector<CompiledFilter> compiled;
+  compiled.reserve (packetFilters.size ());
+  for (std::list<EpcTft::PacketFilter>::const_iterator it = packetFilters.begin ();
+       it != packetFilters.end ();
+       ++it)
+    {
+      CompiledFilter f;
+      f.tftId = id;
+      f.index = compiled.size ();
+      f.direction = it->direction;
+      f.remoteMask = it->remoteMask.Get ();
+      f.remoteAddress = it->remoteAddress.Get () & f.remoteMask;
+      f.localMask = it->localMask.Get ();
+      f.localAddress = it->localAddress.Get () & f.localMask;
+      f.remotePortStart = it->remotePortStart;
+      f.remotePortEnd = it->remotePortEnd;
+      f.localPortStart = it->localPortStart;
+      f.localPortEnd = it->localPortEnd;
+      f.tosMask = it->typeOfServiceMask;
+      f.tos = it->typeOfService & f.tosMask;
+      f.hits = 0;
+      compiled.push_back (f);
+    }
+
+  // the filters are referenced by address from now on, so they are
+  // swapped into place rather than copied
+  std::vector<CompiledFilter> &filters = m_filters[id];
+  filters.swap (compiled);
+  for (std::vector<CompiledFilter>::iterator it = filters.begin (); it != filters.end (); ++it)
+    {
+      if (IsExact (*it))
+        {
+          FilterList &bucket = m_exactFilters[GetKey (*it)];
+          bucket.insert (std::upper_bound (bucket.begin (), bucket.end (), &*it, &IsEvaluatedBefore), &*it);
+        }
+      else
+        {
+          m_rangeTableDirty = true;
+        }
+    }
 }
 
 void
@@ -61,6 +118,133 @@ EpcTftClassifier::Delete (uint32_t id)
 {
   NS_LOG_FUNCTION (this << id);
   m_tftMap.erase (id);
+
+  std::map<uint32_t, std::vector<CompiledFilter> >::iterator fit = m_filters.find (id);
+  if (fit == m_filters.end ())
+    {
+      return;
+    }
+  for (std::vector<CompiledFilter>::iterator it = fit->second.begin (); it != fit->second.end (); ++it)
+    {
+      if (IsExact (*it))
+        {
+          sgi::hash_map<FlowKey, FilterList, FlowKeyHash>::iterator bit = m_exactFilters.find (GetKey (*it));
+          NS_ASSERT (bit != m_exactFilters.end ());
+          bit->second.erase (std::find (bit->second.begin (), bit->second.end (), &*it));
+          if (bit->second.empty ())
+            {
+              m_exactFilters.erase (bit);
+            }
+        }
+      else
+        {
+          m_rangeTableDirty = true;
+        }
+    }
+  m_filters.erase (fit);
+}
+
+bool
+EpcTftClassifier::IsEvaluatedBefore (const CompiledFilter *a, const CompiledFilter *b)
+{
+  // the TFTs are evaluated from the highest identifier since filter
+  // priority is not implemented properly: this way, since the default
+  // bearer is expected to be added first, it will be evaluated last.
+  if (a->tftId != b->tftId)
+    {
+      return a->tftId > b->tftId;
+    }
+  return a->index < b->index;
+}
+
+bool
+EpcTftClassifier::IsExact (const CompiledFilter &f)
+{
+  return f.remoteMask == 0xffffffff && f.localMask == 0xffffffff
+         && f.remotePortStart == f.remotePortEnd && f.localPortStart == f.localPortEnd;
+}
+
+EpcTftClassifier::FlowKey
+EpcTftClassifier::GetKey (const CompiledFilter &f)
+{
+  FlowKey key;
+  key.remoteAddress = f.remoteAddress;
+  key.localAddress = f.localAddress;
+  key.remotePort = f.remotePortStart;
+  key.localPort = f.localPortStart;
+  return key;
+}
+
+EpcTftClassifier::CompiledFilter*
+EpcTftClassifier::FindFirstMatch (const FilterList &filters, uint8_t direction,
+                                  const FlowKey &key, uint8_t tos, CompiledFilter *bound)
+{
+  for (FilterList::const_iterator it = filters.begin (); it != filters.end (); ++it)
+    {
+      CompiledFilter *f = *it;
+      if (bound != 0 && !IsEvaluatedBefore (f, bound))
+        {
+          break;
+        }
+      if ((direction & f->direction)
+          && (key.remoteAddress & f->remoteMask) == f->remoteAddress
+          && (key.localAddress & f->localMask) == f->localAddress
+          && key.remotePort >= f->remotePortStart && key.remotePort <= f->remotePortEnd
+          && key.localPort >= f->localPortStart && key.localPort <= f->localPortEnd
+          && (tos & f->tosMask) == f->tos)
+        {
+          return f;
+        }
+    }
+  return bound;
+}
+
+void
+EpcTftClassifier::BuildRangeTable (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  FilterList rangeFilters;
+  std::vector<uint32_t> starts;
+  starts.push_back (0);
+  for (std::map<uint32_t, std::vector<CompiledFilter> >::iterator tit = m_filters.begin ();
+       tit != m_filters.end ();
+       ++tit)
+    {
+      for (std::vector<CompiledFilter>::iterator it = tit->second.begin (); it != tit->second.end (); ++it)
+        {
+          if (!IsExact (*it))
+            {
+              rangeFilters.push_back (&*it);
+              starts.push_back (it->localPortStart);
+              starts.push_back (it->localPortEnd + 1);
+            }
+        }
+    }
+  std::sort (rangeFilters.begin (), rangeFilters.end (), &IsEvaluatedBefore);
+  std::sort (starts.begin (), starts.end ());
+  starts.erase (std::unique (starts.begin (), starts.end ()), starts.end ());
+  if (starts.back () > 65535)
+    {
+      starts.pop_back ();
+    }
+
+  m_rangeStarts.assign (starts.begin (), starts.end ());
+  m_rangeFilters.assign (m_rangeStarts.size (), FilterList ());
+  for (uint32_t i = 0; i < m_rangeStarts.size (); ++i)
+    {
+      // the filters covering the first port cover the whole interval
+      for (FilterList::const_iterator it = rangeFilters.begin (); it != rangeFilters.end (); ++it)
+        {
+          if ((*it)->localPortStart <= m_rangeStarts[i] && m_rangeStarts[i] <= (*it)->localPortEnd)
+            {
+              m_rangeFilters[i].push_back (*it);
+            }
+        }
+    }
+  NS_LOG_LOGIC ("range table: " << m_rangeStarts.size () << " intervals, "
+                << rangeFilters.size () << " filters");
+  m_rangeTableDirty = false;
 }
 
  
@@ -69,10 +253,9 @@ EpcTftClassifier::Classify (Ptr<Packet> p, EpcTft::Direction direction)
 {
   NS_LOG_FUNCTION (this << p << direction);
 
-  Ptr<Packet> pCopy = p->Copy ();
-
+  // only the IPv4 header and the ports are read, without copying the packet
   Ipv4Header ipv4Header;
-  pCopy->RemoveHeader (ipv4Header);
+  p->PeekHeader (ipv4Header);
 
   Ipv4Address localAddress;
   Ipv4Address remoteAddress;
@@ -97,40 +280,36 @@ EpcTftClassifier::Classify (Ptr<Packet> p, EpcTft::Direction direction)
   uint16_t localPort = 0;
   uint16_t remotePort = 0;
 
-  if (protocol == UdpL4Protocol::PROT_NUMBER)
+  if (protocol == UdpL4Protocol::PROT_NUMBER || protocol == TcpL4Protocol::PROT_NUMBER)
     {
-      UdpHeader udpHeader;
-      pCopy->RemoveHeader (udpHeader);
-
-      if (direction ==  EpcTft::UPLINK)
-	{
-	  localPort = udpHeader.GetSourcePort ();
-	  remotePort = udpHeader.GetDestinationPort ();
-	}
-      else
-	{
-	  remotePort = udpHeader.GetSourcePort ();
-	  localPort = udpHeader.GetDestinationPort ();
-	}
-    }
-  else if (protocol == TcpL4Protocol::PROT_NUMBER)
-    {
-      TcpHeader tcpHeader;
-      pCopy->RemoveHeader (tcpHeader);
+      // the source and destination ports are the first four bytes of
+      // both the UDP and the TCP headers
+      uint8_t buffer[64];
+      uint32_t ipv4HeaderSize = ipv4Header.GetSerializedSize ();
+      NS_ASSERT (ipv4HeaderSize + 4 <= sizeof (buffer));
+      if (p->CopyData (buffer, ipv4HeaderSize + 4) < ipv4HeaderSize + 4)
+        {
+          NS_LOG_INFO ("Packet too short for protocol: " << (uint16_t) protocol);
+          ++m_noMatchCount;
+          return 0;  // no match
+        }
+      uint16_t sourcePort = (buffer[ipv4HeaderSize] << 8) | buffer[ipv4HeaderSize + 1];
+      uint16_t destinationPort = (buffer[ipv4HeaderSize + 2] << 8) | buffer[ipv4HeaderSize + 3];
       if (direction ==  EpcTft::UPLINK)
 	{
-	  localPort = tcpHeader.GetSourcePort ();
-	  remotePort = tcpHeader.GetDestinationPort ();
+	  localPort = sourcePort;
+	  remotePort = destinationPort;
 	}
       else
 	{
-	  remotePort = tcpHeader.GetSourcePort ();
-	  localPort = tcpHeader.GetDestinationPort ();
+	  remotePort = sourcePort;
+	  localPort = destinationPort;
 	}
     }
   else
     {
       NS_LOG_INFO ("Unknown protocol: " << protocol);
+      ++m_noMatchCount;
       return 0;  // no match
     }
 
@@ -142,25 +321,58 @@ EpcTftClassifier::Classify (Ptr<Packet> p, EpcTft::Direction direction)
 	       << " tos=0x" << (uint16_t) tos );
 
   // now it is possible to classify the packet!
-  // we use a reverse iterator since filter priority is not implemented properly.
-  // This way, since the default bearer is expected to be added first, it will be evaluated last.
-  std::map <uint32_t, Ptr<EpcTft> >::const_reverse_iterator it;
-  NS_LOG_LOGIC ("TFT MAP size: " << m_tftMap.size ());
+  FlowKey key;
+  key.remoteAddress = remoteAddress.Get ();
+  key.localAddress = localAddress.Get ();
+  key.remotePort = remotePort;
+  key.localPort = localPort;
 
-  for (it = m_tftMap.rbegin (); it != m_tftMap.rend (); ++it)
+  CompiledFilter *match = 0;
+  sgi::hash_map<FlowKey, FilterList, FlowKeyHash>::const_iterator eit = m_exactFilters.find (key);
+  if (eit != m_exactFilters.end ())
     {
-      NS_LOG_LOGIC ("TFT id: " << it->first );
-      NS_LOG_LOGIC (" Ptr<EpcTft>: " << it->second);
-      Ptr<EpcTft> tft = it->second;         
-      if (tft->Matches (direction, remoteAddress, localAddress, remotePort, localPort, tos))
-        {
-	  NS_LOG_LOGIC ("matches with TFT ID = " << it->first);
-	  return it->first; // the id of the matching TFT
-        }
+      match = FindFirstMatch (eit->second, direction, key, tos, 0);
+    }
+
+  if (m_rangeTableDirty)
+    {
+      BuildRangeTable ();
+    }
+  uint32_t interval = std::upper_bound (m_rangeStarts.begin (), m_rangeStarts.end (), localPort)
+    - m_rangeStarts.begin () - 1;
+  match = FindFirstMatch (m_rangeFilters[interval], direction, key, tos, match);
+
+  if (match != 0)
+    {
+      NS_LOG_LOGIC ("matches with TFT ID = " << match->tftId << ", filter " << match->index);
+      ++match->hits;
+      return match->tftId; // the id of the matching TFT
     }
   NS_LOG_LOGIC ("no match");
+  ++m_noMatchCount;
   return 0;  // no match
 }
 
+std::vector<uint64_t>
+EpcTftClassifier::GetPacketFilterHits (uint32_t id) const
+{
+  std::vector<uint64_t> hits;
+  std::map<uint32_t, std::vector<CompiledFilter> >::const_iterator fit = m_filters.find (id);
+  if (fit != m_filters.end ())
+    {
+      for (std::vector<CompiledFilter>::const_iterator it = fit->second.begin (); it != fit->second.end (); ++it)
+        {
+          hits.push_back (it->hits);
+        }
+    }
+  return hits;
+}
+
+uint64_t
+EpcTftClassifier::GetNoMatchCount (void) const
+{
+  return m_noMatchCount;
+}
+
 
 } // namespace ns3
@@ -26,8 +26,10 @@
 #include "ns3/ptr.h"
 #include "ns3/simple-ref-count.h"
 #include "ns3/epc-tft.h"
+#include "ns3/sgi-hashmap.h"
 
 #include <map>
+#include <vector>
 
 
 namespace ns3 {
@@ -37,7 +39,23 @@ class Packet;
 
 /**
  * \brief classifies IP packets accoding to Traffic Flow Templates (TFTs)
- * 
+ *
+ * The packet filters of the TFTs are compiled when the TFTs are added,
+ * so that a packet is not matched against each filter in turn:
+ *  - the filters on a single remote and local address and port (exact
+ *    filters) are stored in a hash table keyed on these four values;
+ *  - the other filters are stored in a range table, which splits the
+ *    local port space into intervals and lists for each interval the
+ *    filters whose local port range covers it.
+ * A packet is then matched against the exact filters with its addresses
+ * and ports, and against the filters of the interval of its local port.
+ * Adding or deleting a TFT updates the hash table in place; the range
+ * table is rebuilt at the next classification.
+ *
+ * The result is the same as evaluating the TFTs from the highest
+ * identifier to the lowest, and the filters of each TFT in order of
+ * precedence. The classifier counts the packets matched by each filter.
+ *
  * \note this implementation works with IPv4 only.
  */
 class EpcTftClassifier : public SimpleRefCount<EpcTftClassifier>
@@ -47,10 +65,13 @@ public:
   EpcTftClassifier ();
   
   /** 
-   * add a TFT to the Classifier
+   * add a TFT to the Classifier. The packet filters of the TFT are
+   * compiled at this time, hence filters added later to the TFT are
+   * not evaluated.
    * 
    * \param tft the TFT to be added
-   * 
+   * \param id the identifier (>0) of the TFT; a TFT with the same
+   * identifier is replaced
    */
   void Add (Ptr<EpcTft> tft, uint32_t id);
 
@@ -70,10 +91,129 @@ public:
    * \return the identifier (>0) of the first TFT that matches with the IP packet; 0 if no TFT matched.
    */
   uint32_t Classify (Ptr<Packet> p, EpcTft::Direction direction);
+
+  /**
+   * \param id the identifier of a TFT
+   * \return the number of packets matched by each packet filter of the
+   * TFT, in order of precedence; empty if there is no such TFT
+   */
+  std::vector<uint64_t> GetPacketFilterHits (uint32_t id) const;
+
+  /**
+   * \return the number of packets which matched no TFT
+   */
+  uint64_t GetNoMatchCount (void) const;
   
 protected:
   
   std::map <uint32_t, Ptr<EpcTft> > m_tftMap;
+
+private:
+  /**
+   * A packet filter compiled for matching, with the addresses masked.
+   */
+  struct CompiledFilter
+  {
+    uint32_t tftId;          ///< the identifier of the TFT
+    uint32_t index;          ///< the position of the filter in the TFT
+    uint8_t direction;       ///< the direction of the filter
+    uint32_t remoteAddress;  ///< the remote address, masked
+    uint32_t remoteMask;     ///< the remote address mask
+    uint32_t localAddress;   ///< the local address, masked
+    uint32_t localMask;      ///< the local address mask
+    uint16_t remotePortStart; ///< the start of the remote port range
+    uint16_t remotePortEnd;  ///< the end of the remote port range
+    uint16_t localPortStart; ///< the start of the local port range
+    uint16_t localPortEnd;   ///< the end of the local port range
+    uint8_t tos;             ///< the type of service, masked
+    uint8_t tosMask;         ///< the type of service mask
+    uint64_t hits;           ///< the number of packets matched
+  };
+
+  /**
+   * The remote and local address and port of a packet or of an exact
+   * filter.
+   */
+  struct FlowKey
+  {
+    uint32_t remoteAddress; ///< the remote address
+    uint32_t localAddress;  ///< the local address
+    uint16_t remotePort;    ///< the remote port
+    uint16_t localPort;     ///< the local port
+
+    /**
+     * \param o another key
+     * \return true if the keys are equal
+     */
+    bool operator== (const FlowKey &o) const
+    {
+      return remoteAddress == o.remoteAddress && localAddress == o.localAddress
+             && remotePort == o.remotePort && localPort == o.localPort;
+    }
+  };
+
+  /**
+   * Hash function of a FlowKey.
+   */
+  struct FlowKeyHash
+  {
+    /**
+     * \param k a key
+     * \return the hash of the key
+     */
+    size_t operator() (const FlowKey &k) const;
+  };
+
+  /// The filters, in order of evaluation.
+  typedef std::vector<CompiledFilter *> FilterList;
+
+  /**
+   * \param a a filter
+   * \param b another filter
+   * \return true if a is evaluated before b
+   */
+  static bool IsEvaluatedBefore (const CompiledFilter *a, const CompiledFilter *b);
+  /**
+   * \param f a filter
+   * \return true if the filter matches a single remote and local address
+   * and port
+   */
+  static bool IsExact (const CompiledFilter &f);
+  /**
+   * \param f a filter
+   * \return the key of an exact filter
+   */
+  static FlowKey GetKey (const CompiledFilter &f);
+  /**
+   * Find the first filter of a list matching a packet.
+   *
+   * \param filters the list
+   * \param direction the direction of the packet
+   * \param key the addresses and ports of the packet
+   * \param tos the type of service of the packet
+   * \param bound the filter found so far, if any; only the filters
+   * evaluated before it are considered
+   * \return the first filter matching, or bound if none does
+   */
+  static CompiledFilter* FindFirstMatch (const FilterList &filters, uint8_t direction,
+                                         const FlowKey &key, uint8_t tos, CompiledFilter *bound);
+  /**
+   * Build the range table from the filters which are not exact.
+   */
+  void BuildRangeTable (void);
+
+  /// The compiled filters of each TFT, in order of precedence.
+  std::map<uint32_t, std::vector<CompiledFilter> > m_filters;
+  /// The exact filters, by remote and local address and port.
+  sgi::hash_map<FlowKey, FilterList, FlowKeyHash> m_exactFilters;
+  /// The first local port of each interval of the range table.
+  std::vector<uint16_t> m_rangeStarts;
+  /// The filters which are not exact covering each interval of the range table.
+  std::vector<FilterList> m_rangeFilters;
+  /// Whether the range table must be rebuilt.
+  bool m_rangeTableDirty;
+  /// The number of packets which matched no TFT.
+  uint64_t m_noMatchCount;
   
 };
 
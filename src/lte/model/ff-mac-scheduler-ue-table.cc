@@ -0,0 +1,275 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2015 University of Washington
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ff-mac-scheduler-ue-table.h"
+
+#include <ns3/log.h>
+#include <ns3/fatal-error.h>
+#include <ns3/lte-common.h>
+
+#include <algorithm>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("FfMacSchedulerUeTable");
+
+const uint32_t FfMacSchedulerUeTable::NO_SLOT;
+const uint8_t FfMacSchedulerUeTable::NO_CQI;
+const uint8_t FfMacSchedulerUeTable::MAX_LAYERS;
+
+FfMacSchedulerUeTable::FfMacSchedulerUeTable ()
+  : m_dlRbgNum (0),
+    m_capacity (0)
+{
+}
+
+void
+FfMacSchedulerUeTable::SetDlRbgNum (uint32_t rbgNum)
+{
+  NS_LOG_FUNCTION (this << rbgNum);
+  m_dlRbgNum = rbgNum;
+  m_dlSbCqi.assign (MAX_LAYERS * m_dlRbgNum * m_capacity, 1);
+  std::fill (m_hasDlSbCqi.begin (), m_hasDlSbCqi.end (), 0);
+  std::fill (m_dlSbCqiTimer.begin (), m_dlSbCqiTimer.end (), 0);
+}
+
+uint32_t
+FfMacSchedulerUeTable::GetDlRbgNum (void) const
+{
+  return m_dlRbgNum;
+}
+
+void
+FfMacSchedulerUeTable::Reserve (uint32_t nSlots)
+{
+  if (nSlots <= m_capacity)
+    {
+      return;
+    }
+  uint32_t capacity = std::max (m_capacity, (uint32_t) 4);
+  while (capacity < nSlots)
+    {
+      capacity *= 2;
+    }
+  NS_LOG_LOGIC ("growing to " << capacity << " slots");
+  std::vector<uint8_t> dlSbCqi (MAX_LAYERS * m_dlRbgNum * capacity, 1);
+  for (uint32_t row = 0; row < MAX_LAYERS * m_dlRbgNum; ++row)
+    {
+      std::copy (m_dlSbCqi.begin () + row * m_capacity,
+                 m_dlSbCqi.begin () + (row + 1) * m_capacity,
+                 dlSbCqi.begin () + row * capacity);
+    }
+  m_dlSbCqi.swap (dlSbCqi);
+  m_capacity = capacity;
+}
+
+uint32_t
+FfMacSchedulerUeTable::AddUe (uint16_t rnti)
+{
+  NS_LOG_FUNCTION (this << rnti);
+  NS_ASSERT_MSG (rnti != 0 && GetSlot (rnti) == NO_SLOT, "RNTI " << rnti << " invalid or already in the table");
+  uint32_t slot;
+  if (!m_freeSlots.empty ())
+    {
+      slot = m_freeSlots.back ();
+      m_freeSlots.pop_back ();
+    }
+  else
+    {
+      slot = m_rnti.size ();
+      Reserve (slot + 1);
+      m_rnti.push_back (0);
+      m_txMode.push_back (0);
+      m_dlLayers.push_back (0);
+      m_dlHarqCurrentProcessId.push_back (0);
+      m_dlHarqProcessesStatus.resize (m_dlHarqProcessesStatus.size () + HARQ_PROC_NUM);
+      m_dlHarqProcessesTimer.resize (m_dlHarqProcessesTimer.size () + HARQ_PROC_NUM);
+      m_hasDlSbCqi.push_back (0);
+      m_dlSbCqiTimer.push_back (0);
+    }
+  if (rnti >= m_slotOfRnti.size ())
+    {
+      m_slotOfRnti.resize (rnti + 1, NO_SLOT);
+    }
+  m_slotOfRnti[rnti] = slot;
+  m_rnti[slot] = rnti;
+  SetTxMode (slot, 0);
+  m_dlHarqCurrentProcessId[slot] = 0;
+  std::fill (GetDlHarqProcessesStatus (slot), GetDlHarqProcessesStatus (slot) + HARQ_PROC_NUM, 0);
+  std::fill (GetDlHarqProcessesTimer (slot), GetDlHarqProcessesTimer (slot) + HARQ_PROC_NUM, 0);
+  ResetDlSbCqi (slot);
+  return slot;
+}
+
+void
+FfMacSchedulerUeTable::RemoveUe (uint16_t rnti)
+{
+  NS_LOG_FUNCTION (this << rnti);
+  uint32_t slot = GetSlot (rnti);
+  if (slot == NO_SLOT)
+    {
+      return;
+    }
+  m_slotOfRnti[rnti] = NO_SLOT;
+  m_rnti[slot] = 0;
+  m_freeSlots.push_back (slot);
+}
+
+void
+FfMacSchedulerUeTable::Clear (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_slotOfRnti.clear ();
+  m_rnti.clear ();
+  m_freeSlots.clear ();
+  m_txMode.clear ();
+  m_dlLayers.clear ();
+  m_dlHarqCurrentProcessId.clear ();
+  m_dlHarqProcessesStatus.clear ();
+  m_dlHarqProcessesTimer.clear ();
+  m_hasDlSbCqi.clear ();
+  m_dlSbCqiTimer.clear ();
+  m_dlSbCqi.clear ();
+  m_capacity = 0;
+}
+
+uint32_t
+FfMacSchedulerUeTable::GetNUes (void) const
+{
+  return m_rnti.size () - m_freeSlots.size ();
+}
+
+void
+FfMacSchedulerUeTable::SetTxMode (uint32_t slot, uint8_t txMode)
+{
+  m_txMode[slot] = txMode;
+  m_dlLayers[slot] = TransmissionModesLayers::TxMode2LayerNum (txMode);
+}
+
+bool
+FfMacSchedulerUeTable::IsDlHarqProcessAvailable (uint32_t slot) const
+{
+  const uint8_t *status = &m_dlHarqProcessesStatus[slot * HARQ_PROC_NUM];
+  uint8_t current = m_dlHarqCurrentProcessId[slot];
+  uint8_t i = current;
+  do
+    {
+      i = (i + 1) % HARQ_PROC_NUM;
+    }
+  while ((status[i] != 0) && (i != current));
+  return status[i] == 0;
+}
+
+uint8_t
+FfMacSchedulerUeTable::UpdateDlHarqProcessId (uint32_t slot)
+{
+  uint8_t *status = GetDlHarqProcessesStatus (slot);
+  uint8_t current = m_dlHarqCurrentProcessId[slot];
+  uint8_t i = current;
+  do
+    {
+      i = (i + 1) % HARQ_PROC_NUM;
+    }
+  while ((status[i] != 0) && (i != current));
+  if (status[i] != 0)
+    {
+      NS_FATAL_ERROR ("No HARQ process available for RNTI " << m_rnti[slot] << " check before update with HarqProcessAvailability");
+    }
+  m_dlHarqCurrentProcessId[slot] = i;
+  status[i] = 1;
+  return i;
+}
+
+void
+FfMacSchedulerUeTable::RefreshDlHarqProcesses (void)
+{
+  for (uint32_t slot = 0; slot < m_rnti.size (); ++slot)
+    {
+      if (m_rnti[slot] == 0)
+        {
+          continue;
+        }
+      uint8_t *status = GetDlHarqProcessesStatus (slot);
+      uint8_t *timer = GetDlHarqProcessesTimer (slot);
+      for (uint16_t i = 0; i < HARQ_PROC_NUM; i++)
+        {
+          if (timer[i] == HARQ_DL_TIMEOUT)
+            {
+              // reset HARQ process
+              NS_LOG_DEBUG (this << " Reset HARQ proc " << i << " for RNTI " << m_rnti[slot]);
+              status[i] = 0;
+              timer[i] = 0;
+            }
+          else
+            {
+              timer[i]++;
+            }
+        }
+    }
+}
+
+void
+FfMacSchedulerUeTable::ResetDlSbCqi (uint32_t slot)
+{
+  for (uint32_t row = 0; row < MAX_LAYERS * m_dlRbgNum; ++row)
+    {
+      m_dlSbCqi[row * m_capacity + slot] = 1;
+    }
+  m_hasDlSbCqi[slot] = 0;
+  m_dlSbCqiTimer[slot] = 0;
+}
+
+void
+FfMacSchedulerUeTable::SetDlSbCqi (uint32_t slot, const SbMeasResult_s &sbMeasResult, uint32_t validity)
+{
+  const std::vector<struct HigherLayerSelected_s> &subbands = sbMeasResult.m_higherLayerSelected;
+  for (uint8_t layer = 0; layer < MAX_LAYERS; ++layer)
+    {
+      uint8_t *row = &m_dlSbCqi[layer * m_dlRbgNum * m_capacity];
+      for (uint32_t rbg = 0; rbg < m_dlRbgNum; ++rbg)
+        {
+          bool reported = rbg < subbands.size () && layer < subbands[rbg].m_sbCqi.size ();
+          row[rbg * m_capacity + slot] = reported ? subbands[rbg].m_sbCqi[layer] : NO_CQI;
+        }
+    }
+  m_hasDlSbCqi[slot] = 1;
+  m_dlSbCqiTimer[slot] = validity;
+}
+
+void
+FfMacSchedulerUeTable::RefreshDlSbCqi (void)
+{
+  for (uint32_t slot = 0; slot < m_rnti.size (); ++slot)
+    {
+      if (m_rnti[slot] == 0 || !m_hasDlSbCqi[slot])
+        {
+          continue;
+        }
+      if (m_dlSbCqiTimer[slot] == 0)
+        {
+          NS_LOG_INFO (this << " A30-CQI expired for user " << m_rnti[slot]);
+          ResetDlSbCqi (slot);
+        }
+      else
+        {
+          m_dlSbCqiTimer[slot]--;
+        }
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,269 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2015 University of Washington
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef FF_MAC_SCHEDULER_UE_TABLE_H
+#define FF_MAC_SCHEDULER_UE_TABLE_H
+
+#include <ns3/ff-mac-common.h>
+#include <ns3/assert.h>
+#include <stdint.h>
+#include <vector>
+
+/// Number of DL HARQ processes of a UE, shared by the FF MAC schedulers
+#define HARQ_PROC_NUM 8
+/// Number of TTIs after which the FF MAC schedulers release a DL HARQ process
+#define HARQ_DL_TIMEOUT 11
+
+namespace ns3 {
+
+/**
+ * \ingroup ff-api
+ * \brief Per-UE state shared by the FF MAC schedulers, stored in dense
+ * tables indexed by UE slot.
+ *
+ * Each UE added to the table gets a slot, which is reused after the UE
+ * is removed, and its RNTI is mapped to the slot by a direct lookup
+ * table, so that no map is searched per UE and per RBG. The per-UE
+ * values are kept as structures of arrays:
+ *
+ *  - the transmission mode and its number of layers;
+ *  - the DL HARQ process in use, and the status and timer of each DL
+ *    HARQ process;
+ *  - the DL subband CQI (A30 reports) of each layer and RBG, stored so
+ *    that the CQIs of all the slots for a layer and RBG are contiguous,
+ *    which lets a scheduler evaluate its metric for all the UEs on an
+ *    RBG in a single pass over an array.
+ *
+ * A UE without a valid subband CQI report has a CQI of 1 (the lowest
+ * value in range) on every layer and RBG, which is the value the
+ * schedulers use in that case; the layers and RBGs missing from a
+ * report have the value NO_CQI.
+ */
+class FfMacSchedulerUeTable
+{
+public:
+  /// The slot of an RNTI not in the table.
+  static const uint32_t NO_SLOT = 0xffffffff;
+  /// The subband CQI of a layer or RBG missing from a report.
+  static const uint8_t NO_CQI = 0xff;
+  /// The maximum number of layers.
+  static const uint8_t MAX_LAYERS = 2;
+
+  FfMacSchedulerUeTable ();
+
+  /**
+   * Set the number of DL RBGs of the subband CQIs. The CQIs received so
+   * far are discarded.
+   *
+   * \param rbgNum the number of RBGs
+   */
+  void SetDlRbgNum (uint32_t rbgNum);
+  /**
+   * \return the number of DL RBGs of the subband CQIs
+   */
+  uint32_t GetDlRbgNum (void) const;
+
+  /**
+   * Add a UE, with no HARQ process in use and no subband CQI.
+   *
+   * \param rnti the RNTI of the UE, which must not be in the table
+   * \return the slot of the UE
+   */
+  uint32_t AddUe (uint16_t rnti);
+  /**
+   * Remove a UE, if it is in the table.
+   *
+   * \param rnti the RNTI of the UE
+   */
+  void RemoveUe (uint16_t rnti);
+  /**
+   * Remove all the UEs.
+   */
+  void Clear (void);
+
+  /**
+   * \param rnti the RNTI of a UE
+   * \return the slot of the UE, or NO_SLOT if it is not in the table
+   */
+  uint32_t GetSlot (uint16_t rnti) const
+  {
+    return rnti < m_slotOfRnti.size () ? m_slotOfRnti[rnti] : NO_SLOT;
+  }
+  /**
+   * \param slot a slot
+   * \return the RNTI of the UE in the slot, or 0 if the slot is free
+   */
+  uint16_t GetRnti (uint32_t slot) const
+  {
+    NS_ASSERT (slot < m_rnti.size ());
+    return m_rnti[slot];
+  }
+  /**
+   * \return the number of slots, in use or free; the slots are numbered
+   * from 0 to GetNSlots () - 1
+   */
+  uint32_t GetNSlots (void) const
+  {
+    return m_rnti.size ();
+  }
+  /**
+   * \return the number of UEs in the table
+   */
+  uint32_t GetNUes (void) const;
+
+  /**
+   * \param slot the slot of a UE
+   * \param txMode the transmission mode of the UE
+   */
+  void SetTxMode (uint32_t slot, uint8_t txMode);
+  /**
+   * \param slot the slot of a UE
+   * \return the transmission mode of the UE
+   */
+  uint8_t GetTxMode (uint32_t slot) const
+  {
+    return m_txMode[slot];
+  }
+  /**
+   * \param slot the slot of a UE
+   * \return the number of layers of the transmission mode of the UE
+   */
+  uint8_t GetDlLayers (uint32_t slot) const
+  {
+    return m_dlLayers[slot];
+  }
+
+  /**
+   * \param slot the slot of a UE
+   * \return the DL HARQ process in use
+   */
+  uint8_t GetDlHarqCurrentProcessId (uint32_t slot) const
+  {
+    return m_dlHarqCurrentProcessId[slot];
+  }
+  /**
+   * \param slot the slot of a UE
+   * \return the status of the HARQ_PROC_NUM DL HARQ processes of the UE:
+   * 0 if the process is available, else the number of transmissions
+   */
+  uint8_t* GetDlHarqProcessesStatus (uint32_t slot)
+  {
+    return &m_dlHarqProcessesStatus[slot * HARQ_PROC_NUM];
+  }
+  /**
+   * \param slot the slot of a UE
+   * \return the timers of the HARQ_PROC_NUM DL HARQ processes of the UE
+   */
+  uint8_t* GetDlHarqProcessesTimer (uint32_t slot)
+  {
+    return &m_dlHarqProcessesTimer[slot * HARQ_PROC_NUM];
+  }
+  /**
+   * \param slot the slot of a UE
+   * \return true if a DL HARQ process of the UE is available
+   */
+  bool IsDlHarqProcessAvailable (uint32_t slot) const;
+  /**
+   * Move a UE to its next available DL HARQ process and mark it as used.
+   *
+   * \param slot the slot of the UE, which must have an available process
+   * \return the DL HARQ process now in use
+   */
+  uint8_t UpdateDlHarqProcessId (uint32_t slot);
+  /**
+   * Advance the timers of the DL HARQ processes by a TTI, releasing the
+   * processes whose timer reached HARQ_DL_TIMEOUT.
+   */
+  void RefreshDlHarqProcesses (void);
+
+  /**
+   * Store a subband CQI report of a UE.
+   *
+   * \param slot the slot of the UE
+   * \param sbMeasResult the report
+   * \param validity the number of TTIs the report is valid
+   */
+  void SetDlSbCqi (uint32_t slot, const SbMeasResult_s &sbMeasResult, uint32_t validity);
+  /**
+   * \param slot the slot of a UE
+   * \return true if the UE has a valid subband CQI report
+   */
+  bool HasDlSbCqi (uint32_t slot) const
+  {
+    return m_hasDlSbCqi[slot];
+  }
+  /**
+   * \param slot the slot of a UE
+   * \param layer a layer
+   * \param rbg a DL RBG
+   * \return the subband CQI of the UE
+   */
+  uint8_t GetDlSbCqi (uint32_t slot, uint8_t layer, uint32_t rbg) const
+  {
+    NS_ASSERT (layer < MAX_LAYERS && rbg < m_dlRbgNum);
+    return m_dlSbCqi[(layer * m_dlRbgNum + rbg) * m_capacity + slot];
+  }
+  /**
+   * \param layer a layer
+   * \param rbg a DL RBG
+   * \return the subband CQIs of all the slots for the layer and RBG,
+   * indexed by slot
+   */
+  const uint8_t* GetDlSbCqiRow (uint8_t layer, uint32_t rbg) const
+  {
+    NS_ASSERT (layer < MAX_LAYERS && rbg < m_dlRbgNum);
+    return &m_dlSbCqi[(layer * m_dlRbgNum + rbg) * m_capacity];
+  }
+  /**
+   * Advance the validity timers of the subband CQI reports by a TTI,
+   * discarding the expired reports.
+   */
+  void RefreshDlSbCqi (void);
+
+private:
+  /**
+   * Set the subband CQIs of a UE to their value without a report.
+   *
+   * \param slot the slot of the UE
+   */
+  void ResetDlSbCqi (uint32_t slot);
+  /**
+   * Make room for at least a number of slots.
+   *
+   * \param nSlots the number of slots
+   */
+  void Reserve (uint32_t nSlots);
+
+  std::vector<uint32_t> m_slotOfRnti;               //!< The slot of each RNTI.
+  std::vector<uint16_t> m_rnti;                     //!< The RNTI of each slot, 0 if free.
+  std::vector<uint32_t> m_freeSlots;                //!< The free slots.
+  std::vector<uint8_t> m_txMode;                    //!< The transmission mode of each slot.
+  std::vector<uint8_t> m_dlLayers;                  //!< The number of layers of each slot.
+  std::vector<uint8_t> m_dlHarqCurrentProcessId;    //!< The DL HARQ process in use by each slot.
+  std::vector<uint8_t> m_dlHarqProcessesStatus;     //!< The DL HARQ process status, by slot and process.
+  std::vector<uint8_t> m_dlHarqProcessesTimer;      //!< The DL HARQ process timers, by slot and process.
+  std::vector<uint8_t> m_hasDlSbCqi;                //!< Whether each slot has a subband CQI report.
+  std::vector<uint32_t> m_dlSbCqiTimer;             //!< The validity of the subband CQI of each slot.
+  std::vector<uint8_t> m_dlSbCqi;                   //!< The subband CQIs, by layer, RBG and slot.
+  uint32_t m_dlRbgNum;                              //!< The number of DL RBGs.
+  uint32_t m_capacity;                              //!< The number of slots of the subband CQI rows.
+};
+
+} // namespace ns3
+
+#endif /* FF_MAC_SCHEDULER_UE_TABLE_H */
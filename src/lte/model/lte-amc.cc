@@ -352,6 +352,8 @@ LteAmc::CreateCqiFeedbacks (const SpectrumValue& sinr, uint8_t rbgSize)
       NS_ASSERT_MSG (rbgSize > 0, " LteAmc-Vienna: RBG size must be greater than 0");
       std::vector <int> rbgMap;
       int rbId = 0;
+      LteChunkArena sinrChunks;
+      sinrChunks.Add (sinr, Seconds (1));
       for (it = sinr.ConstValuesBegin (); it != sinr.ConstValuesEnd (); it++)
       {
         rbgMap.push_back (rbId++);
@@ -362,9 +364,7 @@ LteAmc::CreateCqiFeedbacks (const SpectrumValue& sinr, uint8_t rbgSize)
             while (mcs <= 28)
               {
                 HarqProcessInfoList_t harqInfoList;
-                std::list<LteListChunkProcessor::Chunk> sinrChunkList;
-                sinrChunkList.push_back (LteListChunkProcessor::Chunk (sinr.Copy (), Seconds (1)));
-                tbStats = LteMiErrorModel::GetTbDecodificationStats (sinrChunkList, rbgMap, (uint16_t)GetTbSizeFromMcs (mcs, rbgSize) / 8, mcs, harqInfoList);
+                tbStats = LteMiErrorModel::GetTbDecodificationStats (sinrChunks, rbgMap, (uint16_t)GetTbSizeFromMcs (mcs, rbgSize) / 8, mcs, harqInfoList);
                 if (tbStats.tbler > 0.1)
                   {
                     break;
@@ -91,14 +91,64 @@ LteAverageChunkProcessor::End ()
 
 
 
-LteListChunkProcessor::Chunk::Chunk (Ptr<SpectrumValue> spectrumValue, Time duration)
-  : m_spectrumValue (spectrumValue),
-    m_duration (duration)
-{  
+LteChunkArena::LteChunkArena ()
+  : m_nRbs (0)
+{
+}
+
+void
+LteChunkArena::Clear ()
+{
+  m_values.clear ();
+  m_durations.clear ();
+}
+
+void
+LteChunkArena::Add (const SpectrumValue& value, Time duration)
+{
+  uint32_t nRbs = value.ConstValuesEnd () - value.ConstValuesBegin ();
+  if (m_durations.empty ())
+    {
+      m_nRbs = nRbs;
+    }
+  NS_ASSERT_MSG (nRbs == m_nRbs, "chunks with different numbers of RBs");
+  m_values.insert (m_values.end (), value.ConstValuesBegin (), value.ConstValuesEnd ());
+  m_durations.push_back (duration);
+}
+
+uint32_t
+LteChunkArena::GetNChunks () const
+{
+  return m_durations.size ();
 }
 
-LteListChunkProcessor::Chunk::Chunk ()
-{  
+uint32_t
+LteChunkArena::GetNRbs () const
+{
+  return m_nRbs;
+}
+
+const double*
+LteChunkArena::GetValues (uint32_t chunk) const
+{
+  NS_ASSERT (chunk < m_durations.size ());
+  return &m_values[chunk * m_nRbs];
+}
+
+Time
+LteChunkArena::GetDuration (uint32_t chunk) const
+{
+  NS_ASSERT (chunk < m_durations.size ());
+  return m_durations[chunk];
+}
+
+void
+LteChunkArena::Scale (double factor)
+{
+  for (std::vector<double>::iterator it = m_values.begin (); it != m_values.end (); ++it)
+    {
+      *it *= factor;
+    }
 }
 
 void
@@ -118,22 +168,22 @@ void
 LteListChunkProcessor::EvaluateChunk (const SpectrumValue& sinr, Time duration)
 {
   NS_LOG_FUNCTION (this << sinr << duration);
-  m_chunkList.push_back (Chunk (sinr.Copy (), duration));
+  m_chunks.Add (sinr, duration);
 }
 
 void
 LteListChunkProcessor::End ()
 {
   NS_LOG_FUNCTION (this);
-  if (!m_chunkList.empty ())
+  if (m_chunks.GetNChunks () > 0)
     {
-      NS_LOG_FUNCTION (this << "reporting " << m_chunkList.size () << " chunks");
+      NS_LOG_FUNCTION (this << "reporting " << m_chunks.GetNChunks () << " chunks");
       std::list<LteListChunkProcessorCallback>::iterator it;
       for (it = m_lteListChunkProcessorCallbacks.begin (); it != m_lteListChunkProcessorCallbacks.end (); it++)
         {
-          (*it)(m_chunkList);
+          (*it)(m_chunks);
         }
-      m_chunkList.clear ();
+      m_chunks.Clear ();
     }
   else
     {
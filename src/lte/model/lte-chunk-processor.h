@@ -32,6 +32,7 @@
 #include <ns3/ptr.h>
 #include <ns3/nstime.h>
 #include <ns3/object.h>
+#include <vector>
 
 namespace ns3 {
 
@@ -116,42 +117,86 @@ private:
 
 
 /**
- * An implementation of LteChunkProcessor that aggregates SpectrumValues
- * in the time domain by storing them in a list together with their associated
- * duration
- * 
+ * The time-vs-frequency chunks of a received signal, stored as the
+ * values of each chunk laid out one after the other in a single
+ * contiguous array, together with the duration of each chunk.
+ *
+ * Clearing the arena keeps its storage, so that an arena reused for
+ * each reception stops allocating memory once it has grown to the
+ * largest number of chunks received.
  */
-class LteListChunkProcessor : public LteChunkProcessor
+class LteChunkArena
 {
 public:
+  LteChunkArena ();
+
+  /**
+   * \brief remove all the chunks, keeping the storage
+   */
+  void Clear ();
+
+  /**
+   * \brief append a chunk
+   *
+   * \param value the values of the chunk, one per RB; all the chunks
+   * must have the same number of values
+   * \param duration the duration of the chunk
+   */
+  void Add (const SpectrumValue& value, Time duration);
+
+  /**
+   * \return the number of chunks
+   */
+  uint32_t GetNChunks () const;
+
+  /**
+   * \return the number of values, i.e., RBs, of each chunk
+   */
+  uint32_t GetNRbs () const;
+
+  /**
+   * \param chunk the index of the chunk
+   * \return a pointer to the GetNRbs () values of the chunk
+   */
+  const double* GetValues (uint32_t chunk) const;
+
+  /**
+   * \param chunk the index of the chunk
+   * \return the duration of the chunk
+   */
+  Time GetDuration (uint32_t chunk) const;
 
   /**
-   * data structure holding a SpectrumValue and its duration in time
+   * \brief multiply all the values of all the chunks by a factor
+   *
+   * \param factor the factor
    */
-  struct Chunk
-  {
-    /** 
-     * constructor
-     * 
-     * \param spectrumValue 
-     * \param duration 
-     */
-    Chunk (Ptr<SpectrumValue> spectrumValue, Time duration);
-
-    /** 
-     * (unused) constructor; requires definition to allow Python API scanning
-     */ 
-    Chunk ();
-    Ptr<SpectrumValue> m_spectrumValue;
-    Time m_duration;
-  };
+  void Scale (double factor);
+
+private:
+  std::vector<double> m_values;  ///< the values of all the chunks
+  std::vector<Time> m_durations; ///< the duration of each chunk
+  uint32_t m_nRbs;               ///< the number of values of each chunk
+};
+
 
 
+/**
+ * An implementation of LteChunkProcessor that aggregates SpectrumValues
+ * in the time domain by storing them in an LteChunkArena together with
+ * their associated duration
+ * 
+ */
+class LteListChunkProcessor : public LteChunkProcessor
+{
+public:
+
   /**
-   * Callback type used by LteListChunkProcessor for reporting
+   * Callback type used by LteListChunkProcessor for reporting; the
+   * chunks are only valid during the call
    * 
    */
-  typedef Callback< void, std::list<Chunk> > LteListChunkProcessorCallback;
+  typedef Callback< void, const LteChunkArena& > LteListChunkProcessorCallback;
   
 
   /**
@@ -170,7 +215,7 @@ public:
 
 private:
 
-  std::list<Chunk> m_chunkList;
+  LteChunkArena m_chunks;
   std::list<LteListChunkProcessorCallback> m_lteListChunkProcessorCallbacks;
 };
 
@@ -133,6 +133,14 @@ private:
                                     * does not include noise, includes the SPD of the signal being RX
                                     */
 
+  Ptr<SpectrumValue> m_sinr; /**< stores the SINR of the last chunk,
+                              * reused across chunks
+                              */
+
+  Ptr<SpectrumValue> m_interf; /**< stores the interference plus noise
+                                * of the last chunk, reused across chunks
+                                */
+
   Ptr<const SpectrumValue> m_noise;
 
   Time m_lastChangeTime;     /**< the time of the last change in
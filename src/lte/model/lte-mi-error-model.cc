@@ -322,6 +322,176 @@ static const double cEcrTable [9][38] = {
     
 };
 
+
+/**
+ * A mutual information curve, sampled over uniformly spaced SINR values
+ */
+struct MiCurve
+{
+  const double *mi;    ///< the MI of each sample
+  const double *axis;  ///< the SINR of each sample, in linear units
+  uint32_t size;       ///< the number of samples
+};
+
+static const MiCurve MiCurveQpsk = {MI_map_qpsk, MI_map_qpsk_axis, MI_MAP_QPSK_SIZE};
+static const MiCurve MiCurve16Qam = {MI_map_16qam, MI_map_16qam_axis, MI_MAP_16QAM_SIZE};
+static const MiCurve MiCurve64Qam = {MI_map_64qam, MI_map_64qam_axis, MI_MAP_64QAM_SIZE};
+
+/// number of RBs whose MI is looked up in a single batch
+static const uint32_t MI_BATCH_SIZE = 32;
+
+/**
+ * Sum the MI of a set of RBs, with the same result as summing the
+ * return values of MibQpsk, Mib16Qam or Mib64Qam.
+ *
+ * The RBs are processed in batches: the SINRs of a batch are first
+ * gathered into a contiguous array, their MI is then looked up without
+ * any branch, so that the compiler can evaluate several RBs in SIMD
+ * lanes, and the MI values are finally summed in RB order.
+ *
+ * \param curve the MI curve of the modulation
+ * \param sinr the SINR of all the RBs, in linear units
+ * \param rbs the indexes of the RBs to sum, or 0 to sum all of them
+ * \param nRbs the number of RBs to sum
+ * \return the sum of the MI of the RBs
+ */
+static double
+SumMi (const MiCurve& curve, const double* sinr, const int* rbs, uint32_t nRbs)
+{
+  const double axisMin = curve.axis[0];
+  const double axisMax = curve.axis[curve.size - 1];
+  // since the values of the axis are uniformly spaced, we have
+  // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
+  const double scalingCoeff = (curve.size - 1) / (axisMax - axisMin);
+  const double maxIndex = curve.size - 1;
+  double s[MI_BATCH_SIZE];
+  double mi[MI_BATCH_SIZE];
+  double sum = 0.0;
+  for (uint32_t first = 0; first < nRbs; first += MI_BATCH_SIZE)
+    {
+      uint32_t n = std::min (nRbs - first, MI_BATCH_SIZE);
+      for (uint32_t i = 0; i < n; i++)
+        {
+          s[i] = sinr[rbs ? rbs[first + i] : first + i];
+        }
+      for (uint32_t i = 0; i < n; i++)
+        {
+          // the index is clamped instead of being checked, and SINRs
+          // beyond the curve are then saturated to an MI of 1
+          double index = (s[i] - axisMin) * scalingCoeff + 1;
+          index = index < 0.0 ? 0.0 : index;
+          index = index > maxIndex ? maxIndex : index;
+          double value = curve.mi[(uint32_t) index];
+          mi[i] = s[i] > axisMax ? 1.0 : value;
+        }
+      for (uint32_t i = 0; i < n; i++)
+        {
+          sum += mi[i];
+        }
+    }
+  return sum;
+}
+
+
+/// number of intervals of the tabulated BLER curve
+static const uint32_t BLER_TABLE_SIZE = 8192;
+/// the BLER curve is tabulated for (mib - b) / (sqrt (2) c) in [-BLER_TABLE_RANGE, BLER_TABLE_RANGE]
+static const double BLER_TABLE_RANGE = 5.0;
+
+/**
+ * The BLER curves of all the (CB size, ECR) pairs, precomputed.
+ *
+ * All the curves are 0.5 * (1 - erf ((mib - b) / (sqrt (2) c))), see
+ * IEEE802.16m EMD formula 55 of section 4.3.2.1, so they are stored as
+ * the parameters of each pair, with the missing entries of the tables
+ * already replaced, and a single sampling of 0.5 * (1 - erf (x)) which
+ * is linearly interpolated.
+ */
+struct BlerTable
+{
+  BlerTable ();
+
+  /**
+   * \param mib the mean mutual information per bit
+   * \param ecrId the Effective Code Rate ID
+   * \param cbIndex the index of the CB size in cbMiSizeTable
+   * \return the code block error rate
+   */
+  double GetBler (double mib, uint8_t ecrId, int cbIndex) const;
+
+  double b[9][38];      ///< the b parameter of each curve
+  double c[9][38];      ///< the c parameter of each curve
+  double scale[9][38];  ///< 1 / (sqrt (2) c) of each curve
+  double bler[BLER_TABLE_SIZE + 1]; ///< the samples of 0.5 * (1 - erf (x))
+};
+
+BlerTable::BlerTable ()
+{
+  for (int cbIndex = 0; cbIndex < 9; cbIndex++)
+    {
+      for (int ecrId = 0; ecrId <= MI_64QAM_BLER_MAX_ID; ecrId++)
+        {
+          double bValue = bEcrTable[cbIndex][ecrId];
+          if (bValue < 0.0)
+            {
+              //take the lowest CB size including this CB for removing CB size
+              //quatization errors
+              int i = cbIndex;
+              while ((i < 9) && (bValue < 0))
+                {
+                  bValue = bEcrTable[i++][ecrId];
+                }
+            }
+          double cValue = cEcrTable[cbIndex][ecrId];
+          if (cValue < 0.0)
+            {
+              int i = cbIndex;
+              while ((i < 9) && (cValue < 0))
+                {
+                  cValue = cEcrTable[i++][ecrId];
+                }
+            }
+          b[cbIndex][ecrId] = bValue;
+          c[cbIndex][ecrId] = cValue;
+          scale[cbIndex][ecrId] = 1.0 / (sqrt (2) * cValue);
+        }
+    }
+  for (uint32_t i = 0; i <= BLER_TABLE_SIZE; i++)
+    {
+      double x = -BLER_TABLE_RANGE + (2 * BLER_TABLE_RANGE * i) / BLER_TABLE_SIZE;
+      bler[i] = 0.5 * (1 - erf (x));
+    }
+}
+
+double
+BlerTable::GetBler (double mib, uint8_t ecrId, int cbIndex) const
+{
+  double x = (mib - b[cbIndex][ecrId]) * scale[cbIndex][ecrId];
+  double pos = (x + BLER_TABLE_RANGE) * (BLER_TABLE_SIZE / (2 * BLER_TABLE_RANGE));
+  if (!(pos > 0.0))
+    {
+      return bler[0];
+    }
+  if (pos >= BLER_TABLE_SIZE)
+    {
+      return bler[BLER_TABLE_SIZE];
+    }
+  uint32_t i = (uint32_t) pos;
+  double frac = pos - i;
+  return bler[i] + frac * (bler[i + 1] - bler[i]);
+}
+
+/**
+ * \return the BLER curves, computed on first use
+ */
+static const BlerTable&
+GetBlerTable ()
+{
+  static const BlerTable table;
+  return table;
+}
+
+
 double 
 LteMiErrorModel::MibQpsk (double sinrLin)
 {
@@ -398,108 +568,99 @@ double
 LteMiErrorModel::Mib (const SpectrumValue& sinr, const std::vector<int>& map, uint8_t mcs)
 {
   NS_LOG_FUNCTION (sinr << &map << (uint32_t) mcs);
-  
-  double MI;
-  double MIsum = 0.0;
-  SpectrumValue sinrCopy = sinr;
-  
-  for (uint32_t i = 0; i < map.size (); i++)
+  NS_ASSERT (sinr.ConstValuesBegin () != sinr.ConstValuesEnd ());
+  return Mib (&(*sinr.ConstValuesBegin ()), map, mcs);
+}
+
+double 
+LteMiErrorModel::Mib (const double* sinr, const std::vector<int>& map, uint8_t mcs)
+{
+  NS_LOG_FUNCTION (sinr << &map << (uint32_t) mcs);
+
+  // the modulation is the same for all the RBs of the TB
+  const MiCurve* curve;
+  if (mcs <= MI_QPSK_MAX_ID) // QPSK
     {
-      double sinrLin = sinrCopy[map.at (i)];
-      if (mcs <= MI_QPSK_MAX_ID) // QPSK
-        {
-          MI = MibQpsk (sinrLin);
-        }
-      else if (mcs > MI_QPSK_MAX_ID && mcs <= MI_16QAM_MAX_ID )	// 16-QAM
-        {
-          MI = Mib16Qam (sinrLin);
-        }
-      else // 64-QAM
-        {
-          MI = Mib64Qam (sinrLin);          
-        }
-      // NS_LOG_LOGIC (" RB " << map.at (i) << " Minimum SNR = " << 10 * std::log10 (sinrLin) << " dB, " << sinrLin << " V, MCS = " << (uint16_t)mcs << ", MI = " << MI);
-      MIsum += MI;
+      curve = &MiCurveQpsk;
     }
+  else if (mcs > MI_QPSK_MAX_ID && mcs <= MI_16QAM_MAX_ID )	// 16-QAM
+    {
+      curve = &MiCurve16Qam;
+    }
+  else // 64-QAM
+    {
+      curve = &MiCurve64Qam;
+    }
+
+  double MI;
+  double MIsum = map.empty () ? 0.0 : SumMi (*curve, sinr, &map[0], map.size ());
   MI = MIsum / map.size ();
   NS_LOG_LOGIC (" MI = " << MI);
   return MI;
 }
 
 
-double 
-LteMiErrorModel::MappingMiBler (double mib, uint8_t ecrId, uint16_t cbSize)
+/**
+ * \param cbSize the size of a CB
+ * \return the index in cbMiSizeTable of the largest CB size not
+ * greater than cbSize
+ */
+static int
+GetCbIndex (uint16_t cbSize)
 {
-  NS_LOG_FUNCTION (mib << (uint32_t) ecrId << (uint32_t) cbSize);
-  double b = 0;
-  double c = 0;
-
-  NS_ASSERT_MSG (ecrId <= MI_64QAM_BLER_MAX_ID, "ECR out of range [0..37]: " << (uint16_t) ecrId);
   int cbIndex = 1;
   while ((cbIndex < 9)&&(cbMiSizeTable[cbIndex]<= cbSize))
     {
       cbIndex++;
     }
   cbIndex--;
+  return cbIndex;
+}
+
+double 
+LteMiErrorModel::MappingMiBler (double mib, uint8_t ecrId, uint16_t cbSize)
+{
+  NS_LOG_FUNCTION (mib << (uint32_t) ecrId << (uint32_t) cbSize);
+
+  NS_ASSERT_MSG (ecrId <= MI_64QAM_BLER_MAX_ID, "ECR out of range [0..37]: " << (uint16_t) ecrId);
+  int cbIndex = GetCbIndex (cbSize);
   NS_LOG_LOGIC (" ECRid " << (uint16_t)ecrId << " ECR " << BlerCurvesEcrMap[ecrId] << " CB size " << cbSize << " CB size curve " << cbMiSizeTable[cbIndex]);
 
-  b = bEcrTable[cbIndex][ecrId];
-  if (b<0.0)
-    {
-      //take the lowest CB size including this CB for removing CB size
-      //quatization errors
-      int i = cbIndex;
-      while ((i<9)&&(b<0))
-        {
-          b = bEcrTable[i++][ecrId];
-        }
-    }
-  c = cEcrTable[cbIndex][ecrId];
-  if (c<0.0)
-    {
-      //take the lowest CB size including this CB for removing CB size
-      //quatization errors
-      int i = cbIndex;
-      while ((i<9)&&(c<0))
-        {
-          c = cEcrTable[i++][ecrId];
-        }
-    }
   // see IEEE802.16m EMD formula 55 of section 4.3.2.1
-  double bler = 0.5*( 1 - erf((mib-b)/(sqrt(2)*c)) );
-  NS_LOG_LOGIC ("MIB: " << mib << " BLER:" << bler << " b:" << b << " c:" << c);
+  const BlerTable& table = GetBlerTable ();
+  double bler = table.GetBler (mib, ecrId, cbIndex);
+  NS_LOG_LOGIC ("MIB: " << mib << " BLER:" << bler << " b:" << table.b[cbIndex][ecrId] << " c:" << table.c[cbIndex][ecrId]);
   return bler;
 }
 
+void
+LteMiErrorModel::GetBlerCurveParameters (uint8_t ecrId, uint16_t cbSize, double& b, double& c)
+{
+  NS_ASSERT_MSG (ecrId <= MI_64QAM_BLER_MAX_ID, "ECR out of range [0..37]: " << (uint16_t) ecrId);
+  int cbIndex = GetCbIndex (cbSize);
+  const BlerTable& table = GetBlerTable ();
+  b = table.b[cbIndex][ecrId];
+  c = table.c[cbIndex][ecrId];
+}
+
 
 
 double
-LteMiErrorModel::GetPcfichPdcchError (std::list<LteListChunkProcessor::Chunk> sinr)
+LteMiErrorModel::GetPcfichPdcchError (const LteChunkArena& sinr)
 {
   NS_LOG_FUNCTION_NOARGS ();
 
   // calculate MI by averaging the MI over different SINR chunks weighted by their duration
   double weightedSum = 0;
   double totDurationSeconds = 0;
-  for (std::list<LteListChunkProcessor::Chunk>::iterator chunkIt = sinr.begin ();
-       chunkIt != sinr.end ();
-       ++chunkIt)
-    {
-      Values::iterator sinrIt = chunkIt->m_spectrumValue->ValuesBegin ();
-      uint16_t rb = 0;
-      double MIsum = 0;
-      NS_ASSERT (sinrIt != chunkIt->m_spectrumValue->ValuesEnd ());
-      while (sinrIt != chunkIt->m_spectrumValue->ValuesEnd ())
-        {
-          double sinrLin = *sinrIt;
-          double rbMI = MibQpsk (sinrLin);
-          MIsum += rbMI;
-          sinrIt++;
-          rb++;
-        }
-      double chunkMI = MIsum / rb;
-      weightedSum += chunkMI * chunkIt->m_duration.GetSeconds ();
-      totDurationSeconds += chunkIt->m_duration.GetSeconds ();
+  uint32_t nRbs = sinr.GetNRbs ();
+  NS_ASSERT (nRbs > 0);
+  for (uint32_t chunk = 0; chunk < sinr.GetNChunks (); ++chunk)
+    {
+      double chunkMI = SumMi (MiCurveQpsk, sinr.GetValues (chunk), 0, nRbs) / nRbs;
+      double durationSeconds = sinr.GetDuration (chunk).GetSeconds ();
+      weightedSum += chunkMI * durationSeconds;
+      totDurationSeconds += durationSeconds;
     }
   double MI = weightedSum / totDurationSeconds;
 
@@ -560,22 +721,20 @@ LteMiErrorModel::GetPcfichPdcchError (std::list<LteListChunkProcessor::Chunk> si
 
 
 TbStats_t
-LteMiErrorModel::GetTbDecodificationStats (std::list<LteListChunkProcessor::Chunk> sinr, const std::vector<int>& map, uint16_t size, uint8_t mcs, HarqProcessInfoList_t miHistory)
+LteMiErrorModel::GetTbDecodificationStats (const LteChunkArena& sinr, const std::vector<int>& map, uint16_t size, uint8_t mcs, const HarqProcessInfoList_t& miHistory)
 {
   NS_LOG_FUNCTION (&sinr << &map << (uint32_t) size << (uint32_t) mcs);
 
   // calculate TB MI by averaging the MI over different SINR chunks weighted by their duration
   double weightedSum = 0;
   double totDurationSeconds = 0;
-  for (std::list<LteListChunkProcessor::Chunk>::iterator chunkIt = sinr.begin ();
-       chunkIt != sinr.end ();
-       ++chunkIt)
+  for (uint32_t chunk = 0; chunk < sinr.GetNChunks (); ++chunk)
     {
-      double chunkMi = Mib(*(chunkIt->m_spectrumValue), map, mcs) * chunkIt->m_duration.GetSeconds ();
+      double durationSeconds = sinr.GetDuration (chunk).GetSeconds ();
+      double chunkMi = Mib (sinr.GetValues (chunk), map, mcs) * durationSeconds;
       weightedSum += chunkMi;
-      totDurationSeconds += chunkIt->m_duration.GetSeconds ();
-      NS_LOG_LOGIC ("chunk MI " << chunkMi << ", duration " << chunkIt->m_duration
-                    << ", sinr " << *(chunkIt->m_spectrumValue));
+      totDurationSeconds += durationSeconds;
+      NS_LOG_LOGIC ("chunk MI " << chunkMi << ", duration " << sinr.GetDuration (chunk));
     }
   double tbMi = weightedSum / totDurationSeconds;
   NS_LOG_LOGIC ("TB MI " << tbMi);
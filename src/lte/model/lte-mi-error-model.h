@@ -108,14 +108,41 @@ public:
    * \return the mmib
    */
   static double Mib (const SpectrumValue& sinr, const std::vector<int>& map, uint8_t mcs);
+  /** 
+   * \brief find the mmib (mean mutual information per bit) for different modulations of the specified TB
+   *
+   * The SINRs of the RBs in the map are gathered and looked up in
+   * batches, without any per-RB branch.
+   *
+   * \param sinr the perceived sinrs in the whole bandwidth, one per RB
+   * \param map the actives RBs for the TB
+   * \param mcs the MCS of the TB
+   * \return the mmib
+   */
+  static double Mib (const double* sinr, const std::vector<int>& map, uint8_t mcs);
   /** 
    * \brief map the mmib (mean mutual information per bit) for different MCS
+   *
+   * The BLER curves are precomputed on first use and linearly
+   * interpolated.
+   *
    * \param mib mean mutual information per bit of a code-block
    * \param ecrId Effective Code Rate ID
    * \param cbSize the size of the CB
    * \return the code block error rate
    */
   static double MappingMiBler (double mib, uint8_t ecrId, uint16_t cbSize);
+  /**
+   * \brief get the parameters of the BLER curve used by MappingMiBler
+   *
+   * The curve is 0.5 * (1 - erf ((mib - b) / (sqrt (2) c))).
+   *
+   * \param ecrId Effective Code Rate ID
+   * \param cbSize the size of the CB
+   * \param b the b parameter of the curve
+   * \param c the c parameter of the curve
+   */
+  static void GetBlerCurveParameters (uint8_t ecrId, uint16_t cbSize, double& b, double& c);
 
   /**
    * \brief run the error-model algorithm for the specified TB
@@ -126,14 +153,14 @@ public:
    * \param miHistory  MI of past transmissions (in case of retx)
    * \return the TB error rate and MI
    */
-  static TbStats_t GetTbDecodificationStats (std::list<LteListChunkProcessor::Chunk> sinr, const std::vector<int>& map, uint16_t size, uint8_t mcs, HarqProcessInfoList_t miHistory);
+  static TbStats_t GetTbDecodificationStats (const LteChunkArena& sinr, const std::vector<int>& map, uint16_t size, uint8_t mcs, const HarqProcessInfoList_t& miHistory);
   
   /** 
   * \brief run the error-model algorithm for the specified PCFICH+PDCCH channels
   * \param sinr the perceived sinrs in the whole bandwidth
   * \return the decodification error of the PCFICH+PDCCH channels
   */  
-  static double GetPcfichPdcchError (std::list<LteListChunkProcessor::Chunk> sinr);
+  static double GetPcfichPdcchError (const LteChunkArena& sinr);
 
 
 //private:
@@ -26,6 +26,7 @@
 #include <ns3/lte-rlc.h>
 
 #include <vector>
+#include <deque>
 #include <map>
 
 namespace ns3 {
@@ -79,7 +80,7 @@ private:
   void DoReportBufferStatus ();
 
 private:
-    std::vector < Ptr<Packet> > m_txonBuffer;       // Transmission buffer
+    std::deque < Ptr<Packet> > m_txonBuffer;        // Transmission buffer
 
     struct RetxPdu
     {
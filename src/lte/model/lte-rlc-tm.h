@@ -25,6 +25,7 @@
 #include "ns3/lte-rlc.h"
 
 #include <ns3/event-id.h>
+#include <deque>
 #include <map>
 
 namespace ns3 {
@@ -59,7 +60,7 @@ private:
 private:
   uint32_t m_maxTxBufferSize;
   uint32_t m_txBufferSize;
-  std::vector < Ptr<Packet> > m_txBuffer;       // Transmission buffer
+  std::deque < Ptr<Packet> > m_txBuffer;        // Transmission buffer
 
   EventId m_rbsTimer;
 
@@ -645,7 +645,7 @@ LteSpectrumPhy::StartRx (Ptr<SpectrumSignalParameters> spectrumRxParams)
   NS_LOG_FUNCTION (this << spectrumRxParams);
   NS_LOG_LOGIC (this << " state: " << m_state);
   
-  Ptr <const SpectrumValue> rxPsd = spectrumRxParams->psd;
+  Ptr <const SpectrumValue> rxPsd = spectrumRxParams->GetPsd ();
   Time duration = spectrumRxParams->duration;
 
   // pass it to interference calculations regardless of the type (LTE or non-LTE)
@@ -916,9 +916,10 @@ LteSpectrumPhy::StartRxUlSrs (Ptr<LteSpectrumSignalParametersUlSrsFrame> lteUlSr
 
 
 void
-LteSpectrumPhy::UpdateSinrPerceived (std::list<LteListChunkProcessor::Chunk> sinr)
+LteSpectrumPhy::UpdateSinrPerceived (const LteChunkArena& sinr)
 {
   NS_LOG_FUNCTION (this);
+  // copied into the storage of the previous reception, which is reused
   m_sinrPerceived = sinr;
 }
 
@@ -961,12 +962,7 @@ LteSpectrumPhy::EndRxData ()
   // apply transmission mode gain
   NS_LOG_DEBUG (this << " txMode " << (uint16_t)m_transmissionMode << " gain " << m_txModeGain.at (m_transmissionMode));
   NS_ASSERT (m_transmissionMode < m_txModeGain.size ());
-  for (std::list<LteListChunkProcessor::Chunk>::iterator chunkIt = m_sinrPerceived.begin ();
-       chunkIt != m_sinrPerceived.end ();
-       ++chunkIt)
-    {
-      *chunkIt->m_spectrumValue *= m_txModeGain.at (m_transmissionMode);
-    }
+  m_sinrPerceived.Scale (m_txModeGain.at (m_transmissionMode));
   
   while (itTb!=m_expectedTbs.end ())
     {
@@ -1164,12 +1160,7 @@ LteSpectrumPhy::EndRxDlCtrl ()
   if (m_transmissionMode>0)
     {
       // in case of MIMO, ctrl is always txed as TX diversity
-      for (std::list<LteListChunkProcessor::Chunk>::iterator chunkIt = m_sinrPerceived.begin ();
-           chunkIt != m_sinrPerceived.end ();
-           ++chunkIt)
-        {
-          *chunkIt->m_spectrumValue *= m_txModeGain.at (1);
-        }      
+      m_sinrPerceived.Scale (m_txModeGain.at (1));
     }
 //   m_sinrPerceived *= m_txModeGain.at (m_transmissionMode);
   bool error = false;
@@ -394,7 +394,7 @@ public:
   * 
   * \param sinr vector of sinr perceived per each RB
   */
-  void UpdateSinrPerceived (std::list<LteListChunkProcessor::Chunk> sinr);
+  void UpdateSinrPerceived (const LteChunkArena& sinr);
   
   /** 
   * 
@@ -472,7 +472,7 @@ private:
   uint16_t m_cellId;
   
   expectedTbs_t m_expectedTbs;
-  std::list<LteListChunkProcessor::Chunk> m_sinrPerceived;
+  LteChunkArena m_sinrPerceived;
 
   /// Provides uniform random variables.
   Ptr<UniformRandomVariable> m_random;
@@ -29,6 +29,7 @@
 #include <ns3/boolean.h>
 #include <cfloat>
 #include <set>
+#include <algorithm>
 
 
 namespace ns3 {
@@ -241,7 +242,7 @@ PfFfMacScheduler::DoDispose ()
 {
   NS_LOG_FUNCTION (this);
   m_dlHarqProcessesDciBuffer.clear ();
-  m_dlHarqProcessesTimer.clear ();
+  m_ueTable.Clear ();
   m_dlHarqProcessesRlcPduListBuffer.clear ();
   m_dlInfoListBuffered.clear ();
   m_ulHarqCurrentProcessId.clear ();
@@ -323,6 +324,7 @@ PfFfMacScheduler::DoCschedCellConfigReq (const struct FfMacCschedSapProvider::Cs
   // Read the subset of parameters used
   m_cschedCellConfig = params;
   m_rachAllocationMap.resize (m_cschedCellConfig.m_ulBandwidth, 0);
+  m_ueTable.SetDlRbgNum (m_cschedCellConfig.m_dlBandwidth / GetRbgSize (m_cschedCellConfig.m_dlBandwidth));
   FfMacCschedSapUser::CschedUeConfigCnfParameters cnf;
   cnf.m_result = SUCCESS;
   m_cschedSapUser->CschedUeConfigCnf (cnf);
@@ -333,18 +335,12 @@ void
 PfFfMacScheduler::DoCschedUeConfigReq (const struct FfMacCschedSapProvider::CschedUeConfigReqParameters& params)
 {
   NS_LOG_FUNCTION (this << " RNTI " << params.m_rnti << " txMode " << (uint16_t)params.m_transmissionMode);
-  std::map <uint16_t,uint8_t>::iterator it = m_uesTxMode.find (params.m_rnti);
-  if (it == m_uesTxMode.end ())
+  uint32_t slot = m_ueTable.GetSlot (params.m_rnti);
+  if (slot == FfMacSchedulerUeTable::NO_SLOT)
     {
-      m_uesTxMode.insert (std::pair <uint16_t, double> (params.m_rnti, params.m_transmissionMode));
+      slot = m_ueTable.AddUe (params.m_rnti);
+      m_ueTable.SetTxMode (slot, params.m_transmissionMode);
       // generate HARQ buffers
-      m_dlHarqCurrentProcessId.insert (std::pair <uint16_t,uint8_t > (params.m_rnti, 0));
-      DlHarqProcessesStatus_t dlHarqPrcStatus;
-      dlHarqPrcStatus.resize (8,0);
-      m_dlHarqProcessesStatus.insert (std::pair <uint16_t, DlHarqProcessesStatus_t> (params.m_rnti, dlHarqPrcStatus));
-      DlHarqProcessesTimer_t dlHarqProcessesTimer;
-      dlHarqProcessesTimer.resize (8,0);
-      m_dlHarqProcessesTimer.insert (std::pair <uint16_t, DlHarqProcessesTimer_t> (params.m_rnti, dlHarqProcessesTimer));
       DlHarqProcessesDciBuffer_t dlHarqdci;
       dlHarqdci.resize (8);
       m_dlHarqProcessesDciBuffer.insert (std::pair <uint16_t, DlHarqProcessesDciBuffer_t> (params.m_rnti, dlHarqdci));
@@ -363,7 +359,7 @@ PfFfMacScheduler::DoCschedUeConfigReq (const struct FfMacCschedSapProvider::Csch
     }
   else
     {
-      (*it).second = params.m_transmissionMode;
+      m_ueTable.SetTxMode (slot, params.m_transmissionMode);
     }
   return;
 }
@@ -428,10 +424,7 @@ PfFfMacScheduler::DoCschedUeReleaseReq (const struct FfMacCschedSapProvider::Csc
 {
   NS_LOG_FUNCTION (this);
 
-  m_uesTxMode.erase (params.m_rnti);
-  m_dlHarqCurrentProcessId.erase (params.m_rnti);
-  m_dlHarqProcessesStatus.erase  (params.m_rnti);
-  m_dlHarqProcessesTimer.erase (params.m_rnti);
+  m_ueTable.RemoveUe (params.m_rnti);
   m_dlHarqProcessesDciBuffer.erase  (params.m_rnti);
   m_dlHarqProcessesRlcPduListBuffer.erase  (params.m_rnti);
   m_ulHarqCurrentProcessId.erase  (params.m_rnti);
@@ -547,30 +540,12 @@ PfFfMacScheduler::HarqProcessAvailability (uint16_t rnti)
 {
   NS_LOG_FUNCTION (this << rnti);
 
-  std::map <uint16_t, uint8_t>::iterator it = m_dlHarqCurrentProcessId.find (rnti);
-  if (it == m_dlHarqCurrentProcessId.end ())
+  uint32_t slot = m_ueTable.GetSlot (rnti);
+  if (slot == FfMacSchedulerUeTable::NO_SLOT)
     {
       NS_FATAL_ERROR ("No Process Id found for this RNTI " << rnti);
     }
-  std::map <uint16_t, DlHarqProcessesStatus_t>::iterator itStat = m_dlHarqProcessesStatus.find (rnti);
-  if (itStat == m_dlHarqProcessesStatus.end ())
-    {
-      NS_FATAL_ERROR ("No Process Id Statusfound for this RNTI " << rnti);
-    }
-  uint8_t i = (*it).second;
-  do
-    {
-      i = (i + 1) % HARQ_PROC_NUM;
-    }
-  while ( ((*itStat).second.at (i) != 0)&&(i != (*it).second));
-  if ((*itStat).second.at (i) == 0)
-    {
-      return (true);
-    }
-  else
-    {
-      return (false); // return a not valid harq proc id
-    }
+  return m_ueTable.IsDlHarqProcessAvailable (slot);
 }
 
 
@@ -585,34 +560,12 @@ PfFfMacScheduler::UpdateHarqProcessId (uint16_t rnti)
       return (0);
     }
 
-
-  std::map <uint16_t, uint8_t>::iterator it = m_dlHarqCurrentProcessId.find (rnti);
-  if (it == m_dlHarqCurrentProcessId.end ())
+  uint32_t slot = m_ueTable.GetSlot (rnti);
+  if (slot == FfMacSchedulerUeTable::NO_SLOT)
     {
       NS_FATAL_ERROR ("No Process Id found for this RNTI " << rnti);
     }
-  std::map <uint16_t, DlHarqProcessesStatus_t>::iterator itStat = m_dlHarqProcessesStatus.find (rnti);
-  if (itStat == m_dlHarqProcessesStatus.end ())
-    {
-      NS_FATAL_ERROR ("No Process Id Statusfound for this RNTI " << rnti);
-    }
-  uint8_t i = (*it).second;
-  do
-    {
-      i = (i + 1) % HARQ_PROC_NUM;
-    }
-  while ( ((*itStat).second.at (i) != 0)&&(i != (*it).second));
-  if ((*itStat).second.at (i) == 0)
-    {
-      (*it).second = i;
-      (*itStat).second.at (i) = 1;
-    }
-  else
-    {
-      NS_FATAL_ERROR ("No HARQ process available for RNTI " << rnti << " check before update with HarqProcessAvailability");
-    }
-
-  return ((*it).second);
+  return m_ueTable.UpdateDlHarqProcessId (slot);
 }
 
 
@@ -621,31 +574,7 @@ PfFfMacScheduler::RefreshHarqProcesses ()
 {
   NS_LOG_FUNCTION (this);
 
-  std::map <uint16_t, DlHarqProcessesTimer_t>::iterator itTimers;
-  for (itTimers = m_dlHarqProcessesTimer.begin (); itTimers != m_dlHarqProcessesTimer.end (); itTimers++)
-    {
-      for (uint16_t i = 0; i < HARQ_PROC_NUM; i++)
-        {
-          if ((*itTimers).second.at (i) == HARQ_DL_TIMEOUT)
-            {
-              // reset HARQ process
-
-              NS_LOG_DEBUG (this << " Reset HARQ proc " << i << " for RNTI " << (*itTimers).first);
-              std::map <uint16_t, DlHarqProcessesStatus_t>::iterator itStat = m_dlHarqProcessesStatus.find ((*itTimers).first);
-              if (itStat == m_dlHarqProcessesStatus.end ())
-                {
-                  NS_FATAL_ERROR ("No Process Id Status found for this RNTI " << (*itTimers).first);
-                }
-              (*itStat).second.at (i) = 0;
-              (*itTimers).second.at (i) = 0;
-            }
-          else
-            {
-              (*itTimers).second.at (i)++;
-            }
-        }
-    }
-
+  m_ueTable.RefreshDlHarqProcesses ();
 }
 
 
@@ -922,12 +851,15 @@ PfFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sched
             {
               // maximum number of retx reached -> drop process
               NS_LOG_INFO ("Maximum number of retransmissions reached -> drop process");
-              std::map <uint16_t, DlHarqProcessesStatus_t>::iterator it = m_dlHarqProcessesStatus.find (rnti);
-              if (it == m_dlHarqProcessesStatus.end ())
+              uint32_t slot = m_ueTable.GetSlot (rnti);
+              if (slot == FfMacSchedulerUeTable::NO_SLOT)
                 {
                   NS_LOG_ERROR ("No info find in HARQ buffer for UE (might change eNB) " << m_dlInfoListBuffered.at (i).m_rnti);
                 }
-              (*it).second.at (harqId) = 0;
+              else
+                {
+                  m_ueTable.GetDlHarqProcessesStatus (slot)[harqId] = 0;
+                }
               std::map <uint16_t, DlHarqRlcPduListBuffer_t>::iterator itRlcPdu =  m_dlHarqProcessesRlcPduListBuffer.find (rnti);
               if (itRlcPdu == m_dlHarqProcessesRlcPduListBuffer.end ())
                 {
@@ -1073,12 +1005,12 @@ PfFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sched
           newEl.m_dci = dci;
           (*itHarq).second.at (harqId).m_rv = dci.m_rv;
           // refresh timer
-          std::map <uint16_t, DlHarqProcessesTimer_t>::iterator itHarqTimer = m_dlHarqProcessesTimer.find (rnti);
-          if (itHarqTimer== m_dlHarqProcessesTimer.end ())
+          uint32_t slot = m_ueTable.GetSlot (rnti);
+          if (slot == FfMacSchedulerUeTable::NO_SLOT)
             {
               NS_FATAL_ERROR ("Unable to find HARQ timer for RNTI " << (uint16_t)rnti);
             }
-          (*itHarqTimer).second.at (harqId) = 0;
+          m_ueTable.GetDlHarqProcessesTimer (slot)[harqId] = 0;
           ret.m_buildDataList.push_back (newEl);
           rntiAllocated.insert (rnti);
         }
@@ -1086,12 +1018,12 @@ PfFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sched
         {
           // update HARQ process status
           NS_LOG_INFO (this << " HARQ received ACK for UE " << m_dlInfoListBuffered.at (i).m_rnti);
-          std::map <uint16_t, DlHarqProcessesStatus_t>::iterator it = m_dlHarqProcessesStatus.find (m_dlInfoListBuffered.at (i).m_rnti);
-          if (it == m_dlHarqProcessesStatus.end ())
+          uint32_t slot = m_ueTable.GetSlot (m_dlInfoListBuffered.at (i).m_rnti);
+          if (slot == FfMacSchedulerUeTable::NO_SLOT)
             {
               NS_FATAL_ERROR ("No info find in HARQ buffer for UE " << m_dlInfoListBuffered.at (i).m_rnti);
             }
-          (*it).second.at (m_dlInfoListBuffered.at (i).m_harqProcessId) = 0;
+          m_ueTable.GetDlHarqProcessesStatus (slot)[m_dlInfoListBuffered.at (i).m_harqProcessId] = 0;
           std::map <uint16_t, DlHarqRlcPduListBuffer_t>::iterator itRlcPdu =  m_dlHarqProcessesRlcPduListBuffer.find (m_dlInfoListBuffered.at (i).m_rnti);
           if (itRlcPdu == m_dlHarqProcessesRlcPduListBuffer.end ())
             {
@@ -1117,143 +1049,120 @@ PfFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sched
     }
 
 
-  std::set<uint16_t> assignedEnoughRBGs;
+  // snapshot the UEs in arrays indexed in RNTI order: whether a UE can be
+  // scheduled at all does not change over the RBGs of the TTI
+  uint32_t nUes = m_flowStatsDl.size ();
+  std::vector <uint16_t> ueRnti (nUes);
+  std::vector <uint32_t> ueSlot (nUes);
+  std::vector <uint8_t> ueLayers (nUes);
+  std::vector <double> ueAvgThr (nUes);
+  std::vector <uint8_t> ueEligible (nUes);
+  std::vector <uint8_t> ueAssignedEnoughRbgs (nUes, 0);
+  std::vector <uint16_t> ueRbgNum (nUes, 0);
+  std::vector <uint8_t> ueAvailable (nUes);
+  std::vector <double> ueRcqi (nUes);
+  uint32_t u = 0;
+  for (std::map <uint16_t, pfsFlowPerf_t>::iterator it = m_flowStatsDl.begin (); it != m_flowStatsDl.end (); it++, u++)
+    {
+      uint16_t rnti = (*it).first;
+      uint32_t slot = m_ueTable.GetSlot (rnti);
+      if (slot == FfMacSchedulerUeTable::NO_SLOT)
+        {
+          NS_FATAL_ERROR ("No Transmission Mode info on user " << rnti);
+        }
+      ueRnti[u] = rnti;
+      ueSlot[u] = slot;
+      ueLayers[u] = m_ueTable.GetDlLayers (slot);
+      ueAvgThr[u] = (*it).second.lastAveragedThroughput;
+      bool allocated = rntiAllocated.find (rnti) != rntiAllocated.end ();
+      bool harqAvailable = m_ueTable.IsDlHarqProcessAvailable (slot);
+      // UE already allocated for HARQ or without HARQ process available -> drop it
+      if (allocated)
+        {
+          NS_LOG_DEBUG (this << " RNTI discared for HARQ tx" << (uint16_t)rnti);
+        }
+      if (!harqAvailable)
+        {
+          NS_LOG_DEBUG (this << " RNTI discared for HARQ id" << (uint16_t)rnti);
+        }
+      ueEligible[u] = !allocated && harqAvailable && LcActivePerFlow (rnti) > 0;
+    }
+
+  // achievable rate (TB size / TTI) and MCS of a layer on an RBG per CQI;
+  // the last entry is for a layer without CQI, which gets the worst MCS
+  const uint8_t noCqiIndex = 16;
+  uint8_t cqiMcs[noCqiIndex + 1];
+  double cqiRate[noCqiIndex + 1];
+  for (uint8_t cqi = 0; cqi <= noCqiIndex; cqi++)
+    {
+      cqiMcs[cqi] = (cqi < noCqiIndex) ? m_amc->GetMcsFromCqi (cqi) : 0;
+      cqiRate[cqi] = ((m_amc->GetTbSizeFromMcs (cqiMcs[cqi], rbgSize) / 8) / 0.001);
+    }
+  NS_ASSERT (m_ueTable.GetDlRbgNum () == (uint32_t) rbgNum);
 
   for (int i = 0; i < rbgNum; i++)
     {
       NS_LOG_INFO (this << " ALLOCATION for RBG " << i << " of " << rbgNum);
       if (rbgMap.at (i) == false)
         {
-          std::map <uint16_t, pfsFlowPerf_t>::iterator it;
-          std::map <uint16_t, pfsFlowPerf_t>::iterator itMax = m_flowStatsDl.end ();
-          uint32_t tbSizeMax = 0;
-          double rcqiMax = 0.0;
-          for (it = m_flowStatsDl.begin (); it != m_flowStatsDl.end (); it++)
+          for (u = 0; u < nUes; u++)
             {
-              if (assignedEnoughRBGs.find((*it).first)!= assignedEnoughRBGs.end())
-                {
-                   continue;
-                }
-              if ((m_ffrSapProvider->IsDlRbgAvailableForUe (i, (*it).first)) == false)
-                {
-                  continue;
-                }
-              std::set <uint16_t>::iterator itRnti = rntiAllocated.find ((*it).first);
-              if ((itRnti != rntiAllocated.end ())||(!HarqProcessAvailability ((*it).first)))
-                {
-                  // UE already allocated for HARQ or without HARQ process available -> drop it
-                  if (itRnti != rntiAllocated.end ())
-                    {
-                      NS_LOG_DEBUG (this << " RNTI discared for HARQ tx" << (uint16_t)(*it).first);
-                    }
-                  if (!HarqProcessAvailability ((*it).first))
-                    {
-                      NS_LOG_DEBUG (this << " RNTI discared for HARQ id" << (uint16_t)(*it).first);
-                    }
-                  continue;
-                }
-              std::map <uint16_t,SbMeasResult_s>::iterator itCqi;
-              itCqi = m_a30CqiRxed.find ((*it).first);
-              std::map <uint16_t,uint8_t>::iterator itTxMode;
-              itTxMode = m_uesTxMode.find ((*it).first);
-              if (itTxMode == m_uesTxMode.end ())
-                {
-                  NS_FATAL_ERROR ("No Transmission Mode info on user " << (*it).first);
-                }
-              int nLayer = TransmissionModesLayers::TxMode2LayerNum ((*itTxMode).second);
-              std::vector <uint8_t> sbCqi;
-              if (itCqi == m_a30CqiRxed.end ())
-                {
-                  for (uint8_t k = 0; k < nLayer; k++)
-                    {
-                      sbCqi.push_back (1);  // start with lowest value
-                    }
-                }
-              else
-                {
-                  sbCqi = (*itCqi).second.m_higherLayerSelected.at (i).m_sbCqi;
-                }
-              uint8_t cqi1 = sbCqi.at (0);
-              uint8_t cqi2 = 1;
-              if (sbCqi.size () > 1)
+              ueAvailable[u] = !ueAssignedEnoughRbgs[u]
+                && m_ffrSapProvider->IsDlRbgAvailableForUe (i, ueRnti[u])
+                && ueEligible[u];
+            }
+
+          // PF metric of every UE on the RBG; the UEs which cannot be
+          // scheduled get 0, so that they are never selected
+          const uint8_t *sbCqi0 = m_ueTable.GetDlSbCqiRow (0, i);
+          const uint8_t *sbCqi1 = m_ueTable.GetDlSbCqiRow (1, i);
+          for (u = 0; u < nUes; u++)
+            {
+              uint8_t cqi1 = sbCqi0[ueSlot[u]];
+              uint8_t cqi2 = sbCqi1[ueSlot[u]];
+              double achievableRate = 0.0;
+              achievableRate += cqiRate[std::min (cqi1, noCqiIndex)];
+              if (ueLayers[u] > 1)
                 {
-                  cqi2 = sbCqi.at (1);
+                  achievableRate += cqiRate[std::min (cqi2, noCqiIndex)];
                 }
+              // CQI == 0 means "out of range" (see table 7.2.3-1 of 36.213)
+              bool inRange = (cqi1 > 0) || (cqi2 > 0);
+              ueRcqi[u] = (ueAvailable[u] && inRange) ? achievableRate / ueAvgThr[u] : 0.0;
+            }
 
-              if ((cqi1 > 0)||(cqi2 > 0)) // CQI == 0 means "out of range" (see table 7.2.3-1 of 36.213)
+          int32_t best = -1;
+          double rcqiMax = 0.0;
+          for (u = 0; u < nUes; u++)
+            {
+              if (ueRcqi[u] > rcqiMax)
                 {
-                  if (LcActivePerFlow ((*it).first) > 0)
-                    {
-                      // this UE has data to transmit
-                      double achievableRate = 0.0;
-                      uint32_t tbSize = 0;
-                      uint8_t mcs = 0;
-                      for (uint8_t k = 0; k < nLayer; k++)
-                        {
-                          if (sbCqi.size () > k)
-                            {
-                              mcs = m_amc->GetMcsFromCqi (sbCqi.at (k));
-                            }
-                          else
-                            {
-                              // no info on this subband -> worst MCS
-                              mcs = 0;
-                            }
-
-                          std::map <uint16_t, std::vector <uint16_t> >::iterator itMap;
-                          itMap = allocationMap.find ((*it).first);
-
-                          if (itMap != allocationMap.end ())
-                            {
-                              tbSize = m_amc->GetTbSizeFromMcs (mcs, rbgSize * (itMap->second.size() + 1));
-                            }
-                          else
-                            {
-                              tbSize = m_amc->GetTbSizeFromMcs (mcs, rbgSize);
-                            }
-                          achievableRate += ((m_amc->GetTbSizeFromMcs (mcs, rbgSize) / 8) / 0.001);   // = TB size / TTI
-                        }
-
-                      double rcqi = achievableRate / (*it).second.lastAveragedThroughput;
-                      NS_LOG_INFO (this << " RNTI " << (*it).first << " MCS " << (uint32_t)mcs << " achievableRate " << achievableRate << " avgThr " << (*it).second.lastAveragedThroughput << " RCQI " << rcqi);
-
-                      if (rcqi > rcqiMax)
-                        {
-                          rcqiMax = rcqi;
-                          itMax = it;
-                          tbSizeMax = tbSize;
-                        }
-                    }
-                }   // end if cqi
-            } // end for m_rlcBufferReq
+                  rcqiMax = ueRcqi[u];
+                  best = u;
+                }
+            }
 
-          if (itMax == m_flowStatsDl.end ())
+          if (best < 0)
             {
               // no UE available for this RB
               NS_LOG_INFO (this << " any UE found");
             }
           else
             {
+              uint16_t rnti = ueRnti[best];
+              uint8_t lastCqi = (ueLayers[best] > 1) ? sbCqi1[ueSlot[best]] : sbCqi0[ueSlot[best]];
+              uint8_t mcs = cqiMcs[std::min (lastCqi, noCqiIndex)];
+              NS_LOG_INFO (this << " RNTI " << rnti << " MCS " << (uint32_t)mcs << " avgThr " << ueAvgThr[best] << " RCQI " << rcqiMax);
               rbgMap.at (i) = true;
-              std::map <uint16_t, std::vector <uint16_t> >::iterator itMap;
-              itMap = allocationMap.find ((*itMax).first);
-              if (itMap == allocationMap.end ())
-                {
-                  // insert new element
-                  std::vector <uint16_t> tempMap;
-                  tempMap.push_back (i);
-                  allocationMap.insert (std::pair <uint16_t, std::vector <uint16_t> > ((*itMax).first, tempMap));
-                }
-              else
-                {
-                  (*itMap).second.push_back (i);
-                }
-              if (tbSizeMax/8 >= GetNecessaryTbSizeEstimation((*itMax).first))
+              allocationMap[rnti].push_back (i);
+              ueRbgNum[best]++;
+              uint32_t tbSize = m_amc->GetTbSizeFromMcs (mcs, rbgSize * ueRbgNum[best]);
+              if (tbSize/8 >= GetNecessaryTbSizeEstimation (rnti))
                 {
-                  assignedEnoughRBGs.insert((*itMax).first);
+                  ueAssignedEnoughRbgs[best] = 1;
                 }
 
-              NS_LOG_INFO (this << " UE assigned " << (*itMax).first);
+              NS_LOG_INFO (this << " UE assigned " << rnti);
             }
         } // end for RBG free
     } // end for RBGs
@@ -1286,55 +1195,31 @@ PfFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sched
           lcActives = (uint16_t)65535; // UINT16_MAX;
         }
       uint16_t RgbPerRnti = (*itMap).second.size ();
-      std::map <uint16_t,SbMeasResult_s>::iterator itCqi;
-      itCqi = m_a30CqiRxed.find ((*itMap).first);
-      std::map <uint16_t,uint8_t>::iterator itTxMode;
-      itTxMode = m_uesTxMode.find ((*itMap).first);
-      if (itTxMode == m_uesTxMode.end ())
+      uint32_t slot = m_ueTable.GetSlot ((*itMap).first);
+      if (slot == FfMacSchedulerUeTable::NO_SLOT)
         {
           NS_FATAL_ERROR ("No Transmission Mode info on user " << (*itMap).first);
         }
-      int nLayer = TransmissionModesLayers::TxMode2LayerNum ((*itTxMode).second);
+      int nLayer = m_ueTable.GetDlLayers (slot);
+      // without a CQI report, every RBG has the lowest CQI of the table
       std::vector <uint8_t> worstCqi (2, 15);
-      if (itCqi != m_a30CqiRxed.end ())
+      for (uint16_t k = 0; k < (*itMap).second.size (); k++)
         {
-          for (uint16_t k = 0; k < (*itMap).second.size (); k++)
+          NS_LOG_INFO (this << " RBG " << (*itMap).second.at (k) << " CQI " << (uint16_t)m_ueTable.GetDlSbCqi (slot, 0, (*itMap).second.at (k)));
+          for (uint8_t j = 0; j < nLayer; j++)
             {
-              if ((*itCqi).second.m_higherLayerSelected.size () > (*itMap).second.at (k))
+              uint8_t cqi = m_ueTable.GetDlSbCqi (slot, j, (*itMap).second.at (k));
+              if (cqi == FfMacSchedulerUeTable::NO_CQI)
                 {
-                  NS_LOG_INFO (this << " RBG " << (*itMap).second.at (k) << " CQI " << (uint16_t)((*itCqi).second.m_higherLayerSelected.at ((*itMap).second.at (k)).m_sbCqi.at (0)) );
-                  for (uint8_t j = 0; j < nLayer; j++)
-                    {
-                      if ((*itCqi).second.m_higherLayerSelected.at ((*itMap).second.at (k)).m_sbCqi.size () > j)
-                        {
-                          if (((*itCqi).second.m_higherLayerSelected.at ((*itMap).second.at (k)).m_sbCqi.at (j)) < worstCqi.at (j))
-                            {
-                              worstCqi.at (j) = ((*itCqi).second.m_higherLayerSelected.at ((*itMap).second.at (k)).m_sbCqi.at (j));
-                            }
-                        }
-                      else
-                        {
-                          // no CQI for this layer of this suband -> worst one
-                          worstCqi.at (j) = 1;
-                        }
-                    }
+                  // no CQI for this layer of this suband -> worst one
+                  worstCqi.at (j) = 1;
                 }
-              else
+              else if (cqi < worstCqi.at (j))
                 {
-                  for (uint8_t j = 0; j < nLayer; j++)
-                    {
-                      worstCqi.at (j) = 1; // try with lowest MCS in RBG with no info on channel
-                    }
+                  worstCqi.at (j) = cqi;
                 }
             }
         }
-      else
-        {
-          for (uint8_t j = 0; j < nLayer; j++)
-            {
-              worstCqi.at (j) = 1; // try with lowest MCS in RBG with no info on channel
-            }
-        }
       for (uint8_t j = 0; j < nLayer; j++)
         {
           NS_LOG_INFO (this << " Layer " << (uint16_t)j << " CQI selected " << (uint16_t)worstCqi.at (j));
@@ -1416,12 +1301,7 @@ PfFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sched
             }
           (*itDci).second.at (newDci.m_harqProcess) = newDci;
           // refresh timer
-          std::map <uint16_t, DlHarqProcessesTimer_t>::iterator itHarqTimer =  m_dlHarqProcessesTimer.find (newEl.m_rnti);
-          if (itHarqTimer== m_dlHarqProcessesTimer.end ())
-            {
-              NS_FATAL_ERROR ("Unable to find HARQ timer for RNTI " << (uint16_t)newEl.m_rnti);
-            }
-          (*itHarqTimer).second.at (newDci.m_harqProcess) = 0;
+          m_ueTable.GetDlHarqProcessesTimer (slot)[newDci.m_harqProcess] = 0;
         }
 
       // ...more parameters -> ingored in this version
@@ -1509,23 +1389,15 @@ PfFfMacScheduler::DoSchedDlCqiInfoReq (const struct FfMacSchedSapProvider::Sched
       else if ( params.m_cqiList.at (i).m_cqiType == CqiListElement_s::A30 )
         {
           // subband CQI reporting high layer configured
-          std::map <uint16_t,SbMeasResult_s>::iterator it;
           uint16_t rnti = params.m_cqiList.at (i).m_rnti;
-          it = m_a30CqiRxed.find (rnti);
-          if (it == m_a30CqiRxed.end ())
+          uint32_t slot = m_ueTable.GetSlot (rnti);
+          if (slot == FfMacSchedulerUeTable::NO_SLOT)
             {
-              // create the new entry
-              m_a30CqiRxed.insert ( std::pair<uint16_t, SbMeasResult_s > (rnti, params.m_cqiList.at (i).m_sbMeasResult) );
-              m_a30CqiTimers.insert ( std::pair<uint16_t, uint32_t > (rnti, m_cqiTimersThreshold));
-            }
-          else
-            {
-              // update the CQI value and refresh correspondent timer
-              (*it).second = params.m_cqiList.at (i).m_sbMeasResult;
-              std::map <uint16_t,uint32_t>::iterator itTimers;
-              itTimers = m_a30CqiTimers.find (rnti);
-              (*itTimers).second = m_cqiTimersThreshold;
+              NS_LOG_ERROR (this << " A30-CQI of unknown user " << rnti);
+              continue;
             }
+          // store the CQI values and refresh correspondent timer
+          m_ueTable.SetDlSbCqi (slot, params.m_cqiList.at (i).m_sbMeasResult, m_cqiTimersThreshold);
         }
       else
         {
@@ -2213,27 +2085,7 @@ PfFfMacScheduler::RefreshDlCqiMaps (void)
     }
 
   // refresh DL CQI A30 Map
-  std::map <uint16_t,uint32_t>::iterator itA30 = m_a30CqiTimers.begin ();
-  while (itA30 != m_a30CqiTimers.end ())
-    {
-      NS_LOG_INFO (this << " A30-CQI for user " << (*itA30).first << " is " << (uint32_t)(*itA30).second << " thr " << (uint32_t)m_cqiTimersThreshold);
-      if ((*itA30).second == 0)
-        {
-          // delete correspondent entries
-          std::map <uint16_t,SbMeasResult_s>::iterator itMap = m_a30CqiRxed.find ((*itA30).first);
-          NS_ASSERT_MSG (itMap != m_a30CqiRxed.end (), " Does not find CQI report for user " << (*itA30).first);
-          NS_LOG_INFO (this << " A30-CQI expired for user " << (*itA30).first);
-          m_a30CqiRxed.erase (itMap);
-          std::map <uint16_t,uint32_t>::iterator temp = itA30;
-          itA30++;
-          m_a30CqiTimers.erase (temp);
-        }
-      else
-        {
-          (*itA30).second--;
-          itA30++;
-        }
-    }
+  m_ueTable.RefreshDlSbCqi ();
 
   return;
 }
@@ -137,11 +137,11 @@ RemSpectrumPhy::StartRx (Ptr<SpectrumSignalParameters> params)
               double power = 0;
               if (m_rbId >= 0)
                 {
-                  power = (*(params->psd))[m_rbId] * 180000;
+                  power = (*(params->GetUnscaledPsd ()))[m_rbId] * 180000 * params->psdGain;
                 }
               else
                 {
-                  power = Integral (*(params->psd));
+                  power = Integral (*(params->GetUnscaledPsd ())) * params->psdGain;
                 }
 
               m_sumPower += power;
@@ -160,11 +160,11 @@ RemSpectrumPhy::StartRx (Ptr<SpectrumSignalParameters> params)
               double power = 0;
               if (m_rbId >= 0)
                 {
-                  power = (*(params->psd))[m_rbId] * 180000;
+                  power = (*(params->GetUnscaledPsd ()))[m_rbId] * 180000 * params->psdGain;
                 }
               else
                 {
-                  power = Integral (*(params->psd));
+                  power = Integral (*(params->GetUnscaledPsd ())) * params->psdGain;
                 }
 
               m_sumPower += power;
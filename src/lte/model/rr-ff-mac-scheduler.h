@@ -30,9 +30,7 @@
 #include <ns3/lte-common.h>
 #include <ns3/lte-amc.h>
 #include <ns3/lte-ffr-sap.h>
-
-#define HARQ_PROC_NUM 8
-#define HARQ_DL_TIMEOUT 11
+#include <ns3/ff-mac-scheduler-ue-table.h>
 
 namespace ns3 {
 
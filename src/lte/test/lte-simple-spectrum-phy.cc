@@ -130,7 +130,7 @@ LteSimpleSpectrumPhy::StartRx (Ptr<SpectrumSignalParameters> spectrumRxParams)
   NS_LOG_DEBUG ("LteSimpleSpectrumPhy::StartRx");
 
   NS_LOG_FUNCTION (this << spectrumRxParams);
-  Ptr <const SpectrumValue> rxPsd = spectrumRxParams->psd;
+  Ptr <const SpectrumValue> rxPsd = spectrumRxParams->GetPsd ();
   Time duration = spectrumRxParams->duration;
 
   // the device might start RX only if the signal is of a type
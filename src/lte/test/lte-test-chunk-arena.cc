@@ -0,0 +1,219 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2015 University of Washington
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/nstime.h"
+#include "ns3/spectrum-value.h"
+
+#include "ns3/lte-chunk-processor.h"
+
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteTestChunkArena");
+
+/**
+ * Create a spectrum model with the given number of RBs.
+ *
+ * \param nRbs the number of RBs
+ * \return the spectrum model
+ */
+static Ptr<SpectrumModel>
+CreateRbModel (uint32_t nRbs)
+{
+  std::vector<double> centerFrequencies;
+  for (uint32_t rb = 0; rb < nRbs; rb++)
+    {
+      centerFrequencies.push_back (2.1e9 + 180e3 * rb);
+    }
+  return Create<SpectrumModel> (centerFrequencies);
+}
+
+/**
+ * Create a spectrum value whose value on RB i is offset + i.
+ *
+ * \param model the spectrum model
+ * \param offset the value on the first RB
+ * \return the spectrum value
+ */
+static SpectrumValue
+CreateRbValue (Ptr<SpectrumModel> model, double offset)
+{
+  SpectrumValue value (model);
+  for (uint32_t rb = 0; rb < model->GetNumBands (); rb++)
+    {
+      value[rb] = offset + rb;
+    }
+  return value;
+}
+
+/**
+ * Checks the layout of the chunks in the arena, their scaling, and the
+ * reuse of the arena after it is cleared.
+ */
+class LteChunkArenaTestCase : public TestCase
+{
+public:
+  LteChunkArenaTestCase ();
+  virtual ~LteChunkArenaTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+LteChunkArenaTestCase::LteChunkArenaTestCase ()
+  : TestCase ("Chunk values, durations and scaling")
+{
+}
+
+LteChunkArenaTestCase::~LteChunkArenaTestCase ()
+{
+}
+
+void
+LteChunkArenaTestCase::DoRun (void)
+{
+  Ptr<SpectrumModel> model = CreateRbModel (4);
+  LteChunkArena arena;
+  NS_TEST_ASSERT_MSG_EQ (arena.GetNChunks (), 0, "new arena not empty");
+
+  for (uint32_t chunk = 0; chunk < 3; chunk++)
+    {
+      arena.Add (CreateRbValue (model, 10.0 * chunk), MicroSeconds (100 * (chunk + 1)));
+    }
+  NS_TEST_ASSERT_MSG_EQ (arena.GetNChunks (), 3, "wrong number of chunks");
+  NS_TEST_ASSERT_MSG_EQ (arena.GetNRbs (), 4, "wrong number of RBs");
+  for (uint32_t chunk = 0; chunk < 3; chunk++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (arena.GetDuration (chunk), MicroSeconds (100 * (chunk + 1)), "wrong duration of chunk " << chunk);
+      const double* values = arena.GetValues (chunk);
+      for (uint32_t rb = 0; rb < 4; rb++)
+        {
+          NS_TEST_ASSERT_MSG_EQ_TOL (values[rb], 10.0 * chunk + rb, 1e-12, "wrong value of chunk " << chunk << " RB " << rb);
+        }
+    }
+
+  arena.Scale (0.5);
+  for (uint32_t chunk = 0; chunk < 3; chunk++)
+    {
+      const double* values = arena.GetValues (chunk);
+      for (uint32_t rb = 0; rb < 4; rb++)
+        {
+          NS_TEST_ASSERT_MSG_EQ_TOL (values[rb], 0.5 * (10.0 * chunk + rb), 1e-12, "wrong scaled value of chunk " << chunk << " RB " << rb);
+        }
+      NS_TEST_ASSERT_MSG_EQ (arena.GetDuration (chunk), MicroSeconds (100 * (chunk + 1)), "duration changed by scaling");
+    }
+
+  // a cleared arena takes chunks with another number of RBs
+  arena.Clear ();
+  NS_TEST_ASSERT_MSG_EQ (arena.GetNChunks (), 0, "cleared arena not empty");
+  Ptr<SpectrumModel> largerModel = CreateRbModel (6);
+  arena.Add (CreateRbValue (largerModel, 1.0), MicroSeconds (50));
+  NS_TEST_ASSERT_MSG_EQ (arena.GetNChunks (), 1, "wrong number of chunks after clear");
+  NS_TEST_ASSERT_MSG_EQ (arena.GetNRbs (), 6, "wrong number of RBs after clear");
+  NS_TEST_ASSERT_MSG_EQ_TOL (arena.GetValues (0)[5], 6.0, 1e-12, "wrong value after clear");
+  NS_TEST_ASSERT_MSG_EQ (arena.GetDuration (0), MicroSeconds (50), "wrong duration after clear");
+}
+
+/**
+ * Checks that LteListChunkProcessor reports the chunks evaluated since
+ * the previous report, and only those.
+ */
+class LteListChunkProcessorTestCase : public TestCase
+{
+public:
+  LteListChunkProcessorTestCase ();
+  virtual ~LteListChunkProcessorTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Store the chunks reported by the processor.
+   *
+   * \param chunks the chunks
+   */
+  void ReportChunks (const LteChunkArena& chunks);
+
+  uint32_t m_nReports;           ///< the number of reports
+  LteChunkArena m_reportedChunks; ///< a copy of the last chunks reported
+};
+
+LteListChunkProcessorTestCase::LteListChunkProcessorTestCase ()
+  : TestCase ("LteListChunkProcessor reports"),
+    m_nReports (0)
+{
+}
+
+LteListChunkProcessorTestCase::~LteListChunkProcessorTestCase ()
+{
+}
+
+void
+LteListChunkProcessorTestCase::ReportChunks (const LteChunkArena& chunks)
+{
+  m_nReports++;
+  m_reportedChunks = chunks;
+}
+
+void
+LteListChunkProcessorTestCase::DoRun (void)
+{
+  Ptr<SpectrumModel> model = CreateRbModel (3);
+  Ptr<LteListChunkProcessor> processor = Create<LteListChunkProcessor> ();
+  processor->AddCallback (MakeCallback (&LteListChunkProcessorTestCase::ReportChunks, this));
+
+  processor->Start ();
+  processor->EvaluateChunk (CreateRbValue (model, 1.0), MicroSeconds (200));
+  processor->EvaluateChunk (CreateRbValue (model, 4.0), MicroSeconds (300));
+  processor->End ();
+  NS_TEST_ASSERT_MSG_EQ (m_nReports, 1, "chunks not reported");
+  NS_TEST_ASSERT_MSG_EQ (m_reportedChunks.GetNChunks (), 2, "wrong number of chunks reported");
+  NS_TEST_ASSERT_MSG_EQ (m_reportedChunks.GetDuration (1), MicroSeconds (300), "wrong duration reported");
+  NS_TEST_ASSERT_MSG_EQ_TOL (m_reportedChunks.GetValues (1)[2], 6.0, 1e-12, "wrong value reported");
+
+  // nothing is reported without new chunks
+  processor->Start ();
+  processor->End ();
+  NS_TEST_ASSERT_MSG_EQ (m_nReports, 1, "empty reception reported");
+
+  // the chunks of the previous reception are not reported again
+  processor->Start ();
+  processor->EvaluateChunk (CreateRbValue (model, 7.0), MicroSeconds (100));
+  processor->End ();
+  NS_TEST_ASSERT_MSG_EQ (m_nReports, 2, "chunks not reported");
+  NS_TEST_ASSERT_MSG_EQ (m_reportedChunks.GetNChunks (), 1, "chunks of the previous reception reported");
+  NS_TEST_ASSERT_MSG_EQ_TOL (m_reportedChunks.GetValues (0)[0], 7.0, 1e-12, "wrong value reported");
+}
+
+class LteChunkArenaTestSuite : public TestSuite
+{
+public:
+  LteChunkArenaTestSuite ();
+};
+
+LteChunkArenaTestSuite::LteChunkArenaTestSuite ()
+  : TestSuite ("lte-chunk-arena", UNIT)
+{
+  AddTestCase (new LteChunkArenaTestCase, TestCase::QUICK);
+  AddTestCase (new LteListChunkProcessorTestCase, TestCase::QUICK);
+}
+
+static LteChunkArenaTestSuite lteChunkArenaTestSuite;
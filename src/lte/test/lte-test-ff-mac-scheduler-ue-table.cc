@@ -0,0 +1,193 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2015 University of Washington
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+
+#include "ns3/ff-mac-scheduler-ue-table.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteTestFfMacSchedulerUeTable");
+
+/**
+ * Build an A30 report with a single layer CQI per RBG, and the CQI of a
+ * second layer on the first RBG only.
+ *
+ * \param rbgNum the number of RBGs of the report
+ * \param offset the CQI of the first RBG
+ */
+static SbMeasResult_s
+CreateSbMeasResult (uint32_t rbgNum, uint8_t offset)
+{
+  SbMeasResult_s sbMeasResult;
+  for (uint32_t rbg = 0; rbg < rbgNum; rbg++)
+    {
+      HigherLayerSelected_s subband;
+      subband.m_sbCqi.push_back ((offset + rbg) % 16);
+      if (rbg == 0)
+        {
+          subband.m_sbCqi.push_back (7);
+        }
+      sbMeasResult.m_higherLayerSelected.push_back (subband);
+    }
+  return sbMeasResult;
+}
+
+/**
+ * Checks the slots given to the UEs, their reuse, and that the subband
+ * CQIs of the UEs are kept while the table grows.
+ */
+class LteFfMacSchedulerUeTableSlotTestCase : public TestCase
+{
+public:
+  LteFfMacSchedulerUeTableSlotTestCase ();
+  virtual ~LteFfMacSchedulerUeTableSlotTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+LteFfMacSchedulerUeTableSlotTestCase::LteFfMacSchedulerUeTableSlotTestCase ()
+  : TestCase ("UE slots and subband CQI storage")
+{
+}
+
+LteFfMacSchedulerUeTableSlotTestCase::~LteFfMacSchedulerUeTableSlotTestCase ()
+{
+}
+
+void
+LteFfMacSchedulerUeTableSlotTestCase::DoRun (void)
+{
+  const uint32_t rbgNum = 13;
+  FfMacSchedulerUeTable table;
+  table.SetDlRbgNum (rbgNum);
+
+  uint32_t first = table.AddUe (5);
+  NS_TEST_ASSERT_MSG_EQ (table.GetSlot (5), first, "wrong slot");
+  NS_TEST_ASSERT_MSG_EQ (table.GetSlot (4), FfMacSchedulerUeTable::NO_SLOT, "RNTI not added has a slot");
+  NS_TEST_ASSERT_MSG_EQ (table.HasDlSbCqi (first), false, "new UE has a CQI report");
+  NS_TEST_ASSERT_MSG_EQ ((uint16_t) table.GetDlSbCqi (first, 1, rbgNum - 1), 1, "wrong CQI without report");
+  table.SetTxMode (first, 2);
+  NS_TEST_ASSERT_MSG_EQ ((uint16_t) table.GetDlLayers (first), 2, "wrong number of layers of txMode 2");
+  table.SetDlSbCqi (first, CreateSbMeasResult (rbgNum, 3), 10);
+
+  // grow the table well past its initial capacity
+  for (uint16_t rnti = 100; rnti < 140; rnti++)
+    {
+      uint32_t slot = table.AddUe (rnti);
+      table.SetDlSbCqi (slot, CreateSbMeasResult (rbgNum, rnti), 10);
+    }
+  NS_TEST_ASSERT_MSG_EQ (table.GetNUes (), 41, "wrong number of UEs");
+  for (uint32_t rbg = 0; rbg < rbgNum; rbg++)
+    {
+      NS_TEST_ASSERT_MSG_EQ ((uint16_t) table.GetDlSbCqi (first, 0, rbg), (3 + rbg) % 16, "CQI lost when growing the table");
+      NS_TEST_ASSERT_MSG_EQ ((uint16_t) table.GetDlSbCqiRow (0, rbg)[table.GetSlot (120)], (120 + rbg) % 16, "wrong CQI in row");
+      uint8_t layer1 = (rbg == 0) ? 7 : FfMacSchedulerUeTable::NO_CQI;
+      NS_TEST_ASSERT_MSG_EQ ((uint16_t) table.GetDlSbCqi (first, 1, rbg), (uint16_t) layer1, "wrong CQI of the second layer");
+    }
+
+  // a released slot is reused, without the state of the previous UE
+  uint32_t released = table.GetSlot (110);
+  table.RemoveUe (110);
+  NS_TEST_ASSERT_MSG_EQ (table.GetSlot (110), FfMacSchedulerUeTable::NO_SLOT, "released RNTI has a slot");
+  NS_TEST_ASSERT_MSG_EQ (table.GetRnti (released), 0, "released slot has a RNTI");
+  uint32_t reused = table.AddUe (7);
+  NS_TEST_ASSERT_MSG_EQ (reused, released, "released slot not reused");
+  NS_TEST_ASSERT_MSG_EQ (table.GetRnti (reused), 7, "wrong RNTI of the slot");
+  NS_TEST_ASSERT_MSG_EQ (table.HasDlSbCqi (reused), false, "CQI report of the released UE kept");
+  NS_TEST_ASSERT_MSG_EQ ((uint16_t) table.GetDlSbCqi (reused, 0, 4), 1, "CQI of the released UE kept");
+  NS_TEST_ASSERT_MSG_EQ ((uint16_t) table.GetDlLayers (reused), 1, "txMode of the released UE kept");
+}
+
+/**
+ * Checks the DL HARQ processes and the expiry of the subband CQIs.
+ */
+class LteFfMacSchedulerUeTableTimersTestCase : public TestCase
+{
+public:
+  LteFfMacSchedulerUeTableTimersTestCase ();
+  virtual ~LteFfMacSchedulerUeTableTimersTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+LteFfMacSchedulerUeTableTimersTestCase::LteFfMacSchedulerUeTableTimersTestCase ()
+  : TestCase ("DL HARQ processes and subband CQI timers")
+{
+}
+
+LteFfMacSchedulerUeTableTimersTestCase::~LteFfMacSchedulerUeTableTimersTestCase ()
+{
+}
+
+void
+LteFfMacSchedulerUeTableTimersTestCase::DoRun (void)
+{
+  FfMacSchedulerUeTable table;
+  table.SetDlRbgNum (25);
+  uint32_t slot = table.AddUe (1);
+
+  // all the processes get used in turn, starting after process 0
+  for (uint8_t i = 1; i <= HARQ_PROC_NUM; i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (table.IsDlHarqProcessAvailable (slot), true, "no HARQ process available");
+      NS_TEST_ASSERT_MSG_EQ ((uint16_t) table.UpdateDlHarqProcessId (slot), i % HARQ_PROC_NUM, "wrong HARQ process");
+    }
+  NS_TEST_ASSERT_MSG_EQ (table.IsDlHarqProcessAvailable (slot), false, "HARQ process available");
+  table.GetDlHarqProcessesStatus (slot)[3] = 0;
+  NS_TEST_ASSERT_MSG_EQ (table.IsDlHarqProcessAvailable (slot), true, "released HARQ process not available");
+  NS_TEST_ASSERT_MSG_EQ ((uint16_t) table.UpdateDlHarqProcessId (slot), 3, "released HARQ process not used");
+
+  // the processes are released when their timer expires
+  table.GetDlHarqProcessesTimer (slot)[5] = 1;
+  for (uint32_t tti = 0; tti < HARQ_DL_TIMEOUT; tti++)
+    {
+      table.RefreshDlHarqProcesses ();
+    }
+  NS_TEST_ASSERT_MSG_EQ ((uint16_t) table.GetDlHarqProcessesStatus (slot)[5], 0, "HARQ process not released");
+  NS_TEST_ASSERT_MSG_EQ ((uint16_t) table.GetDlHarqProcessesStatus (slot)[4], 1, "HARQ process released early");
+
+  // a CQI report is valid for the given number of TTIs
+  table.SetDlSbCqi (slot, CreateSbMeasResult (25, 9), 2);
+  for (uint32_t tti = 0; tti < 2; tti++)
+    {
+      table.RefreshDlSbCqi ();
+      NS_TEST_ASSERT_MSG_EQ (table.HasDlSbCqi (slot), true, "CQI report expired early");
+    }
+  table.RefreshDlSbCqi ();
+  NS_TEST_ASSERT_MSG_EQ (table.HasDlSbCqi (slot), false, "CQI report not expired");
+  NS_TEST_ASSERT_MSG_EQ ((uint16_t) table.GetDlSbCqi (slot, 0, 0), 1, "wrong CQI after expiry");
+}
+
+class LteFfMacSchedulerUeTableTestSuite : public TestSuite
+{
+public:
+  LteFfMacSchedulerUeTableTestSuite ();
+};
+
+LteFfMacSchedulerUeTableTestSuite::LteFfMacSchedulerUeTableTestSuite ()
+  : TestSuite ("lte-ff-mac-scheduler-ue-table", UNIT)
+{
+  AddTestCase (new LteFfMacSchedulerUeTableSlotTestCase, TestCase::QUICK);
+  AddTestCase (new LteFfMacSchedulerUeTableTimersTestCase, TestCase::QUICK);
+}
+
+static LteFfMacSchedulerUeTableTestSuite lteFfMacSchedulerUeTableTestSuite;
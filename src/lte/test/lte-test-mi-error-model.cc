@@ -0,0 +1,222 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2015 University of Washington
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/spectrum-value.h"
+
+#include "ns3/lte-mi-error-model.h"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteTestMiErrorModel");
+
+/**
+ * Checks that the batched Mib gives the same MI as MibQpsk, Mib16Qam
+ * and Mib64Qam evaluated RB by RB.
+ *
+ * The SINRs go from -30 dB to 30 dB, below and above the axis of each
+ * MI curve, where the batched lookup clamps the index instead of
+ * checking it. They avoid the last interval of each axis, where the
+ * per-RB functions assert.
+ */
+class LteMiErrorModelMibTestCase : public TestCase
+{
+public:
+  /**
+   * \param mcs the MCS, which selects the modulation
+   */
+  LteMiErrorModelMibTestCase (uint8_t mcs);
+  virtual ~LteMiErrorModelMibTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * \param sinr the SINR of an RB, in linear units
+   * \return the MI of the RB, computed by the per-RB function
+   */
+  double GetRbMi (double sinr) const;
+
+  uint8_t m_mcs;  ///< the MCS
+};
+
+/**
+ * \param mcs the MCS
+ * \return the name of the test case
+ */
+static std::string
+GetMibTestCaseName (uint8_t mcs)
+{
+  std::ostringstream oss;
+  oss << "Batched Mib equals the per-RB MI, MCS " << (uint32_t) mcs;
+  return oss.str ();
+}
+
+LteMiErrorModelMibTestCase::LteMiErrorModelMibTestCase (uint8_t mcs)
+  : TestCase (GetMibTestCaseName (mcs)),
+    m_mcs (mcs)
+{
+}
+
+LteMiErrorModelMibTestCase::~LteMiErrorModelMibTestCase ()
+{
+}
+
+double
+LteMiErrorModelMibTestCase::GetRbMi (double sinr) const
+{
+  if (m_mcs <= MI_QPSK_MAX_ID)
+    {
+      return LteMiErrorModel::MibQpsk (sinr);
+    }
+  else if (m_mcs <= MI_16QAM_MAX_ID)
+    {
+      return LteMiErrorModel::Mib16Qam (sinr);
+    }
+  return LteMiErrorModel::Mib64Qam (sinr);
+}
+
+void
+LteMiErrorModelMibTestCase::DoRun (void)
+{
+  // more RBs than a batch of the lookup
+  const uint32_t nRbs = 163;
+  std::vector<double> sinr;
+  std::vector<double> centerFrequencies;
+  for (uint32_t rb = 0; rb < nRbs; rb++)
+    {
+      sinr.push_back (std::pow (10.0, (-30.0 + 0.37 * rb) / 10.0));
+      centerFrequencies.push_back (2.1e9 + 180e3 * rb);
+    }
+  SpectrumValue sinrValue (Create<SpectrumModel> (centerFrequencies));
+  for (uint32_t rb = 0; rb < nRbs; rb++)
+    {
+      sinrValue[rb] = sinr[rb];
+    }
+
+  // all the RBs, then two RBs out of three, then a single RB
+  std::vector<std::vector<int> > maps (3);
+  for (uint32_t rb = 0; rb < nRbs; rb++)
+    {
+      maps[0].push_back (rb);
+      if (rb % 3 != 1)
+        {
+          maps[1].push_back (rb);
+        }
+    }
+  maps[2].push_back (nRbs / 2);
+
+  for (uint32_t m = 0; m < maps.size (); m++)
+    {
+      const std::vector<int>& map = maps[m];
+      double miSum = 0;
+      for (uint32_t i = 0; i < map.size (); i++)
+        {
+          miSum += GetRbMi (sinr[map[i]]);
+        }
+      double expected = miSum / map.size ();
+      NS_TEST_EXPECT_MSG_EQ (LteMiErrorModel::Mib (&sinr[0], map, m_mcs), expected,
+                             "wrong MI for map " << m);
+      NS_TEST_EXPECT_MSG_EQ (LteMiErrorModel::Mib (sinrValue, map, m_mcs), expected,
+                             "wrong MI of the spectrum value for map " << m);
+    }
+
+  // the SINRs beyond each end of the axis
+  NS_TEST_EXPECT_MSG_EQ (GetRbMi (sinr[0]), GetRbMi (sinr[0] / 10),
+                         "SINR below the axis not clamped");
+  NS_TEST_EXPECT_MSG_EQ (GetRbMi (sinr[nRbs - 1]), 1.0, "SINR above the axis not saturated");
+}
+
+/**
+ * Checks that the tabulated BLER curves of MappingMiBler stay within
+ * 1e-6 of 0.5 * (1 - erf ((mib - b) / (sqrt (2) c))) for every pair of
+ * CB size and ECR. The linear interpolation of the 8192 intervals on
+ * [-5, 5] is off by less than 1e-7, and the curve is below 1e-12
+ * outside of them.
+ */
+class LteMiErrorModelBlerTestCase : public TestCase
+{
+public:
+  LteMiErrorModelBlerTestCase ();
+  virtual ~LteMiErrorModelBlerTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+LteMiErrorModelBlerTestCase::LteMiErrorModelBlerTestCase ()
+  : TestCase ("Tabulated BLER curves match the erf-based ones")
+{
+}
+
+LteMiErrorModelBlerTestCase::~LteMiErrorModelBlerTestCase ()
+{
+}
+
+void
+LteMiErrorModelBlerTestCase::DoRun (void)
+{
+  // the CB sizes of the curves, and a size between two of them
+  static const uint16_t cbSizes[] = {40, 104, 160, 256, 512, 1024, 2560, 3000, 4032, 6144};
+  const double tolerance = 1e-6;
+  for (uint32_t s = 0; s < sizeof (cbSizes) / sizeof (cbSizes[0]); s++)
+    {
+      for (uint8_t ecrId = 0; ecrId <= MI_64QAM_BLER_MAX_ID; ecrId++)
+        {
+          double b;
+          double c;
+          LteMiErrorModel::GetBlerCurveParameters (ecrId, cbSizes[s], b, c);
+          NS_TEST_ASSERT_MSG_GT (c, 0.0, "no curve for CB size " << cbSizes[s]
+                                 << " and ECR " << (uint32_t) ecrId);
+          double maxError = 0;
+          for (uint32_t i = 0; i <= 1000; i++)
+            {
+              double mib = i / 1000.0;
+              double expected = 0.5 * (1 - erf ((mib - b) / (std::sqrt (2.0) * c)));
+              double bler = LteMiErrorModel::MappingMiBler (mib, ecrId, cbSizes[s]);
+              maxError = std::max (maxError, std::fabs (bler - expected));
+            }
+          NS_TEST_EXPECT_MSG_LT (maxError, tolerance, "BLER too far from the curve for CB size "
+                                 << cbSizes[s] << " and ECR " << (uint32_t) ecrId);
+        }
+    }
+}
+
+class LteMiErrorModelTestSuite : public TestSuite
+{
+public:
+  LteMiErrorModelTestSuite ();
+};
+
+LteMiErrorModelTestSuite::LteMiErrorModelTestSuite ()
+  : TestSuite ("lte-mi-error-model", UNIT)
+{
+  AddTestCase (new LteMiErrorModelMibTestCase (0), TestCase::QUICK);
+  AddTestCase (new LteMiErrorModelMibTestCase (MI_16QAM_MAX_ID), TestCase::QUICK);
+  AddTestCase (new LteMiErrorModelMibTestCase (28), TestCase::QUICK);
+  AddTestCase (new LteMiErrorModelBlerTestCase, TestCase::QUICK);
+}
+
+static LteMiErrorModelTestSuite lteMiErrorModelTestSuite;
@@ -135,6 +135,107 @@ EpcTftClassifierTestCase::DoRun (void)
 
 
 
+/**
+ * Checks the TFT chosen when exact and port range filters of several
+ * TFTs match, after TFTs are deleted, and the hits of each filter.
+ */
+class EpcTftClassifierHitsTestCase : public TestCase
+{
+public:
+  EpcTftClassifierHitsTestCase ();
+  virtual ~EpcTftClassifierHitsTestCase ();
+
+private:
+  /**
+   * Classify a downlink UDP packet from 9.1.1.1 to 8.1.1.1.
+   *
+   * \param c the classifier
+   * \param sp the source port
+   * \param dp the destination port
+   * \return the identifier of the TFT
+   */
+  static uint32_t Classify (Ptr<EpcTftClassifier> c, uint16_t sp, uint16_t dp);
+  virtual void DoRun (void);
+};
+
+EpcTftClassifierHitsTestCase::EpcTftClassifierHitsTestCase ()
+  : TestCase ("exact and port range filters, TFT deletion and filter hits")
+{
+}
+
+EpcTftClassifierHitsTestCase::~EpcTftClassifierHitsTestCase ()
+{
+}
+
+uint32_t
+EpcTftClassifierHitsTestCase::Classify (Ptr<EpcTftClassifier> c, uint16_t sp, uint16_t dp)
+{
+  Ipv4Header ipHeader;
+  ipHeader.SetSource (Ipv4Address ("9.1.1.1"));
+  ipHeader.SetDestination (Ipv4Address ("8.1.1.1"));
+  ipHeader.SetProtocol (UdpL4Protocol::PROT_NUMBER);
+  UdpHeader udpHeader;
+  udpHeader.SetSourcePort (sp);
+  udpHeader.SetDestinationPort (dp);
+  Ptr<Packet> packet = Create<Packet> (100);
+  packet->AddHeader (udpHeader);
+  packet->AddHeader (ipHeader);
+  return c->Classify (packet, EpcTft::DOWNLINK);
+}
+
+void
+EpcTftClassifierHitsTestCase::DoRun (void)
+{
+  Ptr<EpcTftClassifier> c = Create<EpcTftClassifier> ();
+  c->Add (EpcTft::Default (), 1);
+
+  Ptr<EpcTft> tft2 = Create<EpcTft> ();
+  EpcTft::PacketFilter exact;
+  exact.direction = EpcTft::DOWNLINK;
+  exact.remoteAddress.Set ("9.1.1.1");
+  exact.remoteMask.Set (0xFFFFFFFF);
+  exact.localAddress.Set ("8.1.1.1");
+  exact.localMask.Set (0xFFFFFFFF);
+  exact.remotePortStart = 9;
+  exact.remotePortEnd = 9;
+  exact.localPortStart = 3489;
+  exact.localPortEnd = 3489;
+  tft2->Add (exact);
+  EpcTft::PacketFilter range2;
+  range2.localPortStart = 3456;
+  range2.localPortEnd = 3489;
+  tft2->Add (range2);
+  c->Add (tft2, 2);
+
+  Ptr<EpcTft> tft3 = Create<EpcTft> ();
+  EpcTft::PacketFilter range3;
+  range3.localPortStart = 3480;
+  range3.localPortEnd = 3500;
+  tft3->Add (range3);
+  c->Add (tft3, 3);
+
+  NS_TEST_ASSERT_MSG_EQ (Classify (c, 9, 3489), 3, "the TFT with the highest identifier must match first");
+  NS_TEST_ASSERT_MSG_EQ (Classify (c, 9, 3470), 2, "bad classification in a port range");
+  NS_TEST_ASSERT_MSG_EQ (Classify (c, 9, 80), 1, "bad classification by the default TFT");
+
+  c->Delete (3);
+  NS_TEST_ASSERT_MSG_EQ (Classify (c, 9, 3489), 2, "deleted TFT matched");
+  NS_TEST_ASSERT_MSG_EQ (Classify (c, 10, 3489), 2, "bad classification in a port range");
+  NS_TEST_ASSERT_MSG_EQ (Classify (c, 9, 3495), 1, "deleted TFT matched");
+
+  c->Delete (1);
+  NS_TEST_ASSERT_MSG_EQ (Classify (c, 9, 80), 0, "deleted default TFT matched");
+  NS_TEST_ASSERT_MSG_EQ (c->GetNoMatchCount (), 1, "bad number of packets not matched");
+
+  std::vector<uint64_t> hits = c->GetPacketFilterHits (2);
+  NS_TEST_ASSERT_MSG_EQ (hits.size (), 2, "bad number of packet filters");
+  NS_TEST_ASSERT_MSG_EQ (hits[0], 1, "bad number of hits of the exact filter");
+  NS_TEST_ASSERT_MSG_EQ (hits[1], 2, "bad number of hits of the port range filter");
+  NS_TEST_ASSERT_MSG_EQ (c->GetPacketFilterHits (3).size (), 0, "deleted TFT has packet filters");
+}
+
+
+
 
 class EpcTftClassifierTestSuite : public TestSuite
 {
@@ -328,4 +429,11 @@ EpcTftClassifierTestSuite::EpcTftClassifierTestSuite ()
   AddTestCase (new EpcTftClassifierTestCase (c4, EpcTft::UPLINK,   Ipv4Address ("9.1.1.1"), Ipv4Address ("8.1.1.1"),     9,     5897,     0,    2), TestCase::QUICK);
   AddTestCase (new EpcTftClassifierTestCase (c4, EpcTft::DOWNLINK, Ipv4Address ("9.1.1.1"), Ipv4Address ("8.1.1.1"),  5897,       10,     0,    2), TestCase::QUICK);
 
+
+  ///////////////////////////////////////////
+  // check the filter hits and TFT deletion
+  ///////////////////////////////////////////
+
+  AddTestCase (new EpcTftClassifierHitsTestCase, TestCase::QUICK);
+
 }
@@ -0,0 +1,208 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2015 University of Washington
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+#include "ns3/string.h"
+#include "ns3/double.h"
+#include "ns3/uinteger.h"
+#include "ns3/boolean.h"
+#include "ns3/test.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/buildings-helper.h"
+#include "ns3/lte-helper.h"
+#include "ns3/spectrum-channel.h"
+#include "ns3/radio-environment-map-helper.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteRadioEnvironmentMapTest");
+
+/**
+ * Checks that the offline Radio Environment Map has the same points and
+ * SINR values as the one obtained from simulated transmissions.
+ */
+class LteOfflineRemTestCase : public TestCase
+{
+public:
+  /**
+   * \param threadCount the number of threads of the offline map
+   * \param maxPointsPerIteration the number of points per batch
+   * \return the name of the test case
+   */
+  static std::string BuildNameString (uint32_t threadCount, uint32_t maxPointsPerIteration);
+  /**
+   * \param threadCount the number of threads of the offline map
+   * \param maxPointsPerIteration the number of points per batch
+   */
+  LteOfflineRemTestCase (uint32_t threadCount, uint32_t maxPointsPerIteration);
+  virtual ~LteOfflineRemTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /// A line of a map.
+  struct RemLine
+  {
+    double x;      ///< X coordinate.
+    double y;      ///< Y coordinate.
+    double z;      ///< Z coordinate.
+    double sinr;   ///< SINR.
+  };
+
+  /**
+   * Generate a map of a two cell scenario.
+   *
+   * \param offline the `Offline` attribute of the map
+   * \param filename the output file
+   */
+  void GenerateRem (bool offline, std::string filename);
+  /**
+   * \param filename a map file
+   * \return the lines of the map
+   */
+  std::vector<RemLine> ReadRem (std::string filename);
+
+  uint32_t m_threadCount;             ///< The `ThreadCount` attribute.
+  uint32_t m_maxPointsPerIteration;   ///< The `MaxPointsPerIteration` attribute.
+};
+
+std::string
+LteOfflineRemTestCase::BuildNameString (uint32_t threadCount, uint32_t maxPointsPerIteration)
+{
+  std::ostringstream oss;
+  oss << "Offline REM matches the simulated one, " << threadCount << " threads, "
+      << maxPointsPerIteration << " points per iteration";
+  return oss.str ();
+}
+
+LteOfflineRemTestCase::LteOfflineRemTestCase (uint32_t threadCount, uint32_t maxPointsPerIteration)
+  : TestCase (BuildNameString (threadCount, maxPointsPerIteration)),
+    m_threadCount (threadCount),
+    m_maxPointsPerIteration (maxPointsPerIteration)
+{
+}
+
+LteOfflineRemTestCase::~LteOfflineRemTestCase ()
+{
+}
+
+void
+LteOfflineRemTestCase::GenerateRem (bool offline, std::string filename)
+{
+  Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+  lteHelper->SetEnbAntennaModelType ("ns3::CosineAntennaModel");
+  lteHelper->SetEnbAntennaModelAttribute ("Beamwidth", DoubleValue (120));
+
+  NodeContainer enbNodes;
+  enbNodes.Create (2);
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  positionAlloc->Add (Vector (0.0, 0.0, 10.0));
+  positionAlloc->Add (Vector (200.0, 50.0, 10.0));
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.Install (enbNodes);
+  BuildingsHelper::Install (enbNodes);
+
+  lteHelper->SetEnbAntennaModelAttribute ("Orientation", DoubleValue (0));
+  lteHelper->InstallEnbDevice (enbNodes.Get (0));
+  lteHelper->SetEnbAntennaModelAttribute ("Orientation", DoubleValue (180));
+  lteHelper->InstallEnbDevice (enbNodes.Get (1));
+
+  std::ostringstream channelPath;
+  channelPath << "/ChannelList/" << lteHelper->GetDownlinkSpectrumChannel ()->GetId ();
+  Ptr<RadioEnvironmentMapHelper> remHelper = CreateObject<RadioEnvironmentMapHelper> ();
+  remHelper->SetAttribute ("ChannelPath", StringValue (channelPath.str ()));
+  remHelper->SetAttribute ("OutputFile", StringValue (filename));
+  remHelper->SetAttribute ("XMin", DoubleValue (-100.0));
+  remHelper->SetAttribute ("XMax", DoubleValue (300.0));
+  remHelper->SetAttribute ("XRes", UintegerValue (21));
+  remHelper->SetAttribute ("YMin", DoubleValue (-100.0));
+  remHelper->SetAttribute ("YMax", DoubleValue (150.0));
+  remHelper->SetAttribute ("YRes", UintegerValue (11));
+  remHelper->SetAttribute ("Z", DoubleValue (1.5));
+  remHelper->SetAttribute ("MaxPointsPerIteration", UintegerValue (m_maxPointsPerIteration));
+  remHelper->SetAttribute ("Offline", BooleanValue (offline));
+  remHelper->SetAttribute ("ThreadCount", UintegerValue (m_threadCount));
+  remHelper->Install ();
+
+  BuildingsHelper::MakeMobilityModelConsistent ();
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+std::vector<LteOfflineRemTestCase::RemLine>
+LteOfflineRemTestCase::ReadRem (std::string filename)
+{
+  std::vector<RemLine> lines;
+  std::ifstream file (filename.c_str ());
+  RemLine line;
+  while (file >> line.x >> line.y >> line.z >> line.sinr)
+    {
+      lines.push_back (line);
+    }
+  return lines;
+}
+
+void
+LteOfflineRemTestCase::DoRun (void)
+{
+  std::string simulatedFile = CreateTempDirFilename ("rem-simulated.out");
+  std::string offlineFile = CreateTempDirFilename ("rem-offline.out");
+  GenerateRem (false, simulatedFile);
+  GenerateRem (true, offlineFile);
+
+  std::vector<RemLine> simulated = ReadRem (simulatedFile);
+  std::vector<RemLine> offline = ReadRem (offlineFile);
+  NS_TEST_ASSERT_MSG_EQ (simulated.size (), 21 * 11, "wrong number of points in the simulated REM");
+  NS_TEST_ASSERT_MSG_EQ (offline.size (), simulated.size (), "wrong number of points in the offline REM");
+  for (uint32_t i = 0; i < offline.size (); ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ_TOL (offline[i].x, simulated[i].x, 1e-9, "wrong x of point " << i);
+      NS_TEST_ASSERT_MSG_EQ_TOL (offline[i].y, simulated[i].y, 1e-9, "wrong y of point " << i);
+      NS_TEST_ASSERT_MSG_EQ_TOL (offline[i].z, simulated[i].z, 1e-9, "wrong z of point " << i);
+      // the values are printed with 6 significant digits
+      NS_TEST_ASSERT_MSG_EQ_TOL (offline[i].sinr, simulated[i].sinr, simulated[i].sinr * 1e-5,
+                                 "wrong SINR of point " << i);
+    }
+
+  std::remove (simulatedFile.c_str ());
+  std::remove (offlineFile.c_str ());
+}
+
+
+class LteRadioEnvironmentMapTestSuite : public TestSuite
+{
+public:
+  LteRadioEnvironmentMapTestSuite ();
+};
+
+LteRadioEnvironmentMapTestSuite::LteRadioEnvironmentMapTestSuite ()
+  : TestSuite ("lte-radio-environment-map", SYSTEM)
+{
+  AddTestCase (new LteOfflineRemTestCase (1, 20000), TestCase::QUICK);
+  AddTestCase (new LteOfflineRemTestCase (3, 50), TestCase::QUICK);
+}
+
+static LteRadioEnvironmentMapTestSuite lteRadioEnvironmentMapTestSuite;
@@ -0,0 +1,795 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "parallel-simulator-impl.h"
+#include "ns3/simulator.h"
+#include "ns3/scheduler.h"
+#include "ns3/event-impl.h"
+#include "ns3/channel.h"
+#include "ns3/net-device.h"
+#include "ns3/node.h"
+#include "ns3/node-list.h"
+#include "ns3/uinteger.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <iostream>
+#include <unistd.h>
+
+namespace ns3 {
+
+// Note:  Logging in this file is largely avoided due to the
+// number of calls that are made to these functions and the possibility
+// of causing recursions leading to stack overflow
+NS_LOG_COMPONENT_DEFINE ("ParallelSimulatorImpl");
+
+NS_OBJECT_ENSURE_REGISTERED (ParallelSimulatorImpl);
+
+/**
+ * \ingroup mpi
+ * Index plus one of the partition processed by the calling thread,
+ * or zero if the thread is not processing a partition.
+ */
+static __thread uint32_t g_currentPartition = 0;
+
+/** Context of the events which are not bound to any node. */
+static const uint32_t NO_CONTEXT = 0xffffffff;
+
+TypeId
+ParallelSimulatorImpl::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::ParallelSimulatorImpl")
+    .SetParent<SimulatorImpl> ()
+    .SetGroupName ("Mpi")
+    .AddConstructor<ParallelSimulatorImpl> ()
+    .AddAttribute ("ThreadCount",
+                   "The number of partitions of the nodes, each processed "
+                   "by a thread. Zero means one per online processor.",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&ParallelSimulatorImpl::m_threadCount),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("LookAhead",
+                   "If positive, the lookahead to be used instead of the "
+                   "one calculated from the delays of the point-to-point "
+                   "channels connecting different partitions. It is ignored "
+                   "if another kind of channel connects different partitions.",
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&ParallelSimulatorImpl::m_userLookAhead),
+                   MakeTimeChecker ())
+  ;
+  return tid;
+}
+
+ParallelSimulatorImpl::ParallelSimulatorImpl ()
+  : m_threadCount (0),
+    m_lookAhead (0),
+    m_concurrent (false),
+    m_parallelWindows (0),
+    m_window (0),
+    m_windowEnd (0),
+    m_busyWorkers (0),
+    m_exitWorkers (false),
+    m_stop (false)
+{
+  NS_LOG_FUNCTION (this);
+  m_main = SystemThread::Self ();
+  pthread_mutex_init (&m_poolMutex, 0);
+  pthread_cond_init (&m_windowStarted, 0);
+  pthread_cond_init (&m_windowDone, 0);
+}
+
+ParallelSimulatorImpl::~ParallelSimulatorImpl ()
+{
+  NS_LOG_FUNCTION (this);
+  pthread_cond_destroy (&m_windowDone);
+  pthread_cond_destroy (&m_windowStarted);
+  pthread_mutex_destroy (&m_poolMutex);
+}
+
+void
+ParallelSimulatorImpl::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  DeliverEvents ();
+  for (std::vector<Partition>::iterator i = m_partitions.begin (); i != m_partitions.end (); ++i)
+    {
+      while (!i->events->IsEmpty ())
+        {
+          Scheduler::Event next = i->events->RemoveNext ();
+          next.impl->Unref ();
+        }
+      i->events = 0;
+    }
+  m_partitions.clear ();
+  SimulatorImpl::DoDispose ();
+}
+
+void
+ParallelSimulatorImpl::Destroy ()
+{
+  NS_LOG_FUNCTION (this);
+  while (!m_destroyEvents.empty ())
+    {
+      Ptr<EventImpl> ev = m_destroyEvents.front ().PeekEventImpl ();
+      m_destroyEvents.pop_front ();
+      NS_LOG_LOGIC ("handle destroy " << ev);
+      if (!ev->IsCancelled ())
+        {
+          ev->Invoke ();
+        }
+    }
+}
+
+void
+ParallelSimulatorImpl::SetScheduler (ObjectFactory schedulerFactory)
+{
+  NS_LOG_FUNCTION (this << schedulerFactory);
+  if (m_partitions.empty ())
+    {
+      // this is called right after the construction, once the
+      // attributes are set
+      uint32_t nPartitions = m_threadCount;
+      if (nPartitions == 0)
+        {
+          long nProcessors = sysconf (_SC_NPROCESSORS_ONLN);
+          nPartitions = (nProcessors > 0) ? nProcessors : 1;
+        }
+      NS_LOG_LOGIC ("using " << nPartitions << " partitions");
+      // one more partition for the events without context
+      m_partitions.resize (nPartitions + 1);
+      for (std::vector<Partition>::iterator i = m_partitions.begin (); i != m_partitions.end (); ++i)
+        {
+          // uids are allocated from 4, see DefaultSimulatorImpl
+          i->uid = 4;
+          i->currentUid = 0;
+          i->currentTs = 0;
+          i->currentContext = NO_CONTEXT;
+          i->unscheduledEvents = 0;
+        }
+    }
+
+  for (std::vector<Partition>::iterator i = m_partitions.begin (); i != m_partitions.end (); ++i)
+    {
+      Ptr<Scheduler> scheduler = schedulerFactory.Create<Scheduler> ();
+      if (i->events != 0)
+        {
+          while (!i->events->IsEmpty ())
+            {
+              scheduler->Insert (i->events->RemoveNext ());
+            }
+        }
+      i->events = scheduler;
+    }
+}
+
+// System ID for non-distributed simulation is always zero
+uint32_t
+ParallelSimulatorImpl::GetSystemId (void) const
+{
+  return 0;
+}
+
+uint32_t
+ParallelSimulatorImpl::GetPartitionIndex (uint32_t context) const
+{
+  uint32_t nPartitions = m_partitions.size () - 1;
+  if (context == NO_CONTEXT)
+    {
+      return nPartitions;
+    }
+  return context % nPartitions;
+}
+
+ParallelSimulatorImpl::Partition &
+ParallelSimulatorImpl::GetCurrentPartition (void) const
+{
+  // threads which are not processing a partition, including the main
+  // thread while no partition is running, see the events without context
+  std::vector<Partition> &partitions = const_cast<std::vector<Partition> &> (m_partitions);
+  if (g_currentPartition == 0)
+    {
+      return partitions.back ();
+    }
+  return partitions[g_currentPartition - 1];
+}
+
+Scheduler::Event
+ParallelSimulatorImpl::Insert (Partition &partition, uint64_t ts, uint32_t context, EventImpl *event)
+{
+  Scheduler::Event ev;
+  ev.impl = event;
+  ev.key.m_ts = ts;
+  ev.key.m_context = context;
+  ev.key.m_uid = partition.uid;
+  partition.uid++;
+  partition.unscheduledEvents++;
+  partition.events->Insert (ev);
+  return ev;
+}
+
+void
+ParallelSimulatorImpl::ProcessOneEvent (uint32_t index)
+{
+  Partition &partition = m_partitions[index];
+  Scheduler::Event next = partition.events->RemoveNext ();
+
+  NS_ASSERT (next.key.m_ts >= partition.currentTs);
+  partition.unscheduledEvents--;
+
+  partition.currentTs = next.key.m_ts;
+  partition.currentContext = next.key.m_context;
+  partition.currentUid = next.key.m_uid;
+  next.impl->Invoke ();
+  next.impl->Unref ();
+}
+
+void
+ParallelSimulatorImpl::ProcessWindow (uint32_t index, uint64_t end)
+{
+  Partition &partition = m_partitions[index];
+  g_currentPartition = index + 1;
+  while (!partition.events->IsEmpty ()
+         && partition.events->PeekNext ().key.m_ts < end)
+    {
+      ProcessOneEvent (index);
+    }
+  g_currentPartition = 0;
+}
+
+void
+ParallelSimulatorImpl::Worker::Run (void)
+{
+  uint64_t window = 0;
+  uint64_t end;
+  while (simulator->WaitWindow (window, end))
+    {
+      simulator->ProcessWindow (partition, end);
+      simulator->EndWindow ();
+    }
+}
+
+bool
+ParallelSimulatorImpl::WaitWindow (uint64_t &window, uint64_t &end)
+{
+  pthread_mutex_lock (&m_poolMutex);
+  while (m_window == window && !m_exitWorkers)
+    {
+      pthread_cond_wait (&m_windowStarted, &m_poolMutex);
+    }
+  bool exit = m_exitWorkers;
+  window = m_window;
+  end = m_windowEnd;
+  pthread_mutex_unlock (&m_poolMutex);
+  return !exit;
+}
+
+void
+ParallelSimulatorImpl::EndWindow (void)
+{
+  pthread_mutex_lock (&m_poolMutex);
+  m_busyWorkers--;
+  if (m_busyWorkers == 0)
+    {
+      pthread_cond_signal (&m_windowDone);
+    }
+  pthread_mutex_unlock (&m_poolMutex);
+}
+
+void
+ParallelSimulatorImpl::StartWorkers (void)
+{
+  NS_LOG_FUNCTION (this);
+  uint32_t nPartitions = m_partitions.size () - 1;
+  // the partitions share the packets, so their reference counts
+  // must be updated atomically while the workers exist
+  AtomicRefCount::Enable (true);
+  m_window = 0;
+  m_exitWorkers = false;
+  // the vector must not be resized once the threads are started
+  m_workers.resize (nPartitions - 1);
+  for (uint32_t i = 0; i < m_workers.size (); ++i)
+    {
+      m_workers[i].simulator = this;
+      m_workers[i].partition = i + 1;
+      Ptr<SystemThread> thread = Create<SystemThread> (MakeCallback (&Worker::Run, &m_workers[i]));
+      thread->Start ();
+      m_workerThreads.push_back (thread);
+    }
+}
+
+void
+ParallelSimulatorImpl::StopWorkers (void)
+{
+  NS_LOG_FUNCTION (this);
+  pthread_mutex_lock (&m_poolMutex);
+  m_exitWorkers = true;
+  pthread_cond_broadcast (&m_windowStarted);
+  pthread_mutex_unlock (&m_poolMutex);
+  for (std::vector<Ptr<SystemThread> >::iterator i = m_workerThreads.begin (); i != m_workerThreads.end (); ++i)
+    {
+      (*i)->Join ();
+    }
+  m_workerThreads.clear ();
+  m_workers.clear ();
+  AtomicRefCount::Enable (false);
+}
+
+void
+ParallelSimulatorImpl::RunWindow (uint64_t end)
+{
+  uint32_t nPartitions = m_partitions.size () - 1;
+  uint32_t nActive = 0;
+  uint32_t first = 0;
+  for (uint32_t i = 0; i < nPartitions; ++i)
+    {
+      if (!m_partitions[i].events->IsEmpty ()
+          && m_partitions[i].events->PeekNext ().key.m_ts < end)
+        {
+          if (nActive == 0)
+            {
+              first = i;
+            }
+          nActive++;
+        }
+    }
+  NS_ASSERT (nActive != 0);
+
+  // the same rules apply whether the partitions actually run
+  // concurrently or not
+  m_concurrent = true;
+  if (nActive > 1 && !m_workers.empty ())
+    {
+      // hand the window to the workers; the main thread processes
+      // the first partition
+      pthread_mutex_lock (&m_poolMutex);
+      m_windowEnd = end;
+      m_busyWorkers = m_workers.size ();
+      m_window++;
+      pthread_cond_broadcast (&m_windowStarted);
+      pthread_mutex_unlock (&m_poolMutex);
+
+      ProcessWindow (0, end);
+
+      pthread_mutex_lock (&m_poolMutex);
+      while (m_busyWorkers != 0)
+        {
+          pthread_cond_wait (&m_windowDone, &m_poolMutex);
+        }
+      pthread_mutex_unlock (&m_poolMutex);
+      m_parallelWindows++;
+    }
+  else
+    {
+      for (uint32_t i = first; i < nPartitions; ++i)
+        {
+          ProcessWindow (i, end);
+        }
+    }
+  m_concurrent = false;
+}
+
+void
+ParallelSimulatorImpl::DeliverEvents (void)
+{
+  for (std::vector<Partition>::iterator i = m_partitions.begin (); i != m_partitions.end (); ++i)
+    {
+      for (EventsWithContext::const_iterator j = i->outgoing.begin (); j != i->outgoing.end (); ++j)
+        {
+          Insert (m_partitions[GetPartitionIndex (j->context)], j->timestamp, j->context, j->event);
+        }
+      i->outgoing.clear ();
+    }
+
+  std::list<EventWithContext> eventsWithContext;
+  {
+    CriticalSection cs (m_eventsWithContextMutex);
+    m_eventsWithContext.swap (eventsWithContext);
+  }
+  if (eventsWithContext.empty ())
+    {
+      return;
+    }
+  // the delays are relative to the latest time reached by any partition
+  uint64_t now = 0;
+  for (std::vector<Partition>::const_iterator i = m_partitions.begin (); i != m_partitions.end (); ++i)
+    {
+      now = std::max (now, i->currentTs);
+    }
+  for (std::list<EventWithContext>::const_iterator i = eventsWithContext.begin (); i != eventsWithContext.end (); ++i)
+    {
+      Insert (m_partitions[GetPartitionIndex (i->context)], now + i->timestamp, i->context, i->event);
+    }
+}
+
+void
+ParallelSimulatorImpl::CalculateLookAhead (void)
+{
+  NS_LOG_FUNCTION (this);
+  uint64_t lookAhead = GetMaximumSimulationTime ().GetTimeStep ();
+  for (NodeList::Iterator node = NodeList::Begin (); node != NodeList::End (); ++node)
+    {
+      uint32_t localPartition = GetPartitionIndex ((*node)->GetId ());
+      for (uint32_t i = 0; i < (*node)->GetNDevices (); ++i)
+        {
+          Ptr<NetDevice> localDevice = (*node)->GetDevice (i);
+          Ptr<Channel> channel = localDevice->GetChannel ();
+          if (channel == 0)
+            {
+              continue;
+            }
+          for (uint32_t j = 0; j < channel->GetNDevices (); ++j)
+            {
+              Ptr<NetDevice> remoteDevice = channel->GetDevice (j);
+              if (remoteDevice == 0 || remoteDevice->GetNode () == 0
+                  || GetPartitionIndex (remoteDevice->GetNode ()->GetId ()) == localPartition)
+                {
+                  continue;
+                }
+              // as with DistributedSimulatorImpl, only point-to-point
+              // links may be split: the state of a shared channel (e.g.,
+              // a CsmaChannel or a SpectrumChannel) is accessed by all
+              // its devices, whatever the lookahead
+              TimeValue delay;
+              if (!localDevice->IsPointToPoint ()
+                  || !channel->GetAttributeFailSafe ("Delay", delay)
+                  || !delay.Get ().IsStrictlyPositive ())
+                {
+                  std::cerr << "ParallelSimulatorImpl: channel " << channel->GetInstanceTypeId ().GetName ()
+                            << " connects different partitions but is not a point-to-point channel"
+                            << " with a positive Delay attribute; the events are processed sequentially"
+                            << (m_userLookAhead.IsStrictlyPositive () ? " and the LookAhead attribute is ignored." : ".")
+                            << std::endl;
+                  m_lookAhead = 0;
+                  return;
+                }
+              lookAhead = std::min<uint64_t> (lookAhead, delay.Get ().GetTimeStep ());
+            }
+        }
+    }
+  if (m_userLookAhead.IsStrictlyPositive ())
+    {
+      lookAhead = m_userLookAhead.GetTimeStep ();
+    }
+  m_lookAhead = lookAhead;
+  NS_LOG_LOGIC ("lookahead " << TimeStep (m_lookAhead));
+}
+
+bool
+ParallelSimulatorImpl::IsFinished (void) const
+{
+  if (m_stop)
+    {
+      return true;
+    }
+  for (std::vector<Partition>::const_iterator i = m_partitions.begin (); i != m_partitions.end (); ++i)
+    {
+      if (!i->events->IsEmpty ())
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
+void
+ParallelSimulatorImpl::Run (void)
+{
+  NS_LOG_FUNCTION (this);
+  // Set the current threadId as the main threadId
+  m_main = SystemThread::Self ();
+  CalculateLookAhead ();
+  DeliverEvents ();
+  m_stop = false;
+
+  uint32_t global = m_partitions.size () - 1;
+  Ptr<Scheduler> globalEvents = m_partitions[global].events;
+  if (m_lookAhead != 0 && global > 1)
+    {
+      StartWorkers ();
+    }
+  while (!m_stop)
+    {
+      // find the earliest event of the node partitions
+      bool found = false;
+      uint32_t first = 0;
+      uint64_t firstTs = 0;
+      for (uint32_t i = 0; i < global; ++i)
+        {
+          if (!m_partitions[i].events->IsEmpty ())
+            {
+              uint64_t ts = m_partitions[i].events->PeekNext ().key.m_ts;
+              if (!found || ts < firstTs)
+                {
+                  found = true;
+                  first = i;
+                  firstTs = ts;
+                }
+            }
+        }
+
+      if (!globalEvents->IsEmpty ()
+          && (!found || globalEvents->PeekNext ().key.m_ts <= firstTs))
+        {
+          // events without context are processed alone
+          ProcessOneEvent (global);
+        }
+      else if (!found)
+        {
+          break;
+        }
+      else if (m_lookAhead == 0)
+        {
+          // no lookahead: process the events in timestamp order
+          ProcessWindow (first, firstTs + 1);
+        }
+      else
+        {
+          uint64_t end = firstTs + m_lookAhead;
+          if (!globalEvents->IsEmpty ())
+            {
+              end = std::min (end, globalEvents->PeekNext ().key.m_ts);
+            }
+          RunWindow (end);
+        }
+      DeliverEvents ();
+    }
+  if (!m_workers.empty ())
+    {
+      StopWorkers ();
+    }
+
+  // If the simulator stopped naturally by lack of events, make a
+  // consistency test to check that we didn't lose any events along the way.
+  for (std::vector<Partition>::const_iterator i = m_partitions.begin (); i != m_partitions.end (); ++i)
+    {
+      NS_ASSERT (m_stop || i->unscheduledEvents == 0);
+    }
+}
+
+void
+ParallelSimulatorImpl::Stop (void)
+{
+  NS_LOG_FUNCTION (this);
+  CriticalSection cs (m_stopMutex);
+  m_stop = true;
+}
+
+void
+ParallelSimulatorImpl::Stop (Time const &delay)
+{
+  NS_LOG_FUNCTION (this << delay.GetTimeStep ());
+  Simulator::Schedule (delay, &Simulator::Stop);
+}
+
+//
+// Schedule an event for a _relative_ time in the future.
+//
+EventId
+ParallelSimulatorImpl::Schedule (Time const &delay, EventImpl *event)
+{
+  NS_LOG_FUNCTION (this << delay.GetTimeStep () << event);
+  NS_ASSERT_MSG (g_currentPartition != 0 || SystemThread::Equals (m_main), "Simulator::Schedule Thread-unsafe invocation!");
+
+  Partition &partition = GetCurrentPartition ();
+  Time tAbsolute = delay + TimeStep (partition.currentTs);
+
+  NS_ASSERT (tAbsolute.IsPositive ());
+  NS_ASSERT (tAbsolute >= TimeStep (partition.currentTs));
+  Scheduler::Event ev = Insert (partition, tAbsolute.GetTimeStep (), partition.currentContext, event);
+  return EventId (event, ev.key.m_ts, ev.key.m_context, ev.key.m_uid);
+}
+
+void
+ParallelSimulatorImpl::ScheduleWithContext (uint32_t context, Time const &delay, EventImpl *event)
+{
+  NS_LOG_FUNCTION (this << context << delay.GetTimeStep () << event);
+
+  if (g_currentPartition == 0 && !SystemThread::Equals (m_main))
+    {
+      // a thread which is not a simulation thread
+      EventWithContext ev;
+      ev.context = context;
+      // Current time added in DeliverEvents()
+      ev.timestamp = delay.GetTimeStep ();
+      ev.event = event;
+      CriticalSection cs (m_eventsWithContextMutex);
+      m_eventsWithContext.push_back (ev);
+      return;
+    }
+
+  Partition &partition = GetCurrentPartition ();
+  Partition &destination = m_partitions[GetPartitionIndex (context)];
+  uint64_t ts = partition.currentTs + delay.GetTimeStep ();
+  if (&destination == &partition || !m_concurrent)
+    {
+      Insert (destination, ts, context, event);
+      return;
+    }
+  if ((uint64_t) delay.GetTimeStep () < m_lookAhead)
+    {
+      NS_FATAL_ERROR ("Event scheduled for context " << context << " with delay " << delay
+                      << ", which is smaller than the lookahead " << TimeStep (m_lookAhead));
+    }
+  EventWithContext ev;
+  ev.context = context;
+  ev.timestamp = ts;
+  ev.event = event;
+  partition.outgoing.push_back (ev);
+}
+
+EventId
+ParallelSimulatorImpl::ScheduleNow (EventImpl *event)
+{
+  NS_ASSERT_MSG (g_currentPartition != 0 || SystemThread::Equals (m_main), "Simulator::ScheduleNow Thread-unsafe invocation!");
+
+  Partition &partition = GetCurrentPartition ();
+  Scheduler::Event ev = Insert (partition, partition.currentTs, partition.currentContext, event);
+  return EventId (event, ev.key.m_ts, ev.key.m_context, ev.key.m_uid);
+}
+
+EventId
+ParallelSimulatorImpl::ScheduleDestroy (EventImpl *event)
+{
+  NS_ASSERT_MSG (g_currentPartition == 0 && SystemThread::Equals (m_main), "Simulator::ScheduleDestroy Thread-unsafe invocation!");
+
+  EventId id (Ptr<EventImpl> (event, false), GetCurrentPartition ().currentTs, NO_CONTEXT, 2);
+  m_destroyEvents.push_back (id);
+  return id;
+}
+
+Time
+ParallelSimulatorImpl::Now (void) const
+{
+  // Do not add function logging here, to avoid stack overflow
+  return TimeStep (GetCurrentPartition ().currentTs);
+}
+
+Time
+ParallelSimulatorImpl::GetDelayLeft (const EventId &id) const
+{
+  if (IsExpired (id))
+    {
+      return TimeStep (0);
+    }
+  else
+    {
+      return TimeStep (id.GetTs () - GetCurrentPartition ().currentTs);
+    }
+}
+
+void
+ParallelSimulatorImpl::Remove (const EventId &id)
+{
+  if (id.GetUid () == 2)
+    {
+      // destroy events.
+      for (DestroyEvents::iterator i = m_destroyEvents.begin (); i != m_destroyEvents.end (); i++)
+        {
+          if (*i == id)
+            {
+              m_destroyEvents.erase (i);
+              break;
+            }
+        }
+      return;
+    }
+  if (IsExpired (id))
+    {
+      return;
+    }
+  Partition &partition = m_partitions[GetPartitionIndex (id.GetContext ())];
+  CheckPartition (partition, "Remove");
+  Scheduler::Event event;
+  event.impl = id.PeekEventImpl ();
+  event.key.m_ts = id.GetTs ();
+  event.key.m_context = id.GetContext ();
+  event.key.m_uid = id.GetUid ();
+  partition.events->Remove (event);
+  event.impl->Cancel ();
+  // whenever we remove an event from the event list, we have to unref it.
+  event.impl->Unref ();
+
+  partition.unscheduledEvents--;
+}
+
+void
+ParallelSimulatorImpl::Cancel (const EventId &id)
+{
+  if (id.GetUid () != 2)
+    {
+      CheckPartition (m_partitions[GetPartitionIndex (id.GetContext ())], "Cancel");
+    }
+  if (!IsExpired (id))
+    {
+      id.PeekEventImpl ()->Cancel ();
+    }
+}
+
+void
+ParallelSimulatorImpl::CheckPartition (const Partition &partition, const char *operation) const
+{
+  if (m_concurrent && &partition != &GetCurrentPartition ())
+    {
+      NS_FATAL_ERROR ("Simulator::" << operation << " of an event of another partition "
+                      "while the partitions are running");
+    }
+}
+
+bool
+ParallelSimulatorImpl::IsExpired (const EventId &id) const
+{
+  if (id.GetUid () == 2)
+    {
+      if (id.PeekEventImpl () == 0
+          || id.PeekEventImpl ()->IsCancelled ())
+        {
+          return true;
+        }
+      // destroy events.
+      for (DestroyEvents::const_iterator i = m_destroyEvents.begin (); i != m_destroyEvents.end (); i++)
+        {
+          if (*i == id)
+            {
+              return false;
+            }
+        }
+      return true;
+    }
+  // the event is compared with the last event processed by its partition
+  const Partition &partition = m_partitions[GetPartitionIndex (id.GetContext ())];
+  if (id.PeekEventImpl () == 0
+      || id.GetTs () < partition.currentTs
+      || (id.GetTs () == partition.currentTs
+          && id.GetUid () <= partition.currentUid)
+      || id.PeekEventImpl ()->IsCancelled ())
+    {
+      return true;
+    }
+  else
+    {
+      return false;
+    }
+}
+
+Time
+ParallelSimulatorImpl::GetMaximumSimulationTime (void) const
+{
+  return TimeStep (0x7fffffffffffffffLL);
+}
+
+uint32_t
+ParallelSimulatorImpl::GetContext (void) const
+{
+  return GetCurrentPartition ().currentContext;
+}
+
+Time
+ParallelSimulatorImpl::GetLookAhead (void) const
+{
+  return TimeStep (m_lookAhead);
+}
+
+uint64_t
+ParallelSimulatorImpl::GetParallelWindows (void) const
+{
+  return m_parallelWindows;
+}
+
+} // namespace ns3
@@ -0,0 +1,286 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NS3_PARALLEL_SIMULATOR_IMPL_H
+#define NS3_PARALLEL_SIMULATOR_IMPL_H
+
+#include "ns3/simulator-impl.h"
+#include "ns3/scheduler.h"
+#include "ns3/event-impl.h"
+#include "ns3/system-thread.h"
+#include "ns3/system-mutex.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+
+#include <list>
+#include <vector>
+#include <pthread.h>
+
+namespace ns3 {
+
+/**
+ * \ingroup mpi
+ *
+ * \brief Shared-memory parallel simulator implementation.
+ *
+ * The nodes are partitioned across a number of threads of the same
+ * process, node i (i.e., the events with context i) being assigned
+ * to partition i modulo the number of partitions. The simulation
+ * time is advanced in windows: in each window, the events of every
+ * partition whose timestamp is smaller than the earliest pending
+ * event plus the lookahead are processed concurrently, each
+ * partition by one thread of a pool which lives as long as Run ().
+ * The events that a partition schedules for another partition are
+ * buffered and delivered at the end of the window, in partition
+ * order.
+ *
+ * The events of a node are processed in timestamp order, as with
+ * DefaultSimulatorImpl, but the order of the events with the same
+ * timestamp depends on the partitioning, hence on the ThreadCount
+ * attribute, and the packet uids depend on the scheduling of the
+ * threads.
+ *
+ * Unless set with the LookAhead attribute, the lookahead is the
+ * smallest Delay attribute of the point-to-point channels which
+ * connect nodes of different partitions, as done by
+ * DistributedSimulatorImpl::CalculateLookAhead. If another kind of
+ * channel connects nodes of different partitions (e.g., a
+ * CsmaChannel, a SpectrumChannel or a YansWifiChannel), whose state
+ * is shared by all its devices, or if a point-to-point channel has no
+ * positive Delay attribute, a warning is printed and the events are
+ * processed sequentially, whatever the LookAhead attribute.
+ * Scheduling an event in another partition with a delay smaller than
+ * the lookahead, or removing or cancelling an event of another
+ * partition, while the partitions are running is a fatal error.
+ *
+ * The events without context (e.g., those scheduled before the
+ * simulation starts by the main program, or Simulator::Stop) are
+ * processed by the main thread while no other partition is running,
+ * so that they can safely access any node.
+ *
+ * \note The events of different partitions are processed
+ * concurrently, hence the models used by the simulation must not
+ * share any state across nodes other than through the simulator
+ * (e.g., random variable streams, global caches, or objects shared
+ * by the nodes of different partitions) for the simulation to be
+ * correct. Logging (NS_LOG) is not supported while the partitions
+ * are running: the log components are not protected, and the output
+ * of different threads is interleaved.
+ */
+class ParallelSimulatorImpl : public SimulatorImpl
+{
+public:
+  /**
+   *  Register this type.
+   *  \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /** Constructor. */
+  ParallelSimulatorImpl ();
+  /** Destructor. */
+  ~ParallelSimulatorImpl ();
+
+  // Inherited
+  virtual void Destroy ();
+  virtual bool IsFinished (void) const;
+  virtual void Stop (void);
+  virtual void Stop (const Time &delay);
+  virtual EventId Schedule (const Time &delay, EventImpl *event);
+  virtual void ScheduleWithContext (uint32_t context, const Time &delay, EventImpl *event);
+  virtual EventId ScheduleNow (EventImpl *event);
+  virtual EventId ScheduleDestroy (EventImpl *event);
+  virtual void Remove (const EventId &id);
+  virtual void Cancel (const EventId &id);
+  virtual bool IsExpired (const EventId &id) const;
+  virtual void Run (void);
+  virtual Time Now (void) const;
+  virtual Time GetDelayLeft (const EventId &id) const;
+  virtual Time GetMaximumSimulationTime (void) const;
+  virtual void SetScheduler (ObjectFactory schedulerFactory);
+  virtual uint32_t GetSystemId (void) const;
+  virtual uint32_t GetContext (void) const;
+
+  /**
+   * \return the lookahead used by the last call to Run ()
+   */
+  Time GetLookAhead (void) const;
+
+  /**
+   * \return the number of windows processed concurrently by more
+   * than one thread
+   */
+  uint64_t GetParallelWindows (void) const;
+
+private:
+  virtual void DoDispose (void);
+
+  /** An event scheduled by a partition for another partition. */
+  struct EventWithContext
+  {
+    uint32_t context;     //!< The event context.
+    uint64_t timestamp;   //!< The absolute timestamp, or the delay for events of other threads.
+    EventImpl *event;     //!< The event implementation.
+  };
+  /** Container type for the events scheduled for other partitions. */
+  typedef std::vector<EventWithContext> EventsWithContext;
+
+  /** The state of a partition. */
+  struct Partition
+  {
+    Ptr<Scheduler> events;          //!< The event priority queue.
+    uint32_t uid;                   //!< Next event unique id.
+    uint32_t currentUid;            //!< Unique id of the current event.
+    uint64_t currentTs;             //!< Timestamp of the current event.
+    uint32_t currentContext;        //!< Execution context of the current event.
+    int unscheduledEvents;          //!< Number of events inserted but not yet processed.
+    EventsWithContext outgoing;     //!< Events scheduled for other partitions.
+  };
+
+  /** A thread of the pool, processing a partition in every window. */
+  struct Worker
+  {
+    ParallelSimulatorImpl *simulator;  //!< The simulator.
+    uint32_t partition;                //!< Index of the partition.
+    /** Process the windows of the partition until the pool stops. */
+    void Run (void);
+  };
+
+  /**
+   * \param context an event context
+   * \return the index of the partition of the events with that context
+   */
+  uint32_t GetPartitionIndex (uint32_t context) const;
+  /**
+   * \return the partition of the calling thread
+   */
+  Partition & GetCurrentPartition (void) const;
+  /**
+   * Insert an event in a partition.
+   *
+   * \param [in] partition The partition.
+   * \param [in] ts The absolute timestamp.
+   * \param [in] context The event context.
+   * \param [in] event The event implementation.
+   * \return The event inserted.
+   */
+  Scheduler::Event Insert (Partition &partition, uint64_t ts, uint32_t context, EventImpl *event);
+  /**
+   * Process the next event of a partition.
+   *
+   * \param [in] index The index of the partition.
+   */
+  void ProcessOneEvent (uint32_t index);
+  /**
+   * Process the events of a partition whose timestamp is smaller
+   * than end.
+   *
+   * \param [in] index The index of the partition.
+   * \param [in] end The end of the window, excluded.
+   */
+  void ProcessWindow (uint32_t index, uint64_t end);
+  /**
+   * Process a window concurrently over all the partitions.
+   *
+   * \param [in] end The end of the window, excluded.
+   */
+  void RunWindow (uint64_t end);
+  /**
+   * Start one worker thread for each partition but the first one,
+   * which is processed by the main thread.
+   */
+  void StartWorkers (void);
+  /** Stop and join the worker threads. */
+  void StopWorkers (void);
+  /**
+   * Wait for the next window, or for the pool to stop.
+   *
+   * \param [in,out] window The last window processed by the caller.
+   * \param [out] end The end of the next window, excluded.
+   * \return false if the pool stops.
+   */
+  bool WaitWindow (uint64_t &window, uint64_t &end);
+  /** Notify the main thread that a worker is done with the window. */
+  void EndWindow (void);
+  /**
+   * Abort if an event of another partition is accessed while the
+   * partitions are running.
+   *
+   * \param [in] partition The partition of the event.
+   * \param [in] operation The name of the operation.
+   */
+  void CheckPartition (const Partition &partition, const char *operation) const;
+  /** Deliver the events scheduled across partitions and by other threads. */
+  void DeliverEvents (void);
+  /** Calculate the lookahead from the channel delays. */
+  void CalculateLookAhead (void);
+
+  /** Number of threads; zero means one per processor. */
+  uint32_t m_threadCount;
+  /** Lookahead set by the user; zero means it is calculated. */
+  Time m_userLookAhead;
+  /** Lookahead in time steps. */
+  uint64_t m_lookAhead;
+  /**
+   * The partitions; the last one holds the events without context,
+   * which are processed by the main thread.
+   */
+  std::vector<Partition> m_partitions;
+  /** True while Run () is processing windows concurrently. */
+  bool m_concurrent;
+  /** Number of windows processed by more than one thread. */
+  uint64_t m_parallelWindows;
+
+  /** The state of the worker threads. */
+  std::vector<Worker> m_workers;
+  /** The worker threads. */
+  std::vector<Ptr<SystemThread> > m_workerThreads;
+  /** Mutex protecting the state of the pool. */
+  pthread_mutex_t m_poolMutex;
+  /** Signaled when a window starts or the pool stops. */
+  pthread_cond_t m_windowStarted;
+  /** Signaled when the last worker is done with the window. */
+  pthread_cond_t m_windowDone;
+  /** Number of windows handed to the workers. */
+  uint64_t m_window;
+  /** End of the current window, excluded. */
+  uint64_t m_windowEnd;
+  /** Number of workers still processing the current window. */
+  uint32_t m_busyWorkers;
+  /** True when the workers are asked to exit. */
+  bool m_exitWorkers;
+
+  /** Events scheduled by threads which are not simulation threads. */
+  std::list<EventWithContext> m_eventsWithContext;
+  /** Mutex protecting m_eventsWithContext. */
+  SystemMutex m_eventsWithContextMutex;
+
+  /** Container type for the events to run at Simulator::Destroy() */
+  typedef std::list<EventId> DestroyEvents;
+  /** The container of events to run at Destroy. */
+  DestroyEvents m_destroyEvents;
+  /** Flag calling for the end of the simulation. */
+  bool m_stop;
+  /** Mutex protecting m_stop while partitions are running. */
+  SystemMutex m_stopMutex;
+
+  /** Main execution thread. */
+  SystemThread::ThreadId m_main;
+};
+
+} // namespace ns3
+
+#endif /* NS3_PARALLEL_SIMULATOR_IMPL_H */
@@ -0,0 +1,301 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/object-factory.h"
+#include "ns3/uinteger.h"
+#include "ns3/boolean.h"
+#include "ns3/nstime.h"
+#include "ns3/packet.h"
+#include "ns3/node.h"
+#include "ns3/simple-channel.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/parallel-simulator-impl.h"
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * Runs the same events, which exchange packets across nodes, with
+ * DefaultSimulatorImpl and with ParallelSimulatorImpl, and compares
+ * the events processed by every node.
+ */
+class ParallelSimulatorTraceTestCase : public TestCase
+{
+public:
+  /**
+   * \param threads the number of threads of ParallelSimulatorImpl
+   */
+  ParallelSimulatorTraceTestCase (uint32_t threads);
+
+private:
+  virtual void DoRun (void);
+
+  /** The timestamp and the value of an event, and the size of its packet. */
+  typedef std::pair<uint64_t, std::pair<uint32_t, uint32_t> > Record;
+  /** The events processed by a node. */
+  typedef std::vector<Record> Trace;
+
+  /**
+   * Schedule the first events and run the simulation.
+   *
+   * \param traces the traces to fill, one per node
+   */
+  void RunEvents (std::vector<Trace> &traces);
+  /**
+   * Record the event, and schedule an event for another node and,
+   * for some values, another event for this node.
+   *
+   * \param node the node of the event
+   * \param value the value of the event
+   * \param hops the number of events still to be chained
+   * \param packet the packet carried by the event
+   */
+  void Event (uint32_t node, uint32_t value, uint32_t hops, Ptr<Packet> packet);
+
+  uint32_t m_threads;              //!< the number of threads
+  std::vector<Trace> *m_traces;    //!< the traces being filled
+};
+
+/** The number of nodes. */
+static const uint32_t N_NODES = 8;
+/** The lookahead, in microseconds. */
+static const uint32_t LOOKAHEAD = 10;
+
+/**
+ * \param threads the number of threads
+ * \return the name of the test case
+ */
+static std::string
+GetTraceTestCaseName (uint32_t threads)
+{
+  std::ostringstream oss;
+  oss << "Check that the events of every node are those of DefaultSimulatorImpl with "
+      << threads << " threads";
+  return oss.str ();
+}
+
+ParallelSimulatorTraceTestCase::ParallelSimulatorTraceTestCase (uint32_t threads)
+  : TestCase (GetTraceTestCaseName (threads)),
+    m_threads (threads),
+    m_traces (0)
+{
+}
+
+void
+ParallelSimulatorTraceTestCase::Event (uint32_t node, uint32_t value, uint32_t hops, Ptr<Packet> packet)
+{
+  NS_ASSERT (Simulator::GetContext () == node);
+  // each node only accesses its own trace
+  (*m_traces)[node].push_back (std::make_pair (Simulator::Now ().GetTimeStep (),
+                                               std::make_pair (value, packet->GetSize ())));
+  if (hops == 0)
+    {
+      return;
+    }
+  // the copy shares the buffer of the packet, which the local event
+  // keeps using at the same time in another thread
+  Ptr<Packet> copy = packet->Copy ();
+  copy->AddPaddingAtEnd (value % 4);
+  uint32_t remote = (node * 7 + value) % N_NODES;
+  Simulator::ScheduleWithContext (remote, MicroSeconds (LOOKAHEAD + value % 5),
+                                  &ParallelSimulatorTraceTestCase::Event, this,
+                                  remote, value * 31 + node + 1, hops - 1, copy);
+  if (value % 2 == 0)
+    {
+      Simulator::Schedule (MicroSeconds (1 + value % 3),
+                           &ParallelSimulatorTraceTestCase::Event, this,
+                           node, value + 1, hops - 1, packet);
+    }
+}
+
+void
+ParallelSimulatorTraceTestCase::RunEvents (std::vector<Trace> &traces)
+{
+  traces.assign (N_NODES, Trace ());
+  m_traces = &traces;
+  for (uint32_t node = 0; node < N_NODES; ++node)
+    {
+      Simulator::ScheduleWithContext (node, MicroSeconds (node),
+                                      &ParallelSimulatorTraceTestCase::Event, this,
+                                      node, node, 12, Create<Packet> (100 + node));
+    }
+  Simulator::Run ();
+  m_traces = 0;
+  // the events of a node with the same timestamp may be processed in
+  // another order
+  for (uint32_t node = 0; node < N_NODES; ++node)
+    {
+      std::sort (traces[node].begin (), traces[node].end ());
+    }
+}
+
+void
+ParallelSimulatorTraceTestCase::DoRun (void)
+{
+  Simulator::Destroy ();
+  std::vector<Trace> expected;
+  RunEvents (expected);
+  Simulator::Destroy ();
+
+  ObjectFactory factory;
+  factory.SetTypeId ("ns3::ParallelSimulatorImpl");
+  factory.Set ("ThreadCount", UintegerValue (m_threads));
+  factory.Set ("LookAhead", TimeValue (MicroSeconds (LOOKAHEAD)));
+  Ptr<ParallelSimulatorImpl> impl = factory.Create<ParallelSimulatorImpl> ();
+  Simulator::SetImplementation (impl);
+  std::vector<Trace> traces;
+  RunEvents (traces);
+  NS_TEST_EXPECT_MSG_EQ (impl->GetLookAhead (), MicroSeconds (LOOKAHEAD), "Wrong lookahead");
+  if (m_threads > 1)
+    {
+      NS_TEST_EXPECT_MSG_GT (impl->GetParallelWindows (), 0, "No window processed concurrently");
+    }
+  Simulator::Destroy ();
+
+  uint32_t nEvents = 0;
+  for (uint32_t node = 0; node < N_NODES; ++node)
+    {
+      NS_TEST_ASSERT_MSG_EQ (traces[node].size (), expected[node].size (),
+                             "Wrong number of events for node " << node);
+      for (uint32_t i = 0; i < traces[node].size (); ++i)
+        {
+          NS_TEST_ASSERT_MSG_EQ (traces[node][i].first, expected[node][i].first,
+                                 "Wrong timestamp of event " << i << " of node " << node);
+          NS_TEST_ASSERT_MSG_EQ (traces[node][i].second.first, expected[node][i].second.first,
+                                 "Wrong value of event " << i << " of node " << node);
+          NS_TEST_ASSERT_MSG_EQ (traces[node][i].second.second, expected[node][i].second.second,
+                                 "Wrong packet size of event " << i << " of node " << node);
+        }
+      nEvents += traces[node].size ();
+    }
+  NS_TEST_EXPECT_MSG_GT (nEvents, 1000, "Too few events to exercise the windows");
+}
+
+/**
+ * Connects two nodes of different partitions by a SimpleChannel, in
+ * point-to-point mode or not, and checks that the partitions run
+ * concurrently only in point-to-point mode, even if the LookAhead
+ * attribute is set.
+ */
+class ParallelSimulatorChannelTestCase : public TestCase
+{
+public:
+  /**
+   * \param pointToPoint whether the devices are in point-to-point mode
+   */
+  ParallelSimulatorChannelTestCase (bool pointToPoint);
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Count an event of a node.
+   *
+   * \param node the index of the node
+   */
+  void Count (uint32_t node);
+
+  bool m_pointToPoint;             //!< whether the devices are in point-to-point mode
+  std::vector<uint32_t> m_events;  //!< the number of events of each node
+};
+
+ParallelSimulatorChannelTestCase::ParallelSimulatorChannelTestCase (bool pointToPoint)
+  : TestCase (pointToPoint ? "Check that a point-to-point channel may connect partitions"
+              : "Check that a shared channel connecting partitions makes them run sequentially"),
+    m_pointToPoint (pointToPoint)
+{
+}
+
+void
+ParallelSimulatorChannelTestCase::Count (uint32_t node)
+{
+  // each node only accesses its own counter
+  m_events[node]++;
+}
+
+void
+ParallelSimulatorChannelTestCase::DoRun (void)
+{
+  Simulator::Destroy ();
+  ObjectFactory factory;
+  factory.SetTypeId ("ns3::ParallelSimulatorImpl");
+  factory.Set ("ThreadCount", UintegerValue (2));
+  if (!m_pointToPoint)
+    {
+      // the lookahead set by the user must not make a shared channel
+      // run on several threads
+      factory.Set ("LookAhead", TimeValue (MicroSeconds (LOOKAHEAD)));
+    }
+  Ptr<ParallelSimulatorImpl> impl = factory.Create<ParallelSimulatorImpl> ();
+  Simulator::SetImplementation (impl);
+
+  Ptr<SimpleChannel> channel = CreateObject<SimpleChannel> ();
+  channel->SetAttribute ("Delay", TimeValue (MicroSeconds (LOOKAHEAD)));
+  m_events.assign (2, 0);
+  for (uint32_t i = 0; i < 2; ++i)
+    {
+      Ptr<Node> node = CreateObject<Node> ();
+      Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice> ();
+      device->SetAttribute ("PointToPointMode", BooleanValue (m_pointToPoint));
+      device->SetChannel (channel);
+      node->AddDevice (device);
+      for (uint32_t t = 0; t < 10; ++t)
+        {
+          Simulator::ScheduleWithContext (node->GetId (), MicroSeconds (t),
+                                          &ParallelSimulatorChannelTestCase::Count, this, i);
+        }
+    }
+  Simulator::Run ();
+
+  NS_TEST_EXPECT_MSG_EQ (m_events[0], 10, "Wrong number of events for the first node");
+  NS_TEST_EXPECT_MSG_EQ (m_events[1], 10, "Wrong number of events for the second node");
+  if (m_pointToPoint)
+    {
+      NS_TEST_EXPECT_MSG_EQ (impl->GetLookAhead (), MicroSeconds (LOOKAHEAD), "Wrong lookahead");
+      NS_TEST_EXPECT_MSG_GT (impl->GetParallelWindows (), 0, "No window processed concurrently");
+    }
+  else
+    {
+      NS_TEST_EXPECT_MSG_EQ (impl->GetLookAhead (), Seconds (0), "Shared channel accepted");
+      NS_TEST_EXPECT_MSG_EQ (impl->GetParallelWindows (), 0, "Shared channel used by several threads");
+    }
+  Simulator::Destroy ();
+}
+
+class ParallelSimulatorTestSuite : public TestSuite
+{
+public:
+  ParallelSimulatorTestSuite ();
+};
+
+ParallelSimulatorTestSuite::ParallelSimulatorTestSuite ()
+  : TestSuite ("parallel-simulator", UNIT)
+{
+  AddTestCase (new ParallelSimulatorTraceTestCase (1), TestCase::QUICK);
+  AddTestCase (new ParallelSimulatorTraceTestCase (2), TestCase::QUICK);
+  AddTestCase (new ParallelSimulatorTraceTestCase (4), TestCase::QUICK);
+  AddTestCase (new ParallelSimulatorChannelTestCase (true), TestCase::QUICK);
+  AddTestCase (new ParallelSimulatorChannelTestCase (false), TestCase::QUICK);
+}
+
+static ParallelSimulatorTestSuite parallelSimulatorTestSuite;
@@ -20,6 +20,18 @@
 #include "buffer.h"
 #include "ns3/assert.h"
 #include "ns3/log.h"
+#include "ns3/abort.h"
+#include "ns3/global-value.h"
+#include "ns3/boolean.h"
+#include "ns3/core-config.h"
+#include <algorithm>
+#include <cstdlib>
+#ifdef HAVE_PTHREAD_H
+#include <pthread.h>
+#endif /* HAVE_PTHREAD_H */
+#if defined (__linux__)
+#include <sys/mman.h>
+#endif
 
 #define LOG_INTERNAL_STATE(y)                                                                    \
   NS_LOG_LOGIC (y << "start="<<m_start<<", end="<<m_end<<", zero start="<<m_zeroAreaStart<<              \
@@ -52,46 +64,325 @@ NS_LOG_COMPONENT_DEFINE ("Buffer");
 
 uint32_t Buffer::g_recommendedStart = 0;
 #ifdef BUFFER_FREE_LIST
-/* The following macros are pretty evil but they are needed to allow us to
- * keep track of 3 possible states for the g_freeList variable:
- *  - uninitialized means that no one has created a buffer yet
- *    so no one has created the associated free list (it is created
- *    on-demand when the first buffer is created)
- *  - initialized means that the free list exists and is valid
- *  - destroyed means that the static destructors of this compilation unit
- *    have run so, the free list has been cleared from its content
- * The key is that in destroyed state, we are careful not re-create it
- * which is a typical weakness of lazy evaluation schemes which use 
- * '0' as a special value to indicate both un-initialized and destroyed.
- * Note that it is important to use '0' as the marker for un-initialized state
- * because the variable holding this state information is initialized to zero
- * which the compiler assigns to zero-memory which is initialized to _zero_
- * before the constructors run so this ensures perfect handling of crazy 
- * constructor orderings.
+/**
+ * \ingroup packet
+ * A global switch to back the slabs of the buffer data storages with
+ * transparent huge pages, where supported.
+ */
+static GlobalValue g_bufferHugePages = GlobalValue ("BufferHugePages",
+                                                    "A global switch to allocate the packet buffers from huge pages",
+                                                    BooleanValue (false),
+                                                    MakeBooleanChecker ());
+
+/**
+ * \ingroup packet
+ * Capacity of the buffer data storages of each size class, which
+ * fit respectively small control packets, typical IP packets,
+ * Ethernet frames and jumbo frames.
+ */
+static const uint32_t BUFFER_POOL_CLASS_SIZES[] = { 128, 512, 2048, 9216 };
+/** \ingroup packet Number of size classes; larger storages are not pooled. */
+static const uint32_t BUFFER_POOL_N_CLASSES = sizeof (BUFFER_POOL_CLASS_SIZES) / sizeof (BUFFER_POOL_CLASS_SIZES[0]);
+/** \ingroup packet Size of a slab. */
+static const uint32_t BUFFER_POOL_SLAB_SIZE = 64 * 1024;
+/** \ingroup packet Size of a slab backed by huge pages. */
+static const uint32_t BUFFER_POOL_HUGE_SLAB_SIZE = 2 * 1024 * 1024;
+/** \ingroup packet Alignment of the storages carved out of a slab. */
+static const uint32_t BUFFER_POOL_ALIGNMENT = 16;
+/**
+ * \ingroup packet
+ * Maximum number of free storages kept by a thread for each size
+ * class. A thread which releases the storages allocated by other
+ * threads moves the excess to the depot shared by all the threads.
+ */
+static const uint32_t BUFFER_POOL_MAX_CACHED = 1024;
+/** \ingroup packet Number of storages moved at once to or from the depot. */
+static const uint32_t BUFFER_POOL_BATCH = 256;
+
+/**
+ * \ingroup packet
+ * A free storage, linked to the next free storage of the same size class.
  */
-#define MAGIC_DESTROYED (~(long) 0)
-#define IS_UNINITIALIZED(x) (x == (Buffer::FreeList*)0)
-#define IS_DESTROYED(x) (x == (Buffer::FreeList*)MAGIC_DESTROYED)
-#define IS_INITIALIZED(x) (!IS_UNINITIALIZED (x) && !IS_DESTROYED (x))
-#define DESTROYED ((Buffer::FreeList*)MAGIC_DESTROYED)
-#define UNINITIALIZED ((Buffer::FreeList*)0)
-uint32_t Buffer::g_maxSize = 0;
-Buffer::FreeList *Buffer::g_freeList = 0;
-struct Buffer::LocalStaticDestructor Buffer::g_localStaticDestructor;
-
-Buffer::LocalStaticDestructor::~LocalStaticDestructor(void)
+struct BufferPoolBlock
 {
-  NS_LOG_FUNCTION (this);
-  if (IS_INITIALIZED (g_freeList))
+  BufferPoolBlock *next;  //!< The next free storage.
+};
+
+/**
+ * \ingroup packet
+ * The header of a slab. All the slabs are linked together, as they
+ * are never released: any thread can hold the storages they contain.
+ */
+struct BufferPoolSlab
+{
+  BufferPoolSlab *next;   //!< The slab allocated before this one.
+};
+
+/**
+ * \ingroup packet
+ * The pool of buffer data storages of a thread. This must remain a
+ * POD, as it is statically zero-initialized.
+ */
+struct BufferPool
+{
+  BufferPoolBlock *freeList[BUFFER_POOL_N_CLASSES];    //!< Free storages of each size class.
+  uint8_t *slabCurrent[BUFFER_POOL_N_CLASSES];         //!< Next storage to carve out of the slab of each class.
+  uint8_t *slabEnd[BUFFER_POOL_N_CLASSES];             //!< End of the slab of each class.
+  Buffer::PoolStats stats[BUFFER_POOL_N_CLASSES];      //!< Statistics of each size class.
+  bool registered;                                     //!< Whether the pool is moved to the depot at thread exit.
+};
+
+/** \ingroup packet All the slabs, most recent first. */
+static BufferPoolSlab * volatile g_bufferPoolSlabs = 0;
+
+#if defined (__GNUC__)
+/** \ingroup packet The pool of the calling thread. */
+static __thread BufferPool g_bufferPool;
+
+#ifdef HAVE_PTHREAD_H
+/**
+ * \ingroup packet
+ * The free storages shared by all the threads. This must remain a POD,
+ * as it is statically zero-initialized.
+ */
+struct BufferPoolDepot
+{
+  BufferPoolBlock *freeList[BUFFER_POOL_N_CLASSES];    //!< Free storages of each size class.
+};
+
+/** \ingroup packet The depot. */
+static BufferPoolDepot g_bufferPoolDepot;
+/** \ingroup packet Protects g_bufferPoolDepot. */
+static pthread_mutex_t g_bufferPoolDepotMutex = PTHREAD_MUTEX_INITIALIZER;
+/**
+ * \ingroup packet
+ * Key whose destructor moves the pool of an exiting thread to the depot.
+ */
+static pthread_key_t g_bufferPoolKey;
+/** \ingroup packet Creates g_bufferPoolKey once. */
+static pthread_once_t g_bufferPoolKeyOnce = PTHREAD_ONCE_INIT;
+
+/**
+ * \ingroup packet
+ * Move free storages of a size class from the pool of the calling
+ * thread to the depot.
+ * \param [in,out] pool The pool of the calling thread.
+ * \param [in] sizeClass The size class.
+ * \param [in] n The number of storages to move, at most the number
+ *            of free storages of the pool.
+ */
+static void
+SpillBufferPool (BufferPool *pool, uint32_t sizeClass, uint32_t n)
+{
+  if (n == 0)
+    {
+      return;
+    }
+  BufferPoolBlock *first = pool->freeList[sizeClass];
+  BufferPoolBlock *last = first;
+  for (uint32_t i = 1; i < n; i++)
+    {
+      last = last->next;
+    }
+  pool->freeList[sizeClass] = last->next;
+  pool->stats[sizeClass].cached -= n;
+  pthread_mutex_lock (&g_bufferPoolDepotMutex);
+  last->next = g_bufferPoolDepot.freeList[sizeClass];
+  g_bufferPoolDepot.freeList[sizeClass] = first;
+  pthread_mutex_unlock (&g_bufferPoolDepotMutex);
+}
+
+/**
+ * \ingroup packet
+ * Move at most BUFFER_POOL_BATCH free storages of a size class from
+ * the depot to the empty free list of the pool of the calling thread.
+ * \param [in,out] pool The pool of the calling thread.
+ * \param [in] sizeClass The size class.
+ */
+static void
+RefillBufferPool (BufferPool *pool, uint32_t sizeClass)
+{
+  NS_ASSERT (pool->freeList[sizeClass] == 0);
+  pthread_mutex_lock (&g_bufferPoolDepotMutex);
+  BufferPoolBlock *first = g_bufferPoolDepot.freeList[sizeClass];
+  if (first == 0)
+    {
+      pthread_mutex_unlock (&g_bufferPoolDepotMutex);
+      return;
+    }
+  BufferPoolBlock *last = first;
+  uint32_t n = 1;
+  while (n < BUFFER_POOL_BATCH && last->next != 0)
+    {
+      last = last->next;
+      n++;
+    }
+  g_bufferPoolDepot.freeList[sizeClass] = last->next;
+  pthread_mutex_unlock (&g_bufferPoolDepotMutex);
+  last->next = 0;
+  pool->freeList[sizeClass] = first;
+  pool->stats[sizeClass].cached += n;
+}
+
+/**
+ * \ingroup packet
+ * Move all the free storages of the pool of an exiting thread to
+ * the depot, where the other threads can reuse them.
+ * \param [in] p The pool of the exiting thread.
+ */
+static void
+ReleaseBufferPool (void *p)
+{
+  BufferPool *pool = static_cast<BufferPool *> (p);
+  for (uint32_t sizeClass = 0; sizeClass < BUFFER_POOL_N_CLASSES; sizeClass++)
     {
-      for (Buffer::FreeList::iterator i = g_freeList->begin ();
-           i != g_freeList->end (); i++)
+      SpillBufferPool (pool, sizeClass, pool->stats[sizeClass].cached);
+    }
+  // the storages released later by the thread, e.g., by other
+  // destructors, register the pool again
+  pool->registered = false;
+}
+
+/** \ingroup packet Create g_bufferPoolKey. */
+static void
+CreateBufferPoolKey (void)
+{
+  pthread_key_create (&g_bufferPoolKey, &ReleaseBufferPool);
+}
+#endif /* HAVE_PTHREAD_H */
+
+/**
+ * \ingroup packet
+ * \returns The pool of the calling thread.
+ */
+static inline BufferPool *
+GetBufferPool (void)
+{
+  BufferPool *pool = &g_bufferPool;
+#ifdef HAVE_PTHREAD_H
+  if (!pool->registered)
+    {
+      pool->registered = true;
+      pthread_once (&g_bufferPoolKeyOnce, &CreateBufferPoolKey);
+      pthread_setspecific (g_bufferPoolKey, pool);
+    }
+#endif /* HAVE_PTHREAD_H */
+  return pool;
+}
+
+/**
+ * \ingroup packet
+ * Record a new slab.
+ * \param [in] slab The slab.
+ */
+static void
+LinkBufferPoolSlab (BufferPoolSlab *slab)
+{
+  do
+    {
+      slab->next = g_bufferPoolSlabs;
+    }
+  while (!__sync_bool_compare_and_swap (&g_bufferPoolSlabs, slab->next, slab));
+}
+#else /* __GNUC__ */
+/**
+ * \ingroup packet
+ * Thread-local storage is not available: storages are not pooled.
+ * \returns 0
+ */
+static inline BufferPool *
+GetBufferPool (void)
+{
+  return 0;
+}
+
+/**
+ * \ingroup packet
+ * Record a new slab; never called, as storages are not pooled.
+ * \param [in] slab The slab.
+ */
+static void
+LinkBufferPoolSlab (BufferPoolSlab *slab)
+{
+  slab->next = g_bufferPoolSlabs;
+  g_bufferPoolSlabs = slab;
+}
+#endif /* __GNUC__ */
+
+/**
+ * \ingroup packet
+ * \param [in] size The capacity of a storage.
+ * \returns The index of the smallest size class holding that
+ *          capacity, or BUFFER_POOL_N_CLASSES if there is none.
+ */
+static inline uint32_t
+GetBufferPoolSizeClass (uint32_t size)
+{
+  uint32_t sizeClass = 0;
+  while (sizeClass < BUFFER_POOL_N_CLASSES && size > BUFFER_POOL_CLASS_SIZES[sizeClass])
+    {
+      sizeClass++;
+    }
+  return sizeClass;
+}
+
+/**
+ * \ingroup packet
+ * Allocate a new slab to carve the storages of a size class out of.
+ * \param [in,out] pool The pool of the calling thread.
+ * \param [in] sizeClass The size class.
+ * \param [in] blockSize The size of a storage, including its header.
+ */
+static void
+AllocateBufferPoolSlab (BufferPool *pool, uint32_t sizeClass, uint32_t blockSize)
+{
+  NS_LOG_FUNCTION (pool << sizeClass << blockSize);
+  BooleanValue hugePages;
+  g_bufferHugePages.GetValue (hugePages);
+  uint32_t slabSize = hugePages.Get () ? BUFFER_POOL_HUGE_SLAB_SIZE : BUFFER_POOL_SLAB_SIZE;
+  // hold a few storages of the largest classes
+  slabSize = std::max (slabSize, BUFFER_POOL_ALIGNMENT + 4 * blockSize);
+
+  uint8_t *slab = 0;
+#if defined (MADV_HUGEPAGE)
+  if (hugePages.Get ())
+    {
+      void *p;
+      slabSize = (slabSize + BUFFER_POOL_HUGE_SLAB_SIZE - 1) / BUFFER_POOL_HUGE_SLAB_SIZE * BUFFER_POOL_HUGE_SLAB_SIZE;
+      if (posix_memalign (&p, BUFFER_POOL_HUGE_SLAB_SIZE, slabSize) == 0)
         {
-          Buffer::Deallocate (*i);
+          // only a hint: the slab is usable if the kernel declines
+          madvise (p, slabSize, MADV_HUGEPAGE);
+          slab = static_cast<uint8_t *> (p);
         }
-      delete g_freeList;
-      g_freeList = DESTROYED;
     }
+#endif /* MADV_HUGEPAGE */
+  if (slab == 0)
+    {
+      slab = static_cast<uint8_t *> (std::malloc (slabSize));
+      NS_ABORT_MSG_IF (slab == 0, "Could not allocate a slab of " << slabSize << " bytes");
+    }
+  LinkBufferPoolSlab (reinterpret_cast<BufferPoolSlab *> (slab));
+
+  // the storages start after the slab header
+  pool->slabCurrent[sizeClass] = slab + BUFFER_POOL_ALIGNMENT;
+  pool->slabEnd[sizeClass] = slab + slabSize;
+  pool->stats[sizeClass].slabs++;
+}
+
+uint32_t
+Buffer::GetPoolSizeClasses (void)
+{
+  return (GetBufferPool () == 0) ? 0 : BUFFER_POOL_N_CLASSES;
+}
+
+Buffer::PoolStats
+Buffer::GetPoolStats (uint32_t sizeClass)
+{
+  NS_ASSERT (sizeClass < GetPoolSizeClasses ());
+  PoolStats stats = GetBufferPool ()->stats[sizeClass];
+  stats.size = BUFFER_POOL_CLASS_SIZES[sizeClass];
+  return stats;
 }
 
 void
@@ -99,50 +390,91 @@ Buffer::Recycle (struct Buffer::Data *data)
 {
   NS_LOG_FUNCTION (data);
   NS_ASSERT (data->m_count == 0);
-  NS_ASSERT (!IS_UNINITIALIZED (g_freeList));
-  g_maxSize = std::max (g_maxSize, data->m_size);
-  /* feed into free list */
-  if (data->m_size < g_maxSize ||
-      IS_DESTROYED (g_freeList) ||
-      g_freeList->size () > 1000)
+  BufferPool *pool = GetBufferPool ();
+  uint32_t sizeClass = GetBufferPoolSizeClass (data->m_size);
+  if (pool == 0 || sizeClass == BUFFER_POOL_N_CLASSES)
     {
       Buffer::Deallocate (data);
+      return;
     }
-  else
+  // pooled storages have exactly the capacity of their class
+  NS_ASSERT (data->m_size == BUFFER_POOL_CLASS_SIZES[sizeClass]);
+  BufferPoolBlock *block = reinterpret_cast<BufferPoolBlock *> (data);
+  block->next = pool->freeList[sizeClass];
+  pool->freeList[sizeClass] = block;
+  pool->stats[sizeClass].frees++;
+  pool->stats[sizeClass].cached++;
+#ifdef HAVE_PTHREAD_H
+  if (pool->stats[sizeClass].cached > BUFFER_POOL_MAX_CACHED)
     {
-      NS_ASSERT (IS_INITIALIZED (g_freeList));
-      g_freeList->push_back (data);
+      SpillBufferPool (pool, sizeClass, BUFFER_POOL_BATCH);
     }
+#endif /* HAVE_PTHREAD_H */
 }
 
 Buffer::Data *
 Buffer::Create (uint32_t dataSize)
 {
   NS_LOG_FUNCTION (dataSize);
-  /* try to find a buffer correctly sized. */
-  if (IS_UNINITIALIZED (g_freeList))
+  // leave room for the headers which are usually added in front
+  uint32_t size = std::max (dataSize, g_recommendedStart);
+  BufferPool *pool = GetBufferPool ();
+  uint32_t sizeClass = GetBufferPoolSizeClass (size);
+  if (pool == 0 || sizeClass == BUFFER_POOL_N_CLASSES)
     {
-      g_freeList = new Buffer::FreeList ();
+      return Buffer::Allocate (size);
     }
-  else if (IS_INITIALIZED (g_freeList))
+
+  PoolStats &stats = pool->stats[sizeClass];
+  stats.allocations++;
+  uint8_t *b;
+#ifdef HAVE_PTHREAD_H
+  if (pool->freeList[sizeClass] == 0)
     {
-      while (!g_freeList->empty ()) 
+      // reuse the storages released by other threads before carving
+      // new ones
+      RefillBufferPool (pool, sizeClass);
+    }
+#endif /* HAVE_PTHREAD_H */
+  BufferPoolBlock *block = pool->freeList[sizeClass];
+  if (block != 0)
+    {
+      pool->freeList[sizeClass] = block->next;
+      stats.poolHits++;
+      stats.cached--;
+      b = reinterpret_cast<uint8_t *> (block);
+    }
+  else
+    {
+      uint32_t blockSize = sizeof (struct Buffer::Data) - 1 + BUFFER_POOL_CLASS_SIZES[sizeClass];
+      blockSize = (blockSize + BUFFER_POOL_ALIGNMENT - 1) / BUFFER_POOL_ALIGNMENT * BUFFER_POOL_ALIGNMENT;
+      if (static_cast<uint32_t> (pool->slabEnd[sizeClass] - pool->slabCurrent[sizeClass]) < blockSize)
         {
-          struct Buffer::Data *data = g_freeList->back ();
-          g_freeList->pop_back ();
-          if (data->m_size >= dataSize) 
-            {
-              data->m_count = 1;
-              return data;
-            }
-          Buffer::Deallocate (data);
+          AllocateBufferPoolSlab (pool, sizeClass, blockSize);
         }
+      b = pool->slabCurrent[sizeClass];
+      pool->slabCurrent[sizeClass] += blockSize;
     }
-  struct Buffer::Data *data = Buffer::Allocate (dataSize);
-  NS_ASSERT (data->m_count == 1);
+  struct Buffer::Data *data = reinterpret_cast<struct Buffer::Data *> (b);
+  data->m_size = BUFFER_POOL_CLASS_SIZES[sizeClass];
+  data->m_count = 1;
   return data;
 }
 #else /* BUFFER_FREE_LIST */
+uint32_t
+Buffer::GetPoolSizeClasses (void)
+{
+  return 0;
+}
+
+Buffer::PoolStats
+Buffer::GetPoolStats (uint32_t sizeClass)
+{
+  NS_ASSERT_MSG (false, "Buffer data storages are not pooled");
+  PoolStats stats = { 0, 0, 0, 0, 0, 0 };
+  return stats;
+}
+
 void
 Buffer::Recycle (struct Buffer::Data *data)
 {
@@ -262,15 +594,14 @@ Buffer::operator = (Buffer const&o)
   if (m_data != o.m_data) 
     {
       // not assignment to self.
-      m_data->m_count--;
-      if (m_data->m_count == 0) 
+      if (AtomicRefCount::Decrement (m_data->m_count))
         {
           Recycle (m_data);
         }
       m_data = o.m_data;
-      m_data->m_count++;
+      AtomicRefCount::Increment (m_data->m_count);
     }
-  g_recommendedStart = std::max (g_recommendedStart, m_maxZeroAreaStart);
+  UpdateRecommendedStart ();
   m_maxZeroAreaStart = o.m_maxZeroAreaStart;
   m_zeroAreaStart = o.m_zeroAreaStart;
   m_zeroAreaEnd = o.m_zeroAreaEnd;
@@ -280,13 +611,24 @@ Buffer::operator = (Buffer const&o)
   return *this;
 }
 
+void
+Buffer::UpdateRecommendedStart (void) const
+{
+  // the recommended start is shared by all the threads, so it is left
+  // unchanged while the reference counts are atomic, i.e., while
+  // several threads may use buffers
+  if (!AtomicRefCount::IsEnabled ())
+    {
+      g_recommendedStart = std::max (g_recommendedStart, m_maxZeroAreaStart);
+    }
+}
+
 Buffer::~Buffer ()
 {
   NS_LOG_FUNCTION (this);
   NS_ASSERT (CheckInternalState ());
-  g_recommendedStart = std::max (g_recommendedStart, m_maxZeroAreaStart);
-  m_data->m_count--;
-  if (m_data->m_count == 0) 
+  UpdateRecommendedStart ();
+  if (AtomicRefCount::Decrement (m_data->m_count))
     {
       Recycle (m_data);
     }
@@ -310,7 +652,10 @@ Buffer::AddAtStart (uint32_t start)
 {
   NS_LOG_FUNCTION (this << start);
   NS_ASSERT (CheckInternalState ());
-  bool isDirty = m_data->m_count > 1 && m_start > m_data->m_dirtyStart;
+  // with atomic reference counts, another thread may extend the dirty
+  // area of shared data at the same time
+  bool isDirty = m_data->m_count > 1
+    && (AtomicRefCount::IsEnabled () || m_start > m_data->m_dirtyStart);
   if (m_start >= start && !isDirty)
     {
       /* enough space in the buffer and not dirty. 
@@ -328,8 +673,7 @@ Buffer::AddAtStart (uint32_t start)
       uint32_t newSize = GetInternalSize () + start;
       struct Buffer::Data *newData = Buffer::Create (newSize);
       memcpy (newData->m_data + start, m_data->m_data + m_start, GetInternalSize ());
-      m_data->m_count--;
-      if (m_data->m_count == 0)
+      if (AtomicRefCount::Decrement (m_data->m_count))
         {
           Buffer::Recycle (m_data);
         }
@@ -355,7 +699,8 @@ Buffer::AddAtEnd (uint32_t end)
 {
   NS_LOG_FUNCTION (this << end);
   NS_ASSERT (CheckInternalState ());
-  bool isDirty = m_data->m_count > 1 && m_end < m_data->m_dirtyEnd;
+  bool isDirty = m_data->m_count > 1
+    && (AtomicRefCount::IsEnabled () || m_end < m_data->m_dirtyEnd);
   if (GetInternalEnd () + end <= m_data->m_size && !isDirty)
     {
       /* enough space in buffer and not dirty
@@ -373,8 +718,7 @@ Buffer::AddAtEnd (uint32_t end)
       uint32_t newSize = GetInternalSize () + end;
       struct Buffer::Data *newData = Buffer::Create (newSize);
       memcpy (newData->m_data, m_data->m_data + m_start, GetInternalSize ());
-      m_data->m_count--;
-      if (m_data->m_count == 0) 
+      if (AtomicRefCount::Decrement (m_data->m_count))
         {
           Buffer::Recycle (m_data);
         }
@@ -24,6 +24,7 @@
 #include <vector>
 #include <ostream>
 #include "ns3/assert.h"
+#include "ns3/simple-ref-count.h"
 
 #define BUFFER_FREE_LIST 1
 
@@ -88,6 +89,15 @@ namespace ns3 {
  * \endverbatim
  *
  * A simple state invariant is that m_start <= m_zeroStart <= m_zeroEnd <= m_end
+ *
+ * The BufferData instances are allocated by size class (see
+ * GetPoolStats): each thread keeps a bounded free list of the
+ * instances of each class it released, and carves new instances out
+ * of large slabs, which can be backed by huge pages with the
+ * BufferHugePages global value. The instances in excess, and those
+ * of exiting threads, go to a depot shared by all the threads, which
+ * is drained before new instances are carved. Larger instances are
+ * allocated from the heap.
  */
 class Buffer 
 {
@@ -636,6 +646,37 @@ private:
    */
   Buffer (uint32_t dataSize, bool initialize);
   ~Buffer ();
+
+  /**
+   * \brief Statistics of the buffer data storages of a size class
+   *
+   * The counters are kept per thread, see GetPoolStats.
+   */
+  struct PoolStats
+  {
+    uint32_t size;         //!< The capacity of the storages of the size class.
+    uint64_t allocations;  //!< Number of storages handed out.
+    uint64_t poolHits;     //!< Number of storages reused from the free list.
+    uint64_t frees;        //!< Number of storages given back.
+    uint64_t slabs;        //!< Number of slabs carved into storages.
+    uint64_t cached;       //!< Number of storages in the free list.
+  };
+
+  /**
+   * \brief Get the number of size classes of the buffer data storages
+   * \returns the number of size classes, zero if the storages are
+   *          not pooled
+   */
+  static uint32_t GetPoolSizeClasses (void);
+  /**
+   * \brief Get the statistics of the buffer data storages of a size
+   * class for the calling thread
+   * \param sizeClass the index of the size class, smaller than
+   *        GetPoolSizeClasses ()
+   * \returns the statistics
+   */
+  static PoolStats GetPoolStats (uint32_t sizeClass);
+
 private:
   /**
    * This data structure is variable-sized through its last member whose size
@@ -762,6 +803,11 @@ private:
    * value.
    */
   static uint32_t g_recommendedStart;
+  /**
+   * Raise g_recommendedStart to the largest zero area start of this
+   * buffer.
+   */
+  void UpdateRecommendedStart (void) const;
 
   /**
    * offset to the start of the virtual zero area from the start
@@ -783,19 +829,6 @@ private:
    * instance from the start of m_data->m_data
    */
   uint32_t m_end;
-
-#ifdef BUFFER_FREE_LIST
-  /// Container for buffer data
-  typedef std::vector<struct Buffer::Data*> FreeList;
-  /// Local static destructor structure
-  struct LocalStaticDestructor 
-  {
-    ~LocalStaticDestructor ();
-  };
-  static uint32_t g_maxSize; //!< Max observed data size
-  static FreeList *g_freeList; //!< Buffer data container
-  static struct LocalStaticDestructor g_localStaticDestructor; //!< Local static destructor
-#endif
 };
 
 } // namespace ns3
@@ -1049,7 +1082,7 @@ Buffer::Buffer (Buffer const&o)
     m_start (o.m_start),
     m_end (o.m_end)
 {
-  m_data->m_count++;
+  AtomicRefCount::Increment (m_data->m_count);
   NS_ASSERT (CheckInternalState ());
 }
 
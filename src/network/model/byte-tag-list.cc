@@ -19,6 +19,7 @@
  */
 #include "byte-tag-list.h"
 #include "ns3/log.h"
+#include "ns3/simple-ref-count.h"
 #include <vector>
 #include <cstring>
 
@@ -156,7 +157,7 @@ ByteTagList::ByteTagList (const ByteTagList &o)
   NS_LOG_FUNCTION (this << &o);
   if (m_data != 0)
     {
-      m_data->count++;
+      AtomicRefCount::Increment (m_data->count);
     }
 }
 ByteTagList &
@@ -175,7 +176,7 @@ ByteTagList::operator = (const ByteTagList &o)
   m_used = o.m_used;
   if (m_data != 0)
     {
-      m_data->count++;
+      AtomicRefCount::Increment (m_data->count);
     }
   return *this;
 }
@@ -199,7 +200,10 @@ ByteTagList::Add (TypeId tid, uint32_t bufferSize, int32_t start, int32_t end)
       m_used = 0;
     } 
   else if (m_data->size < spaceNeeded ||
-           (m_data->count != 1 && m_data->dirty != m_used))
+           (m_data->count != 1 &&
+            // with atomic reference counts, another thread may append
+            // to shared data at the same time
+            (AtomicRefCount::IsEnabled () || m_data->dirty != m_used)))
     {
       struct ByteTagListData *newData = Allocate (spaceNeeded);
       std::memcpy (&newData->data, &m_data->data, m_used);
@@ -344,7 +348,8 @@ struct ByteTagListData *
 ByteTagList::Allocate (uint32_t size)
 {
   NS_LOG_FUNCTION (this << size);
-  while (!g_freeList.empty ())
+  // the free list is shared by all the threads
+  while (!AtomicRefCount::IsEnabled () && !g_freeList.empty ())
     {
       struct ByteTagListData *data = g_freeList.back ();
       g_freeList.pop_back ();
@@ -374,6 +379,16 @@ ByteTagList::Deallocate (struct ByteTagListData *data)
     {
       return;
     }
+  if (AtomicRefCount::IsEnabled ())
+    {
+      // the free list is shared by all the threads
+      if (AtomicRefCount::Decrement (data->count))
+        {
+          uint8_t *buffer = (uint8_t *)data;
+          delete [] buffer;
+        }
+      return;
+    }
   g_maxSize = std::max (g_maxSize, data->size);
   data->count--;
   if (data->count == 0)
@@ -413,8 +428,7 @@ ByteTagList::Deallocate (struct ByteTagListData *data)
     {
       return;
     }
-  data->count--;
-  if (data->count == 0)
+  if (AtomicRefCount::Decrement (data->count))
     {
       uint8_t *buffer = (uint8_t *)data;
       delete [] buffer;
@@ -77,8 +77,7 @@ PacketMetadata::ReserveCopy (uint32_t size)
   struct PacketMetadata::Data *newData = PacketMetadata::Create (m_used + size);
   memcpy (newData->m_data, m_data->m_data, m_used);
   newData->m_dirtyEnd = m_used;
-  m_data->m_count--;
-  if (m_data->m_count == 0) 
+  if (AtomicRefCount::Decrement (m_data->m_count))
     {
       PacketMetadata::Recycle (m_data);
     }
@@ -100,10 +99,13 @@ PacketMetadata::Reserve (uint32_t size)
 {
   NS_LOG_FUNCTION (this << size);
   NS_ASSERT (m_data != 0);
+  // with atomic reference counts, another thread may append to shared
+  // data at the same time
   if (m_data->m_size >= m_used + size &&
-      (m_head == 0xffff ||
-       m_data->m_count == 1 ||
-       m_data->m_dirtyEnd == m_used))
+      (m_data->m_count == 1 ||
+       (!AtomicRefCount::IsEnabled () &&
+        (m_head == 0xffff ||
+         m_data->m_dirtyEnd == m_used))))
     {
       /* enough room, not dirty. */
     }
@@ -381,9 +383,10 @@ PacketMetadata::AddSmall (const struct PacketMetadata::SmallItem *item)
   uint32_t sizeSize = GetUleb128Size (item->size);
   uint32_t n =  2 + 2 + typeUidSize + sizeSize + 2;
   if (m_used + n > m_data->m_size ||
-      (m_head != 0xffff &&
-       m_data->m_count != 1 &&
-       m_used != m_data->m_dirtyEnd))
+      (m_data->m_count != 1 &&
+       (AtomicRefCount::IsEnabled () ||
+        (m_head != 0xffff &&
+         m_used != m_data->m_dirtyEnd))))
     {
       ReserveCopy (n);
     }
@@ -419,9 +422,10 @@ PacketMetadata::AddBig (uint32_t next, uint32_t prev,
   uint32_t n = 2 + 2 + typeUidSize + sizeSize + 2 + fragStartSize + fragEndSize + 4;
 
   if (m_used + n > m_data->m_size ||
-      (m_head != 0xffff &&
-       m_data->m_count != 1 &&
-       m_used != m_data->m_dirtyEnd))
+      (m_data->m_count != 1 &&
+       (AtomicRefCount::IsEnabled () ||
+        (m_head != 0xffff &&
+         m_used != m_data->m_dirtyEnd))))
     {
       ReserveCopy (n);
     }
@@ -572,6 +576,11 @@ PacketMetadata::Create (uint32_t size)
 {
   NS_LOG_FUNCTION (size);
   NS_LOG_LOGIC ("create size="<<size<<", max="<<m_maxSize);
+  if (AtomicRefCount::IsEnabled ())
+    {
+      // the free list is shared by all the threads
+      return PacketMetadata::Allocate (size);
+    }
   if (size > m_maxSize)
     {
       m_maxSize = size;
@@ -597,7 +606,7 @@ void
 PacketMetadata::Recycle (struct PacketMetadata::Data *data)
 {
   NS_LOG_FUNCTION (data);
-  if (!m_enable)
+  if (!m_enable || AtomicRefCount::IsEnabled ())
     {
       PacketMetadata::Deallocate (data);
       return;
@@ -28,12 +28,160 @@
 #include "tag.h"
 #include "ns3/fatal-error.h"
 #include "ns3/log.h"
+#include "ns3/core-config.h"
 #include <cstring>
+#ifdef HAVE_PTHREAD_H
+#include <pthread.h>
+#endif /* HAVE_PTHREAD_H */
+
+#define FREE_LIST_SIZE 1000
 
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("PacketTagList");
 
+/**
+ * \ingroup packet
+ *
+ * \brief The unused struct PacketTagList::TagData of a thread, linked
+ * through their \c next member.
+ *
+ * Each thread keeps at most FREE_LIST_SIZE of them, as the TagData
+ * are released by whichever thread drops the last reference to a
+ * packet. This must remain a POD, as it is statically zero-initialized.
+ *
+ * Internal use only.
+ */
+struct PacketTagListDataFreeList
+{
+  struct PacketTagList::TagData *head;  //!< The first unused TagData.
+  uint32_t size;                        //!< Number of unused TagData.
+  bool registered;                      //!< Whether the list is freed at thread exit.
+};
+
+#if defined (__GNUC__)
+/** \ingroup packet The free list of the calling thread. */
+static __thread PacketTagListDataFreeList g_freeList;
+
+#ifdef HAVE_PTHREAD_H
+/**
+ * \ingroup packet
+ * Key whose destructor frees the free list of an exiting thread.
+ */
+static pthread_key_t g_freeListKey;
+/** \ingroup packet Creates g_freeListKey once. */
+static pthread_once_t g_freeListKeyOnce = PTHREAD_ONCE_INIT;
+
+/**
+ * \ingroup packet
+ * Delete the unused TagData of an exiting thread.
+ * \param [in] p The free list of the exiting thread.
+ */
+static void
+ReleaseFreeList (void *p)
+{
+  PacketTagListDataFreeList *freeList = static_cast<PacketTagListDataFreeList *> (p);
+  while (freeList->head != 0)
+    {
+      struct PacketTagList::TagData *next = freeList->head->next;
+      delete freeList->head;
+      freeList->head = next;
+    }
+  freeList->size = 0;
+  // the TagData released later by the thread register the list again
+  freeList->registered = false;
+}
+
+/** \ingroup packet Create g_freeListKey. */
+static void
+CreateFreeListKey (void)
+{
+  pthread_key_create (&g_freeListKey, &ReleaseFreeList);
+}
+#endif /* HAVE_PTHREAD_H */
+
+/**
+ * \ingroup packet
+ * \returns The free list of the calling thread.
+ */
+static inline PacketTagListDataFreeList *
+GetFreeList (void)
+{
+  PacketTagListDataFreeList *freeList = &g_freeList;
+#ifdef HAVE_PTHREAD_H
+  if (!freeList->registered)
+    {
+      freeList->registered = true;
+      pthread_once (&g_freeListKeyOnce, &CreateFreeListKey);
+      pthread_setspecific (g_freeListKey, freeList);
+    }
+#endif /* HAVE_PTHREAD_H */
+  return freeList;
+}
+#else /* __GNUC__ */
+/**
+ * \ingroup packet
+ * Thread-local storage is not available: TagData are not pooled.
+ * \returns 0
+ */
+static inline PacketTagListDataFreeList *
+GetFreeList (void)
+{
+  return 0;
+}
+#endif /* __GNUC__ */
+
+struct PacketTagList::TagData *
+PacketTagList::Allocate (void)
+{
+  struct TagData * data;
+  PacketTagListDataFreeList *freeList = GetFreeList ();
+  if (freeList != 0 && freeList->head != 0)
+    {
+      data = freeList->head;
+      freeList->head = data->next;
+      freeList->size--;
+    }
+  else
+    {
+      data = new struct TagData ();
+    }
+  data->count = 1;
+  data->next = 0;
+  return data;
+}
+
+void
+PacketTagList::Deallocate (struct TagData * data)
+{
+  PacketTagListDataFreeList *freeList = GetFreeList ();
+  if (freeList != 0 && freeList->size < FREE_LIST_SIZE)
+    {
+      data->next = freeList->head;
+      freeList->head = data;
+      freeList->size++;
+    }
+  else
+    {
+      delete data;
+    }
+}
+
+void
+PacketTagList::Unmerge (struct TagData * cur)
+{
+  if (AtomicRefCount::Decrement (cur->count))
+    {
+      // the other lists released cur in the meantime, so release its
+      // reference to the next node too
+      if (cur->next != 0)
+        {
+          AtomicRefCount::Decrement (cur->next->count);
+        }
+      Deallocate (cur);
+    }
+}
+
 bool
 PacketTagList::COWTraverse (Tag & tag, PacketTagList::COWWriter Writer)
 {
@@ -101,9 +249,10 @@ PacketTagList::COWTraverse (Tag & tag, PacketTagList::COWWriter Writer)
       return found;
     }
 
-  // At this point cur is a merge, but untested for tid
+  // At this point cur is a merge, but untested for tid; with atomic
+  // reference counts, the other lists may release it at any time
   NS_ASSERT (cur != 0);
-  NS_ASSERT (cur->count > 1);
+  NS_ASSERT (cur->count > 1 || AtomicRefCount::IsEnabled ());
 
   /*
      Walk the remainder of the list, copying, until we find tid
@@ -131,22 +280,21 @@ PacketTagList::COWTraverse (Tag & tag, PacketTagList::COWWriter Writer)
   while ( /* cur && */ cur->tid != tid)
     {
       NS_ASSERT (cur != 0);
-      NS_ASSERT (cur->count > 1);
-      cur->count--;                       // unmerge cur
-      struct TagData * copy = new struct TagData ();
+      NS_ASSERT (cur->count > 1 || AtomicRefCount::IsEnabled ());
+      struct TagData * copy = Allocate ();
       copy->tid = cur->tid;
-      copy->count = 1;
       memcpy (copy->data, cur->data, TagData::MAX_SIZE);
       copy->next = cur->next;             // merge into tail
-      copy->next->count++;                // mark new merge
+      AtomicRefCount::Increment (copy->next->count); // mark new merge
       *prevNext = copy;                   // point prior list at copy
       prevNext = &copy->next;             // advance
+      Unmerge (cur);                      // unmerge cur
       cur      =  copy->next;
     }
   // Sanity check:
   NS_ASSERT (cur != 0);                 // cur should be non-zero
   NS_ASSERT (cur->tid == tid);          // cur->tid should be tid
-  NS_ASSERT (cur->count > 1);           // cur should be a merge
+  NS_ASSERT (cur->count > 1 || AtomicRefCount::IsEnabled ()); // cur should be a merge
 
   // link around tid, removing it from our list
   found = (this->*Writer)(tag, false, cur, prevNext);
@@ -177,18 +325,18 @@ PacketTagList::RemoveWriter (Tag & tag, bool preMerge,
   if (preMerge)
     {
       // found tid before first merge, so delete cur
-      delete cur;
+      Deallocate (cur);
     }
   else
     {
       // cur is always a merge at this point
-      // unmerge cur, since we linked around it already
-      cur->count--;
       if (cur->next != 0)
         {
           // there's a next, so make it a merge
-          cur->next->count++;
+          AtomicRefCount::Increment (cur->next->count);
         }
+      // unmerge cur, since we linked around it already
+      Unmerge (cur);
     }
   return found;
 }
@@ -224,18 +372,17 @@ PacketTagList::ReplaceWriter (Tag & tag, bool preMerge,
     {
       // cur is always a merge at this point
       // need to copy, replace, and link past cur
-      cur->count--;                     // unmerge cur
-      struct TagData * copy = new struct TagData ();
+      struct TagData * copy = Allocate ();
       copy->tid = tag.GetInstanceTypeId ();
-      copy->count = 1;
       tag.Serialize (TagBuffer (copy->data,
                                 copy->data + tag.GetSerializedSize ()));
       copy->next = cur->next;           // merge into tail
       if (copy->next != 0)
         {
-          copy->next->count++;          // mark new merge
+          AtomicRefCount::Increment (copy->next->count); // mark new merge
         }
       *prevNext = copy;                 // point prior list at copy
+      Unmerge (cur);                    // unmerge cur
     }
   return found;
 }
@@ -243,16 +390,15 @@ PacketTagList::ReplaceWriter (Tag & tag, bool preMerge,
 void 
 PacketTagList::Add (const Tag &tag) const
 {
-  NS_LOG_FUNCTION (this << tag.GetInstanceTypeId ());
+  TypeId tid = tag.GetInstanceTypeId ();
+  NS_LOG_FUNCTION (this << tid);
   // ensure this id was not yet added
   for (struct TagData *cur = m_next; cur != 0; cur = cur->next) 
     {
-      NS_ASSERT_MSG (cur->tid != tag.GetInstanceTypeId (), "Error: cannot add the same kind of tag twice.");
+      NS_ASSERT_MSG (cur->tid != tid, "Error: cannot add the same kind of tag twice.");
     }
-  struct TagData * head = new struct TagData ();
-  head->count = 1;
-  head->next = 0;
-  head->tid = tag.GetInstanceTypeId ();
+  struct TagData * head = Allocate ();
+  head->tid = tid;
   head->next = m_next;
   NS_ASSERT (tag.GetSerializedSize () <= TagData::MAX_SIZE);
   tag.Serialize (TagBuffer (head->data, head->data + tag.GetSerializedSize ()));
@@ -263,8 +409,8 @@ PacketTagList::Add (const Tag &tag) const
 bool
 PacketTagList::Peek (Tag &tag) const
 {
-  NS_LOG_FUNCTION (this << tag.GetInstanceTypeId ());
   TypeId tid = tag.GetInstanceTypeId ();
+  NS_LOG_FUNCTION (this << tid);
   for (struct TagData *cur = m_next; cur != 0; cur = cur->next) 
     {
       if (cur->tid == tid) 
@@ -28,6 +28,7 @@
 #include <stdint.h>
 #include <ostream>
 #include "ns3/type-id.h"
+#include "ns3/simple-ref-count.h"
 
 namespace ns3 {
 
@@ -124,6 +125,11 @@ class Tag;
  * \n
  * Packet tags must serialize to a finite maximum size, see TagData
  *
+ * TagData structures are all of the same size, so the ones released are
+ * kept in a free list and reused by the next #Add, #Remove or #Replace,
+ * rather than being returned to the heap and allocated again for each
+ * packet.
+ *
  * This documentation entitles the original author to a free beer.
  */
 class PacketTagList 
@@ -287,6 +293,28 @@ private:
    */
   bool ReplaceWriter (Tag & tag, bool preMerge, struct TagData * cur, struct TagData ** prevNext);
 
+  /**
+   * Get a TagData from the free list of the calling thread, or from the
+   * heap if the free list is empty.
+   *
+   * \returns a TagData with a \c count of 1
+   */
+  static struct TagData * Allocate (void);
+  /**
+   * Return a TagData to the free list of the calling thread, or to the
+   * heap if the free list is full.
+   *
+   * \param [in] data The TagData, which is no longer referenced.
+   */
+  static void Deallocate (struct TagData * data);
+  /**
+   * Release the reference of this list to a merge, once the list
+   * holds its own reference to the next node of the merge.
+   *
+   * \param [in] cur The merge.
+   */
+  static void Unmerge (struct TagData * cur);
+
   /**
    * Pointer to first \ref TagData on the list
    */
@@ -311,7 +339,7 @@ PacketTagList::PacketTagList (PacketTagList const &o)
 {
   if (m_next != 0)
     {
-      m_next->count++;
+      AtomicRefCount::Increment (m_next->count);
     }
 }
 
@@ -327,7 +355,7 @@ PacketTagList::operator = (PacketTagList const &o)
   m_next = o.m_next;
   if (m_next != 0) 
     {
-      m_next->count++;
+      AtomicRefCount::Increment (m_next->count);
     }
   return *this;
 }
@@ -343,20 +371,19 @@ PacketTagList::RemoveAll (void)
   struct TagData *prev = 0;
   for (struct TagData *cur = m_next; cur != 0; cur = cur->next)
     {
-      cur->count--;
-      if (cur->count > 0) 
+      if (!AtomicRefCount::Decrement (cur->count))
         {
           break;
         }
       if (prev != 0) 
         {
-	  delete prev;
+	  Deallocate (prev);
         }
       prev = cur;
     }
   if (prev != 0) 
     {
-      delete prev;
+      Deallocate (prev);
     }
   m_next = 0;
 }
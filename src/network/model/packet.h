@@ -727,6 +727,11 @@ private:
   /* Please see comments above about nix-vector */
   Ptr<NixVector> m_nixVector; //!< the packet's Nix vector
 
+  /**
+   * \return a new packet Uid
+   */
+  static uint32_t AllocateUid (void);
+
   static uint32_t m_globalUid; //!< Global counter of packets Uid
 };
 
@@ -23,6 +23,9 @@
 #include "ns3/double.h"
 #include "ns3/test.h"
 
+#include <algorithm>
+#include <vector>
+
 using namespace ns3;
 
 //-----------------------------------------------------------------------------
@@ -361,6 +364,81 @@ BufferTest::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ (val1, val2, "Bad ReadNtohU16()");
 }
 //-----------------------------------------------------------------------------
+class BufferPoolTest : public TestCase {
+public:
+  virtual void DoRun (void);
+  BufferPoolTest ();
+};
+
+BufferPoolTest::BufferPoolTest ()
+  : TestCase ("Buffer data storages are reused") {
+}
+
+void
+BufferPoolTest::DoRun (void)
+{
+  if (Buffer::GetPoolSizeClasses () == 0)
+    {
+      return;
+    }
+  uint32_t sizeClass = Buffer::GetPoolSizeClasses () - 1;
+  Buffer::PoolStats before = Buffer::GetPoolStats (sizeClass);
+  NS_TEST_ASSERT_MSG_GT (before.size, 5000, "The largest size class should hold 5000 bytes");
+  for (uint32_t i = 0; i < 10; i++)
+    {
+      // the data storage is reallocated from the largest class
+      Buffer buffer;
+      buffer.AddAtStart (5000);
+      Buffer::Iterator it = buffer.Begin ();
+      it.WriteU8 (0x42, 5000);
+      NS_TEST_EXPECT_MSG_EQ (buffer.PeekData ()[4999], 0x42, "Bad data in a pooled buffer");
+    }
+  Buffer::PoolStats after = Buffer::GetPoolStats (sizeClass);
+  NS_TEST_EXPECT_MSG_EQ (after.allocations - before.allocations, 10, "Bad number of allocations");
+  NS_TEST_EXPECT_MSG_EQ (after.frees - before.frees, 10, "Bad number of frees");
+  NS_TEST_EXPECT_MSG_GT_OR_EQ (after.poolHits - before.poolHits, 9, "The data storages were not reused");
+  NS_TEST_EXPECT_MSG_EQ (after.cached, std::max<uint64_t> (before.cached, 1), "Bad number of cached storages");
+}
+//-----------------------------------------------------------------------------
+class BufferPoolBoundTest : public TestCase {
+public:
+  virtual void DoRun (void);
+  BufferPoolBoundTest ();
+};
+
+BufferPoolBoundTest::BufferPoolBoundTest ()
+  : TestCase ("The free data storages of a thread are bounded and reused") {
+}
+
+void
+BufferPoolBoundTest::DoRun (void)
+{
+  if (Buffer::GetPoolSizeClasses () == 0)
+    {
+      return;
+    }
+  uint32_t sizeClass = Buffer::GetPoolSizeClasses () - 1;
+  const uint32_t n = 3000;
+  std::vector<Buffer> buffers (n);
+  for (uint32_t i = 0; i < n; i++)
+    {
+      buffers[i].AddAtStart (5000);
+    }
+  buffers.clear ();
+  Buffer::PoolStats released = Buffer::GetPoolStats (sizeClass);
+  NS_TEST_EXPECT_MSG_LT (released.cached, n, "The free data storages were not moved to the depot");
+
+  // the storages moved to the depot are reused before new slabs are carved
+  buffers.resize (n);
+  for (uint32_t i = 0; i < n; i++)
+    {
+      buffers[i].AddAtStart (5000);
+    }
+  Buffer::PoolStats reused = Buffer::GetPoolStats (sizeClass);
+  NS_TEST_EXPECT_MSG_EQ (reused.poolHits - released.poolHits, n, "The data storages were not reused");
+  NS_TEST_EXPECT_MSG_EQ (reused.slabs, released.slabs, "New slabs were carved");
+}
+//-----------------------------------------------------------------------------
 class BufferTestSuite : public TestSuite
 {
 public:
@@ -371,6 +449,8 @@ BufferTestSuite::BufferTestSuite ()
   : TestSuite ("buffer", UNIT)
 {
   AddTestCase (new BufferTest, TestCase::QUICK);
+  AddTestCase (new BufferPoolTest, TestCase::QUICK);
+  AddTestCase (new BufferPoolBoundTest, TestCase::QUICK);
 }
 
 static BufferTestSuite g_bufferTestSuite;
@@ -79,5 +79,12 @@ JakesPropagationLossModel::DoAssignStreams (int64_t stream)
   return 1;
 }
 
+bool
+JakesPropagationLossModel::DoIsCacheable (void) const
+{
+  // the fading process evolves over time
+  return false;
+}
+
 } // namespace ns3
 
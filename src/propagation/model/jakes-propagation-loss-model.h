@@ -64,6 +64,7 @@ private:
                         Ptr<MobilityModel> a,
                         Ptr<MobilityModel> b) const;
   virtual int64_t DoAssignStreams (int64_t stream);
+  virtual bool DoIsCacheable (void) const;
 
   /**
    * Get the underlying RNG stream
@@ -57,36 +57,15 @@ LogNormalShadowingIid::GetLossDb (Ptr<MobilityModel> a, Ptr<MobilityModel> b) co
       return GetLossDb (b, a);
     }
 
-  std::map<Ptr<MobilityModel>,  std::map<Ptr<MobilityModel>, double> >::iterator 
-    ait = m_shadowingLossMap.find (a);
-  
-  if (ait != m_shadowingLossMap.end ())
-    {
-      std::map<Ptr<MobilityModel>, double>::iterator 
-	bit = ait->second.find (b);
-      if (bit != ait->second.end ())
-        {
-          return (bit->second);
-        }
-      else
-        {
-          double sigma = m_getSigmaCallback (a, b);
-          // side effect: will create new entry          
-          // sigma is standard deviation, not variance
-          double shadowingValue = m_normalRandomVariable->GetValue (0.0, (sigma*sigma));
-          ait->second[b] = shadowingValue;          
-          return (shadowingValue);
-        }
-    }
-  else
+  double *shadowingValue = m_shadowingLossCache.Find (a, b);
+  if (shadowingValue != 0)
     {
-      double sigma = m_getSigmaCallback (a, b);
-      // side effect: will create new entries in both maps
-      // sigma is standard deviation, not variance
-      double shadowingValue = m_normalRandomVariable->GetValue (0.0, (sigma*sigma));
-      m_shadowingLossMap[a][b] = shadowingValue;  
-      return (shadowingValue);       
+      return (*shadowingValue);
     }
+  double sigma = m_getSigmaCallback (a, b);
+  // side effect: will create new entry
+  // sigma is standard deviation, not variance
+  return (*m_shadowingLossCache.Insert (a, b, m_normalRandomVariable->GetValue (0.0, (sigma*sigma))));
 }
 
 int64_t
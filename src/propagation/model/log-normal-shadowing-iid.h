@@ -25,8 +25,7 @@
 
 #include <ns3/mobility-model.h>
 #include <ns3/random-variable-stream.h>
-
-#include <map>
+#include <ns3/symmetric-link-cache.h>
 
 namespace ns3 {
 
@@ -100,7 +99,7 @@ private:
    * PropagationLossModel::CalcRxPower which is also a const method. 
    * 
    */
-  mutable std::map<Ptr<MobilityModel>,  std::map<Ptr<MobilityModel>, double> > m_shadowingLossMap;
+  mutable SymmetricLinkCache<double> m_shadowingLossCache;
 
   /**
    * normal random variable used to generate loss values
@@ -21,7 +21,7 @@
 #define PROPAGATION_CACHE_H_
 
 #include "ns3/mobility-model.h"
-#include <map>
+#include "ns3/symmetric-link-cache.h"
 
 namespace ns3
 {
@@ -47,13 +47,12 @@ public:
    */
   Ptr<T> GetPathData (Ptr<const MobilityModel> a, Ptr<const MobilityModel> b, uint32_t modelUid)
   {
-    PropagationPathIdentifier key = PropagationPathIdentifier (a, b, modelUid);
-    typename PathCache::iterator it = m_pathCache.find (key);
-    if (it == m_pathCache.end ())
+    Ptr<T> *data = m_pathCache.Find (a, b, modelUid);
+    if (data == 0)
       {
         return 0;
       }
-    return it->second;
+    return *data;
   };
 
   /**
@@ -65,49 +64,11 @@ public:
    */
   void AddPathData (Ptr<T> data, Ptr<const MobilityModel> a, Ptr<const MobilityModel> b, uint32_t modelUid)
   {
-    PropagationPathIdentifier key = PropagationPathIdentifier (a, b, modelUid);
-    NS_ASSERT (m_pathCache.find (key) == m_pathCache.end ());
-    m_pathCache.insert (std::make_pair (key, data)); 
+    m_pathCache.Insert (a, b, data, modelUid);
   };
 private:
-  /// Each path is identified by
-  struct PropagationPathIdentifier
-  {
-    /**
-     * Constructor
-     * @param a 1st node mobility model
-     * @param b 2nd node mobility model
-     * @param modelUid model UID
-     */
-    PropagationPathIdentifier (Ptr<const MobilityModel> a, Ptr<const MobilityModel> b, uint32_t modelUid) :
-      m_srcMobility (a), m_dstMobility (b), m_spectrumModelUid (modelUid)
-    {};
-    Ptr<const MobilityModel> m_srcMobility; //!< 1st node mobility model
-    Ptr<const MobilityModel> m_dstMobility; //!< 2nd node mobility model
-    uint32_t m_spectrumModelUid; //!< model UID
-    bool operator < (const PropagationPathIdentifier & other) const
-    {
-      if (m_spectrumModelUid != other.m_spectrumModelUid)
-        {
-          return m_spectrumModelUid < other.m_spectrumModelUid;
-        }
-      /// Links are supposed to be symmetrical!
-      if (std::min (m_dstMobility, m_srcMobility) != std::min (other.m_dstMobility, other.m_srcMobility))
-        {
-          return std::min (m_dstMobility, m_srcMobility) < std::min (other.m_dstMobility, other.m_srcMobility);
-        }
-      if (std::max (m_dstMobility, m_srcMobility) != std::max (other.m_dstMobility, other.m_srcMobility))
-        {
-          return std::max (m_dstMobility, m_srcMobility) < std::max (other.m_dstMobility, other.m_srcMobility);
-        }
-      return false;
-    }
-  };
-
-  /// Typedef: PropagationPathIdentifier, Ptr<T>
-  typedef std::map<PropagationPathIdentifier, Ptr<T> > PathCache;
-private:
-  PathCache m_pathCache; //!< Path cache
+  /// Links are supposed to be symmetrical!
+  SymmetricLinkCache<Ptr<T> > m_pathCache; //!< Path cache
 };
 } // namespace ns3
 
@@ -93,6 +93,22 @@ PropagationLossModel::AssignStreams (int64_t stream)
   return (currentStream - stream);
 }
 
+bool
+PropagationLossModel::IsCacheable (void) const
+{
+  if (!DoIsCacheable ())
+    {
+      return false;
+    }
+  return (m_next == 0) || m_next->IsCacheable ();
+}
+
+bool
+PropagationLossModel::DoIsCacheable (void) const
+{
+  return true;
+}
+
 // ------------------------------------------------------------------------- //
 
 NS_OBJECT_ENSURE_REGISTERED (RandomPropagationLossModel);
@@ -136,6 +152,13 @@ RandomPropagationLossModel::DoAssignStreams (int64_t stream)
   return 1;
 }
 
+bool
+RandomPropagationLossModel::DoIsCacheable (void) const
+{
+  // a new random value is drawn for each call
+  return false;
+}
+
 // ------------------------------------------------------------------------- //
 
 NS_OBJECT_ENSURE_REGISTERED (FriisPropagationLossModel);
@@ -753,6 +776,13 @@ NakagamiPropagationLossModel::DoAssignStreams (int64_t stream)
   return 2;
 }
 
+bool
+NakagamiPropagationLossModel::DoIsCacheable (void) const
+{
+  // a new random value is drawn for each call
+  return false;
+}
+
 // ------------------------------------------------------------------------- //
 
 NS_OBJECT_ENSURE_REGISTERED (FixedRssLossModel);
@@ -880,6 +910,13 @@ MatrixPropagationLossModel::DoAssignStreams (int64_t stream)
   return 0;
 }
 
+bool
+MatrixPropagationLossModel::DoIsCacheable (void) const
+{
+  // the loss of a link can be changed at any time via SetLoss
+  return false;
+}
+
 // ------------------------------------------------------------------------- //
 
 NS_OBJECT_ENSURE_REGISTERED (RangePropagationLossModel);
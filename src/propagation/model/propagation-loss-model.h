@@ -106,6 +106,17 @@ public:
    */
   int64_t AssignStreams (int64_t stream);
 
+  /**
+   * Returns true if, for a given pair of mobility models which did not
+   * change their position, CalcRxPower always returns the same value,
+   * i.e., if its result can be cached by the user until either mobility
+   * model notifies a course change. This holds only if all the
+   * PropagationLossModel(s) chained to the current one are cacheable too.
+   *
+   * \returns true if the loss computed by the chain of models can be cached
+   */
+  bool IsCacheable (void) const;
+
 private:
   /**
    * \brief Copy constructor
@@ -140,6 +151,15 @@ private:
    */
   virtual int64_t DoAssignStreams (int64_t stream) = 0;
 
+  /**
+   * Subclasses whose loss changes over time or between calls (e.g.,
+   * because a new random value is drawn every time) must override this
+   * and return false. The default implementation returns true.
+   *
+   * \returns true if only the particular PropagationLossModel is cacheable
+   */
+  virtual bool DoIsCacheable (void) const;
+
   Ptr<PropagationLossModel> m_next; //!< Next propagation loss model in the list
 };
 
@@ -178,6 +198,7 @@ private:
                                 Ptr<MobilityModel> a,
                                 Ptr<MobilityModel> b) const;
   virtual int64_t DoAssignStreams (int64_t stream);
+  virtual bool DoIsCacheable (void) const;
   Ptr<RandomVariableStream> m_variable; //!< random generator
 };
 
@@ -684,6 +705,7 @@ private:
                                 Ptr<MobilityModel> a,
                                 Ptr<MobilityModel> b) const;
   virtual int64_t DoAssignStreams (int64_t stream);
+  virtual bool DoIsCacheable (void) const;
 
   double m_distance1; //!< Distance1
   double m_distance2; //!< Distance2
@@ -806,6 +828,7 @@ private:
                                 Ptr<MobilityModel> b) const;
 
   virtual int64_t DoAssignStreams (int64_t stream);
+  virtual bool DoIsCacheable (void) const;
 private:
   double m_default; //!< default loss
 
@@ -0,0 +1,207 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2015 University of Washington
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef SYMMETRIC_LINK_CACHE_H
+#define SYMMETRIC_LINK_CACHE_H
+
+#include "ns3/mobility-model.h"
+#include "ns3/assert.h"
+#include <stdint.h>
+#include <vector>
+#include <algorithm>
+
+namespace ns3
+{
+/**
+ * \ingroup propagation
+ * \brief A cache of per-link values, where the link a-->b is the same
+ * as b-->a.
+ *
+ * A link is identified by a couple of MobilityModels and a tag, e.g., a
+ * spectrum model UID, and its value is stored once for both directions.
+ * The values are held in an open addressing hash table with linear
+ * probing, which is kept at most half full; compared to nested maps,
+ * this needs a single lookup and no allocation per link.
+ *
+ * The cache keeps a reference to the MobilityModels of its links, so
+ * that their addresses cannot be reused by other models.
+ *
+ * \tparam T the type of the values, which must be default constructible
+ */
+template<class T>
+class SymmetricLinkCache
+{
+public:
+  SymmetricLinkCache ()
+    : m_n (0)
+  {
+  }
+
+  /**
+   * Get the value of a link.
+   *
+   * \param a 1st node mobility model
+   * \param b 2nd node mobility model
+   * \param tag the link tag
+   * \return the value, or 0 if the link is not in the cache. The pointer
+   * is invalidated by the next Insert () or Clear ().
+   */
+  T* Find (Ptr<const MobilityModel> a, Ptr<const MobilityModel> b, uint32_t tag = 0)
+  {
+    if (m_n == 0)
+      {
+        return 0;
+      }
+    const MobilityModel *lo = PeekPointer (a);
+    const MobilityModel *hi = PeekPointer (b);
+    if (lo > hi)
+      {
+        std::swap (lo, hi);
+      }
+    uint32_t mask = m_entries.size () - 1;
+    for (uint32_t i = GetSlot (lo, hi, tag); m_entries[i].lo != 0; i = (i + 1) & mask)
+      {
+        if (m_entries[i].lo == lo && m_entries[i].hi == hi && m_entries[i].tag == tag)
+          {
+            return &m_entries[i].value;
+          }
+      }
+    return 0;
+  }
+
+  /**
+   * Add a link, which must not be in the cache yet.
+   *
+   * \param a 1st node mobility model
+   * \param b 2nd node mobility model
+   * \param value the value of the link
+   * \param tag the link tag
+   * \return the value stored in the cache. The pointer is invalidated by
+   * the next Insert () or Clear ().
+   */
+  T* Insert (Ptr<const MobilityModel> a, Ptr<const MobilityModel> b, const T &value, uint32_t tag = 0)
+  {
+    NS_ASSERT (a != 0 && b != 0);
+    NS_ASSERT (Find (a, b, tag) == 0);
+    if (2 * (m_n + 1) > m_entries.size ())
+      {
+        Grow ();
+      }
+    if (PeekPointer (a) > PeekPointer (b))
+      {
+        std::swap (a, b);
+      }
+    Entry *entry = FindFreeEntry (PeekPointer (a), PeekPointer (b), tag);
+    entry->lo = PeekPointer (a);
+    entry->hi = PeekPointer (b);
+    entry->tag = tag;
+    entry->value = value;
+    entry->loRef = a;
+    entry->hiRef = b;
+    m_n++;
+    return &entry->value;
+  }
+
+  /**
+   * \return the number of links in the cache
+   */
+  uint32_t GetN (void) const
+  {
+    return m_n;
+  }
+
+  /**
+   * Remove all the links.
+   */
+  void Clear (void)
+  {
+    m_entries.clear ();
+    m_n = 0;
+  }
+
+private:
+  /// A slot of the hash table.
+  struct Entry
+  {
+    Entry ()
+      : lo (0),
+        hi (0),
+        tag (0),
+        value ()
+    {
+    }
+    const MobilityModel *lo;         //!< Lower address of the link ends, 0 if the slot is free
+    const MobilityModel *hi;         //!< Higher address of the link ends
+    uint32_t tag;                    //!< The link tag
+    T value;                         //!< The value of the link
+    Ptr<const MobilityModel> loRef;  //!< Keeps lo alive
+    Ptr<const MobilityModel> hiRef;  //!< Keeps hi alive
+  };
+
+  /**
+   * \param lo lower address of the link ends
+   * \param hi higher address of the link ends
+   * \param tag the link tag
+   * \return the first slot to probe for the link
+   */
+  uint32_t GetSlot (const MobilityModel *lo, const MobilityModel *hi, uint32_t tag) const
+  {
+    uint64_t h = (uint64_t) (uintptr_t) lo * 0x9e3779b97f4a7c15ULL;
+    h ^= ((uint64_t) (uintptr_t) hi + tag) * 0xc2b2ae3d27d4eb4fULL;
+    h ^= h >> 31;
+    return (uint32_t) h & (m_entries.size () - 1);
+  }
+
+  /**
+   * \param lo lower address of the link ends
+   * \param hi higher address of the link ends
+   * \param tag the link tag
+   * \return the free slot where the link is to be stored
+   */
+  Entry* FindFreeEntry (const MobilityModel *lo, const MobilityModel *hi, uint32_t tag)
+  {
+    uint32_t mask = m_entries.size () - 1;
+    uint32_t i = GetSlot (lo, hi, tag);
+    while (m_entries[i].lo != 0)
+      {
+        i = (i + 1) & mask;
+      }
+    return &m_entries[i];
+  }
+
+  /// Double the size of the hash table.
+  void Grow (void)
+  {
+    std::vector<Entry> old;
+    old.swap (m_entries);
+    m_entries.resize (old.empty () ? 64 : 2 * old.size ());
+    for (typename std::vector<Entry>::iterator it = old.begin (); it != old.end (); ++it)
+      {
+        if (it->lo != 0)
+          {
+            *FindFreeEntry (it->lo, it->hi, it->tag) = *it;
+          }
+      }
+  }
+
+  std::vector<Entry> m_entries;  //!< The hash table, whose size is a power of two
+  uint32_t m_n;                  //!< The number of links
+};
+
+} // namespace ns3
+
+#endif /* SYMMETRIC_LINK_CACHE_H */
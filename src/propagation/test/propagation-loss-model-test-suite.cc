@@ -22,9 +22,12 @@
 #include "ns3/config.h"
 #include "ns3/double.h"
 #include "ns3/propagation-loss-model.h"
+#include "ns3/symmetric-link-cache.h"
 #include "ns3/constant-position-mobility-model.h"
 #include "ns3/simulator.h"
 
+#include <vector>
+
 using namespace ns3;
 
 NS_LOG_COMPONENT_DEFINE ("PropagationLossModelsTest");
@@ -436,6 +439,72 @@ RangePropagationLossModelTestCase::DoRun (void)
   Simulator::Destroy ();
 }
 
+class SymmetricLinkCacheTestCase : public TestCase
+{
+public:
+  SymmetricLinkCacheTestCase ();
+  virtual ~SymmetricLinkCacheTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+SymmetricLinkCacheTestCase::SymmetricLinkCacheTestCase ()
+  : TestCase ("Test SymmetricLinkCache")
+{
+}
+
+SymmetricLinkCacheTestCase::~SymmetricLinkCacheTestCase ()
+{
+}
+
+void
+SymmetricLinkCacheTestCase::DoRun (void)
+{
+  // enough links to grow the table several times
+  const uint32_t n = 40;
+  std::vector<Ptr<MobilityModel> > m;
+  for (uint32_t i = 0; i < n; ++i)
+    {
+      m.push_back (CreateObject<ConstantPositionMobilityModel> ());
+    }
+
+  SymmetricLinkCache<double> cache;
+  NS_TEST_ASSERT_MSG_EQ ((cache.Find (m[0], m[1]) == 0), true, "Link found in an empty cache");
+  for (uint32_t i = 0; i < n; ++i)
+    {
+      for (uint32_t j = i + 1; j < n; ++j)
+        {
+          // insert half of the links from the other end
+          Ptr<MobilityModel> a = ((i + j) % 2) ? m[i] : m[j];
+          Ptr<MobilityModel> b = ((i + j) % 2) ? m[j] : m[i];
+          cache.Insert (a, b, 1000.0 * i + j, 1);
+        }
+    }
+  NS_TEST_ASSERT_MSG_EQ (cache.GetN (), n * (n - 1) / 2, "Wrong number of links");
+
+  for (uint32_t i = 0; i < n; ++i)
+    {
+      for (uint32_t j = i + 1; j < n; ++j)
+        {
+          double *ab = cache.Find (m[i], m[j], 1);
+          double *ba = cache.Find (m[j], m[i], 1);
+          NS_TEST_ASSERT_MSG_EQ ((ab != 0 && ab == ba), true, "Link " << i << " - " << j << " not stored once");
+          NS_TEST_ASSERT_MSG_EQ (*ab, 1000.0 * i + j, "Wrong value of link " << i << " - " << j);
+          NS_TEST_ASSERT_MSG_EQ ((cache.Find (m[i], m[j], 2) == 0), true, "Link found with the wrong tag");
+        }
+    }
+
+  // the same couple with another tag is another link
+  *cache.Insert (m[1], m[0], 5.0, 2) += 1.0;
+  NS_TEST_ASSERT_MSG_EQ (*cache.Find (m[0], m[1], 2), 6.0, "Wrong value of a tagged link");
+  NS_TEST_ASSERT_MSG_EQ (*cache.Find (m[0], m[1], 1), 1.0, "Tagged link overwritten");
+
+  cache.Clear ();
+  NS_TEST_ASSERT_MSG_EQ (cache.GetN (), 0, "Cache not cleared");
+  NS_TEST_ASSERT_MSG_EQ ((cache.Find (m[0], m[1], 1) == 0), true, "Link found in a cleared cache");
+}
+
 class PropagationLossModelsTestSuite : public TestSuite
 {
 public:
@@ -450,6 +519,7 @@ PropagationLossModelsTestSuite::PropagationLossModelsTestSuite ()
   AddTestCase (new LogDistancePropagationLossModelTestCase, TestCase::QUICK);
   AddTestCase (new MatrixPropagationLossModelTestCase, TestCase::QUICK);
   AddTestCase (new RangePropagationLossModelTestCase, TestCase::QUICK);
+  AddTestCase (new SymmetricLinkCacheTestCase, TestCase::QUICK);
 }
 
 static PropagationLossModelsTestSuite propagationLossModelsTestSuite;
@@ -7152,11 +7152,30 @@ def register_Ns3MultiModelSpectrumChannel_methods(root_module, cls):
                    'ns3::Ptr< ns3::NetDevice >', 
                    [param('uint32_t', 'i')], 
                    is_const=True, is_virtual=True)
+    ## multi-model-spectrum-channel.h (module 'spectrum'): uint64_t ns3::MultiModelSpectrumChannel::GetLinkCacheHits() const [member function]
+    cls.add_method('GetLinkCacheHits', 
+                   'uint64_t', 
+                   [], 
+                   is_const=True)
+    ## multi-model-spectrum-channel.h (module 'spectrum'): uint64_t ns3::MultiModelSpectrumChannel::GetLinkCacheMisses() const [member function]
+    cls.add_method('GetLinkCacheMisses', 
+                   'uint64_t', 
+                   [], 
+                   is_const=True)
+    ## multi-model-spectrum-channel.h (module 'spectrum'): double ns3::MultiModelSpectrumChannel::GetMaxInterferenceRange() const [member function]
+    cls.add_method('GetMaxInterferenceRange', 
+                   'double', 
+                   [], 
+                   is_const=True)
     ## multi-model-spectrum-channel.h (module 'spectrum'): uint32_t ns3::MultiModelSpectrumChannel::GetNDevices() const [member function]
     cls.add_method('GetNDevices', 
                    'uint32_t', 
                    [], 
                    is_const=True, is_virtual=True)
+    ## multi-model-spectrum-channel.h (module 'spectrum'): ns3::Ptr<ns3::PropagationLossModel> ns3::MultiModelSpectrumChannel::GetPropagationLossModel() [member function]
+    cls.add_method('GetPropagationLossModel', 
+                   'ns3::Ptr< ns3::PropagationLossModel >', 
+                   [])
     ## multi-model-spectrum-channel.h (module 'spectrum'): ns3::Ptr<ns3::SpectrumPropagationLossModel> ns3::MultiModelSpectrumChannel::GetSpectrumPropagationLossModel() [member function]
     cls.add_method('GetSpectrumPropagationLossModel', 
                    'ns3::Ptr< ns3::SpectrumPropagationLossModel >', 
@@ -7167,11 +7186,19 @@ def register_Ns3MultiModelSpectrumChannel_methods(root_module, cls):
                    'ns3::TypeId', 
                    [], 
                    is_static=True)
+    ## multi-model-spectrum-channel.h (module 'spectrum'): void ns3::MultiModelSpectrumChannel::SetMaxInterferenceRange(double range) [member function]
+    cls.add_method('SetMaxInterferenceRange', 
+                   'void', 
+                   [param('double', 'range')])
     ## multi-model-spectrum-channel.h (module 'spectrum'): void ns3::MultiModelSpectrumChannel::SetPropagationDelayModel(ns3::Ptr<ns3::PropagationDelayModel> delay) [member function]
     cls.add_method('SetPropagationDelayModel', 
                    'void', 
                    [param('ns3::Ptr< ns3::PropagationDelayModel >', 'delay')], 
                    is_virtual=True)
+    ## multi-model-spectrum-channel.h (module 'spectrum'): void ns3::MultiModelSpectrumChannel::SetPropagationLossModel(ns3::Ptr<ns3::PropagationLossModel> loss) [member function]
+    cls.add_method('SetPropagationLossModel', 
+                   'void', 
+                   [param('ns3::Ptr< ns3::PropagationLossModel >', 'loss')])
     ## multi-model-spectrum-channel.h (module 'spectrum'): void ns3::MultiModelSpectrumChannel::StartTx(ns3::Ptr<ns3::SpectrumSignalParameters> params) [member function]
     cls.add_method('StartTx', 
                    'void', 
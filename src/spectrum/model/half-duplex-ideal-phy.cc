@@ -341,10 +341,10 @@ HalfDuplexIdealPhy::StartRx (Ptr<SpectrumSignalParameters> spectrumParams)
 {
   NS_LOG_FUNCTION (this << spectrumParams);
   NS_LOG_LOGIC (this << " state: " << m_state);
-  NS_LOG_LOGIC (this << " rx power: " << 10 * std::log10 (Integral (*(spectrumParams->psd))) + 30 << " dBm");
+  NS_LOG_LOGIC (this << " rx power: " << 10 * std::log10 (Integral (*(spectrumParams->GetPsd ()))) + 30 << " dBm");
 
   // interference will happen regardless of the state of the receiver
-  m_interference.AddSignal (spectrumParams->psd, spectrumParams->duration);
+  m_interference.AddSignal (spectrumParams->GetPsd (), spectrumParams->duration);
 
   // the device might start RX only if the signal is of a type understood by this device
   // this corresponds in real devices to preamble detection
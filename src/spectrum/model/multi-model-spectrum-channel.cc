@@ -26,6 +26,7 @@
 #include <ns3/net-device.h>
 #include <ns3/node.h>
 #include <ns3/double.h>
+#include <ns3/boolean.h>
 #include <ns3/mobility-model.h>
 #include <ns3/spectrum-phy.h>
 #include <ns3/spectrum-converter.h>
@@ -36,6 +37,8 @@
 #include <ns3/angles.h>
 #include <iostream>
 #include <utility>
+#include <algorithm>
+#include <cmath>
 #include "multi-model-spectrum-channel.h"
 
 
@@ -82,6 +85,11 @@ RxSpectrumModelInfo::RxSpectrumModelInfo (Ptr<const SpectrumModel> rxSpectrumMod
 
 
 MultiModelSpectrumChannel::MultiModelSpectrumChannel ()
+  : m_maxInterferenceRange (0),
+    m_enableLinkCache (false),
+    m_linkCacheCapacity (0),
+    m_linkCacheHits (0),
+    m_linkCacheMisses (0)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -90,11 +98,25 @@ void
 MultiModelSpectrumChannel::DoDispose ()
 {
   NS_LOG_FUNCTION (this);
+  for (std::map<Ptr<const MobilityModel>, std::set<Ptr<SpectrumPhy> > >::iterator it = m_mobilityPhyMap.begin ();
+       it != m_mobilityPhyMap.end ();
+       ++it)
+    {
+      ConstCast<MobilityModel> (it->first)->TraceDisconnectWithoutContext ("CourseChange", MakeCallback (&MultiModelSpectrumChannel::CourseChanged, this));
+    }
   m_propagationDelay = 0;
   m_propagationLoss = 0;
   m_spectrumPropagationLoss = 0;
   m_txSpectrumModelInfoMap.clear ();
   m_rxSpectrumModelInfoMap.clear ();
+  m_rxPhyGridCellMap.clear ();
+  m_rxPhyGrid.clear ();
+  m_unindexedRxPhySet.clear ();
+  m_mobilityPhyMap.clear ();
+  m_linkCacheSlotMap.clear ();
+  m_linkCacheSlots.clear ();
+  m_linkCache.clear ();
+  m_linkCacheCapacity = 0;
   SpectrumChannel::DoDispose ();
 }
 
@@ -119,6 +141,28 @@ MultiModelSpectrumChannel::GetTypeId (void)
                    DoubleValue (1.0e9),
                    MakeDoubleAccessor (&MultiModelSpectrumChannel::m_maxLossDb),
                    MakeDoubleChecker<double> ())
+    .AddAttribute ("MaxInterferenceRange",
+                   "If positive, transmissions are passed only to the "
+                   "receiving PHYs whose distance in meters from the "
+                   "transmitter is not bigger than this value. A grid-based "
+                   "spatial index of the receivers is then used so that "
+                   "the receivers beyond this range are not even evaluated. "
+                   "Receivers that are moving or have no MobilityModel "
+                   "are always evaluated. The default value disables "
+                   "this feature. Tune this value with care.",
+                   DoubleValue (0.0),
+                   MakeDoubleAccessor (&MultiModelSpectrumChannel::SetMaxInterferenceRange,
+                                       &MultiModelSpectrumChannel::GetMaxInterferenceRange),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("EnableLinkCache",
+                   "If true, the loss of each link between a transmitter "
+                   "and a receiver which are not moving is calculated "
+                   "only once, and reused until either of them notifies "
+                   "a course change. The cache is not used if the "
+                   "PropagationLossModel declares itself not cacheable.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&MultiModelSpectrumChannel::m_enableLinkCache),
+                   MakeBooleanChecker ())
     .AddTraceSource ("PathLoss",
                      "This trace is fired whenever a new path loss value "
                      "is calculated. The first and second parameters "
@@ -172,6 +216,11 @@ MultiModelSpectrumChannel::AddRx (Ptr<SpectrumPhy> phy)
 
   ++m_numDevices;
 
+  if (m_maxInterferenceRange > 0)
+    {
+      AddRxToSpatialIndex (phy);
+    }
+
   RxSpectrumModelInfoMap_t::iterator rxInfoIterator = m_rxSpectrumModelInfoMap.find (rxSpectrumModelUid);
 
   if (rxInfoIterator == m_rxSpectrumModelInfoMap.end ())
@@ -272,6 +321,23 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
   NS_LOG_LOGIC ("converter map size: " << txInfoIteratorerator->second.m_spectrumConverterMap.size ());
   NS_LOG_LOGIC ("converter map first element: " << txInfoIteratorerator->second.m_spectrumConverterMap.begin ()->first);
 
+  bool useSpatialIndex = (m_maxInterferenceRange > 0) && txMobility;
+  std::vector<Ptr<SpectrumPhy> > candidateRxPhys;
+  if (useSpatialIndex)
+    {
+      candidateRxPhys = GetCandidateRxPhys (txMobility->GetPosition ());
+      NS_LOG_LOGIC ("candidate receivers: " << candidateRxPhys.size () << " out of " << m_numDevices);
+    }
+
+  bool useLinkCache = m_enableLinkCache && txMobility
+    && (m_propagationLoss == 0 || m_propagationLoss->IsCacheable ());
+  uint32_t txSlot = 0;
+  if (useLinkCache)
+    {
+      txSlot = GetLinkCacheSlot (txParams->txPhy, txMobility);
+      useLinkCache = m_linkCacheSlots[txSlot].isStatic;
+    }
+
   for (RxSpectrumModelInfoMap_t::const_iterator rxInfoIterator = m_rxSpectrumModelInfoMap.begin ();
        rxInfoIterator != m_rxSpectrumModelInfoMap.end ();
        ++rxInfoIterator)
@@ -279,11 +345,35 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
       SpectrumModelUid_t rxSpectrumModelUid = rxInfoIterator->second.m_rxSpectrumModel->GetUid ();
       NS_LOG_LOGIC (" rxSpectrumModelUids " << rxSpectrumModelUid);
 
-      Ptr <SpectrumValue> convertedTxPowerSpectrum;
+      std::set<Ptr<SpectrumPhy> > candidateRxPhySet;
+      if (useSpatialIndex)
+        {
+          for (std::vector<Ptr<SpectrumPhy> >::const_iterator it = candidateRxPhys.begin ();
+               it != candidateRxPhys.end ();
+               ++it)
+            {
+              if (rxInfoIterator->second.m_rxPhySet.find (*it) != rxInfoIterator->second.m_rxPhySet.end ())
+                {
+                  candidateRxPhySet.insert (*it);
+                }
+            }
+        }
+      const std::set<Ptr<SpectrumPhy> >& rxPhySet = useSpatialIndex ? candidateRxPhySet : rxInfoIterator->second.m_rxPhySet;
+      if (rxPhySet.empty ())
+        {
+          NS_LOG_LOGIC ("no receivers to be considered for this model");
+          continue;
+        }
+
+      // this PSD is shared (read-only) by all the receivers using
+      // rxSpectrumModel, each of which applies its own path gain lazily
+      Ptr <const SpectrumValue> convertedTxPowerSpectrum;
       if (txSpectrumModelUid == rxSpectrumModelUid)
         {
           NS_LOG_LOGIC ("no spectrum conversion needed");
-          convertedTxPowerSpectrum = txParams->psd;
+          // a single copy per transmission protects the receivers
+          // from later changes made by the transmitter to its own PSD
+          convertedTxPowerSpectrum = Copy<SpectrumValue> (txParams->psd);
         }
       else
         {
@@ -294,8 +384,8 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
         }
 
 
-      for (std::set<Ptr<SpectrumPhy> >::const_iterator rxPhyIterator = rxInfoIterator->second.m_rxPhySet.begin ();
-           rxPhyIterator != rxInfoIterator->second.m_rxPhySet.end ();
+      for (std::set<Ptr<SpectrumPhy> >::const_iterator rxPhyIterator = rxPhySet.begin ();
+           rxPhyIterator != rxPhySet.end ();
            ++rxPhyIterator)
         {
           NS_ASSERT_MSG ((*rxPhyIterator)->GetRxSpectrumModel ()->GetUid () == rxSpectrumModelUid,
@@ -310,28 +400,65 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
               if (txMobility && receiverMobility)
                 {
                   double pathLossDb = 0;
-                  if (txParams->txAntenna != 0)
+                  Ptr<AntennaModel> rxAntenna = (*rxPhyIterator)->GetRxAntenna ();
+                  LinkCacheEntry* cacheEntry = 0;
+                  bool cacheHit = false;
+                  if (useLinkCache)
                     {
-                      Angles txAngles (receiverMobility->GetPosition (), txMobility->GetPosition ());
-                      double txAntennaGain = txParams->txAntenna->GetGainDb (txAngles);
-                      NS_LOG_LOGIC ("txAntennaGain = " << txAntennaGain << " dB");
-                      pathLossDb -= txAntennaGain;
+                      // the slot is taken before the entry since the
+                      // matrix might be reallocated
+                      uint32_t rxSlot = GetLinkCacheSlot (*rxPhyIterator, receiverMobility);
+                      if (m_linkCacheSlots[rxSlot].isStatic)
+                        {
+                          cacheEntry = &m_linkCache[txSlot * m_linkCacheCapacity + rxSlot];
+                          cacheHit = (cacheEntry->txEpoch == m_linkCacheSlots[txSlot].epoch)
+                            && (cacheEntry->rxEpoch == m_linkCacheSlots[rxSlot].epoch)
+                            && (cacheEntry->txAntenna == PeekPointer (txParams->txAntenna))
+                            && (cacheEntry->rxAntenna == PeekPointer (rxAntenna));
+                          if (!cacheHit)
+                            {
+                              cacheEntry->txEpoch = m_linkCacheSlots[txSlot].epoch;
+                              cacheEntry->rxEpoch = m_linkCacheSlots[rxSlot].epoch;
+                              cacheEntry->txAntenna = PeekPointer (txParams->txAntenna);
+                              cacheEntry->rxAntenna = PeekPointer (rxAntenna);
+                            }
+                        }
                     }
-                  Ptr<AntennaModel> rxAntenna = (*rxPhyIterator)->GetRxAntenna ();
-                  if (rxAntenna != 0)
+                  if (cacheHit)
                     {
-                      Angles rxAngles (txMobility->GetPosition (), receiverMobility->GetPosition ());
-                      double rxAntennaGain = rxAntenna->GetGainDb (rxAngles);
-                      NS_LOG_LOGIC ("rxAntennaGain = " << rxAntennaGain << " dB");
-                      pathLossDb -= rxAntennaGain;
+                      ++m_linkCacheHits;
+                      pathLossDb = cacheEntry->pathLossDb;
+                      NS_LOG_LOGIC ("cached pathLoss = " << pathLossDb << " dB");
                     }
-                  if (m_propagationLoss)
+                  else
                     {
-                      double propagationGainDb = m_propagationLoss->CalcRxPower (0, txMobility, receiverMobility);
-                      NS_LOG_LOGIC ("propagationGainDb = " << propagationGainDb << " dB");
-                      pathLossDb -= propagationGainDb;
-                    }                    
-                  NS_LOG_LOGIC ("total pathLoss = " << pathLossDb << " dB");    
+                      if (txParams->txAntenna != 0)
+                        {
+                          Angles txAngles (receiverMobility->GetPosition (), txMobility->GetPosition ());
+                          double txAntennaGain = txParams->txAntenna->GetGainDb (txAngles);
+                          NS_LOG_LOGIC ("txAntennaGain = " << txAntennaGain << " dB");
+                          pathLossDb -= txAntennaGain;
+                        }
+                      if (rxAntenna != 0)
+                        {
+                          Angles rxAngles (txMobility->GetPosition (), receiverMobility->GetPosition ());
+                          double rxAntennaGain = rxAntenna->GetGainDb (rxAngles);
+                          NS_LOG_LOGIC ("rxAntennaGain = " << rxAntennaGain << " dB");
+                          pathLossDb -= rxAntennaGain;
+                        }
+                      if (m_propagationLoss)
+                        {
+                          double propagationGainDb = m_propagationLoss->CalcRxPower (0, txMobility, receiverMobility);
+                          NS_LOG_LOGIC ("propagationGainDb = " << propagationGainDb << " dB");
+                          pathLossDb -= propagationGainDb;
+                        }
+                      NS_LOG_LOGIC ("total pathLoss = " << pathLossDb << " dB");
+                      if (cacheEntry != 0)
+                        {
+                          ++m_linkCacheMisses;
+                          cacheEntry->pathLossDb = pathLossDb;
+                        }
+                    }
                   m_pathLossTrace (txParams->txPhy, *rxPhyIterator, pathLossDb);
                   if ( pathLossDb > m_maxLossDb)
                     {
@@ -344,15 +471,17 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
                   NS_LOG_LOGIC (" copying signal parameters " << txParams);
                   // shallow copy
                   rxParams = txParams->Copy ();
-                  // the fact that txParams->Copy () does not actually
-                  // copy tx.Params.psd saves us a useless copy here,
-                  // since we actually use convertedTxPowerSpectrum 
-                  rxParams->psd = Copy<SpectrumValue> (convertedTxPowerSpectrum);
-                  *(rxParams->psd) *= pathGainLinear;              
+                  // the received PSD is convertedTxPowerSpectrum scaled
+                  // by pathGainLinear; it is materialized only if the
+                  // receiver (or the SpectrumPropagationLossModel) needs
+                  // per-band values
+                  rxParams->psd = 0;
+                  rxParams->sharedPsd = convertedTxPowerSpectrum;
+                  rxParams->psdGain = pathGainLinear;
 
                   if (m_spectrumPropagationLoss)
                     {
-                      rxParams->psd = m_spectrumPropagationLoss->CalcRxPowerSpectralDensity (rxParams->psd, txMobility, receiverMobility);
+                      rxParams->psd = m_spectrumPropagationLoss->CalcRxPowerSpectralDensity (rxParams->GetPsd (), txMobility, receiverMobility);
                       NS_LOG_LOGIC ("rxPsd after spectrumPropagationLoss:  " << *(rxParams->psd));                     
                     }
 
@@ -396,6 +525,245 @@ MultiModelSpectrumChannel::StartRx (Ptr<SpectrumSignalParameters> params, Ptr<Sp
 }
 
 
+void
+MultiModelSpectrumChannel::SetMaxInterferenceRange (double range)
+{
+  NS_LOG_FUNCTION (this << range);
+  m_maxInterferenceRange = range;
+  // the range is also the size of the grid cells, hence the receivers
+  // already added are indexed again
+  m_rxPhyGridCellMap.clear ();
+  m_rxPhyGrid.clear ();
+  m_unindexedRxPhySet.clear ();
+  if (m_maxInterferenceRange > 0)
+    {
+      for (RxSpectrumModelInfoMap_t::const_iterator rxInfoIterator = m_rxSpectrumModelInfoMap.begin ();
+           rxInfoIterator != m_rxSpectrumModelInfoMap.end ();
+           ++rxInfoIterator)
+        {
+          for (std::set<Ptr<SpectrumPhy> >::const_iterator phyIt = rxInfoIterator->second.m_rxPhySet.begin ();
+               phyIt != rxInfoIterator->second.m_rxPhySet.end ();
+               ++phyIt)
+            {
+              AddRxToSpatialIndex (*phyIt);
+            }
+        }
+    }
+}
+
+double
+MultiModelSpectrumChannel::GetMaxInterferenceRange (void) const
+{
+  return m_maxInterferenceRange;
+}
+
+void
+MultiModelSpectrumChannel::AddRxToSpatialIndex (Ptr<SpectrumPhy> phy)
+{
+  NS_LOG_FUNCTION (this << phy);
+  if (m_rxPhyGridCellMap.find (phy) != m_rxPhyGridCellMap.end ()
+      || m_unindexedRxPhySet.find (phy) != m_unindexedRxPhySet.end ())
+    {
+      // already tracked, e.g., AddRx called again after a SpectrumModel change
+      return;
+    }
+  Ptr<MobilityModel> mobility = phy->GetMobility ();
+  if (mobility == 0)
+    {
+      NS_LOG_LOGIC ("phy " << phy << " has no MobilityModel, it will not be indexed");
+      m_unindexedRxPhySet.insert (phy);
+      return;
+    }
+  TrackMobility (phy, mobility);
+  UpdateRxSpatialIndex (phy, mobility);
+}
+
+void
+MultiModelSpectrumChannel::UpdateRxSpatialIndex (Ptr<SpectrumPhy> phy, Ptr<const MobilityModel> mobility)
+{
+  NS_LOG_FUNCTION (this << phy << mobility);
+  std::map<Ptr<SpectrumPhy>, SpectrumGridCell_t>::iterator cellIt = m_rxPhyGridCellMap.find (phy);
+  if (cellIt != m_rxPhyGridCellMap.end ())
+    {
+      std::map<SpectrumGridCell_t, std::set<Ptr<SpectrumPhy> > >::iterator gridIt = m_rxPhyGrid.find (cellIt->second);
+      NS_ASSERT (gridIt != m_rxPhyGrid.end ());
+      gridIt->second.erase (phy);
+      if (gridIt->second.empty ())
+        {
+          m_rxPhyGrid.erase (gridIt);
+        }
+      m_rxPhyGridCellMap.erase (cellIt);
+    }
+  else
+    {
+      m_unindexedRxPhySet.erase (phy);
+    }
+
+  Vector velocity = mobility->GetVelocity ();
+  if (velocity.x != 0 || velocity.y != 0 || velocity.z != 0)
+    {
+      // the position of a moving receiver changes without any
+      // notification, hence it cannot be indexed
+      NS_LOG_LOGIC ("phy " << phy << " is moving, it will not be indexed");
+      m_unindexedRxPhySet.insert (phy);
+    }
+  else
+    {
+      SpectrumGridCell_t cell = GetGridCell (mobility->GetPosition ());
+      NS_LOG_LOGIC ("phy " << phy << " indexed in cell (" << cell.first << "," << cell.second << ")");
+      m_rxPhyGridCellMap.insert (std::make_pair (phy, cell));
+      m_rxPhyGrid[cell].insert (phy);
+    }
+}
+
+void
+MultiModelSpectrumChannel::TrackMobility (Ptr<SpectrumPhy> phy, Ptr<MobilityModel> mobility)
+{
+  NS_LOG_FUNCTION (this << phy << mobility);
+  std::map<Ptr<const MobilityModel>, std::set<Ptr<SpectrumPhy> > >::iterator it = m_mobilityPhyMap.find (mobility);
+  if (it == m_mobilityPhyMap.end ())
+    {
+      // first phy using this MobilityModel
+      mobility->TraceConnectWithoutContext ("CourseChange", MakeCallback (&MultiModelSpectrumChannel::CourseChanged, this));
+      it = m_mobilityPhyMap.insert (std::make_pair (mobility, std::set<Ptr<SpectrumPhy> > ())).first;
+    }
+  it->second.insert (phy);
+}
+
+void
+MultiModelSpectrumChannel::CourseChanged (Ptr<const MobilityModel> mobility)
+{
+  NS_LOG_FUNCTION (this << mobility);
+  std::map<Ptr<const MobilityModel>, std::set<Ptr<SpectrumPhy> > >::const_iterator it = m_mobilityPhyMap.find (mobility);
+  if (it == m_mobilityPhyMap.end ())
+    {
+      return;
+    }
+  for (std::set<Ptr<SpectrumPhy> >::const_iterator phyIt = it->second.begin ();
+       phyIt != it->second.end ();
+       ++phyIt)
+    {
+      if (m_rxPhyGridCellMap.find (*phyIt) != m_rxPhyGridCellMap.end ()
+          || m_unindexedRxPhySet.find (*phyIt) != m_unindexedRxPhySet.end ())
+        {
+          UpdateRxSpatialIndex (*phyIt, mobility);
+        }
+      std::map<Ptr<SpectrumPhy>, uint32_t>::const_iterator slotIt = m_linkCacheSlotMap.find (*phyIt);
+      if (slotIt != m_linkCacheSlotMap.end ())
+        {
+          InvalidateLinkCacheSlot (slotIt->second);
+        }
+    }
+}
+
+uint32_t
+MultiModelSpectrumChannel::GetLinkCacheSlot (Ptr<SpectrumPhy> phy, Ptr<MobilityModel> mobility)
+{
+  NS_LOG_FUNCTION (this << phy << mobility);
+  std::map<Ptr<SpectrumPhy>, uint32_t>::const_iterator it = m_linkCacheSlotMap.find (phy);
+  if (it != m_linkCacheSlotMap.end ())
+    {
+      if (m_linkCacheSlots[it->second].mobility != mobility)
+        {
+          // the phy has been given a different MobilityModel
+          m_linkCacheSlots[it->second].mobility = mobility;
+          TrackMobility (phy, mobility);
+          InvalidateLinkCacheSlot (it->second);
+        }
+      return it->second;
+    }
+
+  uint32_t slot = m_linkCacheSlots.size ();
+  LinkCacheSlot newSlot;
+  newSlot.phy = phy;
+  newSlot.mobility = mobility;
+  newSlot.epoch = 0;
+  newSlot.isStatic = false;
+  m_linkCacheSlots.push_back (newSlot);
+  m_linkCacheSlotMap.insert (std::make_pair (phy, slot));
+  TrackMobility (phy, mobility);
+  // the first epoch is 1, so that the empty entries are never valid
+  InvalidateLinkCacheSlot (slot);
+
+  if (slot >= m_linkCacheCapacity)
+    {
+      // grow the matrix, doubling its size along each dimension
+      uint32_t capacity = (m_linkCacheCapacity == 0) ? 16 : 2 * m_linkCacheCapacity;
+      NS_LOG_LOGIC ("growing the link cache to " << capacity << " slots");
+      LinkCacheEntry emptyEntry;
+      emptyEntry.pathLossDb = 0;
+      emptyEntry.txEpoch = 0;
+      emptyEntry.rxEpoch = 0;
+      emptyEntry.txAntenna = 0;
+      emptyEntry.rxAntenna = 0;
+      std::vector<LinkCacheEntry> linkCache (capacity * capacity, emptyEntry);
+      for (uint32_t i = 0; i < m_linkCacheCapacity; ++i)
+        {
+          std::copy (m_linkCache.begin () + i * m_linkCacheCapacity,
+                     m_linkCache.begin () + (i + 1) * m_linkCacheCapacity,
+                     linkCache.begin () + i * capacity);
+        }
+      m_linkCache.swap (linkCache);
+      m_linkCacheCapacity = capacity;
+    }
+  return slot;
+}
+
+void
+MultiModelSpectrumChannel::InvalidateLinkCacheSlot (uint32_t slot)
+{
+  NS_LOG_FUNCTION (this << slot);
+  LinkCacheSlot& cacheSlot = m_linkCacheSlots[slot];
+  ++cacheSlot.epoch;
+  // the position of a moving phy changes without any notification,
+  // hence its links cannot be cached
+  Vector velocity = cacheSlot.mobility->GetVelocity ();
+  cacheSlot.isStatic = (velocity.x == 0 && velocity.y == 0 && velocity.z == 0);
+}
+
+SpectrumGridCell_t
+MultiModelSpectrumChannel::GetGridCell (const Vector& position) const
+{
+  NS_ASSERT (m_maxInterferenceRange > 0);
+  int64_t x = static_cast<int64_t> (std::floor (position.x / m_maxInterferenceRange));
+  int64_t y = static_cast<int64_t> (std::floor (position.y / m_maxInterferenceRange));
+  return std::make_pair (x, y);
+}
+
+std::vector<Ptr<SpectrumPhy> >
+MultiModelSpectrumChannel::GetCandidateRxPhys (const Vector& txPosition) const
+{
+  NS_LOG_FUNCTION (this << txPosition);
+  std::vector<Ptr<SpectrumPhy> > candidates (m_unindexedRxPhySet.begin (), m_unindexedRxPhySet.end ());
+
+  // since the cell size is equal to the maximum range, all the
+  // receivers in range are in the cell of the transmitter or in one
+  // of the eight neighboring cells
+  SpectrumGridCell_t txCell = GetGridCell (txPosition);
+  for (int64_t x = txCell.first - 1; x <= txCell.first + 1; ++x)
+    {
+      for (int64_t y = txCell.second - 1; y <= txCell.second + 1; ++y)
+        {
+          std::map<SpectrumGridCell_t, std::set<Ptr<SpectrumPhy> > >::const_iterator gridIt = m_rxPhyGrid.find (std::make_pair (x, y));
+          if (gridIt == m_rxPhyGrid.end ())
+            {
+              continue;
+            }
+          for (std::set<Ptr<SpectrumPhy> >::const_iterator phyIt = gridIt->second.begin ();
+               phyIt != gridIt->second.end ();
+               ++phyIt)
+            {
+              if (CalculateDistance (txPosition, (*phyIt)->GetMobility ()->GetPosition ()) <= m_maxInterferenceRange)
+                {
+                  candidates.push_back (*phyIt);
+                }
+            }
+        }
+    }
+  return candidates;
+}
+
+
 
 uint32_t
 MultiModelSpectrumChannel::GetNDevices (void) const
@@ -475,5 +843,28 @@ MultiModelSpectrumChannel::GetPropagationLossModel (void)
   return m_propagationLoss;
 }
 
+void
+MultiModelSpectrumChannel::SetPropagationLossModel (Ptr<PropagationLossModel> loss)
+{
+  NS_LOG_FUNCTION (this << loss);
+  m_propagationLoss = loss;
+  for (uint32_t slot = 0; slot < m_linkCacheSlots.size (); ++slot)
+    {
+      InvalidateLinkCacheSlot (slot);
+    }
+}
+
+uint64_t
+MultiModelSpectrumChannel::GetLinkCacheHits (void) const
+{
+  return m_linkCacheHits;
+}
+
+uint64_t
+MultiModelSpectrumChannel::GetLinkCacheMisses (void) const
+{
+  return m_linkCacheMisses;
+}
+
 
 } // namespace ns3
@@ -27,11 +27,16 @@
 #include <ns3/spectrum-channel.h>
 #include <ns3/spectrum-propagation-loss-model.h>
 #include <ns3/propagation-delay-model.h>
+#include <ns3/vector.h>
 #include <map>
 #include <set>
+#include <vector>
 
 namespace ns3 {
 
+class MobilityModel;
+class AntennaModel;
+
 
 /**
  * \ingroup spectrum
@@ -89,6 +94,12 @@ public:
  */
 typedef std::map<SpectrumModelUid_t, RxSpectrumModelInfo> RxSpectrumModelInfoMap_t;
 
+/**
+ * \ingroup spectrum
+ * Coordinates (along x and y) of a cell of the receiver spatial index
+ */
+typedef std::pair<int64_t, int64_t> SpectrumGridCell_t;
+
 
 /**
  * \ingroup spectrum
@@ -102,6 +113,25 @@ typedef std::map<SpectrumModelUid_t, RxSpectrumModelInfo> RxSpectrumModelInfoMap
  * for this to work is that, after the SpectrumPhy switched its
  * SpectrumModel,  MultiModelSpectrumChannel::AddRx () is
  * called again passing the pointer to that SpectrumPhy.
+ *
+ * If the MaxInterferenceRange attribute is set to a positive value,
+ * the channel keeps a grid-based spatial index of the positions of
+ * the receivers, and each transmission is only delivered to the
+ * receivers within that distance from the transmitter. The index
+ * is updated upon the CourseChange notifications of the receivers'
+ * MobilityModel. Receivers that are moving, as well as receivers
+ * without a MobilityModel, are not indexed and are always considered.
+ *
+ * If the EnableLinkCache attribute is set, the single-frequency loss
+ * of each TX-RX link (i.e., the antenna gains plus the loss of the
+ * PropagationLossModel) is stored in a dense matrix indexed by the
+ * slot assigned to each SpectrumPhy, and is reused by the following
+ * transmissions on the same link. A cached value is discarded when
+ * the MobilityModel of either end notifies a course change, and it is
+ * never used if either end is moving or if the PropagationLossModel
+ * is not cacheable (see PropagationLossModel::IsCacheable ()). The
+ * cache assumes that the radiation pattern of the AntennaModels does
+ * not change during the simulation.
  */
 class MultiModelSpectrumChannel : public SpectrumChannel
 {
@@ -141,6 +171,40 @@ public:
    */
   Ptr<PropagationLossModel> GetPropagationLossModel (void);
 
+  /**
+   * Replace the PropagationLossModel used by this channel, e.g., by a
+   * model wrapping it. The link losses cached so far are discarded.
+   *
+   * \param loss the new PropagationLossModel
+   */
+  void SetPropagationLossModel (Ptr<PropagationLossModel> loss);
+
+  /**
+   * \return the number of link losses that were retrieved from the
+   * link cache
+   */
+  uint64_t GetLinkCacheHits (void) const;
+
+  /**
+   * \return the number of link losses that were calculated while
+   * the link cache was enabled
+   */
+  uint64_t GetLinkCacheMisses (void) const;
+
+  /**
+   * Set the maximum distance at which signals are delivered, and index
+   * again the receivers already added to the channel.
+   *
+   * \param range the range in meters; the spatial index is not used if
+   * it is not positive
+   */
+  void SetMaxInterferenceRange (double range);
+
+  /**
+   * \return the maximum distance in meters at which signals are delivered
+   */
+  double GetMaxInterferenceRange (void) const;
+
 
 protected:
   void DoDispose ();
@@ -166,6 +230,98 @@ private:
    */
   virtual void StartRx (Ptr<SpectrumSignalParameters> params, Ptr<SpectrumPhy> receiver);
 
+  /**
+   * Start tracking the position of a receiver in the spatial index.
+   * Nothing is done if the receiver is already tracked.
+   *
+   * @param phy the receiver SpectrumPhy
+   */
+  void AddRxToSpatialIndex (Ptr<SpectrumPhy> phy);
+
+  /**
+   * Move a receiver to the grid cell corresponding to its current
+   * position, or to the set of non-indexed receivers if it is moving.
+   *
+   * @param phy the receiver SpectrumPhy
+   * @param mobility the MobilityModel of the receiver
+   */
+  void UpdateRxSpatialIndex (Ptr<SpectrumPhy> phy, Ptr<const MobilityModel> mobility);
+
+  /**
+   * Subscribe to the CourseChange notifications of the MobilityModel
+   * of a SpectrumPhy. Each MobilityModel is subscribed to only once.
+   *
+   * @param phy the SpectrumPhy
+   * @param mobility the MobilityModel of phy
+   */
+  void TrackMobility (Ptr<SpectrumPhy> phy, Ptr<MobilityModel> mobility);
+
+  /**
+   * Callback for the CourseChange trace of the tracked MobilityModels.
+   * It updates the spatial index and invalidates the link cache
+   * entries of the corresponding SpectrumPhy instances.
+   *
+   * @param mobility the MobilityModel whose course changed
+   */
+  void CourseChanged (Ptr<const MobilityModel> mobility);
+
+  /**
+   * Get the slot assigned to a SpectrumPhy in the link cache,
+   * assigning a new one if needed.
+   *
+   * @param phy the SpectrumPhy
+   * @param mobility the MobilityModel of phy
+   * @return the index of the slot in m_linkCacheSlots
+   */
+  uint32_t GetLinkCacheSlot (Ptr<SpectrumPhy> phy, Ptr<MobilityModel> mobility);
+
+  /**
+   * Invalidate all the link cache entries involving a slot, and
+   * check again whether the SpectrumPhy of the slot is moving.
+   *
+   * @param slot the slot index
+   */
+  void InvalidateLinkCacheSlot (uint32_t slot);
+
+  /**
+   * State of a SpectrumPhy in the link cache
+   */
+  struct LinkCacheSlot
+  {
+    Ptr<SpectrumPhy> phy;            //!< the SpectrumPhy
+    Ptr<MobilityModel> mobility;     //!< the MobilityModel the slot refers to
+    uint32_t epoch;                  //!< incremented at each course change
+    bool isStatic;                   //!< true if the velocity is zero
+  };
+
+  /**
+   * Cached loss of a TX-RX link
+   */
+  struct LinkCacheEntry
+  {
+    double pathLossDb;               //!< the loss in dB, including the antenna gains
+    uint32_t txEpoch;                //!< epoch of the TX slot when the loss was calculated
+    uint32_t rxEpoch;                //!< epoch of the RX slot when the loss was calculated
+    const AntennaModel* txAntenna;   //!< TX antenna used to calculate the loss
+    const AntennaModel* rxAntenna;   //!< RX antenna used to calculate the loss
+  };
+
+  /**
+   * @param position a position
+   * @return the cell of the spatial index which contains position
+   */
+  SpectrumGridCell_t GetGridCell (const Vector& position) const;
+
+  /**
+   * Get the receivers which might be within MaxInterferenceRange from
+   * the transmitter, i.e., the indexed receivers within that range
+   * plus all the non-indexed receivers.
+   *
+   * @param txPosition the position of the transmitter
+   * @return the candidate receivers
+   */
+  std::vector<Ptr<SpectrumPhy> > GetCandidateRxPhys (const Vector& txPosition) const;
+
   /**
    * Propagation delay model to be used with this channel.
    */
@@ -209,6 +365,64 @@ private:
    */
   double m_maxLossDb;
 
+  /**
+   * Maximum distance [m] at which signals are delivered, and size of
+   * the cells of the receiver spatial index. The spatial index is not
+   * used if this value is not positive.
+   */
+  double m_maxInterferenceRange;
+
+  /**
+   * Receivers that are indexed, and the grid cell each one belongs to.
+   */
+  std::map<Ptr<SpectrumPhy>, SpectrumGridCell_t> m_rxPhyGridCellMap;
+
+  /**
+   * Indexed receivers, grouped by grid cell.
+   */
+  std::map<SpectrumGridCell_t, std::set<Ptr<SpectrumPhy> > > m_rxPhyGrid;
+
+  /**
+   * Receivers tracked by the spatial index which are not in any grid
+   * cell, because they are moving or have no MobilityModel.
+   */
+  std::set<Ptr<SpectrumPhy> > m_unindexedRxPhySet;
+
+  /**
+   * SpectrumPhy instances whose MobilityModel is tracked, grouped by
+   * MobilityModel.
+   */
+  std::map<Ptr<const MobilityModel>, std::set<Ptr<SpectrumPhy> > > m_mobilityPhyMap;
+
+  /**
+   * If true, the loss of each link is cached in m_linkCache.
+   */
+  bool m_enableLinkCache;
+
+  /**
+   * Slot assigned to each SpectrumPhy in the link cache.
+   */
+  std::map<Ptr<SpectrumPhy>, uint32_t> m_linkCacheSlotMap;
+
+  /**
+   * Link cache slots, indexed by slot.
+   */
+  std::vector<LinkCacheSlot> m_linkCacheSlots;
+
+  /**
+   * Link cache matrix; the entry of the link from TX slot i to RX
+   * slot j is at index i * m_linkCacheCapacity + j.
+   */
+  std::vector<LinkCacheEntry> m_linkCache;
+
+  /**
+   * Number of rows and columns of m_linkCache.
+   */
+  uint32_t m_linkCacheCapacity;
+
+  uint64_t m_linkCacheHits;    //!< number of link cache hits
+  uint64_t m_linkCacheMisses;  //!< number of link cache misses
+
   /**
    * \deprecated The non-const \c Ptr<SpectrumPhy> argument
    * is deprecated and will be changed to \c Ptr<const SpectrumPhy>
@@ -161,7 +161,7 @@ void
 SpectrumAnalyzer::StartRx (Ptr<SpectrumSignalParameters> params)
 {
   NS_LOG_FUNCTION ( this << params);
-  AddSignal (params->psd);
+  AddSignal (params->GetPsd ());
   Simulator::Schedule (params->duration, &SpectrumAnalyzer::SubtractSignal, this, params->psd);
 }
 
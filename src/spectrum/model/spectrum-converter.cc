@@ -22,6 +22,7 @@
 #include <ns3/assert.h>
 #include <ns3/log.h>
 #include <algorithm>
+#include <cstddef>
 
 
 
@@ -39,23 +40,28 @@ SpectrumConverter::SpectrumConverter (Ptr<const SpectrumModel> fromSpectrumModel
   m_fromSpectrumModel = fromSpectrumModel;
   m_toSpectrumModel = toSpectrumModel;
 
+  m_rowOffsets.reserve (toSpectrumModel->GetNumBands () + 1);
+  m_rowOffsets.push_back (0);
   for (Bands::const_iterator toit = toSpectrumModel->Begin (); toit != toSpectrumModel->End (); ++toit)
     {
-      std::vector<double> coeffs;
-
-      for (Bands::const_iterator fromit = fromSpectrumModel->Begin (); fromit != fromSpectrumModel->End (); ++fromit)
+      size_t fromIndex = 0;
+      for (Bands::const_iterator fromit = fromSpectrumModel->Begin (); fromit != fromSpectrumModel->End (); ++fromit, ++fromIndex)
         {
           double c = GetCoefficient (*fromit, *toit);
           NS_LOG_LOGIC ("(" << fromit->fl << ","  << fromit->fh << ")"
                             << " --> " <<
                         "(" << toit->fl << "," << toit->fh << ")"
                             << " = " << c);
-          coeffs.push_back (c);
+          if (c > 0)
+            {
+              m_fromIndices.push_back (fromIndex);
+              m_coefficients.push_back (c);
+            }
         }
-
-      m_conversionMatrix.push_back (coeffs);
+      m_rowOffsets.push_back (m_coefficients.size ());
     }
-
+  NS_LOG_LOGIC ("non-zero coefficients: " << m_coefficients.size ()
+                << " out of " << toSpectrumModel->GetNumBands () * fromSpectrumModel->GetNumBands ());
 }
 
 
@@ -73,31 +79,27 @@ double SpectrumConverter::GetCoefficient (const BandInfo& from, const BandInfo&
 Ptr<SpectrumValue>
 SpectrumConverter::Convert (Ptr<const SpectrumValue> fvvf) const
 {
+  NS_ASSERT_MSG (!m_rowOffsets.empty (), "SpectrumConverter used without spectrum models");
   NS_ASSERT ( *(fvvf->GetSpectrumModel ()) == *m_fromSpectrumModel);
 
   Ptr<SpectrumValue> tvvf = Create<SpectrumValue> (m_toSpectrumModel);
+  NS_ASSERT (tvvf->ValuesEnd () - tvvf->ValuesBegin () + 1 == (ptrdiff_t) m_rowOffsets.size ());
 
-  Values::iterator tvit = tvvf->ValuesBegin ();
+  const double* fromValues = &(*fvvf->ConstValuesBegin ());
+  double* toValues = &(*tvvf->ValuesBegin ());
+  const size_t* fromIndices = m_fromIndices.empty () ? 0 : &m_fromIndices[0];
+  const double* coefficients = m_coefficients.empty () ? 0 : &m_coefficients[0];
+  const size_t numToBands = m_rowOffsets.empty () ? 0 : m_rowOffsets.size () - 1;
 
-
-  for (std::vector<std::vector<double> >::const_iterator toit = m_conversionMatrix.begin ();
-       toit != m_conversionMatrix.end ();
-       ++toit)
+  for (size_t i = 0; i < numToBands; ++i)
     {
-      NS_ASSERT (tvit != tvvf->ValuesEnd ());
-      Values::const_iterator fvit = fvvf->ConstValuesBegin ();
-
+      const size_t end = m_rowOffsets[i + 1];
       double sum = 0;
-      for (std::vector<double>::const_iterator fromit = toit->begin ();
-           fromit != toit->end ();
-           ++fromit)
+      for (size_t k = m_rowOffsets[i]; k < end; ++k)
         {
-          NS_ASSERT (fvit != fvvf->ConstValuesEnd ());
-          sum += (*fvit) * (*fromit);
-          ++fvit;
+          sum += fromValues[fromIndices[k]] * coefficients[k];
         }
-      *tvit = sum;
-      ++tvit;
+      toValues[i] = sum;
     }
 
   return tvvf;
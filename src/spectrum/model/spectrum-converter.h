@@ -38,6 +38,11 @@ namespace ns3 {
  * and devices using a finer representation (e.g., one frequency for
  * each OFDM subcarrier).
  *
+ * Since in practice each band of the destination SpectrumModel
+ * overlaps with only a few bands of the source SpectrumModel, the
+ * conversion coefficients are stored in a compressed sparse row
+ * (CSR) layout: for each destination band, only the indices and the
+ * values of the non-zero coefficients are kept.
  */
 class SpectrumConverter : public SimpleRefCount<SpectrumConverter>
 {
@@ -78,7 +83,14 @@ private:
    */
   double GetCoefficient (const BandInfo& from, const BandInfo& to) const;
 
-  std::vector<std::vector<double> > m_conversionMatrix; //!< matrix of conversion coefficients
+  /**
+   * for each destination band i, the non-zero coefficients of the
+   * conversion matrix are stored in positions [m_rowOffsets[i], m_rowOffsets[i+1])
+   * of m_coefficients and m_fromIndices
+   */
+  std::vector<size_t> m_rowOffsets;
+  std::vector<size_t> m_fromIndices; //!< index of the source band of each non-zero coefficient
+  std::vector<double> m_coefficients; //!< non-zero conversion coefficients
   Ptr<const SpectrumModel> m_fromSpectrumModel;  //!<  the SpectrumModel this SpectrumConverter instance can convert from
   Ptr<const SpectrumModel> m_toSpectrumModel;    //!<  the SpectrumModel this SpectrumConverter instance can convert to
 
@@ -62,6 +62,7 @@ SpectrumInterference::DoDispose ()
   NS_LOG_FUNCTION (this);
   m_rxSignal = 0;
   m_allSignals = 0;
+  m_sinr = 0;
   m_noise = 0;
   m_errorModel = 0;
   Object::DoDispose ();
@@ -131,10 +132,10 @@ SpectrumInterference::ConditionallyEvaluateChunk ()
   NS_LOG_LOGIC ("if condition: " << condition);
   if (condition)
     {
-      SpectrumValue sinr = (*m_rxSignal) / ((*m_allSignals) - (*m_rxSignal) + (*m_noise));
+      ComputeSinr (*m_sinr, *m_rxSignal, *m_allSignals, *m_noise);
       Time duration = Now () - m_lastChangeTime;
       NS_LOG_LOGIC ("calling m_errorModel->EvaluateChunk (sinr, duration)");
-      m_errorModel->EvaluateChunk (sinr, duration);
+      m_errorModel->EvaluateChunk (*m_sinr, duration);
     }
 }
 
@@ -148,6 +149,7 @@ SpectrumInterference::SetNoisePowerSpectralDensity (Ptr<const SpectrumValue> noi
   // we'll now create a zeroed SpectrumValue using the same
   // SpectrumModel which is being specified for the noise.
   m_allSignals = Create<SpectrumValue> (noisePsd->GetSpectrumModel ());
+  m_sinr = Create<SpectrumValue> (noisePsd->GetSpectrumModel ());
 }
 
 void
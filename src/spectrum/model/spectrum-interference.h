@@ -141,6 +141,12 @@ private:
    */
   Ptr<SpectrumValue> m_allSignals;
 
+  /**
+   * Stores the SINR of the last chunk, reused across chunks to avoid
+   * allocating a new SpectrumValue for each of them
+   */
+  Ptr<SpectrumValue> m_sinr;
+
   Ptr<const SpectrumValue> m_noise; //!< Noise spectral power density
 
   Time m_lastChangeTime;     //!< the time of the last change in m_TotalPower
@@ -31,6 +31,7 @@ namespace ns3 {
 NS_LOG_COMPONENT_DEFINE ("SpectrumSignalParameters");
 
 SpectrumSignalParameters::SpectrumSignalParameters ()
+  : psdGain (1.0)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -45,6 +46,8 @@ SpectrumSignalParameters::SpectrumSignalParameters (const SpectrumSignalParamete
   NS_LOG_FUNCTION (this << &p);
   // shallow copy only 
   psd = p.psd;
+  sharedPsd = p.sharedPsd;
+  psdGain = p.psdGain;
   duration = p.duration;
   txPhy = p.txPhy;
   txAntenna = p.txAntenna;
@@ -57,6 +60,31 @@ SpectrumSignalParameters::Copy ()
   return Create<SpectrumSignalParameters> (*this);
 }
 
+Ptr<SpectrumValue>
+SpectrumSignalParameters::GetPsd ()
+{
+  NS_LOG_FUNCTION (this);
+  if (sharedPsd != 0)
+    {
+      NS_LOG_LOGIC ("materializing shared PSD with gain " << psdGain);
+      psd = sharedPsd->Copy ();
+      *psd *= psdGain;
+      sharedPsd = 0;
+      psdGain = 1.0;
+    }
+  return psd;
+}
+
+Ptr<const SpectrumValue>
+SpectrumSignalParameters::GetUnscaledPsd () const
+{
+  if (sharedPsd != 0)
+    {
+      return sharedPsd;
+    }
+  return psd;
+}
+
 
 
 } // namespace ns3
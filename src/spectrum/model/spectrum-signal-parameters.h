@@ -93,6 +93,41 @@ struct SpectrumSignalParameters : public SimpleRefCount<SpectrumSignalParameters
    */
   Ptr <SpectrumValue> psd;
 
+  /**
+   * Immutable Power Spectral Density shared among all the receivers
+   * of the same transmission. When this pointer is set, the actual
+   * received PSD is sharedPsd scaled by psdGain, and psd is left
+   * unset until some receiver actually needs per-band values (see
+   * GetPsd ()). This avoids allocating and scaling a private copy of
+   * the PSD for every receiver.
+   */
+  Ptr <const SpectrumValue> sharedPsd;
+
+  /**
+   * The linear gain to be applied to sharedPsd to obtain the actual
+   * PSD. It is equal to 1 whenever sharedPsd is not set.
+   */
+  double psdGain;
+
+  /**
+   * Get the Power Spectral Density of the signal. If the signal is
+   * held in shared form, a private copy of sharedPsd scaled by psdGain
+   * is created and stored in psd, and the shared form is dropped.
+   *
+   * \return the Power Spectral Density of the signal
+   */
+  Ptr<SpectrumValue> GetPsd ();
+
+  /**
+   * Get the Power Spectral Density of the signal without applying
+   * psdGain and without making any copy. This is meant for receivers that
+   * only need quantities (such as the integral over a filter) that can
+   * be computed on the unscaled PSD and then multiplied by psdGain.
+   *
+   * \return sharedPsd if set, psd otherwise
+   */
+  Ptr<const SpectrumValue> GetUnscaledPsd () const;
+
   /**
    * The duration of the packet transmission. It is
    * assumed that the Power Spectral Density remains constant for the
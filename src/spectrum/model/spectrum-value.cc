@@ -403,6 +403,96 @@ Integral (const SpectrumValue& arg)
   return i;
 }
 
+double
+FilteredIntegral (const SpectrumValue& arg, const SpectrumValue& filter)
+{
+  NS_ASSERT (arg.GetSpectrumModelUid () == filter.GetSpectrumModelUid ());
+  double i = 0;
+  Values::const_iterator vit = arg.ConstValuesBegin ();
+  Values::const_iterator fit = filter.ConstValuesBegin ();
+  Bands::const_iterator bit = arg.ConstBandsBegin ();
+  while (vit != arg.ConstValuesEnd ())
+    {
+      NS_ASSERT (bit != arg.ConstBandsEnd ());
+      NS_ASSERT (fit != filter.ConstValuesEnd ());
+      i += (*vit) * (*fit) * (bit->fh - bit->fl);
+      ++vit;
+      ++fit;
+      ++bit;
+    }
+  NS_ASSERT (bit == arg.ConstBandsEnd ());
+  return i;
+}
+
+/**
+ * Compute the SINR, and optionally the interference plus noise, of
+ * each component. The components are independent and the arrays do
+ * not overlap, so that the compiler can vectorize the loop.
+ *
+ * \param sinr the SINR
+ * \param interference the interference plus noise, or 0
+ * \param signal the signal of interest
+ * \param allSignals all the signals
+ * \param noise the noise
+ * \param n the number of components
+ */
+static void
+SinrKernel (double * __restrict sinr, double * __restrict interference,
+            const double * __restrict signal, const double * __restrict allSignals,
+            const double * __restrict noise, size_t n)
+{
+  if (interference == 0)
+    {
+      for (size_t i = 0; i < n; ++i)
+        {
+          sinr[i] = signal[i] / (allSignals[i] - signal[i] + noise[i]);
+        }
+    }
+  else
+    {
+      for (size_t i = 0; i < n; ++i)
+        {
+          double interf = allSignals[i] - signal[i] + noise[i];
+          interference[i] = interf;
+          sinr[i] = signal[i] / interf;
+        }
+    }
+}
+
+void
+ComputeSinr (SpectrumValue& sinr, const SpectrumValue& signal,
+             const SpectrumValue& allSignals, const SpectrumValue& noise)
+{
+  NS_ASSERT (sinr.GetSpectrumModelUid () == signal.GetSpectrumModelUid ());
+  NS_ASSERT (allSignals.GetSpectrumModelUid () == signal.GetSpectrumModelUid ());
+  NS_ASSERT (noise.GetSpectrumModelUid () == signal.GetSpectrumModelUid ());
+  size_t n = signal.GetSpectrumModel ()->GetNumBands ();
+  if (n > 0)
+    {
+      SinrKernel (&(*sinr.ValuesBegin ()), 0, &(*signal.ConstValuesBegin ()),
+                  &(*allSignals.ConstValuesBegin ()), &(*noise.ConstValuesBegin ()), n);
+    }
+}
+
+void
+ComputeSinr (SpectrumValue& sinr, SpectrumValue& interference,
+             const SpectrumValue& signal, const SpectrumValue& allSignals,
+             const SpectrumValue& noise)
+{
+  NS_ASSERT (sinr.GetSpectrumModelUid () == signal.GetSpectrumModelUid ());
+  NS_ASSERT (interference.GetSpectrumModelUid () == signal.GetSpectrumModelUid ());
+  NS_ASSERT (allSignals.GetSpectrumModelUid () == signal.GetSpectrumModelUid ());
+  NS_ASSERT (noise.GetSpectrumModelUid () == signal.GetSpectrumModelUid ());
+  NS_ASSERT (&sinr != &interference);
+  size_t n = signal.GetSpectrumModel ()->GetNumBands ();
+  if (n > 0)
+    {
+      SinrKernel (&(*sinr.ValuesBegin ()), &(*interference.ValuesBegin ()),
+                  &(*signal.ConstValuesBegin ()), &(*allSignals.ConstValuesBegin ()),
+                  &(*noise.ConstValuesBegin ()), n);
+    }
+}
+
 
 
 Ptr<SpectrumValue>
@@ -620,6 +620,53 @@ SpectrumValue Log2 (const SpectrumValue& arg);
 SpectrumValue Log (const SpectrumValue& arg);
 double Integral (const SpectrumValue& arg);
 
+/**
+ * Compute the integral of the product of two SpectrumValue instances
+ * defined over the same SpectrumModel, i.e., Integral (arg * filter),
+ * without allocating the intermediate product.
+ *
+ * \param arg the SpectrumValue to be integrated, e.g., a PSD
+ * \param filter the SpectrumValue by which arg is weighted, e.g., the
+ * frequency response of a receive filter
+ *
+ * \return the integral of arg * filter
+ */
+double FilteredIntegral (const SpectrumValue& arg, const SpectrumValue& filter);
+
+/**
+ * Compute the SINR of a signal, i.e., signal / (allSignals - signal +
+ * noise), into an existing SpectrumValue, in a single pass and without
+ * allocating any intermediate value. All the SpectrumValue instances
+ * must be defined over the same SpectrumModel.
+ *
+ * \param sinr the SpectrumValue receiving the SINR
+ * \param signal the power spectral density of the signal of interest
+ * \param allSignals the power spectral density of all the signals
+ * being received, including the signal of interest
+ * \param noise the power spectral density of the noise
+ */
+void ComputeSinr (SpectrumValue& sinr, const SpectrumValue& signal,
+                  const SpectrumValue& allSignals, const SpectrumValue& noise);
+
+/**
+ * Compute the interference plus noise power spectral density of a
+ * signal, i.e., allSignals - signal + noise, and its SINR, i.e.,
+ * signal / (allSignals - signal + noise), in a single pass and without
+ * allocating any intermediate value. All the SpectrumValue instances
+ * must be defined over the same SpectrumModel.
+ *
+ * \param sinr the SpectrumValue receiving the SINR
+ * \param interference the SpectrumValue receiving the interference
+ * plus noise
+ * \param signal the power spectral density of the signal of interest
+ * \param allSignals the power spectral density of all the signals
+ * being received, including the signal of interest
+ * \param noise the power spectral density of the noise
+ */
+void ComputeSinr (SpectrumValue& sinr, SpectrumValue& interference,
+                  const SpectrumValue& signal, const SpectrumValue& allSignals,
+                  const SpectrumValue& noise);
+
 
 } // namespace ns3
 
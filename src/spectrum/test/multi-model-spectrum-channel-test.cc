@@ -0,0 +1,262 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include <ns3/core-module.h>
+#include <ns3/test.h>
+#include <ns3/mobility-module.h>
+#include <ns3/spectrum-module.h>
+#include <ns3/propagation-module.h>
+#include <map>
+
+
+NS_LOG_COMPONENT_DEFINE ("MultiModelSpectrumChannelTest");
+
+using namespace ns3;
+
+
+
+/**
+ * Check that, when MaxInterferenceRange is set, signals are
+ * delivered only to the receivers within that range, and that the
+ * spatial index follows the position changes of the receivers.
+ */
+class MultiModelSpectrumChannelSpatialIndexTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   * \param setRangeLast whether MaxInterferenceRange is set after the
+   * receivers are added
+   */
+  MultiModelSpectrumChannelSpatialIndexTestCase (bool setRangeLast);
+  virtual ~MultiModelSpectrumChannelSpatialIndexTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  void TracePathLoss (Ptr<SpectrumPhy> txPhy, Ptr<SpectrumPhy> rxPhy, double lossDb);
+
+  bool m_setRangeLast;
+  std::map<Ptr<SpectrumPhy>, uint32_t> m_evaluations;
+};
+
+MultiModelSpectrumChannelSpatialIndexTestCase::MultiModelSpectrumChannelSpatialIndexTestCase (bool setRangeLast)
+  : TestCase (setRangeLast ? "Check receiver culling with MaxInterferenceRange set after the receivers are added"
+              : "Check receiver culling based on MaxInterferenceRange"),
+    m_setRangeLast (setRangeLast)
+{
+}
+
+MultiModelSpectrumChannelSpatialIndexTestCase::~MultiModelSpectrumChannelSpatialIndexTestCase ()
+{
+}
+
+void
+MultiModelSpectrumChannelSpatialIndexTestCase::TracePathLoss (Ptr<SpectrumPhy> txPhy, Ptr<SpectrumPhy> rxPhy, double lossDb)
+{
+  m_evaluations[rxPhy]++;
+}
+
+void
+MultiModelSpectrumChannelSpatialIndexTestCase::DoRun (void)
+{
+  Ptr<SpectrumValue> txPsd = MicrowaveOvenSpectrumValueHelper::CreatePowerSpectralDensityMwo1 ();
+
+  Ptr<MultiModelSpectrumChannel> channel = CreateObject<MultiModelSpectrumChannel> ();
+  if (!m_setRangeLast)
+    {
+      channel->SetAttribute ("MaxInterferenceRange", DoubleValue (150.0));
+    }
+  channel->TraceConnectWithoutContext ("PathLoss", MakeCallback (&MultiModelSpectrumChannelSpatialIndexTestCase::TracePathLoss, this));
+
+  Ptr<ConstantPositionMobilityModel> txMobility = CreateObject<ConstantPositionMobilityModel> ();
+  txMobility->SetPosition (Vector (0, 0, 0));
+  Ptr<WaveformGenerator> tx = CreateObject<WaveformGenerator> ();
+  tx->SetMobility (txMobility);
+  tx->SetChannel (channel);
+  tx->SetTxPowerSpectralDensity (txPsd);
+  tx->SetPeriod (Seconds (1.0));
+  tx->SetDutyCycle (0.5);
+
+  double distances[] = { 10.0, 100.0, 1000.0 };
+  std::vector<Ptr<SpectrumAnalyzer> > rx;
+  std::vector<Ptr<ConstantPositionMobilityModel> > rxMobility;
+  for (uint32_t i = 0; i < 3; ++i)
+    {
+      Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+      mobility->SetPosition (Vector (distances[i], 0, 0));
+      Ptr<SpectrumAnalyzer> analyzer = CreateObject<SpectrumAnalyzer> ();
+      analyzer->SetMobility (mobility);
+      analyzer->SetRxSpectrumModel (ConstCast<SpectrumModel> (txPsd->GetSpectrumModel ()));
+      channel->AddRx (analyzer);
+      rx.push_back (analyzer);
+      rxMobility.push_back (mobility);
+    }
+  if (m_setRangeLast)
+    {
+      channel->SetAttribute ("MaxInterferenceRange", DoubleValue (150.0));
+    }
+
+  // transmissions start at 1s and 2s; the far receiver gets in range in between
+  Simulator::Schedule (Seconds (1.0), &WaveformGenerator::Start, tx);
+  Simulator::Schedule (Seconds (1.7), &ConstantPositionMobilityModel::SetPosition, rxMobility[2], Vector (0, 50, 0));
+  Simulator::Schedule (Seconds (2.7), &WaveformGenerator::Stop, tx);
+
+  Simulator::Stop (Seconds (3.0));
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_evaluations[rx[0]], 2, "receiver at 10 m should be reached by both transmissions");
+  NS_TEST_ASSERT_MSG_EQ (m_evaluations[rx[1]], 2, "receiver at 100 m should be reached by both transmissions");
+  NS_TEST_ASSERT_MSG_EQ (m_evaluations[rx[2]], 1, "moved receiver should be reached only by the second transmission");
+
+  Simulator::Destroy ();
+}
+
+
+
+/**
+ * Check that the link cache is used for the links between static
+ * devices, that it is invalidated upon a course change, and that it
+ * is not used with a non-cacheable PropagationLossModel.
+ */
+class MultiModelSpectrumChannelLinkCacheTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   * \param cacheable whether a cacheable PropagationLossModel is used
+   */
+  MultiModelSpectrumChannelLinkCacheTestCase (bool cacheable);
+  virtual ~MultiModelSpectrumChannelLinkCacheTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  void TracePathLoss (Ptr<SpectrumPhy> txPhy, Ptr<SpectrumPhy> rxPhy, double lossDb);
+
+  bool m_cacheable;
+  std::map<Ptr<SpectrumPhy>, std::vector<double> > m_losses;
+};
+
+MultiModelSpectrumChannelLinkCacheTestCase::MultiModelSpectrumChannelLinkCacheTestCase (bool cacheable)
+  : TestCase (cacheable ? "Check the link cache with a cacheable loss model" : "Check the link cache with a non-cacheable loss model"),
+    m_cacheable (cacheable)
+{
+}
+
+MultiModelSpectrumChannelLinkCacheTestCase::~MultiModelSpectrumChannelLinkCacheTestCase ()
+{
+}
+
+void
+MultiModelSpectrumChannelLinkCacheTestCase::TracePathLoss (Ptr<SpectrumPhy> txPhy, Ptr<SpectrumPhy> rxPhy, double lossDb)
+{
+  m_losses[rxPhy].push_back (lossDb);
+}
+
+void
+MultiModelSpectrumChannelLinkCacheTestCase::DoRun (void)
+{
+  Ptr<SpectrumValue> txPsd = MicrowaveOvenSpectrumValueHelper::CreatePowerSpectralDensityMwo1 ();
+
+  Ptr<MultiModelSpectrumChannel> channel = CreateObject<MultiModelSpectrumChannel> ();
+  channel->SetAttribute ("EnableLinkCache", BooleanValue (true));
+  if (m_cacheable)
+    {
+      channel->AddPropagationLossModel (CreateObject<FriisPropagationLossModel> ());
+    }
+  else
+    {
+      Ptr<RandomPropagationLossModel> loss = CreateObject<RandomPropagationLossModel> ();
+      loss->SetAttribute ("Variable", StringValue ("ns3::UniformRandomVariable[Min=0.0|Max=10.0]"));
+      channel->AddPropagationLossModel (loss);
+    }
+  channel->TraceConnectWithoutContext ("PathLoss", MakeCallback (&MultiModelSpectrumChannelLinkCacheTestCase::TracePathLoss, this));
+
+  Ptr<ConstantPositionMobilityModel> txMobility = CreateObject<ConstantPositionMobilityModel> ();
+  txMobility->SetPosition (Vector (0, 0, 0));
+  Ptr<WaveformGenerator> tx = CreateObject<WaveformGenerator> ();
+  tx->SetMobility (txMobility);
+  tx->SetChannel (channel);
+  tx->SetTxPowerSpectralDensity (txPsd);
+  tx->SetPeriod (Seconds (1.0));
+  tx->SetDutyCycle (0.5);
+
+  std::vector<Ptr<SpectrumAnalyzer> > rx;
+  std::vector<Ptr<ConstantPositionMobilityModel> > rxMobility;
+  for (uint32_t i = 0; i < 2; ++i)
+    {
+      Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+      mobility->SetPosition (Vector (10.0 * (i + 1), 0, 0));
+      Ptr<SpectrumAnalyzer> analyzer = CreateObject<SpectrumAnalyzer> ();
+      analyzer->SetMobility (mobility);
+      analyzer->SetRxSpectrumModel (ConstCast<SpectrumModel> (txPsd->GetSpectrumModel ()));
+      channel->AddRx (analyzer);
+      rx.push_back (analyzer);
+      rxMobility.push_back (mobility);
+    }
+
+  // transmissions start at 1s, 2s and 3s; the second receiver moves
+  // before the last one
+  Simulator::Schedule (Seconds (1.0), &WaveformGenerator::Start, tx);
+  Simulator::Schedule (Seconds (2.7), &ConstantPositionMobilityModel::SetPosition, rxMobility[1], Vector (200, 0, 0));
+  Simulator::Schedule (Seconds (3.7), &WaveformGenerator::Stop, tx);
+
+  Simulator::Stop (Seconds (4.0));
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_losses[rx[0]].size (), 3, "wrong number of transmissions to the first receiver");
+  NS_TEST_ASSERT_MSG_EQ (m_losses[rx[1]].size (), 3, "wrong number of transmissions to the second receiver");
+  if (m_cacheable)
+    {
+      NS_TEST_ASSERT_MSG_EQ (channel->GetLinkCacheMisses (), 3, "wrong number of link cache misses");
+      NS_TEST_ASSERT_MSG_EQ (channel->GetLinkCacheHits (), 3, "wrong number of link cache hits");
+      for (uint32_t i = 1; i < 3; ++i)
+        {
+          NS_TEST_ASSERT_MSG_EQ_TOL (m_losses[rx[0]][i], m_losses[rx[0]][0], 1e-9, "cached loss differs from the calculated one");
+        }
+      NS_TEST_ASSERT_MSG_EQ_TOL (m_losses[rx[1]][1], m_losses[rx[1]][0], 1e-9, "cached loss differs from the calculated one");
+      // 20 dB more with Friis when moving from 20 m to 200 m
+      NS_TEST_ASSERT_MSG_EQ_TOL (m_losses[rx[1]][2], m_losses[rx[1]][0] + 20.0, 1e-6, "stale loss used after a course change");
+    }
+  else
+    {
+      NS_TEST_ASSERT_MSG_EQ (channel->GetLinkCacheMisses (), 0, "link cache should not be used");
+      NS_TEST_ASSERT_MSG_EQ (channel->GetLinkCacheHits (), 0, "link cache should not be used");
+    }
+
+  Simulator::Destroy ();
+}
+
+
+
+class MultiModelSpectrumChannelTestSuite : public TestSuite
+{
+public:
+  MultiModelSpectrumChannelTestSuite ();
+};
+
+MultiModelSpectrumChannelTestSuite::MultiModelSpectrumChannelTestSuite ()
+  : TestSuite ("multi-model-spectrum-channel", UNIT)
+{
+  NS_LOG_INFO ("creating MultiModelSpectrumChannelTestSuite");
+
+  AddTestCase (new MultiModelSpectrumChannelSpatialIndexTestCase (false), TestCase::QUICK);
+  AddTestCase (new MultiModelSpectrumChannelSpatialIndexTestCase (true), TestCase::QUICK);
+  AddTestCase (new MultiModelSpectrumChannelLinkCacheTestCase (true), TestCase::QUICK);
+  AddTestCase (new MultiModelSpectrumChannelLinkCacheTestCase (false), TestCase::QUICK);
+}
+
+static MultiModelSpectrumChannelTestSuite g_multiModelSpectrumChannelTestSuite;
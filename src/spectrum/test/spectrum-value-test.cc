@@ -82,6 +82,40 @@ SpectrumValueTestCase::DoRun (void)
 
 
 
+class SpectrumValueFilteredIntegralTestCase : public TestCase
+{
+public:
+  SpectrumValueFilteredIntegralTestCase (SpectrumValue arg, SpectrumValue filter, std::string name);
+  virtual ~SpectrumValueFilteredIntegralTestCase ();
+  virtual void DoRun (void);
+
+private:
+  SpectrumValue m_arg;
+  SpectrumValue m_filter;
+};
+
+SpectrumValueFilteredIntegralTestCase::SpectrumValueFilteredIntegralTestCase (SpectrumValue arg, SpectrumValue filter, std::string name)
+  : TestCase (name),
+    m_arg (arg),
+    m_filter (filter)
+{
+}
+
+SpectrumValueFilteredIntegralTestCase::~SpectrumValueFilteredIntegralTestCase ()
+{
+}
+
+void
+SpectrumValueFilteredIntegralTestCase::DoRun (void)
+{
+  double expected = Integral (m_arg * m_filter);
+  NS_TEST_ASSERT_MSG_EQ_TOL (FilteredIntegral (m_arg, m_filter), expected, TOLERANCE, "FilteredIntegral does not match Integral of the product");
+}
+
+
+
+
+
 class SpectrumValueTestSuite : public TestSuite
 {
 public:
@@ -241,6 +275,18 @@ SpectrumValueTestSuite::SpectrumValueTestSuite ()
   tv1rs3 = v1 >> 3;
   AddTestCase (new SpectrumValueTestCase (tv1rs3, v1rs3, "tv1rs3 = v1 >> 3"), TestCase::QUICK);
 
+  AddTestCase (new SpectrumValueFilteredIntegralTestCase (v1, v2, "FilteredIntegral (v1, v2)"), TestCase::QUICK);
+
+  SpectrumValue sinr (f), interf (f), tsinr (f), tinterf (f);
+  interf = v3 - v1 + v7;
+  sinr = v1 / interf;
+  ComputeSinr (tsinr, v1, v3, v7);
+  AddTestCase (new SpectrumValueTestCase (tsinr, sinr, "ComputeSinr (tsinr, v1, v3, v7)"), TestCase::QUICK);
+  tsinr = 0;
+  ComputeSinr (tsinr, tinterf, v1, v3, v7);
+  AddTestCase (new SpectrumValueTestCase (tsinr, sinr, "ComputeSinr (tsinr, tinterf, v1, v3, v7)"), TestCase::QUICK);
+  AddTestCase (new SpectrumValueTestCase (tinterf, interf, "tinterf = v3 - v1 + v7"), TestCase::QUICK);
+
 
 }
 
@@ -329,6 +375,24 @@ SpectrumConverterTestSuite::SpectrumConverterTestSuite ()
   AddTestCase (new SpectrumValueTestCase (t21b, *res, ""), TestCase::QUICK);
 
 
+  // partially overlapping models: destination bands with no overlap
+  // must be converted to zero
+  std::vector<double> f3;
+  for (f = 6; f <= 12; f += 2)
+    {
+      f3.push_back (f);
+    }
+  Ptr<SpectrumModel> sof3 = Create<SpectrumModel> (f3);
+
+  SpectrumConverter c23 (sof2, sof3);
+  res = c23.Convert (v2b);
+  SpectrumValue t23 (sof3);
+  t23[0] = 2 * 0.25 + 4 * 0.5 + 6 * 0.25;
+  t23[1] = 6 * 0.25 + 3 * 0.5;
+  t23[2] = 0;
+  t23[3] = 0;
+  AddTestCase (new SpectrumValueTestCase (t23, *res, ""), TestCase::QUICK);
+
 }
 
 
@@ -18,7 +18,9 @@
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
 
+#include <cmath>
 #include "error-rate-model.h"
+#include "ns3/double.h"
 
 namespace ns3 {
 
@@ -29,10 +31,101 @@ TypeId ErrorRateModel::GetTypeId (void)
   static TypeId tid = TypeId ("ns3::ErrorRateModel")
     .SetParent<Object> ()
     .SetGroupName ("Wifi")
+    .AddAttribute ("SnrCacheResolution",
+                   "The resolution, in dB, to which the SNR of the chunks is quantized "
+                   "to cache their success rate, or 0 to compute the success rate "
+                   "of each chunk at its exact SNR.",
+                   DoubleValue (0.0),
+                   MakeDoubleAccessor (&ErrorRateModel::SetSnrCacheResolution,
+                                       &ErrorRateModel::GetSnrCacheResolution),
+                   MakeDoubleChecker<double> (0.0))
   ;
   return tid;
 }
 
+/// Number of entries of the chunk success rate cache: 2^10, indexed by the top 10 bits of a 64-bit hash.
+static const uint32_t CACHE_SIZE = 1024;
+
+ErrorRateModel::ErrorRateModel ()
+  : m_snrCacheResolution (0.0)
+{
+  m_cacheStats.lookups = 0;
+  m_cacheStats.hits = 0;
+}
+
+void
+ErrorRateModel::SetSnrCacheResolution (double resolution)
+{
+  m_snrCacheResolution = resolution;
+  if (resolution > 0)
+    {
+      m_cache.resize (CACHE_SIZE);
+      FlushChunkSuccessRateCache ();
+    }
+  else
+    {
+      std::vector<CacheEntry> ().swap (m_cache);
+    }
+}
+
+double
+ErrorRateModel::GetSnrCacheResolution (void) const
+{
+  return m_snrCacheResolution;
+}
+
+void
+ErrorRateModel::FlushChunkSuccessRateCache (void)
+{
+  for (std::vector<CacheEntry>::iterator it = m_cache.begin (); it != m_cache.end (); ++it)
+    {
+      it->nbits = 0;
+    }
+}
+
+ErrorRateModel::CacheStats
+ErrorRateModel::GetCacheStats (void) const
+{
+  return m_cacheStats;
+}
+
+double
+ErrorRateModel::GetCachedChunkSuccessRate (WifiMode mode, WifiTxVector txVector, double snr, uint32_t nbits) const
+{
+  if (m_cache.empty () || !(snr > 0) || nbits == 0)
+    {
+      return GetChunkSuccessRate (mode, txVector, snr, nbits);
+    }
+  double snrSteps = std::floor (10.0 * std::log10 (snr) / m_snrCacheResolution + 0.5);
+  if (std::fabs (snrSteps) > 0x3fffffff)
+    {
+      return GetChunkSuccessRate (mode, txVector, snr, nbits);
+    }
+  int32_t snrIndex = static_cast<int32_t> (snrSteps);
+  uint64_t txParams = (static_cast<uint64_t> (mode.GetUid ()) << 32)
+    | (static_cast<uint64_t> (txVector.GetChannelWidth () & 0xffff) << 16)
+    | (static_cast<uint64_t> (txVector.GetNss ()) << 8)
+    | (txVector.IsShortGuardInterval () ? 1 : 0);
+  // multiplicative hashing of the key, keeping the top bits
+  uint64_t hash = txParams ^ (nbits * 0xbf58476d1ce4e5b9ULL)
+    ^ (static_cast<uint64_t> (static_cast<uint32_t> (snrIndex)) * 0x94d049bb133111ebULL);
+  hash *= 0x9e3779b97f4a7c15ULL;
+  CacheEntry &entry = m_cache[hash >> 54];
+  m_cacheStats.lookups++;
+  if (entry.nbits == nbits && entry.snrIndex == snrIndex && entry.txParams == txParams)
+    {
+      m_cacheStats.hits++;
+      return entry.csr;
+    }
+  double quantizedSnr = std::pow (10.0, snrIndex * m_snrCacheResolution / 10.0);
+  double csr = GetChunkSuccessRate (mode, txVector, quantizedSnr, nbits);
+  entry.txParams = txParams;
+  entry.nbits = nbits;
+  entry.snrIndex = snrIndex;
+  entry.csr = csr;
+  return csr;
+}
+
 double
 ErrorRateModel::CalculateSnr (WifiTxVector txVector, double ber) const
 {
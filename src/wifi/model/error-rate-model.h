@@ -22,6 +22,7 @@
 #define ERROR_RATE_MODEL_H
 
 #include <stdint.h>
+#include <vector>
 #include "wifi-mode.h"
 #include "wifi-tx-vector.h"
 #include "ns3/object.h"
@@ -37,6 +38,18 @@ class ErrorRateModel : public Object
 public:
   static TypeId GetTypeId (void);
 
+  /**
+   * Counters of the chunk success rate cache, see
+   * GetCachedChunkSuccessRate.
+   */
+  struct CacheStats
+  {
+    uint64_t lookups;  //!< Number of chunks looked up in the cache.
+    uint64_t hits;     //!< Number of chunks found in the cache.
+  };
+
+  ErrorRateModel ();
+
   /**
    * \param txVector a specific transmission vector including WifiMode
    * \param ber a target ber
@@ -69,6 +82,67 @@ public:
    * \return probability of successfully receiving the chunk
    */
   virtual double GetChunkSuccessRate (WifiMode mode, WifiTxVector txVector, double snr, uint32_t nbits) const = 0;
+
+  /**
+   * Return the probability that the given 'chunk' of the packet will
+   * be successfully received by the PHY, as GetChunkSuccessRate, but
+   * through a cache when the SnrCacheResolution attribute is not zero.
+   *
+   * The SNR is then quantized to the resolution, in dB, and the chunk
+   * success rate of the quantized SNR is stored in a direct-mapped
+   * cache indexed by the mode, the channel width, the number of
+   * spatial streams, the guard interval, the number of bits and the
+   * quantized SNR, so that chunks which map to the same entry cost a
+   * single lookup.
+   *
+   * \param mode the Wi-Fi mode applicable to this chunk
+   * \param txVector TXVECTOR of the overall transmission
+   * \param snr the SNR of the chunk
+   * \param nbits the number of bits in this chunk
+   *
+   * \return probability of successfully receiving the chunk
+   */
+  double GetCachedChunkSuccessRate (WifiMode mode, WifiTxVector txVector, double snr, uint32_t nbits) const;
+
+  /**
+   * \return the counters of the chunk success rate cache
+   */
+  CacheStats GetCacheStats (void) const;
+
+
+protected:
+  /**
+   * Remove all the entries of the chunk success rate cache. Subclasses
+   * must call this method when a change of their configuration changes
+   * the chunk success rates.
+   */
+  void FlushChunkSuccessRateCache (void);
+
+
+private:
+  /**
+   * Set the resolution of the chunk success rate cache.
+   *
+   * \param resolution the resolution, in dB, or 0 to disable the cache
+   */
+  void SetSnrCacheResolution (double resolution);
+  /**
+   * \return the resolution of the chunk success rate cache, in dB
+   */
+  double GetSnrCacheResolution (void) const;
+
+  /** An entry of the chunk success rate cache. */
+  struct CacheEntry
+  {
+    uint64_t txParams;   //!< The mode, channel width, NSS and guard interval.
+    uint32_t nbits;      //!< The number of bits, or 0 if the entry is empty.
+    int32_t snrIndex;    //!< The quantized SNR, in units of the resolution.
+    double csr;          //!< The chunk success rate.
+  };
+
+  double m_snrCacheResolution;               //!< The SNR resolution of the cache, in dB.
+  mutable std::vector<CacheEntry> m_cache;   //!< The cache entries.
+  mutable CacheStats m_cacheStats;           //!< The cache counters.
 };
 
 } //namespace ns3
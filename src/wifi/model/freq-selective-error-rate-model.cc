@@ -31,6 +31,57 @@ NS_LOG_COMPONENT_DEFINE ("FreqSelectiveErrorRateModel");
 
 NS_OBJECT_ENSURE_REGISTERED (FreqSelectiveErrorRateModel);
 
+/**
+ * The parameters of the bit error rate curve of an HT MCS, which is
+ * 1 below snrDbMin and 10 ^ (p1 * snrDb + p2) above
+ */
+struct BerCurve
+{
+  double snrDbMin; //!< minimum SNR, in dB
+  double p1;       //!< slope of the log linear curve
+  double p2;       //!< intercept of the log linear curve
+};
+
+/**
+ * BER curves for 2 RX antennas, indexed by HT MCS
+ */
+static const BerCurve g_berCurves2Rx[] = {
+  //1 spatial stream, 2 RX antennas, from UW link sim
+  { -5.1, -0.300827, -3.756085 },  // HtMcs0
+  { -1.6, -0.309238, -2.965011 },  // HtMcs1
+  { 1.4, -0.237281, -2.405734 },   // HtMcs2
+  { 3.3, -0.359498, -1.821525 },   // HtMcs3
+  { 7.3, -0.246839, -1.573179 },   // HtMcs4
+  { 11.3, -0.239672, -0.664214 },  // HtMcs5
+  { 12.6, -0.249975, -0.241742 },  // HtMcs6
+  { 14.8, -0.250718, 0.350541 },   // HtMcs7
+  //2 spatial streams, 2 RX antennas, based on Figure 10 of
+  //S. A. Mujtaba, "TGnSync proposal PHY results," IEEE, Tech. Rep., May 2005.
+  { 6.0, -0.331433, -1.707058 },   // HtMcs8
+  { 9.0, -0.327923, -0.512829 },   // HtMcs9
+  { 12.0, -0.250134, -0.312513 },  // HtMcs10
+  { 15.0, -0.293255, 1.055878 },   // HtMcs11
+  { 18.0, -0.225802, 0.830230 },   // HtMcs12
+  { 24.0, -0.265136, 2.807394 },   // HtMcs13
+  { 24.0, -0.229463, 2.290292 },   // HtMcs14
+  { 27.0, -0.159535, 0.688334 }    // HtMcs15
+};
+
+/**
+ * BER curves for 1 RX antenna, indexed by HT MCS
+ */
+static const BerCurve g_berCurves1Rx[] = {
+  //1 spatial stream, 1 RX antenna, from UW link sim. TODO: run more linksim iterations for 1x1
+  { -1.0, -0.187098, -2.378001 },  // HtMcs0
+  { 3.0, -0.184590, -1.973042 },   // HtMcs1
+  { 6.0, -0.137791, -1.841526 },   // HtMcs2
+  { 7.0, -0.223005, -1.841909 },   // HtMcs3
+  { 11.0, -0.164868, -1.540567 },  // HtMcs4
+  { 15.0, -0.152820, -1.347143 },  // HtMcs5
+  { 17.0, -0.151264, -1.188952 },  // HtMcs6
+  { 19.0, -0.161418, -0.353079 }   // HtMcs7
+};
+
 
 TypeId
 FreqSelectiveErrorRateModel::GetTypeId (void)
@@ -84,7 +135,11 @@ void
 FreqSelectiveErrorRateModel::SetNumRxAntennas (uint32_t numRxAntennas)
 {
   NS_LOG_FUNCTION (this << numRxAntennas);
-  m_numRxAntennas = numRxAntennas;
+  if (numRxAntennas != m_numRxAntennas)
+    {
+      m_numRxAntennas = numRxAntennas;
+      FlushChunkSuccessRateCache ();
+    }
 }
 
 
@@ -92,179 +147,38 @@ double
 FreqSelectiveErrorRateModel::GetBitErrorRate (double snrDb, WifiMode mode) const
 {
   NS_ASSERT_MSG (m_numRxAntennas <= 2, "only up to 2 RX antennas currently supported");
-  double snrDbMin = 0;
-  double p1 = 0;
-  double p2 = 0;
+  if (mode.GetModulationClass () != WIFI_MOD_CLASS_HT)
+    {
+      // the curves are indexed by HT MCS: the MCS values of the other
+      // modulation classes do not designate them
+      NS_FATAL_ERROR ("unsupported MCS for bit error rate lookup");
+    }
+  uint8_t mcs = mode.GetMcsValue ();
+  const BerCurve *curve;
   if (m_numRxAntennas == 2)
     {
-      //1 spatial stream, 2 RX antennas, from UW link sim
-      if (mode == WifiPhy::GetHtMcs0 ())
-        {
-            snrDbMin = -5.1;
-            p1 = -0.300827;
-            p2 = -3.756085;
-        }
-      else if (mode == WifiPhy::GetHtMcs1 ())
-        {
-            snrDbMin = -1.6;
-            p1 = -0.309238;
-            p2 = -2.965011;
-        }
-      else if (mode == WifiPhy::GetHtMcs2 ())
+      if (mcs >= sizeof (g_berCurves2Rx) / sizeof (g_berCurves2Rx[0]))
         {
-            snrDbMin = 1.4;
-            p1 = -0.237281;
-            p2 = -2.405734;
-        }
-      else if (mode == WifiPhy::GetHtMcs3 ())
-        {
-            snrDbMin = 3.3;
-            p1 = -0.359498;
-            p2 = -1.821525;
-        }
-      else if (mode == WifiPhy::GetHtMcs4 ())
-        {
-            snrDbMin = 7.3;
-            p1 = -0.246839;
-            p2 = -1.573179;
-        }
-      else if (mode == WifiPhy::GetHtMcs5 ())
-        {
-            snrDbMin = 11.3;
-            p1 = -0.239672;
-            p2 = -0.664214;
-        }
-      else if (mode == WifiPhy::GetHtMcs6 ())
-        {
-            snrDbMin = 12.6;
-            p1 = -0.249975;
-            p2 = -0.241742;
-        }
-      else if (mode == WifiPhy::GetHtMcs7 ())
-        {
-            snrDbMin = 14.8;
-            p1 = -0.250718;
-            p2 = 0.350541;
-        }
-          //2 spatial streams, 2 RX antennas, based on Figure 10 of
-          //S. A. Mujtaba, "TGnSync proposal PHY results," IEEE, Tech. Rep., May 2005.
-      else if (mode == WifiPhy::GetHtMcs8 ())
-        {
-            snrDbMin = 6.0;
-            p1 = -0.331433;
-            p2 = -1.707058;
-        }
-      else if (mode == WifiPhy::GetHtMcs9 ())
-        {
-            snrDbMin = 9.0;
-            p1 = -0.327923;
-            p2 = -0.512829;
-        }
-      else if (mode == WifiPhy::GetHtMcs10 ())
-        {
-            snrDbMin = 12.0;
-            p1 = -0.250134;
-            p2 = -0.312513;
-        }
-      else if (mode == WifiPhy::GetHtMcs11 ())
-        {
-            snrDbMin = 15.0;
-            p1 = -0.293255;
-            p2 = 1.055878;
-        }
-      else if (mode == WifiPhy::GetHtMcs12 ())
-        {
-            snrDbMin = 18.0;
-            p1 = -0.225802;
-            p2 = 0.830230;
-        }
-      else if (mode == WifiPhy::GetHtMcs13 ())
-        {
-            snrDbMin = 24.0;
-            p1 = -0.265136;
-            p2 = 2.807394;
-        }
-      else if (mode == WifiPhy::GetHtMcs14 ())
-        {
-            snrDbMin = 24.0;
-            p1 = -0.229463;
-            p2 = 2.290292;
-        }
-      else if (mode == WifiPhy::GetHtMcs15 ())
-        {
-            snrDbMin = 27.0;
-            p1 = -0.159535;
-            p2 = 0.688334;
-        }
-      else
-        {
-            NS_FATAL_ERROR ("unsupported MCS for bit error rate lookup");
+          NS_FATAL_ERROR ("unsupported MCS for bit error rate lookup");
         }
+      curve = &g_berCurves2Rx[mcs];
     }
   else //m_numRxAntennas == 1
     {
-      if (mode == WifiPhy::GetHtMcs0 ())
-        {
-          //1 spatial stream, 1 RX antenna, from UW link sim. TODO: run more linksim iterations for 1x1
-            snrDbMin = -1.0;
-            p1 = -0.187098;
-            p2 = -2.378001;
-        }
-      else if (mode == WifiPhy::GetHtMcs1 ())
-        {
-            snrDbMin = 3.0;
-            p1 = -0.184590;
-            p2 = -1.973042;
-        }
-      else if (mode == WifiPhy::GetHtMcs2 ())
-        {
-            snrDbMin = 6.0;
-            p1 = -0.137791;
-            p2 = -1.841526;
-        }
-      else if (mode == WifiPhy::GetHtMcs3 ())
-        {
-            snrDbMin = 7.0;
-            p1 = -0.223005;
-            p2 = -1.841909;
-        }
-      else if (mode == WifiPhy::GetHtMcs4 ())
-        {
-            snrDbMin = 11.0;
-            p1 = -0.164868;
-            p2 = -1.540567;
-        }
-      else if (mode == WifiPhy::GetHtMcs5 ())
-        {
-            snrDbMin = 15.0;
-            p1 = -0.152820;
-            p2 = -1.347143;
-        }
-      else if (mode == WifiPhy::GetHtMcs6 ())
-        {
-            snrDbMin = 17.0;
-            p1 = -0.151264;
-            p2 = -1.188952;
-        }
-      else if (mode == WifiPhy::GetHtMcs7 ())
-        {
-            snrDbMin = 19.0;
-            p1 = -0.161418;
-            p2 = -0.353079;
-        }
-      else 
+      if (mcs >= sizeof (g_berCurves1Rx) / sizeof (g_berCurves1Rx[0]))
         {
-            NS_FATAL_ERROR ("unsupported MCS for bit error rate lookup");
+          NS_FATAL_ERROR ("unsupported MCS for bit error rate lookup");
         }
+      curve = &g_berCurves1Rx[mcs];
     }
   double ber;
-  if (snrDb < snrDbMin)
+  if (snrDb < curve->snrDbMin)
     {
       ber = 1; //bit error rate = 1 if SNR is below minimum
     }
   else
     {
-      ber = std::pow (10, p1 * snrDb + p2); //log linear curve (ber = 10 ^ (p1*snrDb + p2))
+      ber = std::pow (10, curve->p1 * snrDb + curve->p2); //log linear curve (ber = 10 ^ (p1*snrDb + p2))
     }
   return ber;
 }
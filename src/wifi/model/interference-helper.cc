@@ -107,7 +107,8 @@ InterferenceHelper::Event::GetPreambleType (void) const
 
 InterferenceHelper::NiChange::NiChange (Time time, double delta)
   : m_time (time),
-    m_delta (delta)
+    m_delta (delta),
+    m_power (0.0)
 {
 }
 
@@ -123,6 +124,18 @@ InterferenceHelper::NiChange::GetDelta (void) const
   return m_delta;
 }
 
+double
+InterferenceHelper::NiChange::GetPower (void) const
+{
+  return m_power;
+}
+
+void
+InterferenceHelper::NiChange::SetPower (double power)
+{
+  m_power = power;
+}
+
 bool
 InterferenceHelper::NiChange::operator < (const InterferenceHelper::NiChange& o) const
 {
@@ -191,6 +204,7 @@ void
 InterferenceHelper::SetErrorRateModel (Ptr<ErrorRateModel> rate)
 {
   m_errorRateModel = rate;
+  m_freqSelErrorRateModel = rate != 0 ? rate->GetObject<FreqSelectiveErrorRateModel> () : 0;
 }
 
 Ptr<ErrorRateModel>
@@ -204,10 +218,9 @@ InterferenceHelper::SetNumberOfReceiveAntennas (uint32_t rx)
 {
   m_numRxAntennas = rx;
   // XXX this is a workaround to use subclass API
-  Ptr<FreqSelectiveErrorRateModel> em = DynamicCast<FreqSelectiveErrorRateModel> (m_errorRateModel);
-  if (em)
+  if (m_freqSelErrorRateModel != 0)
     {
-      em->SetNumRxAntennas (rx);
+      m_freqSelErrorRateModel->SetNumRxAntennas (rx);
     }
 }
 
@@ -215,21 +228,16 @@ Time
 InterferenceHelper::GetEnergyDuration (double energyW)
 {
   Time now = Simulator::Now ();
-  double noiseInterferenceW = 0.0;
   Time end = now;
-  noiseInterferenceW = m_firstPower;
-  for (NiChanges::const_iterator i = m_niChanges.begin (); i != m_niChanges.end (); i++)
+  // the changes before now cannot end the busy period: start from the
+  // first change at or after now, whose running power already accounts
+  // for all the previous ones
+  NiChangeQueue::const_iterator i = std::lower_bound (m_niChanges.begin (), m_niChanges.end (), NiChange (now, 0));
+  for (; i != m_niChanges.end (); i++)
     {
-      // // FIXME: not sure about the role of m_firstPower
-      // // large value of m_firstPower seems to mess things
-      noiseInterferenceW += i->GetDelta ();
       end = i->GetTime ();
-      NS_LOG_DEBUG ("noiseInterferenceW=" << i->GetDelta () << ", end= " << end << ", now=" << now << ", m_firstPower=" << m_firstPower);
-      if (end < now)
-        {
-          continue;
-        }
-      if (noiseInterferenceW < energyW)
+      NS_LOG_DEBUG ("noiseInterferenceW=" << i->GetPower () << ", end= " << end << ", now=" << now << ", m_firstPower=" << m_firstPower);
+      if (i->GetPower () < energyW)
         {
           break;
         }
@@ -245,13 +253,9 @@ InterferenceHelper::AppendEvent (Ptr<InterferenceHelper::Event> event)
   Time now = Simulator::Now ();
   if (!m_rxing)
     {
-      NiChanges::iterator nowIterator = GetPosition (now);
-      for (NiChanges::iterator i = m_niChanges.begin (); i != nowIterator; i++)
-        {
-          m_firstPower += i->GetDelta ();
-        }
-      m_niChanges.erase (m_niChanges.begin (), nowIterator);
-      m_niChanges.insert (m_niChanges.begin (), NiChange (event->GetStartTime (), event->GetRxPowerW ()));
+      EraseNiChanges (GetPosition (now));
+      m_niChanges.push_front (NiChange (event->GetStartTime (), event->GetRxPowerW ()));
+      UpdatePowers (m_niChanges.begin ());
     }
   else
     {
@@ -281,7 +285,7 @@ double
 InterferenceHelper::CalculateNoiseInterferenceW (Ptr<InterferenceHelper::Event> event, NiChanges *ni) const
 {
   double noiseInterference = m_firstPower;
-  for (NiChanges::const_iterator i = m_niChanges.begin () + 1; i != m_niChanges.end (); i++)
+  for (NiChangeQueue::const_iterator i = m_niChanges.begin () + 1; i != m_niChanges.end (); i++)
     {
       if ((event->GetEndTime () == i->GetTime ()) && event->GetRxPowerW () == -i->GetDelta ())
         {
@@ -303,10 +307,9 @@ InterferenceHelper::CalculateChunkSuccessRate (double snir, Time duration, WifiM
     }
   uint32_t rate = mode.GetPhyRate (txVector);
   uint64_t nbits = (uint64_t)(rate * duration.GetSeconds ());
-  Ptr<FreqSelectiveErrorRateModel> freqSelErrorModel = m_errorRateModel->GetObject<FreqSelectiveErrorRateModel> ();
-  if (freqSelErrorModel != NULL) // is frequency selective error rate model
+  if (m_freqSelErrorRateModel != 0) // is frequency selective error rate model
     {
-      freqSelErrorModel->SetNumRxAntennas (m_numRxAntennas); //ensure correct number of antennas is used for error rates
+      m_freqSelErrorRateModel->SetNumRxAntennas (m_numRxAntennas); //ensure correct number of antennas is used for error rates
     }
   else // using an AWGN error rate model
     {
@@ -320,7 +323,7 @@ InterferenceHelper::CalculateChunkSuccessRate (double snir, Time duration, WifiM
     {
       nbits = 1; // XXX above arithmetic may lead to zero value
     }
-  double csr = m_errorRateModel->GetChunkSuccessRate (mode, txVector, snir, (uint32_t)nbits);
+  double csr = m_errorRateModel->GetCachedChunkSuccessRate (mode, txVector, snir, (uint32_t)nbits);
   return csr;
 }
 
@@ -938,7 +941,7 @@ InterferenceHelper::EraseEvents (void)
   m_firstPower = 0.0;
 }
 
-InterferenceHelper::NiChanges::iterator
+InterferenceHelper::NiChangeQueue::iterator
 InterferenceHelper::GetPosition (Time moment)
 {
   return std::upper_bound (m_niChanges.begin (), m_niChanges.end (), NiChange (moment, 0));
@@ -947,7 +950,28 @@ InterferenceHelper::GetPosition (Time moment)
 void
 InterferenceHelper::AddNiChangeEvent (NiChange change)
 {
-  m_niChanges.insert (GetPosition (change.GetTime ()), change);
+  UpdatePowers (m_niChanges.insert (GetPosition (change.GetTime ()), change));
+}
+
+void
+InterferenceHelper::UpdatePowers (NiChangeQueue::iterator first)
+{
+  double power = (first == m_niChanges.begin ()) ? m_firstPower : (first - 1)->GetPower ();
+  for (NiChangeQueue::iterator i = first; i != m_niChanges.end (); i++)
+    {
+      power += i->GetDelta ();
+      i->SetPower (power);
+    }
+}
+
+void
+InterferenceHelper::EraseNiChanges (NiChangeQueue::iterator last)
+{
+  if (last != m_niChanges.begin ())
+    {
+      m_firstPower = (last - 1)->GetPower ();
+      m_niChanges.erase (m_niChanges.begin (), last);
+    }
 }
 
 void
@@ -962,6 +986,8 @@ InterferenceHelper::NotifyRxEnd ()
 {
   NS_LOG_FUNCTION (this);
   m_rxing = false;
+  // the changes before now are no longer needed by any query
+  EraseNiChanges (std::lower_bound (m_niChanges.begin (), m_niChanges.end (), NiChange (Simulator::Now (), 0)));
 }
 
 } //namespace ns3
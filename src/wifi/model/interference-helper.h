@@ -24,6 +24,7 @@
 #include <stdint.h>
 #include <vector>
 #include <list>
+#include <deque>
 #include "wifi-mode.h"
 #include "wifi-preamble.h"
 #include "wifi-phy-standard.h"
@@ -34,10 +35,20 @@
 namespace ns3 {
 
 class ErrorRateModel;
+class FreqSelectiveErrorRateModel;
 
 /**
  * \ingroup wifi
  * \brief handles interference calculations
+ *
+ * The noise and interference changes are kept in a time-ordered queue
+ * with the running power after each change. Finding the power at a
+ * given time is O(log n), n being the number of changes in the queue,
+ * but adding a signal is O(n): the running power of every later change
+ * is updated. The changes before the current time are dropped when a
+ * reception ends or a signal arrives while idle, so n stays of the
+ * order of the number of overlapping signals, and the end of a new
+ * signal, usually the latest change, is inserted near the back.
  */
 class InterferenceHelper
 {
@@ -275,6 +286,20 @@ public:
      * \return the power
      */
     double GetDelta (void) const;
+    /**
+     * Return the total noise and interference power right after this
+     * change. This is only maintained for the changes stored in
+     * InterferenceHelper::m_niChanges.
+     *
+     * \return the total power (W)
+     */
+    double GetPower (void) const;
+    /**
+     * Set the total noise and interference power right after this change.
+     *
+     * \param power the total power (W)
+     */
+    void SetPower (double power);
     /**
      * Compare the event time of two NiChange objects (a < o).
      *
@@ -287,11 +312,16 @@ public:
 private:
     Time m_time;
     double m_delta;
+    double m_power;
   };
   /**
    * typedef for a vector of NiChanges
    */
   typedef std::vector <NiChange> NiChanges;
+  /**
+   * typedef for the time-ordered queue of NiChanges kept by the helper
+   */
+  typedef std::deque <NiChange> NiChangeQueue;
   /**
    * typedef for a list of Events
    */
@@ -358,19 +388,43 @@ private:
 
   double m_noiseFigure; /**< noise figure (linear) */
   Ptr<ErrorRateModel> m_errorRateModel;
+  /// m_errorRateModel if it is a FreqSelectiveErrorRateModel, 0 otherwise
+  Ptr<FreqSelectiveErrorRateModel> m_freqSelErrorRateModel;
   uint32_t m_numRxAntennas; /**< the number of RX antennas in the corresponding receiver */
-  /// Experimental: needed for energy duration calculation
-  NiChanges m_niChanges;
-  double m_firstPower;
+  /**
+   * Noise and interference changes, sorted by time. Each change holds
+   * the total power right after it (a running sum starting from
+   * m_firstPower), so that the power at a given time is found with a
+   * binary search. The changes which are no longer needed are folded
+   * into m_firstPower and removed from the front of the queue.
+   */
+  NiChangeQueue m_niChanges;
+  double m_firstPower; /**< total power before the first change in m_niChanges */
   bool m_rxing;
   /// Returns an iterator to the first nichange, which is later than moment
-  NiChanges::iterator GetPosition (Time moment);
+  NiChangeQueue::iterator GetPosition (Time moment);
   /**
-   * Add NiChange to the list at the appropriate position.
+   * Add NiChange to the list at the appropriate position, and update the
+   * running power of the later changes. This is linear in the number of
+   * later changes.
    *
    * \param change
    */
   void AddNiChangeEvent (NiChange change);
+  /**
+   * Recompute the running power of the changes from the given one to
+   * the end of the queue.
+   *
+   * \param first the first change whose running power is out of date
+   */
+  void UpdatePowers (NiChangeQueue::iterator first);
+  /**
+   * Fold the changes before the given one into m_firstPower and remove
+   * them from the queue.
+   *
+   * \param last the first change to keep
+   */
+  void EraseNiChanges (NiChangeQueue::iterator last);
 };
 
 } //namespace ns3
@@ -246,10 +246,12 @@ NistErrorRateModel::GetFec256QamBer (double snr, uint32_t nbits,
   return pms;
 }
 
-double
-NistErrorRateModel::GetChunkSuccessRate (WifiMode mode, WifiTxVector txVector, double snr, uint32_t nbits) const
+NistErrorRateModel::ModeCurve
+NistErrorRateModel::ResolveModeCurve (WifiMode mode)
 {
-  NS_LOG_FUNCTION (this << mode << txVector.GetMode () << snr << nbits);
+  ModeCurve modeCurve;
+  modeCurve.curve = CURVE_NONE;
+  modeCurve.bValue = 0;
   if (mode.GetModulationClass () == WIFI_MOD_CLASS_ERP_OFDM
       || mode.GetModulationClass () == WIFI_MOD_CLASS_OFDM
       || mode.GetModulationClass () == WIFI_MOD_CLASS_HT
@@ -257,86 +259,39 @@ NistErrorRateModel::GetChunkSuccessRate (WifiMode mode, WifiTxVector txVector, d
     {
       if (mode.GetConstellationSize () == 2)
         {
-          if (mode.GetCodeRate () == WIFI_CODE_RATE_1_2)
-            {
-              return GetFecBpskBer (snr,
-                                    nbits,
-                                    1); //b value
-            }
-          else
-            {
-              return GetFecBpskBer (snr,
-                                    nbits,
-                                    3); //b value
-            }
+          modeCurve.curve = CURVE_FEC_BPSK;
+          modeCurve.bValue = mode.GetCodeRate () == WIFI_CODE_RATE_1_2 ? 1 : 3;
         }
       else if (mode.GetConstellationSize () == 4)
         {
-          if (mode.GetCodeRate () == WIFI_CODE_RATE_1_2)
-            {
-              return GetFecQpskBer (snr,
-                                    nbits,
-                                    1); //b value
-            }
-          else
-            {
-              return GetFecQpskBer (snr,
-                                    nbits,
-                                    3); //b value
-            }
+          modeCurve.curve = CURVE_FEC_QPSK;
+          modeCurve.bValue = mode.GetCodeRate () == WIFI_CODE_RATE_1_2 ? 1 : 3;
         }
       else if (mode.GetConstellationSize () == 16)
         {
-          if (mode.GetCodeRate () == WIFI_CODE_RATE_1_2)
-            {
-              return GetFec16QamBer (snr,
-                                     nbits,
-                                     1); //b value
-            }
-          else
-            {
-              return GetFec16QamBer (snr,
-                                     nbits,
-                                     3); //b value
-            }
+          modeCurve.curve = CURVE_FEC_16QAM;
+          modeCurve.bValue = mode.GetCodeRate () == WIFI_CODE_RATE_1_2 ? 1 : 3;
         }
       else if (mode.GetConstellationSize () == 64)
         {
+          modeCurve.curve = CURVE_FEC_64QAM;
           if (mode.GetCodeRate () == WIFI_CODE_RATE_2_3)
             {
-              return GetFec64QamBer (snr,
-                                     nbits,
-                                     2); //b value
+              modeCurve.bValue = 2;
             }
           else if (mode.GetCodeRate () == WIFI_CODE_RATE_5_6)
             {
-              return GetFec64QamBer (snr,
-                                     nbits,
-                                     5); //b value
+              modeCurve.bValue = 5;
             }
           else
             {
-              return GetFec64QamBer (snr,
-                                     nbits,
-                                     3); //b value
+              modeCurve.bValue = 3;
             }
         }
       else if (mode.GetConstellationSize () == 256)
         {
-          if (mode.GetCodeRate () == WIFI_CODE_RATE_5_6)
-            {
-              return GetFec256QamBer (snr,
-                                      nbits,
-                                      5     // b value
-                                      );
-            }
-          else
-            {
-              return GetFec256QamBer (snr,
-                                      nbits,
-                                      3     // b value
-                                      );
-            }
+          modeCurve.curve = CURVE_FEC_256QAM;
+          modeCurve.bValue = mode.GetCodeRate () == WIFI_CODE_RATE_5_6 ? 5 : 3;
         }
     }
   else if (mode.GetModulationClass () == WIFI_MOD_CLASS_DSSS || mode.GetModulationClass () == WIFI_MOD_CLASS_HR_DSSS)
@@ -344,18 +299,70 @@ NistErrorRateModel::GetChunkSuccessRate (WifiMode mode, WifiTxVector txVector, d
       switch (mode.GetDataRate (20, 0, 1))
         {
         case 1000000:
-          return DsssErrorRateModel::GetDsssDbpskSuccessRate (snr, nbits);
+          modeCurve.curve = CURVE_DSSS_DBPSK;
+          break;
         case 2000000:
-          return DsssErrorRateModel::GetDsssDqpskSuccessRate (snr, nbits);
+          modeCurve.curve = CURVE_DSSS_DQPSK;
+          break;
         case 5500000:
-          return DsssErrorRateModel::GetDsssDqpskCck5_5SuccessRate (snr, nbits);
+          modeCurve.curve = CURVE_DSSS_CCK_5_5;
+          break;
         case 11000000:
-          return DsssErrorRateModel::GetDsssDqpskCck11SuccessRate (snr, nbits);
+          modeCurve.curve = CURVE_DSSS_CCK_11;
+          break;
         default:
           NS_ASSERT ("undefined DSSS/HR-DSSS datarate");
         }
     }
-  return 0;
+  return modeCurve;
+}
+
+NistErrorRateModel::ModeCurve
+NistErrorRateModel::GetModeCurve (WifiMode mode) const
+{
+  uint32_t uid = mode.GetUid ();
+  if (uid >= m_modeCurves.size ())
+    {
+      ModeCurve unresolved;
+      unresolved.curve = CURVE_UNRESOLVED;
+      unresolved.bValue = 0;
+      m_modeCurves.resize (uid + 1, unresolved);
+    }
+  if (m_modeCurves[uid].curve == CURVE_UNRESOLVED)
+    {
+      m_modeCurves[uid] = ResolveModeCurve (mode);
+    }
+  return m_modeCurves[uid];
+}
+
+double
+NistErrorRateModel::GetChunkSuccessRate (WifiMode mode, WifiTxVector txVector, double snr, uint32_t nbits) const
+{
+  NS_LOG_FUNCTION (this << mode << txVector.GetMode () << snr << nbits);
+  ModeCurve modeCurve = GetModeCurve (mode);
+  switch (modeCurve.curve)
+    {
+    case CURVE_FEC_BPSK:
+      return GetFecBpskBer (snr, nbits, modeCurve.bValue);
+    case CURVE_FEC_QPSK:
+      return GetFecQpskBer (snr, nbits, modeCurve.bValue);
+    case CURVE_FEC_16QAM:
+      return GetFec16QamBer (snr, nbits, modeCurve.bValue);
+    case CURVE_FEC_64QAM:
+      return GetFec64QamBer (snr, nbits, modeCurve.bValue);
+    case CURVE_FEC_256QAM:
+      return GetFec256QamBer (snr, nbits, modeCurve.bValue);
+    case CURVE_DSSS_DBPSK:
+      return DsssErrorRateModel::GetDsssDbpskSuccessRate (snr, nbits);
+    case CURVE_DSSS_DQPSK:
+      return DsssErrorRateModel::GetDsssDqpskSuccessRate (snr, nbits);
+    case CURVE_DSSS_CCK_5_5:
+      return DsssErrorRateModel::GetDsssDqpskCck5_5SuccessRate (snr, nbits);
+    case CURVE_DSSS_CCK_11:
+      return DsssErrorRateModel::GetDsssDqpskCck11SuccessRate (snr, nbits);
+    default:
+      return 0;
+    }
 }
 
 } //namespace ns3
@@ -22,6 +22,7 @@
 #define NIST_ERROR_RATE_MODEL_H
 
 #include <stdint.h>
+#include <vector>
 #include "wifi-mode.h"
 #include "error-rate-model.h"
 #include "dsss-error-rate-model.h"
@@ -47,6 +48,47 @@ public:
 
 
 private:
+  /// The error rate curve of a mode
+  enum Curve
+  {
+    CURVE_UNRESOLVED = 0,
+    CURVE_NONE,
+    CURVE_FEC_BPSK,
+    CURVE_FEC_QPSK,
+    CURVE_FEC_16QAM,
+    CURVE_FEC_64QAM,
+    CURVE_FEC_256QAM,
+    CURVE_DSSS_DBPSK,
+    CURVE_DSSS_DQPSK,
+    CURVE_DSSS_CCK_5_5,
+    CURVE_DSSS_CCK_11
+  };
+
+  /// The error rate curve of a mode and its parameter
+  struct ModeCurve
+  {
+    uint8_t curve;   //!< the Curve
+    uint8_t bValue;  //!< the b value of the FEC curves
+  };
+
+  /**
+   * Return the error rate curve of a mode, resolved from its modulation
+   * class, constellation size, code rate and data rate on first use.
+   *
+   * \param mode the Wi-Fi mode
+   *
+   * \return the error rate curve of the mode
+   */
+  ModeCurve GetModeCurve (WifiMode mode) const;
+  /**
+   * Resolve the error rate curve of a mode.
+   *
+   * \param mode the Wi-Fi mode
+   *
+   * \return the error rate curve of the mode
+   */
+  static ModeCurve ResolveModeCurve (WifiMode mode);
+
   /**
    * Return the coded BER for the given p and b.
    *
@@ -149,6 +191,8 @@ private:
    */
   double GetFec256QamBer (double snr, uint32_t nbits,
                           uint32_t bValue) const;
+
+  mutable std::vector<ModeCurve> m_modeCurves; //!< the curve of each mode, indexed by WifiMode uid
 };
 
 } //namespace ns3
@@ -473,6 +473,7 @@ namespace ns3 {
                 //this is not channel switch, this is initialization
                 NS_LOG_DEBUG ("start at channel " << nch);
                 m_channelNumber = nch;
+                m_rfFilter = 0;
                 return;
             }
 
@@ -517,6 +518,7 @@ switchChannel:
              */
             m_channelFreqMhz = WifiSpectrumHelper::GetFreqMHzForChannel (nch);
             m_channelNumber = nch;
+            m_rfFilter = 0;
         }
 
     void
@@ -641,7 +643,9 @@ switchChannel:
         {
             NS_LOG_FUNCTION (this << rxParams);
             Time rxDuration = rxParams->duration;
-            Ptr<SpectrumValue> receivedSignalPsd = rxParams->psd;
+            // the PSD is not materialized, since we only need its
+            // filtered integral, which scales linearly with psdGain
+            Ptr<const SpectrumValue> receivedSignalPsd = rxParams->GetUnscaledPsd ();
             uint32_t senderNodeId = 0;
             uint32_t selfNodeId = 0;
             selfNodeId = m_device->GetNode ()->GetId ();//rxParams->txPhy->GetDevice ()->GetNode ()->GetId ();
@@ -649,14 +653,17 @@ switchChannel:
             {
                 senderNodeId =  rxParams->txPhy->GetDevice ()->GetNode ()->GetId ();
             }
-            NS_LOG_DEBUG (selfNodeId << "Received signal from " << senderNodeId << " with unfiltered power " << WToDbm (Integral (*receivedSignalPsd)) << " dBm");
+            NS_LOG_DEBUG (selfNodeId << "Received signal from " << senderNodeId << " with unfiltered power " << WToDbm (Integral (*receivedSignalPsd) * rxParams->psdGain) << " dBm");
             // Integrate over our receive bandwidth (i.e., all that the receive
             // spectral mask representing our filtering allows) to find the
             // total energy apparent to the "demodulator".
-            Ptr<SpectrumValue> filter = WifiSpectrumHelper::CreateRfFilter (m_channelNumber);
-            SpectrumValue filteredSignal = (*filter) * (*receivedSignalPsd);
+            if (m_rfFilter == 0)
+            {
+                // looked up once per channel rather than on every reception
+                m_rfFilter = WifiSpectrumHelper::GetRfFilter (m_channelNumber);
+            }
             // Add receiver antenna gain
-            double rxPowerW = Integral (filteredSignal) * DbToRatio (m_rxGainDb);
+            double rxPowerW = FilteredIntegral (*receivedSignalPsd, *m_rfFilter) * rxParams->psdGain * DbToRatio (m_rxGainDb);
             NS_LOG_DEBUG ("Signal power received: " << WToDbm (rxPowerW) << " dBm");
 
             Ptr<WifiSpectrumSignalParameters> wifiRxParams = DynamicCast<WifiSpectrumSignalParameters> (rxParams);
@@ -530,6 +530,7 @@ private:
   Ptr<SpectrumChannel> m_channel;        //!< SpectrumChannel that this SpectrumWifiPhy is connected to
   uint16_t             m_channelFreqMhz; 
   uint16_t             m_channelNumber;  //!< Operating channel number
+  Ptr<const SpectrumValue> m_rfFilter;   //!< RF filter of the operating channel, 0 until the first reception
   Ptr<NetDevice>       m_device;         //!< Pointer to the device
   Ptr<MobilityModel>   m_mobility;       //!< Pointer to the mobility model
 
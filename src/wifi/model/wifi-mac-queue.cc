@@ -35,7 +35,8 @@ WifiMacQueue::Item::Item (Ptr<const Packet> packet,
                           Time tstamp)
   : packet (packet),
     hdr (hdr),
-    tstamp (tstamp)
+    tstamp (tstamp),
+    order (0)
 {
 }
 
@@ -59,7 +60,13 @@ WifiMacQueue::GetTypeId (void)
 }
 
 WifiMacQueue::WifiMacQueue ()
-  : m_size (0)
+  : m_frontOrder (0x8000000000000000ULL),
+    m_backOrder (0x8000000000000000ULL),
+    m_size (0),
+    m_nTotalReceivedPackets (0),
+    m_nTotalDroppedPackets (0),
+    m_nTotalExpiredPackets (0),
+    m_maxOccupancy (0)
 {
 }
 
@@ -96,13 +103,78 @@ void
 WifiMacQueue::Enqueue (Ptr<const Packet> packet, const WifiMacHeader &hdr)
 {
   Cleanup ();
+  Insert (packet, hdr, false);
+}
+
+void
+WifiMacQueue::Insert (Ptr<const Packet> packet, const WifiMacHeader &hdr, bool front)
+{
   if (m_size == m_maxSize)
     {
+      if (!front)
+        {
+          m_nTotalDroppedPackets++;
+        }
       return;
     }
   Time now = Simulator::Now ();
-  m_queue.push_back (Item (packet, hdr, now));
+  PacketQueueI it;
+  if (front)
+    {
+      it = m_queue.insert (m_queue.begin (), Item (packet, hdr, now));
+      it->order = --m_frontOrder;
+    }
+  else
+    {
+      it = m_queue.insert (m_queue.end (), Item (packet, hdr, now));
+      it->order = m_backOrder++;
+    }
+  // the packets arrive in the order of their timestamps, wherever they are queued
+  it->arrival = m_arrivals.insert (m_arrivals.end (), it);
+  ItemIndex *index = &m_nonQosIndex;
+  if (hdr.IsQosData ())
+    {
+      TidAddressIndex &tidAddressIndex = m_tidAddressIndexes[TidAddress (hdr.GetQosTid (), hdr.GetAddr1 ())];
+      if (tidAddressIndex.items.empty ())
+        {
+          tidAddressIndex.size = 0;
+        }
+      tidAddressIndex.size++;
+      index = &tidAddressIndex.items;
+    }
+  it->index = index->insert (front ? index->begin () : index->end (), it);
   m_size++;
+  if (!front)
+    {
+      // the packets pushed at the front are re-queued, not received
+      m_nTotalReceivedPackets++;
+    }
+  if (m_size > m_maxOccupancy)
+    {
+      m_maxOccupancy = m_size;
+    }
+}
+
+void
+WifiMacQueue::Erase (PacketQueueI it)
+{
+  m_arrivals.erase (it->arrival);
+  if (it->hdr.IsQosData ())
+    {
+      TidAddressIndexes::iterator tidAddressIndex = m_tidAddressIndexes.find (TidAddress (it->hdr.GetQosTid (), it->hdr.GetAddr1 ()));
+      NS_ASSERT (tidAddressIndex != m_tidAddressIndexes.end ());
+      tidAddressIndex->second.items.erase (it->index);
+      if (--tidAddressIndex->second.size == 0)
+        {
+          m_tidAddressIndexes.erase (tidAddressIndex);
+        }
+    }
+  else
+    {
+      m_nonQosIndex.erase (it->index);
+    }
+  m_queue.erase (it);
+  m_size--;
 }
 
 void
@@ -113,21 +185,13 @@ WifiMacQueue::Cleanup (void)
       return;
     }
 
+  // the expired packets are at the head of the arrival index
   Time now = Simulator::Now ();
-  uint32_t n = 0;
-  for (PacketQueueI i = m_queue.begin (); i != m_queue.end (); )
+  while (!m_arrivals.empty () && m_arrivals.front ()->tstamp + m_maxDelay <= now)
     {
-      if (i->tstamp + m_maxDelay > now)
-        {
-          i++;
-        }
-      else
-        {
-          i = m_queue.erase (i);
-          n++;
-        }
+      Erase (m_arrivals.front ());
+      m_nTotalExpiredPackets++;
     }
-  m_size -= n;
 }
 
 Ptr<const Packet>
@@ -136,11 +200,11 @@ WifiMacQueue::Dequeue (WifiMacHeader *hdr)
   Cleanup ();
   if (!m_queue.empty ())
     {
-      Item i = m_queue.front ();
-      m_queue.pop_front ();
-      m_size--;
-      *hdr = i.hdr;
-      return i.packet;
+      PacketQueueI it = m_queue.begin ();
+      Ptr<const Packet> packet = it->packet;
+      *hdr = it->hdr;
+      Erase (it);
+      return packet;
     }
   return 0;
 }
@@ -151,37 +215,52 @@ WifiMacQueue::Peek (WifiMacHeader *hdr)
   Cleanup ();
   if (!m_queue.empty ())
     {
-      Item i = m_queue.front ();
+      const Item &i = m_queue.front ();
       *hdr = i.hdr;
       return i.packet;
     }
   return 0;
 }
 
+WifiMacQueue::PacketQueueI
+WifiMacQueue::FindByTidAndAddress (uint8_t tid, WifiMacHeader::AddressType type, Mac48Address dest)
+{
+  if (type == WifiMacHeader::ADDR1)
+    {
+      TidAddressIndexes::iterator tidAddressIndex = m_tidAddressIndexes.find (TidAddress (tid, dest));
+      if (tidAddressIndex == m_tidAddressIndexes.end ())
+        {
+          return m_queue.end ();
+        }
+      return tidAddressIndex->second.items.front ();
+    }
+  PacketQueueI it;
+  for (it = m_queue.begin (); it != m_queue.end (); ++it)
+    {
+      if (it->hdr.IsQosData ())
+        {
+          if (GetAddressForPacket (type, it) == dest
+              && it->hdr.GetQosTid () == tid)
+            {
+              break;
+            }
+        }
+    }
+  return it;
+}
+
 Ptr<const Packet>
 WifiMacQueue::DequeueByTidAndAddress (WifiMacHeader *hdr, uint8_t tid,
                                       WifiMacHeader::AddressType type, Mac48Address dest)
 {
   Cleanup ();
   Ptr<const Packet> packet = 0;
-  if (!m_queue.empty ())
+  PacketQueueI it = FindByTidAndAddress (tid, type, dest);
+  if (it != m_queue.end ())
     {
-      PacketQueueI it;
-      for (it = m_queue.begin (); it != m_queue.end (); ++it)
-        {
-          if (it->hdr.IsQosData ())
-            {
-              if (GetAddressForPacket (type, it) == dest
-                  && it->hdr.GetQosTid () == tid)
-                {
-                  packet = it->packet;
-                  *hdr = it->hdr;
-                  m_queue.erase (it);
-                  m_size--;
-                  break;
-                }
-            }
-        }
+      packet = it->packet;
+      *hdr = it->hdr;
+      Erase (it);
     }
   return packet;
 }
@@ -191,22 +270,12 @@ WifiMacQueue::PeekByTidAndAddress (WifiMacHeader *hdr, uint8_t tid,
                                    WifiMacHeader::AddressType type, Mac48Address dest, Time *timestamp)
 {
   Cleanup ();
-  if (!m_queue.empty ())
+  PacketQueueI it = FindByTidAndAddress (tid, type, dest);
+  if (it != m_queue.end ())
     {
-      PacketQueueI it;
-      for (it = m_queue.begin (); it != m_queue.end (); ++it)
-        {
-          if (it->hdr.IsQosData ())
-            {
-              if (GetAddressForPacket (type, it) == dest
-                  && it->hdr.GetQosTid () == tid)
-                {
-                  *hdr = it->hdr;
-                  *timestamp = it->tstamp;
-                  return it->packet;
-                }
-            }
-        }
+      *hdr = it->hdr;
+      *timestamp = it->tstamp;
+      return it->packet;
     }
   return 0;
 }
@@ -225,10 +294,46 @@ WifiMacQueue::GetSize (void)
   return m_size;
 }
 
+uint32_t
+WifiMacQueue::GetTotalReceivedPackets (void) const
+{
+  return m_nTotalReceivedPackets;
+}
+
+uint32_t
+WifiMacQueue::GetTotalDroppedPackets (void) const
+{
+  return m_nTotalDroppedPackets;
+}
+
+uint32_t
+WifiMacQueue::GetTotalExpiredPackets (void) const
+{
+  return m_nTotalExpiredPackets;
+}
+
+uint32_t
+WifiMacQueue::GetMaxOccupancy (void) const
+{
+  return m_maxOccupancy;
+}
+
+void
+WifiMacQueue::ResetStatistics (void)
+{
+  m_nTotalReceivedPackets = 0;
+  m_nTotalDroppedPackets = 0;
+  m_nTotalExpiredPackets = 0;
+  m_maxOccupancy = m_size;
+}
+
 void
 WifiMacQueue::Flush (void)
 {
   m_queue.erase (m_queue.begin (), m_queue.end ());
+  m_arrivals.clear ();
+  m_tidAddressIndexes.clear ();
+  m_nonQosIndex.clear ();
   m_size = 0;
 }
 
@@ -253,13 +358,27 @@ WifiMacQueue::GetAddressForPacket (enum WifiMacHeader::AddressType type, PacketQ
 bool
 WifiMacQueue::Remove (Ptr<const Packet> packet)
 {
+  // the packets removed are usually at the front of an index, after a peek
+  if (!m_nonQosIndex.empty () && m_nonQosIndex.front ()->packet == packet)
+    {
+      Erase (m_nonQosIndex.front ());
+      return true;
+    }
+  for (TidAddressIndexes::iterator tidAddressIndex = m_tidAddressIndexes.begin ();
+       tidAddressIndex != m_tidAddressIndexes.end (); ++tidAddressIndex)
+    {
+      if (tidAddressIndex->second.items.front ()->packet == packet)
+        {
+          Erase (tidAddressIndex->second.items.front ());
+          return true;
+        }
+    }
   PacketQueueI it = m_queue.begin ();
   for (; it != m_queue.end (); it++)
     {
       if (it->packet == packet)
         {
-          m_queue.erase (it);
-          m_size--;
+          Erase (it);
           return true;
         }
     }
@@ -270,13 +389,7 @@ void
 WifiMacQueue::PushFront (Ptr<const Packet> packet, const WifiMacHeader &hdr)
 {
   Cleanup ();
-  if (m_size == m_maxSize)
-    {
-      return;
-    }
-  Time now = Simulator::Now ();
-  m_queue.push_front (Item (packet, hdr, now));
-  m_size++;
+  Insert (packet, hdr, true);
 }
 
 uint32_t
@@ -284,6 +397,11 @@ WifiMacQueue::GetNPacketsByTidAndAddress (uint8_t tid, WifiMacHeader::AddressTyp
                                           Mac48Address addr)
 {
   Cleanup ();
+  if (type == WifiMacHeader::ADDR1)
+    {
+      TidAddressIndexes::const_iterator tidAddressIndex = m_tidAddressIndexes.find (TidAddress (tid, addr));
+      return (tidAddressIndex == m_tidAddressIndexes.end ()) ? 0 : tidAddressIndex->second.size;
+    }
   uint32_t nPackets = 0;
   if (!m_queue.empty ())
     {
@@ -302,24 +420,52 @@ WifiMacQueue::GetNPacketsByTidAndAddress (uint8_t tid, WifiMacHeader::AddressTyp
   return nPackets;
 }
 
+WifiMacQueue::PacketQueueI
+WifiMacQueue::FindFirstAvailable (const QosBlockedDestinations *blockedPackets)
+{
+  if (m_queue.empty ())
+    {
+      return m_queue.end ();
+    }
+  PacketQueueI it = m_queue.begin ();
+  if (!it->hdr.IsQosData ()
+      || !blockedPackets->IsBlocked (it->hdr.GetAddr1 (), it->hdr.GetQosTid ()))
+    {
+      return it;
+    }
+  // the first available packet is the first of the non-QoS packets or of
+  // the packets of a TID and address which is not blocked
+  it = m_queue.end ();
+  if (!m_nonQosIndex.empty ())
+    {
+      it = m_nonQosIndex.front ();
+    }
+  for (TidAddressIndexes::iterator tidAddressIndex = m_tidAddressIndexes.begin ();
+       tidAddressIndex != m_tidAddressIndexes.end (); ++tidAddressIndex)
+    {
+      PacketQueueI first = tidAddressIndex->second.items.front ();
+      if ((it == m_queue.end () || first->order < it->order)
+          && !blockedPackets->IsBlocked (tidAddressIndex->first.second, tidAddressIndex->first.first))
+        {
+          it = first;
+        }
+    }
+  return it;
+}
+
 Ptr<const Packet>
 WifiMacQueue::DequeueFirstAvailable (WifiMacHeader *hdr, Time &timestamp,
                                      const QosBlockedDestinations *blockedPackets)
 {
   Cleanup ();
   Ptr<const Packet> packet = 0;
-  for (PacketQueueI it = m_queue.begin (); it != m_queue.end (); it++)
+  PacketQueueI it = FindFirstAvailable (blockedPackets);
+  if (it != m_queue.end ())
     {
-      if (!it->hdr.IsQosData ()
-          || !blockedPackets->IsBlocked (it->hdr.GetAddr1 (), it->hdr.GetQosTid ()))
-        {
-          *hdr = it->hdr;
-          timestamp = it->tstamp;
-          packet = it->packet;
-          m_queue.erase (it);
-          m_size--;
-          return packet;
-        }
+      *hdr = it->hdr;
+      timestamp = it->tstamp;
+      packet = it->packet;
+      Erase (it);
     }
   return packet;
 }
@@ -329,15 +475,12 @@ WifiMacQueue::PeekFirstAvailable (WifiMacHeader *hdr, Time &timestamp,
                                   const QosBlockedDestinations *blockedPackets)
 {
   Cleanup ();
-  for (PacketQueueI it = m_queue.begin (); it != m_queue.end (); it++)
+  PacketQueueI it = FindFirstAvailable (blockedPackets);
+  if (it != m_queue.end ())
     {
-      if (!it->hdr.IsQosData ()
-          || !blockedPackets->IsBlocked (it->hdr.GetAddr1 (), it->hdr.GetQosTid ()))
-        {
-          *hdr = it->hdr;
-          timestamp = it->tstamp;
-          return it->packet;
-        }
+      *hdr = it->hdr;
+      timestamp = it->tstamp;
+      return it->packet;
     }
   return 0;
 }
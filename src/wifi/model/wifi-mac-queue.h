@@ -24,6 +24,7 @@
 #define WIFI_MAC_QUEUE_H
 
 #include <list>
+#include <map>
 #include <utility>
 #include "ns3/packet.h"
 #include "ns3/nstime.h"
@@ -47,6 +48,14 @@ class QosBlockedDestinations;
  * to verify whether or not it should be dropped. If
  * dot11EDCATableMSDULifetime has elapsed, it is dropped.
  * Otherwise, it is returned to the caller.
+ *
+ * Besides the queue itself, the packets are indexed in the order they
+ * arrived, which is the order of their timestamps, so that the expired
+ * packets are dropped from the head of this index without walking the
+ * queue. The QoS data packets are also indexed by TID and address 1,
+ * and the other packets together, in the queue order, so that the
+ * lookups by TID and address 1 and for the first packet not blocked by
+ * the block ack agreements do not walk the queue either.
  */
 class WifiMacQueue : public Object
 {
@@ -151,7 +160,9 @@ public:
   /**
    * If exists, removes <i>packet</i> from queue and returns true. Otherwise it
    * takes no effects and return false. Deletion of the packet is
-   * performed in linear time (O(n)).
+   * performed in constant time when it is the first packet of its TID
+   * and address 1 (as after a PeekByTidAndAddress), or the first of the
+   * other packets, and in linear time (O(n)) otherwise.
    *
    * \param packet the packet to be removed
    *
@@ -217,6 +228,42 @@ public:
    */
   uint32_t GetSize (void);
 
+  /**
+   * Return the number of packets enqueued since the queue was created or
+   * the statistics were reset. The packets pushed at the front, which
+   * are re-queued, are not counted.
+   *
+   * \return the number of packets enqueued
+   */
+  uint32_t GetTotalReceivedPackets (void) const;
+  /**
+   * Return the number of packets dropped because the queue was full since
+   * the queue was created or the statistics were reset. The packets
+   * pushed at the front are not counted.
+   *
+   * \return the number of packets dropped because the queue was full
+   */
+  uint32_t GetTotalDroppedPackets (void) const;
+  /**
+   * Return the number of packets dropped because they stayed longer than
+   * the maximum delay in the queue since the queue was created or the
+   * statistics were reset.
+   *
+   * \return the number of packets dropped because of the maximum delay
+   */
+  uint32_t GetTotalExpiredPackets (void) const;
+  /**
+   * Return the largest queue size since the queue was created or the
+   * statistics were reset.
+   *
+   * \return the largest queue size
+   */
+  uint32_t GetMaxOccupancy (void) const;
+  /**
+   * Reset the statistics of the queue.
+   */
+  void ResetStatistics (void);
+
 
 protected:
   /**
@@ -224,6 +271,28 @@ protected:
    */
   virtual void Cleanup (void);
 
+  struct Item;
+  /**
+   * typedef for packet (struct Item) queue.
+   */
+  typedef std::list<struct Item> PacketQueue;
+  /**
+   * typedef for packet (struct Item) queue reverse iterator.
+   */
+  typedef std::list<struct Item>::reverse_iterator PacketQueueRI;
+  /**
+   * typedef for packet (struct Item) queue iterator.
+   */
+  typedef std::list<struct Item>::iterator PacketQueueI;
+  /**
+   * typedef for an index of packets, in the queue or arrival order.
+   */
+  typedef std::list<PacketQueueI> ItemIndex;
+  /**
+   * typedef for an iterator in an index of packets.
+   */
+  typedef std::list<PacketQueueI>::iterator ItemIndexI;
+
   /**
    * A struct that holds information about a packet for putting
    * in a packet queue.
@@ -243,20 +312,27 @@ protected:
     Ptr<const Packet> packet; //!< Actual packet
     WifiMacHeader hdr;        //!< Wifi MAC header associated with the packet
     Time tstamp;              //!< timestamp when the packet arrived at the queue
+    uint64_t order;           //!< increasing from the front to the back of the queue
+    ItemIndexI arrival;       //!< position in the arrival index
+    ItemIndexI index;         //!< position in the index by TID and address 1, or of the non-QoS packets
   };
 
   /**
-   * typedef for packet (struct Item) queue.
+   * The packets of an index by TID and address 1.
    */
-  typedef std::list<struct Item> PacketQueue;
+  struct TidAddressIndex
+  {
+    ItemIndex items;          //!< the packets, in the queue order
+    uint32_t size;            //!< the number of packets
+  };
   /**
-   * typedef for packet (struct Item) queue reverse iterator.
+   * typedef for the key of an index by TID and address 1.
    */
-  typedef std::list<struct Item>::reverse_iterator PacketQueueRI;
+  typedef std::pair<uint8_t, Mac48Address> TidAddress;
   /**
-   * typedef for packet (struct Item) queue iterator.
+   * typedef for the indexes by TID and address 1.
    */
-  typedef std::list<struct Item>::iterator PacketQueueI;
+  typedef std::map<TidAddress, TidAddressIndex> TidAddressIndexes;
   /**
    * Return the appropriate address for the given packet (given by PacketQueue iterator).
    *
@@ -266,11 +342,55 @@ protected:
    * \return the address
    */
   Mac48Address GetAddressForPacket (enum WifiMacHeader::AddressType type, PacketQueueI it);
+  /**
+   * Insert a packet at the front or at the back of the queue and in the
+   * indexes, unless the queue is full.
+   *
+   * \param packet the packet
+   * \param hdr the header of the packet
+   * \param front whether to insert the packet at the front of the queue
+   */
+  void Insert (Ptr<const Packet> packet, const WifiMacHeader &hdr, bool front);
+  /**
+   * Remove a packet from the queue and from the indexes.
+   *
+   * \param it the packet
+   */
+  void Erase (PacketQueueI it);
+  /**
+   * Find the first packet in the queue having address indicated by
+   * <i>type</i> equals to <i>addr</i>, and tid equals to <i>tid</i>.
+   *
+   * \param tid the given TID
+   * \param type the given address type
+   * \param addr the given destination
+   *
+   * \return the packet, or the end of the queue if none
+   */
+  PacketQueueI FindByTidAndAddress (uint8_t tid, WifiMacHeader::AddressType type, Mac48Address addr);
+  /**
+   * Find the first packet in the queue which is not a QoS data packet
+   * blocked by <i>blockedPackets</i>.
+   *
+   * \param blockedPackets the blocked destinations
+   *
+   * \return the packet, or the end of the queue if none
+   */
+  PacketQueueI FindFirstAvailable (const QosBlockedDestinations *blockedPackets);
 
-  PacketQueue m_queue; //!< Packet (struct Item) queue
+  PacketQueue m_queue;                   //!< Packet (struct Item) queue
+  ItemIndex m_arrivals;                  //!< Packets in the order they arrived
+  TidAddressIndexes m_tidAddressIndexes; //!< QoS data packets by TID and address 1
+  ItemIndex m_nonQosIndex;               //!< Packets other than QoS data
+  uint64_t m_frontOrder;                 //!< Order of the last packet pushed at the front
+  uint64_t m_backOrder;                  //!< Order of the next packet enqueued at the back
   uint32_t m_size;     //!< Current queue size
   uint32_t m_maxSize;  //!< Queue capacity
   Time m_maxDelay;     //!< Time to live for packets in the queue
+  uint32_t m_nTotalReceivedPackets; //!< Total received packets
+  uint32_t m_nTotalDroppedPackets;  //!< Total packets dropped because the queue was full
+  uint32_t m_nTotalExpiredPackets;  //!< Total packets dropped because of the maximum delay
+  uint32_t m_maxOccupancy;          //!< Largest queue size
 };
 
 } //namespace ns3
@@ -21,9 +21,14 @@
  * Ported/adapted from LTE lte-spectrum-value-helper.cc
  */
 
+#include "ns3/core-config.h"
 #include "ns3/log.h"
 #include "wifi-spectrum-helper.h"
 #include "wifi-phy.h"
+#include <map>
+#ifdef HAVE_PTHREAD_H
+#include "ns3/system-mutex.h"
+#endif /* HAVE_PTHREAD_H */
 
 namespace ns3 {
 
@@ -32,6 +37,13 @@ NS_LOG_COMPONENT_DEFINE ("WifiSpectrumHelper");
 // convert this to map as in LTE in the future
 static Ptr<SpectrumModel> g_wifiSpectrumModel = 0;
 
+/// RF filters already created, indexed by channel number
+static std::map<uint32_t, Ptr<const SpectrumValue> > g_wifiRfFilterMap;
+#ifdef HAVE_PTHREAD_H
+/// Protects g_wifiRfFilterMap, which the PHYs of concurrent partitions may fill
+static SystemMutex g_wifiRfFilterMutex;
+#endif /* HAVE_PTHREAD_H */
+
 uint16_t 
 WifiSpectrumHelper::GetFreqMHzForChannel (uint16_t channel)
 {
@@ -196,4 +208,21 @@ WifiSpectrumHelper::CreateRfFilter (uint32_t channel)
   return c;
 }
 
+Ptr<const SpectrumValue>
+WifiSpectrumHelper::GetRfFilter (uint32_t channel)
+{
+#ifdef HAVE_PTHREAD_H
+  CriticalSection cs (g_wifiRfFilterMutex);
+#endif /* HAVE_PTHREAD_H */
+  std::map<uint32_t, Ptr<const SpectrumValue> >::const_iterator it = g_wifiRfFilterMap.find (channel);
+  if (it != g_wifiRfFilterMap.end ())
+    {
+      return it->second;
+    }
+  NS_LOG_LOGIC ("creating RF filter for channel " << channel);
+  Ptr<const SpectrumValue> filter = CreateRfFilter (channel);
+  g_wifiRfFilterMap.insert (std::make_pair (channel, filter));
+  return filter;
+}
+
 } // namespace ns3
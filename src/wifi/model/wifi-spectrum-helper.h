@@ -80,6 +80,19 @@ public:
    */
   static Ptr<SpectrumValue> CreateRfFilter (uint32_t channel);
 
+  /*
+   *
+   * @param channel the number of the channel
+   *
+   * @return a Ptr to a shared SpectrumValue instance which represents
+   * the frequency response of the RF filter for the given channel. The
+   * filter is created with CreateRfFilter the first time a channel is
+   * requested, and then cached for subsequent calls. The cache is
+   * protected by a lock, so the PHYs keep the filter of their channel
+   * rather than calling this method on every reception.
+   */
+  static Ptr<const SpectrumValue> GetRfFilter (uint32_t channel);
+
 };
 
 } // namespace ns3
@@ -23,6 +23,9 @@
 #include "ns3/dsss-error-rate-model.h"
 #include "ns3/yans-error-rate-model.h"
 #include "ns3/nist-error-rate-model.h"
+#include "ns3/freq-selective-error-rate-model.h"
+#include "ns3/wifi-phy.h"
+#include "ns3/double.h"
 
 using namespace ns3;
 
@@ -279,6 +282,74 @@ WifiErrorRateModelsTestCaseNist::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ_TOL (ps, 0.999, 0.001, "Not equal within tolerance");
 }
 
+class WifiErrorRateModelsTestCaseCache : public TestCase
+{
+public:
+  WifiErrorRateModelsTestCaseCache ();
+  virtual ~WifiErrorRateModelsTestCaseCache ();
+
+private:
+  virtual void DoRun (void);
+};
+
+WifiErrorRateModelsTestCaseCache::WifiErrorRateModelsTestCaseCache ()
+  : TestCase ("WifiErrorRateModel test case for the FreqSelective tables and the chunk success rate cache")
+{
+}
+
+WifiErrorRateModelsTestCaseCache::~WifiErrorRateModelsTestCaseCache ()
+{
+}
+
+void
+WifiErrorRateModelsTestCaseCache::DoRun (void)
+{
+  uint32_t nbits = 2000 * 8;
+  WifiTxVector txVector;
+  txVector.SetChannelWidth (20);
+  txVector.SetNss (1);
+  Ptr<FreqSelectiveErrorRateModel> freqSel = CreateObject<FreqSelectiveErrorRateModel> ();
+
+  // ber = 10 ^ (p1 * snrDb + p2), with the parameters of the curves of HtMcs0
+  double snr = 10.0; // dB
+  double ber = std::pow (10.0, -0.187098 * snr - 2.378001);
+  double ps = freqSel->GetChunkSuccessRate (WifiPhy::GetHtMcs0 (), txVector, std::pow (10.0, snr / 10.0), nbits);
+  NS_TEST_ASSERT_MSG_EQ_TOL (ps, std::pow (1 - ber, nbits), 1e-12, "HtMcs0, 1 RX antenna");
+  freqSel->SetNumRxAntennas (2);
+  ber = std::pow (10.0, -0.300827 * snr - 3.756085);
+  ps = freqSel->GetChunkSuccessRate (WifiPhy::GetHtMcs0 (), txVector, std::pow (10.0, snr / 10.0), nbits);
+  NS_TEST_ASSERT_MSG_EQ_TOL (ps, std::pow (1 - ber, nbits), 1e-12, "HtMcs0, 2 RX antennas");
+  snr = 26.0;
+  txVector.SetNss (2);
+  ps = freqSel->GetChunkSuccessRate (WifiPhy::GetHtMcs15 (), txVector, std::pow (10.0, snr / 10.0), nbits);
+  NS_TEST_ASSERT_MSG_EQ_TOL (ps, 0, 1e-12, "HtMcs15, below the minimum SNR");
+  snr = 28.0;
+  ber = std::pow (10.0, -0.159535 * snr + 0.688334);
+  ps = freqSel->GetChunkSuccessRate (WifiPhy::GetHtMcs15 (), txVector, std::pow (10.0, snr / 10.0), nbits);
+  NS_TEST_ASSERT_MSG_EQ_TOL (ps, std::pow (1 - ber, nbits), 1e-12, "HtMcs15, 2 RX antennas");
+
+  // without a resolution, the cache is bypassed
+  txVector.SetNss (1);
+  Ptr<NistErrorRateModel> nist = CreateObject<NistErrorRateModel> ();
+  WifiMode mode ("OfdmRate24Mbps");
+  snr = std::pow (10.0, 13.0 / 10.0);
+  ps = nist->GetChunkSuccessRate (mode, txVector, snr, nbits);
+  NS_TEST_ASSERT_MSG_EQ (nist->GetCachedChunkSuccessRate (mode, txVector, snr, nbits), ps, "uncached success rate");
+  NS_TEST_ASSERT_MSG_EQ (nist->GetCacheStats ().lookups, 0, "the cache is disabled");
+
+  // with a resolution, the success rate of the quantized SNR is cached
+  nist->SetAttribute ("SnrCacheResolution", DoubleValue (0.01));
+  double cached = nist->GetCachedChunkSuccessRate (mode, txVector, snr, nbits);
+  NS_TEST_ASSERT_MSG_EQ_TOL (cached, ps, 0.01, "cached success rate");
+  NS_TEST_ASSERT_MSG_EQ (nist->GetCacheStats ().hits, 0, "the first lookup is a miss");
+  NS_TEST_ASSERT_MSG_EQ (nist->GetCachedChunkSuccessRate (mode, txVector, snr * 1.0001, nbits), cached, "same SNR bucket");
+  NS_TEST_ASSERT_MSG_EQ (nist->GetCacheStats ().hits, 1, "the second lookup is a hit");
+  ps = nist->GetCachedChunkSuccessRate (mode, txVector, snr, nbits / 2);
+  NS_TEST_ASSERT_MSG_EQ (nist->GetCacheStats ().hits, 1, "another number of bits is a miss");
+  NS_TEST_ASSERT_MSG_GT (ps, cached, "success rate of a shorter chunk");
+  NS_TEST_ASSERT_MSG_EQ (nist->GetCacheStats ().lookups, 3, "three lookups");
+}
+
 class WifiErrorRateModelsTestSuite : public TestSuite
 {
 public:
@@ -290,6 +361,7 @@ WifiErrorRateModelsTestSuite::WifiErrorRateModelsTestSuite ()
 {
   AddTestCase (new WifiErrorRateModelsTestCaseDsss, TestCase::QUICK);
   AddTestCase (new WifiErrorRateModelsTestCaseNist, TestCase::QUICK);
+  AddTestCase (new WifiErrorRateModelsTestCaseCache, TestCase::QUICK);
 }
 
 static WifiErrorRateModelsTestSuite wifiErrorRateModelsTestSuite;
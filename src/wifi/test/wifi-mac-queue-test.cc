@@ -0,0 +1,212 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2015 University of Washington
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/packet.h"
+#include "ns3/wifi-mac-queue.h"
+#include "ns3/qos-blocked-destinations.h"
+
+using namespace ns3;
+
+/**
+ * Return the header of a QoS data frame.
+ *
+ * \param tid the TID
+ * \param addr1 the address 1
+ */
+static WifiMacHeader
+CreateQosHeader (uint8_t tid, Mac48Address addr1)
+{
+  WifiMacHeader hdr;
+  hdr.SetType (WIFI_MAC_QOSDATA);
+  hdr.SetQosTid (tid);
+  hdr.SetAddr1 (addr1);
+  hdr.SetAddr2 (Mac48Address ("00:00:00:00:00:01"));
+  return hdr;
+}
+
+/**
+ * Return the header of a non-QoS data frame.
+ *
+ * \param addr1 the address 1
+ */
+static WifiMacHeader
+CreateDataHeader (Mac48Address addr1)
+{
+  WifiMacHeader hdr;
+  hdr.SetType (WIFI_MAC_DATA);
+  hdr.SetAddr1 (addr1);
+  return hdr;
+}
+
+/**
+ * Checks that the packets which stayed longer than the maximum delay are
+ * dropped, including those behind a packet pushed at the front.
+ */
+class WifiMacQueueExpiryTest : public TestCase
+{
+public:
+  WifiMacQueueExpiryTest ();
+
+private:
+  virtual void DoRun (void);
+  void PushFront (void);
+  void CheckFirstExpired (void);
+  void CheckAllExpired (void);
+
+  Ptr<WifiMacQueue> m_queue;
+  Ptr<const Packet> m_pushed;
+};
+
+WifiMacQueueExpiryTest::WifiMacQueueExpiryTest ()
+  : TestCase ("Check the expiry of the packets of a WifiMacQueue")
+{
+}
+
+void
+WifiMacQueueExpiryTest::PushFront (void)
+{
+  m_pushed = Create<Packet> (200);
+  m_queue->PushFront (m_pushed, CreateDataHeader (Mac48Address ("00:00:00:00:00:02")));
+}
+
+void
+WifiMacQueueExpiryTest::CheckFirstExpired (void)
+{
+  NS_TEST_EXPECT_MSG_EQ (m_queue->GetSize (), 1, "the packets enqueued first did not expire");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->GetTotalExpiredPackets (), 2, "wrong number of expired packets");
+  WifiMacHeader hdr;
+  NS_TEST_EXPECT_MSG_EQ (m_queue->Peek (&hdr), m_pushed, "the packet pushed at the front expired");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->GetNPacketsByTidAndAddress (3, WifiMacHeader::ADDR1, Mac48Address ("00:00:00:00:00:02")), 0,
+                         "an expired packet is still indexed");
+}
+
+void
+WifiMacQueueExpiryTest::CheckAllExpired (void)
+{
+  NS_TEST_EXPECT_MSG_EQ (m_queue->IsEmpty (), true, "the packet pushed at the front did not expire");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->GetTotalExpiredPackets (), 3, "wrong number of expired packets");
+}
+
+void
+WifiMacQueueExpiryTest::DoRun (void)
+{
+  m_queue = CreateObject<WifiMacQueue> ();
+  m_queue->SetMaxDelay (MilliSeconds (100));
+  m_queue->Enqueue (Create<Packet> (100), CreateQosHeader (3, Mac48Address ("00:00:00:00:00:02")));
+  m_queue->Enqueue (Create<Packet> (100), CreateQosHeader (3, Mac48Address ("00:00:00:00:00:02")));
+  Simulator::Schedule (MilliSeconds (60), &WifiMacQueueExpiryTest::PushFront, this);
+  Simulator::Schedule (MilliSeconds (120), &WifiMacQueueExpiryTest::CheckFirstExpired, this);
+  Simulator::Schedule (MilliSeconds (170), &WifiMacQueueExpiryTest::CheckAllExpired, this);
+  Simulator::Run ();
+  Simulator::Destroy ();
+  m_queue = 0;
+}
+
+/**
+ * Checks the lookups of a WifiMacQueue by TID and address, and for the
+ * first packet not blocked, and its statistics.
+ */
+class WifiMacQueueLookupTest : public TestCase
+{
+public:
+  WifiMacQueueLookupTest ();
+
+private:
+  virtual void DoRun (void);
+};
+
+WifiMacQueueLookupTest::WifiMacQueueLookupTest ()
+  : TestCase ("Check the lookups of the packets of a WifiMacQueue")
+{
+}
+
+void
+WifiMacQueueLookupTest::DoRun (void)
+{
+  Mac48Address x ("00:00:00:00:00:02");
+  Mac48Address y ("00:00:00:00:00:03");
+  Ptr<WifiMacQueue> queue = CreateObject<WifiMacQueue> ();
+  queue->SetMaxSize (6);
+  Ptr<const Packet> a = Create<Packet> (100);
+  Ptr<const Packet> b = Create<Packet> (100);
+  Ptr<const Packet> c = Create<Packet> (100);
+  Ptr<const Packet> d = Create<Packet> (100);
+  Ptr<const Packet> e = Create<Packet> (100);
+  Ptr<const Packet> f = Create<Packet> (100);
+  queue->Enqueue (a, CreateQosHeader (0, x));
+  queue->Enqueue (b, CreateQosHeader (1, x));
+  queue->Enqueue (c, CreateQosHeader (0, y));
+  queue->Enqueue (d, CreateDataHeader (x));
+  queue->Enqueue (e, CreateQosHeader (0, x));
+  queue->PushFront (f, CreateQosHeader (0, y));
+  queue->Enqueue (Create<Packet> (100), CreateDataHeader (y));
+  NS_TEST_EXPECT_MSG_EQ (queue->GetSize (), 6, "wrong queue size");
+  // the packet pushed at the front is not counted as received
+  NS_TEST_EXPECT_MSG_EQ (queue->GetTotalReceivedPackets (), 5, "wrong number of received packets");
+  NS_TEST_EXPECT_MSG_EQ (queue->GetTotalDroppedPackets (), 1, "wrong number of dropped packets");
+  NS_TEST_EXPECT_MSG_EQ (queue->GetMaxOccupancy (), 6, "wrong maximum occupancy");
+
+  WifiMacHeader hdr;
+  Time tstamp;
+  NS_TEST_EXPECT_MSG_EQ (queue->GetNPacketsByTidAndAddress (0, WifiMacHeader::ADDR1, x), 2, "wrong number of packets");
+  NS_TEST_EXPECT_MSG_EQ (queue->GetNPacketsByTidAndAddress (0, WifiMacHeader::ADDR1, y), 2, "wrong number of packets");
+  NS_TEST_EXPECT_MSG_EQ (queue->GetNPacketsByTidAndAddress (0, WifiMacHeader::ADDR2, Mac48Address ("00:00:00:00:00:01")), 4,
+                         "wrong number of packets by address 2");
+  NS_TEST_EXPECT_MSG_EQ (queue->PeekByTidAndAddress (&hdr, 0, WifiMacHeader::ADDR1, y, &tstamp), f, "wrong first packet");
+  NS_TEST_EXPECT_MSG_EQ (queue->DequeueByTidAndAddress (&hdr, 0, WifiMacHeader::ADDR1, x), a, "wrong first packet");
+  NS_TEST_EXPECT_MSG_EQ (queue->PeekByTidAndAddress (&hdr, 0, WifiMacHeader::ADDR1, x, &tstamp), e, "wrong next packet");
+  NS_TEST_EXPECT_MSG_EQ (queue->PeekByTidAndAddress (&hdr, 2, WifiMacHeader::ADDR1, x, &tstamp), 0, "packet of another TID");
+  NS_TEST_EXPECT_MSG_EQ (queue->Remove (e), true, "packet not removed");
+  NS_TEST_EXPECT_MSG_EQ (queue->Remove (e), false, "packet removed twice");
+  NS_TEST_EXPECT_MSG_EQ (queue->GetNPacketsByTidAndAddress (0, WifiMacHeader::ADDR1, x), 0, "wrong number of packets");
+
+  // the queue holds f, b, c, d
+  QosBlockedDestinations blocked;
+  blocked.Block (y, 0);
+  NS_TEST_EXPECT_MSG_EQ (queue->PeekFirstAvailable (&hdr, tstamp, &blocked), b, "wrong first available packet");
+  blocked.Block (x, 1);
+  NS_TEST_EXPECT_MSG_EQ (queue->DequeueFirstAvailable (&hdr, tstamp, &blocked), d, "wrong first available packet");
+  NS_TEST_EXPECT_MSG_EQ (queue->PeekFirstAvailable (&hdr, tstamp, &blocked), 0, "blocked packet available");
+  blocked.Unblock (y, 0);
+  NS_TEST_EXPECT_MSG_EQ (queue->DequeueFirstAvailable (&hdr, tstamp, &blocked), f, "wrong first available packet");
+  NS_TEST_EXPECT_MSG_EQ (queue->Dequeue (&hdr), b, "wrong packet at the front");
+  NS_TEST_EXPECT_MSG_EQ (queue->Dequeue (&hdr), c, "wrong packet at the front");
+  NS_TEST_EXPECT_MSG_EQ (queue->IsEmpty (), true, "queue not empty");
+
+  queue->ResetStatistics ();
+  NS_TEST_EXPECT_MSG_EQ (queue->GetTotalReceivedPackets (), 0, "statistics not reset");
+  NS_TEST_EXPECT_MSG_EQ (queue->GetMaxOccupancy (), 0, "statistics not reset");
+  Simulator::Destroy ();
+}
+
+class WifiMacQueueTestSuite : public TestSuite
+{
+public:
+  WifiMacQueueTestSuite ();
+};
+
+WifiMacQueueTestSuite::WifiMacQueueTestSuite ()
+  : TestSuite ("wifi-mac-queue", UNIT)
+{
+  AddTestCase (new WifiMacQueueExpiryTest, TestCase::QUICK);
+  AddTestCase (new WifiMacQueueLookupTest, TestCase::QUICK);
+}
+
+static WifiMacQueueTestSuite g_wifiMacQueueTestSuite;
@@ -39,6 +39,7 @@
 #include "ns3/packet-socket-server.h"
 #include "ns3/packet-socket-client.h"
 #include "ns3/packet-socket-helper.h"
+#include "ns3/interference-helper.h"
 
 using namespace ns3;
 
@@ -618,6 +619,72 @@ Bug730TestCase::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ (result, true, "packet reception unexpectedly stopped after adapting fragmentation threshold!");
 }
 
+//-----------------------------------------------------------------------------
+/**
+ * Make sure that the time until the medium energy drops below a threshold
+ * is computed correctly with overlapping signals, also after the helper
+ * has discarded the past noise and interference changes.
+ */
+class InterferenceHelperEnergyDurationTest : public TestCase
+{
+public:
+  InterferenceHelperEnergyDurationTest ();
+
+  virtual void DoRun (void);
+
+
+private:
+  /**
+   * Add a foreign signal to the helper.
+   * \param duration the duration of the signal
+   * \param rxPowerW the receive power (W)
+   */
+  void AddSignal (Time duration, double rxPowerW);
+  /**
+   * Check the energy duration returned by the helper.
+   * \param energyW the energy threshold (W)
+   * \param expected the expected duration
+   */
+  void CheckEnergyDuration (double energyW, Time expected);
+
+  InterferenceHelper m_interference;
+};
+
+InterferenceHelperEnergyDurationTest::InterferenceHelperEnergyDurationTest ()
+  : TestCase ("InterferenceHelper energy duration")
+{
+}
+
+void
+InterferenceHelperEnergyDurationTest::AddSignal (Time duration, double rxPowerW)
+{
+  m_interference.AddForeignSignal (duration, rxPowerW);
+}
+
+void
+InterferenceHelperEnergyDurationTest::CheckEnergyDuration (double energyW, Time expected)
+{
+  NS_TEST_EXPECT_MSG_EQ (m_interference.GetEnergyDuration (energyW), expected,
+                         "Unexpected energy duration at " << Simulator::Now () << " for threshold " << energyW);
+}
+
+void
+InterferenceHelperEnergyDurationTest::DoRun (void)
+{
+  // signal 1: [0, 100) us at 1 nW; signal 2: [20, 70) us at 2 nW
+  Simulator::Schedule (MicroSeconds (0), &InterferenceHelperEnergyDurationTest::AddSignal, this, MicroSeconds (100), 1e-9);
+  Simulator::Schedule (MicroSeconds (20), &InterferenceHelperEnergyDurationTest::AddSignal, this, MicroSeconds (50), 2e-9);
+  Simulator::Schedule (MicroSeconds (30), &InterferenceHelperEnergyDurationTest::CheckEnergyDuration, this, 1.5e-9, MicroSeconds (40));
+  Simulator::Schedule (MicroSeconds (30), &InterferenceHelperEnergyDurationTest::CheckEnergyDuration, this, 0.5e-9, MicroSeconds (70));
+  // signal 3: [80, 120) us at 1 nW, added once the changes of signal 2 are past
+  Simulator::Schedule (MicroSeconds (80), &InterferenceHelperEnergyDurationTest::AddSignal, this, MicroSeconds (40), 1e-9);
+  Simulator::Schedule (MicroSeconds (80), &InterferenceHelperEnergyDurationTest::CheckEnergyDuration, this, 1.5e-9, MicroSeconds (20));
+  Simulator::Schedule (MicroSeconds (90), &InterferenceHelperEnergyDurationTest::CheckEnergyDuration, this, 0.5e-9, MicroSeconds (30));
+  Simulator::Schedule (MicroSeconds (130), &InterferenceHelperEnergyDurationTest::CheckEnergyDuration, this, 0.5e-9, MicroSeconds (0));
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
 //-----------------------------------------------------------------------------
 class WifiTestSuite : public TestSuite
 {
@@ -633,6 +700,7 @@ WifiTestSuite::WifiTestSuite ()
   AddTestCase (new InterferenceHelperSequenceTest, TestCase::QUICK); //Bug 991
   AddTestCase (new Bug555TestCase, TestCase::QUICK); //Bug 555
   AddTestCase (new Bug730TestCase, TestCase::QUICK); //Bug 730
+  AddTestCase (new InterferenceHelperEnergyDurationTest, TestCase::QUICK);
 }
 
 static WifiTestSuite g_wifiTestSuite;